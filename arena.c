@@ -0,0 +1,233 @@
+#include <stdlib.h>  // Header file for memory allocation functions (malloc, calloc, free)
+#include <stdint.h>  // Header file for uintptr_t (address range test of arena_release)
+#include <pthread.h> // Header file for pthread_once / pthread_key_t (one arena per worker thread)
+#include "arena.h"   // User-defined header file for arena declarations
+
+#define ARENA_ROUND(n) (((n) + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1)) // Rounds a size up to ARENA_ALIGN
+
+// Structure to store one block of an arena; its memory follows the header
+struct ArenaBlock
+{
+  ArenaBlock *next; // Next block of the chain
+  size_t size;      // Usable bytes
+  size_t used;      // Bytes handed out since the last reset
+};
+
+#define ARENA_HEADER ARENA_ROUND(sizeof(ArenaBlock)) // Offset of the block memory (keeps it aligned)
+
+static __thread Arena *bound_arena;                    // Arena used by arena_malloc on this thread (NULL = heap)
+static pthread_key_t worker_key;                       // Thread's arena, destroyed when the thread exits
+static pthread_once_t worker_once = PTHREAD_ONCE_INIT; // Guards the one-time key creation
+
+/*
+ * Function: block_data
+ * Description: Returns the first byte of a block's memory
+ * Parameters: block - pointer to ArenaBlock
+ * Return: unsigned char * - block memory
+ */
+static unsigned char *block_data(ArenaBlock *block)
+{
+  return (unsigned char *)block + ARENA_HEADER;
+}
+
+/*
+ * Function: arena_init
+ * Description: Prepares an empty arena
+ * Parameters: arena - pointer to Arena
+ * Return: void
+ */
+void arena_init(Arena *arena)
+{
+  arena->first = NULL;
+  arena->current = NULL;
+}
+
+/*
+ * Function: arena_alloc
+ * Description: Bumps the current block, moves on to the next kept block, or appends a new one
+ * Parameters: arena - pointer to Arena, size - bytes wanted
+ * Return: void * - aligned memory, or NULL
+ */
+void *arena_alloc(Arena *arena, size_t size)
+{
+  ArenaBlock *last = NULL; // Last block of the chain (new blocks are appended)
+
+  size = ARENA_ROUND(size ? size : 1);
+  for (ArenaBlock *block = arena->current; block != NULL; block = block->next) // Kept blocks first
+  {
+    if (block->size - block->used >= size)
+    {
+      void *ptr = block_data(block) + block->used;
+      block->used += size;
+      arena->current = block; // Space left in earlier blocks waits for the reset
+      return ptr;
+    }
+    last = block;
+  }
+
+  size_t block_size = (size > ARENA_BLOCK_SIZE) ? size : ARENA_BLOCK_SIZE; // Oversized requests get a block of their own
+  ArenaBlock *block = malloc(ARENA_HEADER + block_size);
+
+  if (block == NULL) // Error handling: allocation failed
+  {
+    return NULL;
+  }
+  block->next = NULL;
+  block->size = block_size;
+  block->used = size;
+  if (last != NULL) // Append after the last block (current is NULL only while the arena is empty)
+  {
+    last->next = block;
+  }
+  else
+  {
+    arena->first = block;
+  }
+  arena->current = block;
+  return block_data(block);
+}
+
+/*
+ * Function: arena_reset
+ * Description: Rewinds every kept block; frees the blocks that would keep more than ARENA_RETAIN_MAX bytes
+ * Parameters: arena - pointer to Arena
+ * Return: void
+ */
+void arena_reset(Arena *arena)
+{
+  size_t kept = 0;                   // Bytes kept so far
+  ArenaBlock **link = &arena->first; // Link to the block being examined
+
+  while (*link != NULL)
+  {
+    ArenaBlock *block = *link;
+
+    if (kept + block->size > ARENA_RETAIN_MAX) // Rare huge file: do not hold its memory
+    {
+      *link = block->next;
+      free(block);
+      continue;
+    }
+    block->used = 0;
+    kept += block->size;
+    link = &block->next;
+  }
+  arena->current = arena->first;
+}
+
+/*
+ * Function: arena_destroy
+ * Description: Frees every block
+ * Parameters: arena - pointer to Arena
+ * Return: void
+ */
+void arena_destroy(Arena *arena)
+{
+  ArenaBlock *block = arena->first;
+
+  while (block != NULL)
+  {
+    ArenaBlock *next = block->next;
+    free(block);
+    block = next;
+  }
+  arena_init(arena);
+}
+
+/*
+ * Function: worker_exit
+ * Description: Thread-exit destructor of the worker arena
+ * Parameters: ptr - thread's Arena
+ * Return: void
+ */
+static void worker_exit(void *ptr)
+{
+  arena_destroy(ptr);
+  free(ptr);
+}
+
+/*
+ * Function: worker_key_create
+ * Description: Creates the key holding each thread's arena (run once)
+ * Parameters: None
+ * Return: void
+ */
+static void worker_key_create(void)
+{
+  pthread_key_create(&worker_key, worker_exit);
+}
+
+/*
+ * Function: arena_worker
+ * Description: Returns the calling thread's arena, creating it on first use
+ * Parameters: None
+ * Return: Arena * - thread's arena, or NULL
+ */
+Arena *arena_worker(void)
+{
+  pthread_once(&worker_once, worker_key_create); // Key created on first use
+
+  Arena *arena = pthread_getspecific(worker_key);
+  if (arena == NULL && (arena = calloc(1, sizeof(Arena))) != NULL) // First file of this thread
+  {
+    if (pthread_setspecific(worker_key, arena) != 0)
+    {
+      free(arena);
+      return NULL;
+    }
+  }
+  return arena;
+}
+
+/*
+ * Function: arena_bind
+ * Description: Sets the arena used by arena_malloc on the calling thread
+ * Parameters: arena - arena to bind, or NULL
+ * Return: Arena * - previous binding
+ */
+Arena *arena_bind(Arena *arena)
+{
+  Arena *previous = bound_arena;
+
+  bound_arena = arena;
+  return previous;
+}
+
+/*
+ * Function: arena_malloc
+ * Description: Allocates from the bound arena, or with malloc
+ * Parameters: size - bytes wanted
+ * Return: void * - memory, or NULL
+ */
+void *arena_malloc(size_t size)
+{
+  return (bound_arena != NULL) ? arena_alloc(bound_arena, size) : malloc(size);
+}
+
+/*
+ * Function: arena_release
+ * Description: Frees memory that does not lie in a block of the bound arena
+ * Parameters: ptr - memory to release
+ * Return: void
+ */
+void arena_release(void *ptr)
+{
+  if (ptr == NULL)
+  {
+    return;
+  }
+  if (bound_arena != NULL)
+  {
+    uintptr_t addr = (uintptr_t)ptr; // Compared as an address: ptr may come from the heap
+
+    for (ArenaBlock *block = bound_arena->first; block != NULL; block = block->next) // A block or two per worker
+    {
+      uintptr_t start = (uintptr_t)block_data(block);
+      if (addr >= start && addr < start + block->size) // Reclaimed by the next reset
+      {
+        return;
+      }
+    }
+  }
+  free(ptr); // Heap memory (allocated without an arena, or copied by code that does not use one)
+}
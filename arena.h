@@ -0,0 +1,95 @@
+#ifndef ARENA_H // If not defined ARENA_H ---> Checks if ARENA_H was previously defined: If not present, code is processed; else code below till #endif is ignored
+#define ARENA_H // Defines the macro ARENA_H if macro was not previously defined
+
+/*
+ * Per-worker bump allocator for the parsing path of bulk reads.
+ *
+ * - A bulk worker binds its arena to the thread for one file; while it is bound, arena_malloc hands out arena memory
+ *   and arena_release of such memory does nothing. The arena is reset after the file, keeping its blocks, so a scan
+ *   in steady state makes no heap allocation per file (and no cross-thread malloc/free traffic).
+ * - Without a bound arena (edits, the library, the service) arena_malloc is malloc and arena_release is free, so the
+ *   same parsing code serves both.
+ * - Memory from a bound arena must not outlive the file: copy anything kept longer (the index does).
+ */
+
+#include <stddef.h> // Header file for size_t
+
+#define ARENA_BLOCK_SIZE (256 * 1024)    // Default block: first read, frame window and decoded values of a typical file
+#define ARENA_RETAIN_MAX (1024 * 1024)   // Blocks kept by a reset; larger ones (huge unsynchronised tags) go back to the heap
+#define ARENA_ALIGN 16                   // Alignment of every allocation (malloc's guarantee on 64-bit glibc)
+
+typedef struct ArenaBlock ArenaBlock; // One heap block of an arena (defined in arena.c)
+
+// Structure to store one arena: a chain of blocks reused after every reset
+typedef struct // typedef used to give alternate name for structure here
+{
+  ArenaBlock *first;   // First block (kept by every reset)
+  ArenaBlock *current; // Block allocations are taken from
+} Arena;               // Arena is alternate name for this structure
+
+/*
+ * Function: arena_init
+ * Description: Prepares an empty arena (the first block is allocated by the first arena_alloc)
+ * Parameters: arena - pointer to Arena
+ * Return: void
+ */
+void arena_init(Arena *arena);
+
+/*
+ * Function: arena_alloc
+ * Description: Takes size bytes from the arena, adding a block only when no kept block has room
+ * Parameters: arena - pointer to Arena, size - bytes wanted
+ * Return: void * - ARENA_ALIGN-aligned memory valid until the next reset, or NULL if a block cannot be allocated
+ */
+void *arena_alloc(Arena *arena, size_t size);
+
+/*
+ * Function: arena_reset
+ * Description: Makes all memory of the arena available again; blocks beyond ARENA_RETAIN_MAX are freed
+ * Parameters: arena - pointer to Arena
+ * Return: void
+ */
+void arena_reset(Arena *arena);
+
+/*
+ * Function: arena_destroy
+ * Description: Frees every block of the arena
+ * Parameters: arena - pointer to Arena
+ * Return: void
+ */
+void arena_destroy(Arena *arena);
+
+/*
+ * Function: arena_worker
+ * Description: Returns the arena of the calling thread, created on first use and freed when the thread exits
+ * Parameters: None
+ * Return: Arena * - thread's arena, or NULL if it cannot be allocated (callers then fall back to the heap)
+ */
+Arena *arena_worker(void);
+
+/*
+ * Function: arena_bind
+ * Description: Makes an arena the source of arena_malloc on the calling thread (NULL restores malloc)
+ * Parameters: arena - arena to bind, or NULL
+ * Return: Arena * - previously bound arena (to be restored by the caller)
+ */
+Arena *arena_bind(Arena *arena);
+
+/*
+ * Function: arena_malloc
+ * Description: Allocates from the arena bound to the calling thread, or with malloc when none is bound
+ * Parameters: size - bytes wanted
+ * Return: void * - memory to give back with arena_release, or NULL
+ */
+void *arena_malloc(size_t size);
+
+/*
+ * Function: arena_release
+ * Description: Gives back memory from arena_malloc: nothing to do for memory of the bound arena (reclaimed by its
+ *              reset), free for anything else
+ * Parameters: ptr - memory to release (NULL is ignored)
+ * Return: void
+ */
+void arena_release(void *ptr);
+
+#endif // End of header guard: Marks the end of conditional compilation block started by #ifndef ARENA_H
@@ -0,0 +1,536 @@
+#include <stdio.h>    // Header file for standard input/output functions (printf, perror, snprintf)
+#include <stdlib.h>   // Header file for memory allocation functions (malloc, free)
+#include <string.h>   // Header file for string/memory functions (memchr, memcmp, strstr)
+#include <fcntl.h>    // Header file for open() and its flags (O_RDONLY)
+#include <unistd.h>   // Header file for POSIX I/O functions (pread, close)
+#include <sys/stat.h> // Header file for file status information (fstat)
+#include "type.h"     // User-defined header file for custom type definitions (Status, e_success, e_failure)
+#include "id3.h"      // User-defined header file for the ID3v2 header (where the audio starts)
+#include "trailer.h"  // User-defined header file for the trailer probe (where the audio ends)
+#include "output.h"   // User-defined header file for JSON Lines / TSV output
+#include "audio.h"    // User-defined header file for audio analysis declarations
+
+#if defined(__SSE2__) // x86-64 always has SSE2: the sync-word search checks 16 positions at a time
+#define HAVE_SSE2 1   // Enables the SSE2 search below
+#include <emmintrin.h> // Header file for SSE2 intrinsics
+#endif
+
+#define XING_SPAN 160 // Bytes of the first frame that hold a Xing/Info (up to 4 + 32 + 120) or VBRI header
+
+// Bitrates in kbit/s: [MPEG-1 / MPEG-2 and 2.5][layer - 1][bitrate index] (index 0 = free format, 15 = bad)
+static const short bitrates[2][3][16] = {
+    {{0, 32, 64, 96, 128, 160, 192, 224, 256, 288, 320, 352, 384, 416, 448, 0},
+     {0, 32, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384, 0},
+     {0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 0}},
+    {{0, 32, 48, 56, 64, 80, 96, 112, 128, 144, 160, 176, 192, 224, 256, 0},
+     {0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160, 0},
+     {0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160, 0}},
+};
+
+// Sample rates in Hz: [MPEG-1, MPEG-2, MPEG-2.5][sample rate index]
+static const int sample_rates[3][3] = {{44100, 48000, 32000}, {22050, 24000, 16000}, {11025, 12000, 8000}};
+
+static const char *const channel_modes[4] = {"stereo", "joint stereo", "dual channel", "mono"}; // Channel mode names
+static const char *const sources[4] = {"xing", "info", "vbri", "walk"};                         // AudioSource names
+
+/*
+ * Function: be32
+ * Description: Decodes a 4-byte big-endian integer (Xing and VBRI fields)
+ * Parameters: p - pointer to 4 bytes
+ * Return: unsigned long - decoded value
+ */
+static unsigned long be32(const unsigned char *p)
+{
+  return (unsigned long)p[0] << 24 | (unsigned long)p[1] << 16 | (unsigned long)p[2] << 8 | p[3];
+}
+
+/*
+ * Function: mpeg_parse_frame
+ * Description: Decodes a 4-byte MPEG audio frame header
+ * Parameters: h - 4 header bytes, frame - pointer to MpegFrame to fill
+ * Return: Status (e_success/e_failure)
+ *
+ * Header bits: AAAAAAAA AAABBCCD EEEEFFGH IIJJKLMM
+ * A = sync, B = version (00 = 2.5, 10 = 2, 11 = 1), C = layer (01 = III, 10 = II, 11 = I), D = no CRC,
+ * E = bitrate index, F = sample rate index, G = padding, H = private, I = channel mode, J..M = extension, flags, emphasis
+ */
+Status mpeg_parse_frame(const unsigned char *h, MpegFrame *frame)
+{
+  int version_bits = (h[1] >> 3) & 0x03; // B
+  int layer_bits = (h[1] >> 1) & 0x03;   // C
+  int bitrate_index = h[2] >> 4;         // E
+  int rate_index = (h[2] >> 2) & 0x03;   // F
+  int padding = (h[2] >> 1) & 0x01;      // G
+
+  if (h[0] != 0xFF || (h[1] & 0xE0) != 0xE0 || version_bits == 1 || layer_bits == 0 || bitrate_index == 0 || bitrate_index == 15 || rate_index == 3)
+  {
+    return e_failure; // No sync word, reserved value, free format or bad bitrate
+  }
+
+  int mpeg1 = (version_bits == 3);
+  frame->version = mpeg1 ? 10 : (version_bits == 2) ? 20 : 25;
+  frame->layer = 4 - layer_bits;
+  frame->bitrate = bitrates[!mpeg1][frame->layer - 1][bitrate_index];
+  frame->sample_rate = sample_rates[mpeg1 ? 0 : (version_bits == 2) ? 1 : 2][rate_index];
+  frame->channel_mode = h[3] >> 6;
+
+  if (frame->layer == 1) // Layer I: 4-byte slots
+  {
+    frame->samples = 384;
+    frame->length = (size_t)(12000 * frame->bitrate / frame->sample_rate + padding) * 4;
+  }
+  else if (frame->layer == 2 || mpeg1) // Layer II, and Layer III of MPEG-1
+  {
+    frame->samples = 1152;
+    frame->length = (size_t)(144000 * frame->bitrate / frame->sample_rate + padding);
+  }
+  else // Layer III of MPEG-2 / 2.5: half the samples
+  {
+    frame->samples = 576;
+    frame->length = (size_t)(72000 * frame->bitrate / frame->sample_rate + padding);
+  }
+  return e_success;
+}
+
+/*
+ * Function: same_stream
+ * Description: Tells whether a frame belongs to the stream of the first frame (false syncs in the audio data rarely do)
+ * Parameters: a, b - decoded frames
+ * Return: int - 1 if version, layer and sample rate match
+ */
+static int same_stream(const MpegFrame *a, const MpegFrame *b)
+{
+  return a->version == b->version && a->layer == b->layer && a->sample_rate == b->sample_rate;
+}
+
+/*
+ * Function: find_sync
+ * Description: Finds the next candidate frame header: a 0xFF byte followed by a byte with its top 3 bits set.
+ *              SSE2 compares 16 positions per step; elsewhere memchr (vectorised by the C library) finds each 0xFF.
+ * Parameters: p - search start, end - end of the bytes
+ * Return: const unsigned char * - candidate, or NULL when none starts before end - 1
+ */
+static const unsigned char *find_sync(const unsigned char *p, const unsigned char *end)
+{
+#ifdef HAVE_SSE2
+  const __m128i ff = _mm_set1_epi8((char)0xFF);
+  const __m128i e0 = _mm_set1_epi8((char)0xE0);
+
+  for (; end - p >= 17; p += 16) // 16 first bytes + the byte after the last one
+  {
+    __m128i first = _mm_loadu_si128((const __m128i *)p);
+    __m128i second = _mm_loadu_si128((const __m128i *)(p + 1));
+    __m128i hit = _mm_and_si128(_mm_cmpeq_epi8(first, ff), _mm_cmpeq_epi8(_mm_max_epu8(second, e0), second)); // 0xFF, then >= 0xE0
+    int mask = _mm_movemask_epi8(hit);
+    if (mask != 0)
+    {
+      return p + __builtin_ctz((unsigned int)mask);
+    }
+  }
+#endif
+
+  while (end - p >= 2)
+  {
+    p = memchr(p, 0xFF, (size_t)(end - p) - 1); // A candidate needs the byte after it
+    if (p == NULL)
+    {
+      return NULL;
+    }
+    if (p[1] >= 0xE0)
+    {
+      return p;
+    }
+    p++;
+  }
+  return NULL;
+}
+
+/*
+ * Function: audio_bounds
+ * Description: Finds the audio region between the ID3v2 tag and the trailer tags
+ * Parameters: fd - file descriptor, start - receives the audio start, end - receives the audio end
+ * Return: Status (e_success/e_failure)
+ */
+Status audio_bounds(int fd, off_t *start, off_t *end)
+{
+  Id3Header header; // ID3v2 header at the start (optional)
+  TrailerInfo trailer;
+  struct stat st;
+
+  if (fstat(fd, &st) == -1 || trailer_probe(fd, &trailer) == e_failure)
+  {
+    return e_failure;
+  }
+  *start = (id3_read_header(fd, &header) == e_success) ? (off_t)id3_tag_end(&header) : 0; // Tag, padding and footer
+  *end = trailer.found ? trailer.start : st.st_size;                                        // ID3v1 / APEv2 / Lyrics3v2 are not audio
+  trailer_free(&trailer);
+
+  if (*start > *end) // Error handling: tag size larger than the file
+  {
+    *start = *end;
+  }
+  return e_success;
+}
+
+/*
+ * Function: find_first_frame
+ * Description: Searches the first AUDIO_SYNC_WINDOW bytes of the audio for a frame header whose next frame
+ *              header is valid and of the same stream
+ * Parameters: fd - file descriptor, stream - AudioStream with audio_start/audio_end (audio_start is moved to the frame),
+ *             head - receives the first XING_SPAN bytes of the frame (zero-filled past the end of the audio)
+ * Return: Status (e_failure if no confirmed frame header was found)
+ */
+static Status find_first_frame(int fd, AudioStream *stream, unsigned char head[XING_SPAN])
+{
+  off_t avail = stream->audio_end - stream->audio_start;
+  size_t want = (avail < AUDIO_SYNC_WINDOW) ? (size_t)avail : AUDIO_SYNC_WINDOW;
+  unsigned char *buf = malloc(want + XING_SPAN);
+  Status status = e_failure;
+
+  if (buf == NULL)
+  {
+    return e_failure;
+  }
+
+  ssize_t got = pread(fd, buf, want, stream->audio_start);
+  const unsigned char *end = buf + (got > 0 ? got : 0);
+
+  for (const unsigned char *p = find_sync(buf, end); p != NULL && p + MPEG_HEADER_SIZE <= end; p = find_sync(p + 1, end))
+  {
+    MpegFrame frame, next;
+    off_t offset = stream->audio_start + (p - buf); // File offset of the candidate
+    unsigned char h[MPEG_HEADER_SIZE];              // Header of the following frame
+
+    if (mpeg_parse_frame(p, &frame) == e_failure)
+    {
+      continue;
+    }
+    if (offset + (off_t)frame.length + MPEG_HEADER_SIZE <= stream->audio_end) // Confirm with the next header
+    {
+      const unsigned char *n = p + frame.length;
+      if (n + MPEG_HEADER_SIZE > end) // Next header is past the window
+      {
+        if (pread(fd, h, MPEG_HEADER_SIZE, offset + (off_t)frame.length) != MPEG_HEADER_SIZE)
+        {
+          continue;
+        }
+        n = h;
+      }
+      if (mpeg_parse_frame(n, &next) == e_failure || !same_stream(&frame, &next))
+      {
+        continue;
+      }
+    }
+    else if (offset + (off_t)frame.length > stream->audio_end) // A single frame must at least fit
+    {
+      continue;
+    }
+
+    stream->first = frame;
+    stream->audio_start = offset;
+    memset(head, 0, XING_SPAN);
+    if (p + XING_SPAN <= end) // Xing/VBRI area already read
+    {
+      memcpy(head, p, XING_SPAN);
+    }
+    else if (pread(fd, head, XING_SPAN, offset) < MPEG_HEADER_SIZE)
+    {
+      break;
+    }
+    status = e_success;
+    break;
+  }
+  free(buf);
+  return status;
+}
+
+/*
+ * Function: read_vbr_header
+ * Description: Takes the frame count (and byte count) from a Xing/Info header after the Layer III side information,
+ *              or from a VBRI header 32 bytes after the frame header
+ * Parameters: stream - AudioStream with the first frame, head - first XING_SPAN bytes of the frame, bytes - receives
+ *             the audio byte count (0 if not given)
+ * Return: int - 1 if the frame count is known, 0 if the frames must be walked, -1 for a Xing/Info frame without count
+ */
+static int read_vbr_header(AudioStream *stream, const unsigned char *head, unsigned long *bytes)
+{
+  int mono = (stream->first.channel_mode == 3);
+  size_t side = (stream->first.version == 10) ? (mono ? 17 : 32) : (mono ? 9 : 17); // Layer III side information
+  const unsigned char *x = head + MPEG_HEADER_SIZE + side;
+
+  *bytes = 0;
+  if (stream->first.layer == 3 && (memcmp(x, "Xing", 4) == 0 || memcmp(x, "Info", 4) == 0))
+  {
+    unsigned long flags = be32(x + 4);
+    const unsigned char *q = x + 8; // Optional fields in flag order: frames, bytes, TOC, quality
+
+    stream->source = (x[0] == 'X') ? e_audio_xing : e_audio_info;
+    if (!(flags & 0x01))
+    {
+      return -1;
+    }
+    stream->frames = be32(q);
+    if (flags & 0x02)
+    {
+      *bytes = be32(q + 4);
+    }
+    return 1;
+  }
+
+  const unsigned char *v = head + MPEG_HEADER_SIZE + 32; // VBRI: fixed position
+  if (memcmp(v, "VBRI", 4) == 0)
+  {
+    stream->source = e_audio_vbri;
+    *bytes = be32(v + 10);
+    stream->frames = be32(v + 14);
+    return 1;
+  }
+  return 0;
+}
+
+/*
+ * Function: walk_frames
+ * Description: Visits every frame header from offset to the end of the audio, hopping by frame length; bytes that
+ *              are not a frame of the stream are skipped with find_sync
+ * Parameters: fd - file descriptor, stream - AudioStream to complete, offset - first frame to count
+ * Return: Status (e_success/e_failure)
+ */
+static Status walk_frames(int fd, AudioStream *stream, off_t offset)
+{
+  unsigned char *buf = malloc(AUDIO_WALK_CHUNK);
+  off_t buf_off = 0;             // File offset of buf[0]
+  size_t got = 0;                // Bytes in buf
+  unsigned long long samples = 0; // Samples of all counted frames
+  unsigned long long bytes = 0;  // Bytes of all counted frames
+
+  if (buf == NULL)
+  {
+    return e_failure;
+  }
+
+  stream->frames = 0;
+  while (offset + MPEG_HEADER_SIZE <= stream->audio_end)
+  {
+    if (got == 0 || offset < buf_off || offset + MPEG_HEADER_SIZE > buf_off + (off_t)got) // Header not in the buffer
+    {
+      off_t left = stream->audio_end - offset;
+      ssize_t n = pread(fd, buf, left < AUDIO_WALK_CHUNK ? (size_t)left : AUDIO_WALK_CHUNK, offset);
+      if (n < MPEG_HEADER_SIZE)
+      {
+        break;
+      }
+      buf_off = offset;
+      got = (size_t)n;
+    }
+
+    const unsigned char *h = buf + (offset - buf_off);
+    MpegFrame frame;
+    if (mpeg_parse_frame(h, &frame) == e_success && same_stream(&frame, &stream->first))
+    {
+      if (offset + (off_t)frame.length > stream->audio_end) // Truncated last frame
+      {
+        break;
+      }
+      stream->frames++;
+      samples += (unsigned long long)frame.samples;
+      bytes += frame.length;
+      if (frame.bitrate != stream->first.bitrate)
+      {
+        stream->vbr = 1;
+      }
+      offset += (off_t)frame.length; // Next header: the audio between them is never looked at
+      continue;
+    }
+
+    const unsigned char *sync = find_sync(h + 1, buf + got); // Lost sync (junk, ID3 chunks): next candidate
+    offset = sync ? buf_off + (sync - buf) : buf_off + (off_t)got - 1; // Keep the last byte: it may start a sync word
+  }
+  free(buf);
+
+  stream->duration = (double)samples / stream->first.sample_rate;
+  stream->bitrate = stream->duration > 0 ? (int)(bytes * 8 / stream->duration / 1000 + 0.5) : 0;
+  stream->source = e_audio_walk;
+  return e_success;
+}
+
+/*
+ * Function: audio_locate
+ * Description: Finds the audio region and its first confirmed frame header
+ * Parameters: fd - file descriptor, stream - pointer to AudioStream to fill (first, audio_start, audio_end)
+ * Return: Status (e_success/e_failure)
+ */
+Status audio_locate(int fd, AudioStream *stream)
+{
+  unsigned char head[XING_SPAN]; // Start of the first frame (not needed here)
+
+  memset(stream, 0, sizeof(*stream));
+  if (audio_bounds(fd, &stream->audio_start, &stream->audio_end) == e_failure)
+  {
+    return e_failure;
+  }
+  return find_first_frame(fd, stream, head);
+}
+
+/*
+ * Function: audio_analyze
+ * Description: Finds the first frame, then reads a VBR header or walks the frame headers
+ * Parameters: fd - file descriptor, stream - pointer to AudioStream to fill
+ * Return: Status (e_success/e_failure)
+ */
+Status audio_analyze(int fd, AudioStream *stream)
+{
+  unsigned char head[XING_SPAN]; // Start of the first frame
+  unsigned long bytes;           // Audio bytes from the VBR header
+
+  memset(stream, 0, sizeof(*stream));
+  if (audio_bounds(fd, &stream->audio_start, &stream->audio_end) == e_failure || find_first_frame(fd, stream, head) == e_failure)
+  {
+    return e_failure;
+  }
+
+  int known = read_vbr_header(stream, head, &bytes);
+  if (known <= 0) // No usable header: count the frames (skipping a Xing/Info frame that had no count)
+  {
+    return walk_frames(fd, stream, stream->audio_start + (known < 0 ? (off_t)stream->first.length : 0));
+  }
+
+  if (bytes == 0) // Header without byte count: everything after the header frame
+  {
+    bytes = (unsigned long)(stream->audio_end - stream->audio_start - (off_t)stream->first.length);
+  }
+  stream->duration = (double)stream->frames * stream->first.samples / stream->first.sample_rate;
+  stream->bitrate = stream->duration > 0 ? (int)(bytes * 8.0 / stream->duration / 1000 + 0.5) : stream->first.bitrate;
+  stream->vbr = (stream->source != e_audio_info); // Info marks a constant bitrate file
+  return e_success;
+}
+
+/*
+ * Function: read_and_validate_for_info
+ * Description: Validates the --info arguments: one or more .mp3 files
+ * Parameters: argc - argument count, argv[] - command-line argument array, auInfo - pointer to AudioInfo structure
+ * Return: Status (e_success/e_failure)
+ */
+Status read_and_validate_for_info(int argc, char *argv[], AudioInfo *auInfo)
+{
+  if (argc < 3) // Error handling: no file given
+  {
+    printf("\033[1;91mERROR: \033[1;97mUsage: --info <file.mp3...>\n");
+    return e_failure;
+  }
+
+  for (int i = 2; i < argc; i++)
+  {
+    if (strstr(argv[i], ".mp3") == NULL) // Same rule as the other commands
+    {
+      printf("\033[1;91mERROR: \033[1;97mInvalid source file without .mp3 extension: %s\n", argv[i]);
+      return e_failure;
+    }
+  }
+  auInfo->files = argv + 2;
+  auInfo->count = argc - 2;
+  return e_success;
+}
+
+/*
+ * Function: format_name
+ * Description: Writes "MPEG-1 Layer III" style names
+ * Parameters: frame - decoded frame, out - output buffer (at least 24 bytes), size - buffer size
+ * Return: const char * - out
+ */
+static const char *format_name(const MpegFrame *frame, char *out, size_t size)
+{
+  static const char *const layers[3] = {"I", "II", "III"};
+
+  snprintf(out, size, "MPEG-%s Layer %s", frame->version == 10 ? "1" : frame->version == 20 ? "2" : "2.5", layers[frame->layer - 1]);
+  return out;
+}
+
+/*
+ * Function: print_info_row
+ * Description: Prints one row of the audio table (same layout as the tag table)
+ * Parameters: label - row label, gap - spaces after the label, value - row text
+ * Return: void
+ */
+static void print_info_row(const char *label, int gap, const char *value)
+{
+  printf("▐ \033[1;93m\033[1;7m \033[1;92m %-4s\033[0m\033[1;97m%*s%-5s \033[1;3m%-102s\033[0m▌\n", label, gap, "", ":", value);
+}
+
+/*
+ * Function: print_info_table
+ * Description: Prints the analysis of one file as a table
+ * Parameters: path - file path, stream - analysis result
+ * Return: void
+ */
+static void print_info_table(const char *path, const AudioStream *stream)
+{
+  char rows[7][128]; // Row texts
+  static const char *const labels[7] = {"DURATION ", "BITRATE ", "SAMPLING ", "CHANNELS ", "FORMAT ", "FRAMES ", "SOURCE "};
+  static const int gaps[7] = {2, 3, 2, 2, 4, 4, 4}; // Spaces after each label so the ':' column lines up
+  long ms = (long)(stream->duration * 1000 + 0.5);
+
+  snprintf(rows[0], sizeof(rows[0]), "%ld:%02ld.%03ld (%.3f s)", ms / 60000, ms / 1000 % 60, ms % 1000, stream->duration);
+  snprintf(rows[1], sizeof(rows[1]), "%d kbit/s%s", stream->bitrate, stream->vbr ? " (VBR average)" : "");
+  snprintf(rows[2], sizeof(rows[2]), "%d Hz", stream->first.sample_rate);
+  snprintf(rows[3], sizeof(rows[3]), "%s", channel_modes[stream->first.channel_mode]);
+  format_name(&stream->first, rows[4], sizeof(rows[4]));
+  snprintf(rows[5], sizeof(rows[5]), "%lu", stream->frames);
+  snprintf(rows[6], sizeof(rows[6]), "%s", sources[stream->source]);
+
+  printf("\033[1;97m\n▐▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▀▌\n");
+  printf("▐ \033[1;7;93m%-47c\033[1;92m %s \033[0m\033[1;7;93m%-46c\033[0m\033[1;97m ▌\n", ' ', "MP3 Tag Reader and Editor", ' ');
+  printf("\033[1;97m▐▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▌\n");
+  print_info_row("FILE ", 6, path);
+  for (int i = 0; i < 7; i++)
+  {
+    printf("\033[1;97m▐▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▌\n");
+    print_info_row(labels[i], gaps[i], rows[i]);
+  }
+  printf("\033[1;97m▐▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▄▌\n\n");
+}
+
+/*
+ * Function: audio_info
+ * Description: Analyses and prints every file of the request
+ * Parameters: auInfo - pointer to AudioInfo structure
+ * Return: Status (e_failure if any file failed)
+ */
+Status audio_info(AudioInfo *auInfo)
+{
+  Status status = e_success;
+
+  for (int i = 0; i < auInfo->count; i++)
+  {
+    const char *path = auInfo->files[i];
+    AudioStream stream;
+    int fd = open(path, O_RDONLY); // Open source MP3 file in read mode
+
+    if (fd == -1)
+    {
+      perror(path);
+      status = e_failure;
+      continue;
+    }
+    Status analysed = audio_analyze(fd, &stream);
+    close(fd);
+
+    if (analysed == e_failure) // Error handling: no MPEG audio after the tag
+    {
+      printf("\033[1;91mERROR: \033[1;97m%s: no MPEG audio frames found\n", path);
+      status = e_failure;
+      continue;
+    }
+
+    if (output_porcelain()) // JSON Lines / TSV record instead of the table
+    {
+      char format[32];
+      output_audio(path, stream.duration, stream.bitrate, stream.first.sample_rate, channel_modes[stream.first.channel_mode],
+                   format_name(&stream.first, format, sizeof(format)), stream.vbr, stream.frames, sources[stream.source]);
+    }
+    else
+    {
+      print_info_table(path, &stream);
+    }
+  }
+  return status;
+}
@@ -0,0 +1,105 @@
+#ifndef AUDIO_H // If not defined AUDIO_H ---> Checks if AUDIO_H was previously defined: If not present, code is processed; else code below till #endif is ignored
+#define AUDIO_H // Defines the macro AUDIO_H if macro was not previously defined
+
+#include <sys/types.h> // Header file for off_t
+#include "type.h"      // User-defined header file for custom type definitions (Status, e_success, e_failure)
+
+#define AUDIO_SYNC_WINDOW (64 * 1024)   // Bytes searched after the tag for the first frame header
+#define AUDIO_WALK_CHUNK (1024 * 1024)  // Read size of the frame-header walk
+#define MPEG_HEADER_SIZE 4              // 11-bit sync word + version, layer, bitrate, sample rate, channel mode
+
+// Enumeration of where the duration came from
+typedef enum // typedef used to give alternate name for enum here
+{
+  e_audio_xing, // Xing header (VBR): frame count in the first frame
+  e_audio_info, // Info header (CBR, written by LAME): same layout as Xing
+  e_audio_vbri, // VBRI header (Fraunhofer encoders)
+  e_audio_walk  // No header: every frame header was visited
+} AudioSource;  // AudioSource is alternate name for this enum
+
+// Structure to store the decoded fields of one MPEG audio frame header
+typedef struct // typedef used to give alternate name for structure here
+{
+  int version;       // 10 = MPEG-1, 20 = MPEG-2, 25 = MPEG-2.5
+  int layer;         // 1, 2 or 3
+  int bitrate;       // Bitrate in kbit/s
+  int sample_rate;   // Sample rate in Hz
+  int channel_mode;  // 0 = stereo, 1 = joint stereo, 2 = dual channel, 3 = mono
+  int samples;       // Samples per frame (384, 576 or 1152)
+  size_t length;     // Frame length in bytes, header included
+} MpegFrame;         // MpegFrame is alternate name for this structure
+
+// Structure to store the result of the audio analysis
+typedef struct // typedef used to give alternate name for structure here
+{
+  MpegFrame first;      // First frame header (format of the stream)
+  off_t audio_start;    // Offset of the first frame (after the ID3v2 tag and any junk)
+  off_t audio_end;      // End of the audio data (start of the trailer tags, or end of file)
+  unsigned long frames; // Audio frames (the Xing / VBRI frame itself is not counted)
+  double duration;      // Duration in seconds
+  int bitrate;          // Average bitrate in kbit/s
+  int vbr;              // 1 if the bitrate changes between frames
+  AudioSource source;   // Where the frame count came from
+} AudioStream;          // AudioStream is alternate name for this structure
+
+// Structure to store the files of an --info request
+typedef struct // typedef used to give alternate name for structure here
+{
+  char **files; // MP3 files to analyse (argv[2..])
+  int count;    // Number of files
+} AudioInfo;    // AudioInfo is alternate name for this structure
+
+/*
+ * Function: mpeg_parse_frame
+ * Description: Decodes a 4-byte MPEG audio frame header (reserved, free-format and bad values are rejected)
+ * Parameters: h - 4 header bytes, frame - pointer to MpegFrame to fill
+ * Return: Status (e_failure if the bytes are not a usable frame header)
+ */
+Status mpeg_parse_frame(const unsigned char *h, MpegFrame *frame);
+
+/*
+ * Function: audio_bounds
+ * Description: Finds the audio region of a file: after the ID3v2 tag (footer included), before the trailer tags
+ * Parameters: fd - file descriptor, start - receives the first byte after the tag, end - receives the end of the audio
+ * Return: Status (e_failure for read errors)
+ */
+Status audio_bounds(int fd, off_t *start, off_t *end);
+
+/*
+ * Function: audio_locate
+ * Description: Finds the audio region (audio_bounds) and moves its start to the first confirmed frame header, so
+ *              zero bytes or junk that taggers leave between the tag and the audio are not counted as audio
+ * Parameters: fd - file descriptor, stream - pointer to AudioStream (first, audio_start and audio_end are filled)
+ * Return: Status (e_failure if no MPEG audio frame is found)
+ */
+Status audio_locate(int fd, AudioStream *stream);
+
+/*
+ * Function: audio_analyze
+ * Description: Locates the first frame (confirmed by the frame that follows it), then takes the frame count from a
+ *              Xing/Info or VBRI header. Without one, every frame header is visited: the walk hops from header to
+ *              header by frame length in AUDIO_WALK_CHUNK reads and resynchronises with a vectorised sync-word
+ *              search. The audio itself is never decoded.
+ * Parameters: fd - file descriptor, stream - pointer to AudioStream to fill
+ * Return: Status (e_failure if no MPEG audio frame is found)
+ */
+Status audio_analyze(int fd, AudioStream *stream);
+
+/*
+ * Function: read_and_validate_for_info
+ * Description: Stores the .mp3 files given after --info
+ * Parameters: argc - argument count, argv[] - command-line argument array, auInfo - pointer to AudioInfo structure
+ * Return: Status (e_success/e_failure)
+ */
+Status read_and_validate_for_info(int argc, char *argv[], AudioInfo *auInfo);
+
+/*
+ * Function: audio_info
+ * Description: Analyses every file and prints duration, bitrate, sample rate, channel mode and format
+ *              (a table, or one JSON Lines / TSV record per file with --format)
+ * Parameters: auInfo - pointer to AudioInfo structure
+ * Return: Status (e_failure if any file could not be analysed)
+ */
+Status audio_info(AudioInfo *auInfo);
+
+#endif // End of header guard: Marks the end of conditional compilation block started by #ifndef AUDIO_H
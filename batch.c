@@ -0,0 +1,575 @@
+#include <stdio.h>   // Header file for standard input/output functions (printf, fprintf, fopen, getline, flockfile, etc.)
+#include <stdlib.h>  // Header file for memory allocation functions (malloc, realloc, free, qsort, realpath)
+#include <string.h>  // Header file for string manipulation functions (strcmp, strdup, strcspn, strerror, etc.)
+#include <strings.h> // Header file for strcasecmp, strncasecmp
+#include <ctype.h>   // Header file for character classification (isspace, isxdigit)
+#include <errno.h>   // Header file for errno (cause of a failed edit)
+#include "type.h"    // User-defined header file for custom type definitions (Status, e_success, e_failure)
+#include "id3.h"     // User-defined header file for TagField lookup
+#include "mp3tag.h"  // Library header file for the per-file edit (open, set frame, commit)
+#include "pool.h"    // User-defined header file for the worker pool
+#include "text.h"    // User-defined header file for UTF-8 output of \uXXXX escapes (text_put_utf8)
+#include "stats.h"   // User-defined header file for per-file latency (--stats)
+#include "batch.h"   // User-defined header file for BatchInfo structure and function declarations
+
+/*
+ * Function: read_and_validate_for_batch
+ * Description: Stores the manifest name given after -b
+ * Parameters: argc - argument count, argv[] - command-line argument array, batchInfo - pointer to BatchInfo structure
+ * Return: Status (e_success/e_failure)
+ */
+Status read_and_validate_for_batch(int argc, char *argv[], BatchInfo *batchInfo)
+{
+  memset(batchInfo, 0, sizeof(*batchInfo)); // No entries, no counters
+
+  if (argc != 3) // Exactly one manifest expected
+  {
+    printf("\033[1;91mERROR: \033[1;97mBatch mode needs one manifest file (or \"-\" for standard input)\n");
+    return e_failure;
+  }
+  batchInfo->manifest_fname = argv[2]; // Manifest path or "-"
+  return e_success;
+}
+
+/*
+ * Function: add_entry
+ * Description: Appends one parsed manifest line as a BatchEntry (the values are copied)
+ * Parameters: batchInfo - pointer to BatchInfo, path - file path, value - new content per field, line - manifest line
+ * Return: Status (e_success/e_failure)
+ */
+static Status add_entry(BatchInfo *batchInfo, const char *path, char *value[TAG_FIELD_COUNT], unsigned long line)
+{
+  if (batchInfo->entry_count == batchInfo->entry_capacity) // Grow the entry array geometrically
+  {
+    size_t capacity = batchInfo->entry_capacity ? batchInfo->entry_capacity * 2 : 256;
+    BatchEntry *entries = realloc(batchInfo->entries, capacity * sizeof(BatchEntry));
+
+    if (entries == NULL) // Error handling: allocation failed
+    {
+      perror("realloc");
+      return e_failure;
+    }
+    batchInfo->entries = entries;
+    batchInfo->entry_capacity = capacity;
+  }
+
+  BatchEntry *entry = &batchInfo->entries[batchInfo->entry_count]; // Next free entry
+
+  memset(entry, 0, sizeof(*entry));
+  entry->line = line;
+  entry->path = strdup(path);              // Path as written in the manifest
+  entry->key = realpath(path, NULL);       // "./a.mp3" and "a.mp3" name the same file
+  if (entry->key == NULL)                  // Missing file: the edit will report it, group by the name as given
+  {
+    entry->key = strdup(path);
+  }
+
+  int failed = (entry->path == NULL || entry->key == NULL); // Allocation failure
+  for (int i = 0; i < TAG_FIELD_COUNT; i++)                // Copy every given field
+  {
+    if (value[i] != NULL && (entry->value[i] = strdup(value[i])) == NULL)
+    {
+      failed = 1;
+    }
+  }
+
+  batchInfo->entry_count++; // Entry is owned by the batch even when incomplete (freed by free_batch)
+  return failed ? e_failure : e_success;
+}
+
+/*
+ * Function: next_csv_field
+ * Description: Splits the next CSV field off a line in place ("double quotes" may contain commas, "" is a quote)
+ * Parameters: cursor - current position in the line (advanced past the field), field - receives the field text
+ * Return: int - 1 if a field was produced, 0 at the end of the line
+ */
+static int next_csv_field(char **cursor, char **field)
+{
+  char *p = *cursor; // Read position
+
+  if (p == NULL) // Previous field was the last one
+  {
+    return 0;
+  }
+
+  if (*p == '"') // Quoted field: unescape in place
+  {
+    char *out = ++p; // Write position lags behind the read position
+    *field = out;
+
+    while (*p != '\0')
+    {
+      if (*p == '"' && p[1] == '"') // Escaped quote
+      {
+        *out++ = '"';
+        p += 2;
+      }
+      else if (*p == '"') // Closing quote
+      {
+        p++;
+        break;
+      }
+      else
+      {
+        *out++ = *p++;
+      }
+    }
+    *out = '\0';
+    p += strcspn(p, ","); // Ignore anything between the closing quote and the separator
+  }
+  else // Plain field
+  {
+    *field = p;
+    p += strcspn(p, ",");
+  }
+
+  if (*p == ',') // More fields follow
+  {
+    *p = '\0';
+    *cursor = p + 1;
+  }
+  else // Last field on the line
+  {
+    *cursor = NULL;
+  }
+  return 1;
+}
+
+/*
+ * Function: parse_csv_line
+ * Description: Parses "path,field,value[,field,value...]"
+ * Parameters: line - line text (modified in place), path - receives the path, value - receives the field values
+ * Return: Status (e_success/e_failure)
+ */
+static Status parse_csv_line(char *line, char **path, char *value[TAG_FIELD_COUNT])
+{
+  char *cursor = line; // Read position inside the line
+  char *name, *text;   // Current field name and value
+
+  if (!next_csv_field(&cursor, path) || **path == '\0') // First column is the file
+  {
+    return e_failure;
+  }
+
+  while (next_csv_field(&cursor, &name)) // Remaining columns come in name/value pairs
+  {
+    int field = id3_field_lookup(name);
+
+    if (field == -1 || !next_csv_field(&cursor, &text)) // Unknown field or value missing
+    {
+      return e_failure;
+    }
+    value[field] = text; // Later pair for the same field wins
+  }
+  return e_success;
+}
+
+/*
+ * Function: skip_space
+ * Description: Skips JSON whitespace
+ * Parameters: p - current position
+ * Return: char * - first non-space position
+ */
+static char *skip_space(char *p)
+{
+  while (isspace((unsigned char)*p))
+  {
+    p++;
+  }
+  return p;
+}
+
+/*
+ * Function: read_hex4
+ * Description: Decodes the four hex digits of a \uXXXX escape
+ * Parameters: p - first digit, cp - receives the value
+ * Return: int - 1 on success, 0 if the digits are invalid
+ */
+static int read_hex4(const char *p, unsigned long *cp)
+{
+  *cp = 0;
+  for (int i = 0; i < 4; i++)
+  {
+    if (!isxdigit((unsigned char)p[i]))
+    {
+      return 0;
+    }
+    *cp = (*cp << 4) | (unsigned long)(isdigit((unsigned char)p[i]) ? p[i] - '0' : (tolower((unsigned char)p[i]) - 'a' + 10));
+  }
+  return 1;
+}
+
+/*
+ * Function: parse_json_string
+ * Description: Decodes a JSON string in place (escapes resolved, \u escapes written as UTF-8)
+ * Parameters: p - position of the opening quote, text - receives the decoded string
+ * Return: char * - position after the closing quote, NULL on a malformed string
+ */
+static char *parse_json_string(char *p, char **text)
+{
+  char *out = ++p; // Decoded text overwrites the escaped form (never longer)
+  *text = out;
+
+  while (*p != '"')
+  {
+    if (*p == '\0') // Unterminated string
+    {
+      return NULL;
+    }
+    if (*p != '\\') // Plain character
+    {
+      *out++ = *p++;
+      continue;
+    }
+
+    p++; // Escape sequence
+    switch (*p)
+    {
+    case 'b': *out++ = '\b'; break;
+    case 'f': *out++ = '\f'; break;
+    case 'n': *out++ = '\n'; break;
+    case 'r': *out++ = '\r'; break;
+    case 't': *out++ = '\t'; break;
+    case '"': case '\\': case '/': *out++ = *p; break;
+    case 'u':
+    {
+      unsigned long cp, low;
+
+      if (!read_hex4(p + 1, &cp))
+      {
+        return NULL;
+      }
+      p += 4;
+      if (cp >= 0xD800 && cp < 0xDC00 && p[1] == '\\' && p[2] == 'u' && read_hex4(p + 3, &low) && low >= 0xDC00 && low < 0xE000) // Surrogate pair
+      {
+        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+        p += 6;
+      }
+      out = text_put_utf8(out, cp);
+      break;
+    }
+    default:
+      return NULL; // Unknown escape
+    }
+    p++;
+  }
+  *out = '\0';
+  return p + 1; // Past the closing quote
+}
+
+/*
+ * Function: parse_json_line
+ * Description: Parses a flat JSON object: "path" (or "file") plus field names with string or number values
+ * Parameters: line - line text (modified in place), path - receives the path, value - receives the field values
+ * Return: Status (e_success/e_failure)
+ */
+static Status parse_json_line(char *line, char **path, char *value[TAG_FIELD_COUNT])
+{
+  char *p = skip_space(line) + 1; // Past the opening brace
+
+  *path = NULL;
+  p = skip_space(p);
+  while (*p != '}')
+  {
+    char *key, *text; // Current member
+
+    if (*p != '"' || (p = parse_json_string(p, &key)) == NULL) // Member name
+    {
+      return e_failure;
+    }
+    p = skip_space(p);
+    if (*p++ != ':')
+    {
+      return e_failure;
+    }
+    p = skip_space(p);
+
+    if (*p == '"') // String value
+    {
+      if ((p = parse_json_string(p, &text)) == NULL)
+      {
+        return e_failure;
+      }
+    }
+    else // Bare value (e.g. a year written as a number)
+    {
+      text = p;
+      p += strcspn(p, ",} \t\r\n");
+      if (p == text)
+      {
+        return e_failure;
+      }
+    }
+
+    char *end = p;    // End of the value, terminated once the separator has been read
+    p = skip_space(p);
+    if (*p != ',' && *p != '}') // Members must be separated by commas
+    {
+      return e_failure;
+    }
+    char separator = *p;
+    *end = '\0';
+    p = skip_space(p + 1); // Past the separator
+
+    if (strcmp(key, "path") == 0 || strcmp(key, "file") == 0) // File to edit
+    {
+      *path = text;
+    }
+    else
+    {
+      int field = id3_field_lookup(key);
+
+      if (field == -1) // Unknown field name
+      {
+        return e_failure;
+      }
+      value[field] = text;
+    }
+
+    if (separator == '}') // Last member
+    {
+      break;
+    }
+  }
+  return (*path != NULL && **path != '\0') ? e_success : e_failure;
+}
+
+/*
+ * Function: load_manifest
+ * Description: Opens the manifest and parses every line into BatchEntry records
+ * Parameters: batchInfo - pointer to BatchInfo structure
+ * Return: Status (e_success/e_failure)
+ */
+Status load_manifest(BatchInfo *batchInfo)
+{
+  if (strcmp(batchInfo->manifest_fname, "-") == 0) // Manifest piped on standard input
+  {
+    batchInfo->fptr_manifest = stdin;
+  }
+  else if ((batchInfo->fptr_manifest = fopen(batchInfo->manifest_fname, "r")) == NULL) // Error handling: manifest cannot be opened
+  {
+    perror("fopen");
+    fprintf(stderr, "\033[1;91mERROR: Unable to open manifest %s\033[0m\n", batchInfo->manifest_fname);
+    return e_failure;
+  }
+
+  char *line = NULL;       // Buffer reused by getline for every line
+  size_t cap = 0;          // Capacity of the buffer
+  unsigned long number = 0; // Current line number
+
+  while (getline(&line, &cap, batchInfo->fptr_manifest) != -1)
+  {
+    number++;
+    line[strcspn(line, "\r\n")] = '\0'; // Strip the line ending
+
+    char *start = skip_space(line); // First visible character
+    if (*start == '\0' || *start == '#' || (number == 1 && strncasecmp(start, "path,", 5) == 0)) // Blank line, comment or CSV header
+    {
+      continue;
+    }
+
+    char *path = NULL;                        // File named by this line
+    char *value[TAG_FIELD_COUNT] = {NULL};    // Fields given on this line
+    Status parsed = (*start == '{') ? parse_json_line(start, &path, value) : parse_csv_line(line, &path, value);
+    int given = 0;                            // Number of fields on this line
+
+    for (int i = 0; i < TAG_FIELD_COUNT; i++)
+    {
+      given += (value[i] != NULL);
+    }
+
+    if (parsed == e_failure || given == 0) // Error handling: report the line and keep going
+    {
+      fprintf(stderr, "\033[1;91mERROR: \033[1;97m%s:%lu: invalid manifest line\033[0m\n", batchInfo->manifest_fname, number);
+      batchInfo->lines_invalid++;
+      continue;
+    }
+
+    if (add_entry(batchInfo, path, value, number) == e_failure) // Out of memory: stop reading
+    {
+      free(line);
+      return e_failure;
+    }
+  }
+  free(line); // Free line buffer
+  return e_success;
+}
+
+/*
+ * Function: compare_entries
+ * Description: qsort comparator: by resolved path, then by manifest line
+ * Parameters: a, b - pointers to BatchEntry
+ * Return: int - ordering
+ */
+static int compare_entries(const void *a, const void *b)
+{
+  const BatchEntry *x = a, *y = b;
+  int order = strcmp(x->key, y->key);
+
+  if (order != 0)
+  {
+    return order;
+  }
+  return (x->line > y->line) - (x->line < y->line); // Keep manifest order inside one file
+}
+
+/*
+ * Function: group_entries
+ * Description: Sorts entries by file and folds every run of the same file into its first entry
+ * Parameters: batchInfo - pointer to BatchInfo structure
+ * Return: void
+ */
+void group_entries(BatchInfo *batchInfo)
+{
+  size_t kept = 0; // Number of merged entries
+
+  qsort(batchInfo->entries, batchInfo->entry_count, sizeof(BatchEntry), compare_entries);
+
+  for (size_t i = 0; i < batchInfo->entry_count; i++)
+  {
+    BatchEntry *entry = &batchInfo->entries[i];
+
+    if (kept > 0 && strcmp(batchInfo->entries[kept - 1].key, entry->key) == 0) // Same file as the previous entry: merge
+    {
+      BatchEntry *target = &batchInfo->entries[kept - 1];
+
+      for (int f = 0; f < TAG_FIELD_COUNT; f++)
+      {
+        if (entry->value[f] != NULL) // Later line overrides
+        {
+          free(target->value[f]);
+          target->value[f] = entry->value[f];
+        }
+      }
+      free(entry->path);
+      free(entry->key);
+    }
+    else // New file
+    {
+      batchInfo->entries[kept++] = *entry;
+    }
+  }
+  batchInfo->entry_count = kept;
+}
+
+/*
+ * Function: batch_edit_file
+ * Description: Worker task: applies all edits of one entry in a single rewrite and prints the result line
+ * Parameters: item - pointer to BatchEntry, ctx - pointer to BatchInfo
+ * Return: void
+ */
+static void batch_edit_file(void *item, void *ctx)
+{
+  BatchEntry *entry = item; // File and its edits
+  BatchInfo *batchInfo = ctx; // Shared counters
+  Mp3Tag *tag = NULL;       // Per-file library handle (nothing shared between workers)
+  StatsTimer timer;         // Latency of this file (--stats)
+  StatsTimer phase_timer;   // Phase timer of this worker (--stats)
+
+  stats_begin(&timer);
+  stats_begin(&phase_timer);
+  Mp3TagError error = mp3tag_open_file(entry->path, 1, &tag);
+  stats_end(e_phase_open, &phase_timer);
+  if (error == e_mp3tag_ok)
+  {
+    error = edit_set_padding(tag, &batchInfo->padding); // --padding applies to every rewritten tag
+  }
+  if (error == e_mp3tag_ok)
+  {
+    error = mp3tag_set_phase_hook(tag, stats_phase_hook, &phase_timer); // Commit steps for --stats
+  }
+  for (int i = 0; i < TAG_FIELD_COUNT && error == e_mp3tag_ok; i++) // Stage every field of this file
+  {
+    if (entry->value[i] != NULL)
+    {
+      error = mp3tag_set_frame(tag, id3_field_ids[i], entry->value[i]);
+    }
+  }
+  if (error == e_mp3tag_ok)
+  {
+    error = mp3tag_commit(tag); // One rewrite for all fields
+  }
+  int saved = errno; // Cause of an e_mp3tag_io failure, before close and flockfile can change it
+  mp3tag_close(tag);
+  stats_file_done(&timer);
+
+  Status status = (error == e_mp3tag_ok) ? e_success : e_failure;
+  flockfile(stdout); // Keep each result line together
+  if (status == e_success)
+  {
+    printf("\033[1;92mEDITED\033[0m %s\n", entry->path);
+  }
+  else
+  {
+    printf("\033[1;91mFAILED\033[0m %s (%s)\n", entry->path, (error == e_mp3tag_io) ? strerror(saved) : mp3tag_strerror(error));
+  }
+  funlockfile(stdout);
+
+  __atomic_add_fetch(status == e_success ? &batchInfo->files_edited : &batchInfo->files_failed, 1, __ATOMIC_RELAXED);
+}
+
+/*
+ * Function: do_batch_edit
+ * Description: Loads and groups the manifest, then edits every file on the worker pool
+ * Parameters: batchInfo - pointer to BatchInfo structure
+ * Return: Status (e_success/e_failure)
+ */
+Status do_batch_edit(BatchInfo *batchInfo)
+{
+  if (load_manifest(batchInfo) == e_failure) // Parse every manifest line
+  {
+    free_batch(batchInfo);
+    return e_failure;
+  }
+
+  group_entries(batchInfo); // One entry (and one rewrite) per file
+
+  if (pool_start(&batchInfo->pool, 0, 0, batch_edit_file, batchInfo) == e_failure) // One worker per CPU
+  {
+    free_batch(batchInfo);
+    return e_failure;
+  }
+
+  for (size_t i = 0; i < batchInfo->entry_count; i++) // Queue every file (blocks while the queue is full)
+  {
+    if (pool_submit(&batchInfo->pool, &batchInfo->entries[i]) == e_failure)
+    {
+      batchInfo->files_failed++;
+    }
+  }
+  pool_finish(&batchInfo->pool); // Wait for the last edit
+
+  fprintf(stderr, "\033[1;97mEdited %lu file(s), %lu failed, %lu invalid manifest line(s)\033[0m\n", batchInfo->files_edited, batchInfo->files_failed, batchInfo->lines_invalid);
+
+  Status status = (batchInfo->files_failed || batchInfo->lines_invalid) ? e_failure : e_success;
+  free_batch(batchInfo);
+  return status;
+}
+
+/*
+ * Function: free_batch
+ * Description: Frees every entry and closes the manifest
+ * Parameters: batchInfo - pointer to BatchInfo structure
+ * Return: void
+ */
+void free_batch(BatchInfo *batchInfo)
+{
+  for (size_t i = 0; i < batchInfo->entry_count; i++) // Free every entry
+  {
+    free(batchInfo->entries[i].path);
+    free(batchInfo->entries[i].key);
+    for (int f = 0; f < TAG_FIELD_COUNT; f++)
+    {
+      free(batchInfo->entries[i].value[f]);
+    }
+  }
+  free(batchInfo->entries);
+  batchInfo->entries = NULL;
+  batchInfo->entry_count = 0;
+
+  if (batchInfo->fptr_manifest != NULL && batchInfo->fptr_manifest != stdin) // Close manifest file
+  {
+    fclose(batchInfo->fptr_manifest);
+  }
+  batchInfo->fptr_manifest = NULL;
+}
@@ -0,0 +1,79 @@
+#ifndef BATCH_H // If not defined BATCH_H ---> Checks if BATCH_H was previously defined: If not present, code is processed; else code below till #endif is ignored
+#define BATCH_H // Defines the macro BATCH_H if macro was not previously defined
+
+#include <stdio.h>  // Header file for FILE
+#include <stddef.h> // Header file for size_t
+#include "type.h"   // User-defined header file for custom type definitions (Status, e_success, e_failure)
+#include "id3.h"    // User-defined header file for TagField and TAG_FIELD_COUNT
+#include "pool.h"   // User-defined header file for the worker pool running the edits
+#include "edit_cli.h" // User-defined header file for EditPadding (--padding policy)
+
+// Structure to store all edits requested for one file
+typedef struct // typedef used to give alternate name for structure here
+{
+  char *path;                   // File path as written in the manifest
+  char *key;                    // Resolved path used to group lines naming the same file
+  char *value[TAG_FIELD_COUNT]; // New content per field (NULL = unchanged)
+  unsigned long line;           // Manifest line of the first request (later lines override earlier ones)
+} BatchEntry;                   // BatchEntry is alternate name for this structure
+
+// Structure to store the state of a manifest-driven batch edit
+typedef struct // typedef used to give alternate name for structure here
+{
+  char *manifest_fname;         // Manifest file name ("-" for standard input)
+  FILE *fptr_manifest;          // Manifest stream
+  BatchEntry *entries;          // One entry per manifest line, then one per file after grouping
+  size_t entry_count;           // Number of entries in use
+  size_t entry_capacity;        // Number of entries allocated
+  WorkPool pool;                // Worker pool editing files concurrently
+  unsigned long files_edited;   // Files edited successfully (updated atomically by workers)
+  unsigned long files_failed;   // Files that could not be edited
+  unsigned long lines_invalid;  // Manifest lines that could not be parsed
+  EditPadding padding;          // --padding policy of every rewritten tag (set by main)
+} BatchInfo;                    // BatchInfo is alternate name for this structure
+
+/*
+ * Function: read_and_validate_for_batch
+ * Description: Stores the manifest name (argv[2], "-" for standard input) in BatchInfo
+ * Parameters: argc - argument count, argv[] - command-line argument array, batchInfo - pointer to BatchInfo structure
+ * Return: Status (e_success/e_failure)
+ */
+Status read_and_validate_for_batch(int argc, char *argv[], BatchInfo *batchInfo);
+
+/*
+ * Function: load_manifest
+ * Description: Reads every manifest line. Each line is either CSV (path,field,value[,field,value...]) or a JSON
+ *              object ({"path": "...", "title": "...", ...}); fields are names (title) or frame IDs (TIT2).
+ *              Blank lines, '#' comments and a CSV header line starting with "path" are skipped.
+ * Parameters: batchInfo - pointer to BatchInfo structure
+ * Return: Status (e_success/e_failure)
+ */
+Status load_manifest(BatchInfo *batchInfo);
+
+/*
+ * Function: group_entries
+ * Description: Merges all lines naming the same file into one entry so every file is rewritten once
+ *              (a later line wins when the same field is given twice)
+ * Parameters: batchInfo - pointer to BatchInfo structure
+ * Return: void
+ */
+void group_entries(BatchInfo *batchInfo);
+
+/*
+ * Function: do_batch_edit
+ * Description: Loads and groups the manifest, edits all files on a worker pool and prints one result line per file;
+ *              a failing file never stops the batch
+ * Parameters: batchInfo - pointer to BatchInfo structure
+ * Return: Status (e_success if every file was edited, e_failure otherwise)
+ */
+Status do_batch_edit(BatchInfo *batchInfo);
+
+/*
+ * Function: free_batch
+ * Description: Frees all entries and closes the manifest
+ * Parameters: batchInfo - pointer to BatchInfo structure
+ * Return: void
+ */
+void free_batch(BatchInfo *batchInfo);
+
+#endif // End of header guard: Marks the end of conditional compilation block started by #ifndef BATCH_H
@@ -0,0 +1,431 @@
+/**
+ * ----------------------------------------------------------------------------------------------------------------
+ * TITLE: Synthetic MP3 corpus generator (benchmark helper)
+ * DESCRIPTION: Writes a reproducible set of MP3 files for the benchmark: ID3v2.2 / v2.3 / v2.4 tags with varied
+ *              frame counts, padding and cover-art sizes, followed by CBR MPEG-1 Layer III frames and an optional
+ *              ID3v1 trailer. The same seed always produces the same bytes.
+ *              Build: gcc -O2 bench/gencorpus.c -o gencorpus
+ * ----------------------------------------------------------------------------------------------------------------
+ */
+
+#include <stdio.h>    // Header file for standard input/output functions (printf, fprintf, snprintf)
+#include <stdlib.h>   // Header file for memory allocation and conversion functions (malloc, free, strtoul)
+#include <string.h>   // Header file for string/memory functions (memcpy, memset, strlen)
+#include <stdint.h>   // Header file for fixed-width integers (uint64_t)
+#include <math.h>     // Header file for log/exp (log-uniform audio lengths)
+#include <fcntl.h>    // Header file for open() flags
+#include <unistd.h>   // Header file for POSIX I/O functions (write, close)
+#include <sys/stat.h> // Header file for mkdir()
+
+#define AUDIO_BLOCK (1024 * 1024)       // Audio is generated and written in blocks of this size
+#define FRAME_BYTES_X44100 18432000UL   // 144 * 128000: frame length times the sample rate (128 kbit/s, 44.1 kHz)
+
+// Enumeration of return status used by the generator
+typedef enum // typedef used to give alternate name for enum here
+{
+  e_success, // Operation completed successfully
+  e_failure  // Operation failed
+} Status;    // Status is alternate name for this enum
+
+// Structure to store the generator settings
+typedef struct // typedef used to give alternate name for structure here
+{
+  const char *dir;        // Output directory
+  unsigned long files;    // Number of files
+  uint64_t seed;          // Seed of the random generator
+  double min_audio_mb;    // Smallest audio length (MB)
+  double max_audio_mb;    // Largest audio length (MB)
+  unsigned long cover_kb; // Largest cover art (KB, 0 = never)
+  unsigned long pad_kb;   // Largest tag padding (KB)
+} CorpusSpec;             // CorpusSpec is alternate name for this structure
+
+// Structure to store a growing in-memory tag
+typedef struct // typedef used to give alternate name for structure here
+{
+  unsigned char *data; // Tag bytes (header first)
+  size_t len;          // Bytes in use
+  size_t cap;          // Bytes allocated
+} TagBuf;              // TagBuf is alternate name for this structure
+
+static const char *words[] = {"Blue", "Night", "River", "Echo", "Signal", "Paper", "Glass", "Summer", "Motor", "Quiet",
+                              "Static", "Golden", "Hollow", "Northern", "Velvet", "Orbit", "Cinder", "Harbor", "Lantern", "Tide"};
+static const char *genres[] = {"Rock", "Pop", "Jazz", "Electronic", "Classical", "Hip-Hop", "Folk", "Ambient"};
+
+/*
+ * Function: next_random
+ * Description: splitmix64 step: small, fast and identical on every platform
+ * Parameters: state - generator state
+ * Return: uint64_t - next random value
+ */
+static uint64_t next_random(uint64_t *state)
+{
+  uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+/*
+ * Function: random_below
+ * Description: Draws a value in [0, n)
+ * Parameters: state - generator state, n - upper bound (> 0)
+ * Return: unsigned long - random value
+ */
+static unsigned long random_below(uint64_t *state, unsigned long n)
+{
+  return (unsigned long)(next_random(state) % n);
+}
+
+/*
+ * Function: put_bytes
+ * Description: Appends bytes to the tag, growing it as needed
+ * Parameters: tag - tag buffer, src - bytes (NULL appends zeros), len - byte count
+ * Return: Status (e_success/e_failure)
+ */
+static Status put_bytes(TagBuf *tag, const void *src, size_t len)
+{
+  if (tag->len + len > tag->cap)
+  {
+    size_t cap = (tag->len + len) * 2;
+    unsigned char *grown = realloc(tag->data, cap);
+    if (grown == NULL)
+    {
+      return e_failure;
+    }
+    tag->data = grown;
+    tag->cap = cap;
+  }
+  if (src != NULL)
+  {
+    memcpy(tag->data + tag->len, src, len);
+  }
+  else
+  {
+    memset(tag->data + tag->len, 0, len);
+  }
+  tag->len += len;
+  return e_success;
+}
+
+/*
+ * Function: put_frame
+ * Description: Appends one frame in the layout of the tag version (v2.2: 3-char id and 24-bit size, v2.3: 32-bit
+ *              size, v2.4: synchsafe size)
+ * Parameters: tag - tag buffer, major - 2, 3 or 4, id - frame id for v2.3/v2.4, id22 - frame id for v2.2,
+ *             body - frame body, len - body length
+ * Return: Status (e_success/e_failure)
+ */
+static Status put_frame(TagBuf *tag, int major, const char *id, const char *id22, const void *body, size_t len)
+{
+  unsigned char head[10];
+  size_t head_len;
+
+  if (major == 2)
+  {
+    memcpy(head, id22, 3);
+    head[3] = (unsigned char)(len >> 16);
+    head[4] = (unsigned char)(len >> 8);
+    head[5] = (unsigned char)len;
+    head_len = 6;
+  }
+  else
+  {
+    memcpy(head, id, 4);
+    for (int i = 0; i < 4; i++)
+    {
+      head[4 + i] = (major == 4) ? (unsigned char)((len >> (21 - 7 * i)) & 0x7F) : (unsigned char)(len >> (24 - 8 * i));
+    }
+    head[8] = 0; // No frame flags
+    head[9] = 0;
+    head_len = 10;
+  }
+  return (put_bytes(tag, head, head_len) == e_success) ? put_bytes(tag, body, len) : e_failure;
+}
+
+/*
+ * Function: put_text
+ * Description: Appends a text frame (ISO-8859-1)
+ * Parameters: tag - tag buffer, major - tag version, id / id22 - frame ids, text - frame text
+ * Return: Status (e_success/e_failure)
+ */
+static Status put_text(TagBuf *tag, int major, const char *id, const char *id22, const char *text)
+{
+  char body[256];
+  size_t len = strlen(text);
+
+  body[0] = 0; // Encoding byte: ISO-8859-1
+  memcpy(body + 1, text, len);
+  return put_frame(tag, major, id, id22, body, len + 1);
+}
+
+/*
+ * Function: random_phrase
+ * Description: Builds a phrase of 1..4 words
+ * Parameters: rng - generator state, out - output (at least 64 bytes)
+ * Return: char * - out
+ */
+static char *random_phrase(uint64_t *rng, char *out)
+{
+  unsigned long count = 1 + random_below(rng, 4);
+
+  out[0] = '\0';
+  for (unsigned long i = 0; i < count; i++)
+  {
+    strcat(out, i ? " " : "");
+    strcat(out, words[random_below(rng, sizeof(words) / sizeof(words[0]))]);
+  }
+  return out;
+}
+
+/*
+ * Function: build_tag
+ * Description: Builds a complete ID3v2 tag: the six fields the tool edits, 0..30 extra TXXX frames, an optional
+ *              cover and random padding
+ * Parameters: rng - generator state, spec - settings, index - file number, major - tag version, tag - output buffer
+ * Return: Status (e_success/e_failure)
+ */
+static Status build_tag(uint64_t *rng, const CorpusSpec *spec, unsigned long index, int major, TagBuf *tag)
+{
+  char text[128];
+  char phrase[64];
+  Status status = put_bytes(tag, NULL, 10); // Header is filled in last
+
+  snprintf(text, sizeof(text), "%s %lu", random_phrase(rng, phrase), index);
+  status |= put_text(tag, major, "TIT2", "TT2", text);
+  status |= put_text(tag, major, "TPE1", "TP1", random_phrase(rng, phrase));
+  status |= put_text(tag, major, "TALB", "TAL", random_phrase(rng, phrase));
+  snprintf(text, sizeof(text), "%lu", 1960 + random_below(rng, 66));
+  status |= put_text(tag, major, major == 4 ? "TDRC" : "TYER", "TYE", text);
+  status |= put_text(tag, major, "TCON", "TCO", genres[random_below(rng, sizeof(genres) / sizeof(genres[0]))]);
+
+  size_t len = (size_t)snprintf(text + 5, sizeof(text) - 5, "%s", random_phrase(rng, phrase)); // COMM: language, empty description
+  memcpy(text, "\0eng\0", 5);
+  status |= put_frame(tag, major, "COMM", "COM", text, len + 5);
+
+  for (unsigned long extra = random_below(rng, 31); extra > 0; extra--) // Frames the tool never reads
+  {
+    len = (size_t)snprintf(text, sizeof(text), "%cEXTRA%lu%c%s", 0, extra, 0, random_phrase(rng, phrase));
+    status |= put_frame(tag, major, "TXXX", "TXX", text, len);
+  }
+
+  if (spec->cover_kb > 0 && random_below(rng, 2)) // Cover art on half of the files
+  {
+    size_t image = 1024 + random_below(rng, spec->cover_kb * 1024);
+    size_t head = (major == 2) ? 6 : 15; // Encoding, format or MIME type, picture type, empty description
+    unsigned char *body = malloc(head + image);
+    if (body == NULL)
+    {
+      return e_failure;
+    }
+    memcpy(body, major == 2 ? "\0JPG\3\0" : "\0image/jpeg\0\3\0", head);
+    for (size_t i = 0; i < image; i++)
+    {
+      body[head + i] = (unsigned char)next_random(rng);
+    }
+    memcpy(body + head, "\xFF\xD8\xFF\xE0", 4); // JPEG signature
+    status |= put_frame(tag, major, "APIC", "PIC", body, head + image);
+    free(body);
+  }
+
+  status |= put_bytes(tag, NULL, random_below(rng, spec->pad_kb * 1024 + 1)); // Padding (may be zero)
+
+  size_t size = tag->len - 10; // Header: synchsafe size of everything after it
+  memcpy(tag->data, "ID3", 3);
+  tag->data[3] = (unsigned char)major;
+  tag->data[4] = 0;
+  tag->data[5] = 0;
+  for (int i = 0; i < 4; i++)
+  {
+    tag->data[6 + i] = (unsigned char)((size >> (21 - 7 * i)) & 0x7F);
+  }
+  return (status == e_success) ? e_success : e_failure;
+}
+
+/*
+ * Function: write_all
+ * Description: Writes a whole buffer
+ * Parameters: fd - file descriptor, buf - bytes, len - byte count
+ * Return: Status (e_success/e_failure)
+ */
+static Status write_all(int fd, const unsigned char *buf, size_t len)
+{
+  while (len > 0)
+  {
+    ssize_t n = write(fd, buf, len);
+    if (n <= 0)
+    {
+      return e_failure;
+    }
+    buf += n;
+    len -= (size_t)n;
+  }
+  return e_success;
+}
+
+/*
+ * Function: write_audio
+ * Description: Writes CBR MPEG-1 Layer III frames (128 kbit/s, 44.1 kHz, joint stereo) with random payloads until
+ *              at least the requested length; frames are padded like an encoder does to keep the average bitrate
+ * Parameters: fd - file descriptor, rng - generator state, bytes - requested audio length, block - AUDIO_BLOCK buffer
+ * Return: Status (e_success/e_failure)
+ */
+static Status write_audio(int fd, uint64_t *rng, uint64_t bytes, unsigned char *block)
+{
+  unsigned long rest = 0; // Padding accumulator
+  uint64_t written = 0;
+  size_t used = 0;
+
+  while (written + used < bytes)
+  {
+    rest += FRAME_BYTES_X44100 % 44100;
+    int pad = (rest >= 44100);
+    if (pad)
+    {
+      rest -= 44100;
+    }
+    size_t frame = FRAME_BYTES_X44100 / 44100 + (size_t)pad;
+
+    if (used + frame > AUDIO_BLOCK) // Block full: write it
+    {
+      if (write_all(fd, block, used) == e_failure)
+      {
+        return e_failure;
+      }
+      written += used;
+      used = 0;
+    }
+    unsigned char *p = block + used;
+    p[0] = 0xFF; // Sync, MPEG-1, Layer III, no CRC
+    p[1] = 0xFB;
+    p[2] = (unsigned char)(0x90 | (pad << 1)); // 128 kbit/s, 44.1 kHz, padding bit
+    p[3] = 0x40;                               // Joint stereo
+    for (size_t i = 4; i < frame; i += 8)      // Random payload
+    {
+      uint64_t r = next_random(rng);
+      memcpy(p + i, &r, (frame - i < 8) ? frame - i : 8);
+    }
+    used += frame;
+  }
+  return write_all(fd, block, used);
+}
+
+/*
+ * Function: write_file
+ * Description: Generates one file: tag, audio and (on a third of the files) an ID3v1 trailer
+ * Parameters: spec - settings, index - file number, block - audio buffer, total - adds the file length
+ * Return: Status (e_success/e_failure)
+ */
+static Status write_file(const CorpusSpec *spec, unsigned long index, unsigned char *block, uint64_t *total)
+{
+  uint64_t rng = spec->seed ^ (0x9E3779B97F4A7C15ULL * (index + 1)); // Each file has its own stream: same bytes whatever the count
+  int major = 2 + (int)random_below(&rng, 3);
+  TagBuf tag = {NULL, 0, 0};
+  char path[4096];
+  Status status;
+
+  double mb = spec->min_audio_mb; // Log-uniform between the limits: many small files, a few large ones
+  if (spec->max_audio_mb > spec->min_audio_mb)
+  {
+    mb = exp(log(spec->min_audio_mb) + (log(spec->max_audio_mb) - log(spec->min_audio_mb)) * (double)random_below(&rng, 1000001) / 1e6);
+  }
+
+  snprintf(path, sizeof(path), "%s/%05lu_v2%d.mp3", spec->dir, index, major);
+  int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd == -1)
+  {
+    fprintf(stderr, "\033[1;91mERROR: \033[1;97m%s: unable to create file\033[0m\n", path);
+    return e_failure;
+  }
+
+  uint64_t audio = (uint64_t)(mb * 1024 * 1024);
+  status = build_tag(&rng, spec, index, major, &tag);
+  if (status == e_success)
+  {
+    status = write_all(fd, tag.data, tag.len);
+  }
+  if (status == e_success)
+  {
+    status = write_audio(fd, &rng, audio, block);
+  }
+  if (status == e_success && random_below(&rng, 3) == 0)
+  {
+    unsigned char v1[128] = "TAG";
+    snprintf((char *)v1 + 3, 30, "Track %lu", index);
+    status = write_all(fd, v1, sizeof(v1));
+  }
+  *total += (uint64_t)lseek(fd, 0, SEEK_CUR);
+  free(tag.data);
+  if (close(fd) != 0 || status == e_failure)
+  {
+    fprintf(stderr, "\033[1;91mERROR: \033[1;97m%s: unable to write file\033[0m\n", path);
+    return e_failure;
+  }
+  return e_success;
+}
+
+/*
+ * Function: main
+ * Description: Parses the options and writes the corpus
+ *              Usage: gencorpus [-n files] [-s seed] [-a min_mb:max_mb] [-c max_cover_kb] [-p max_padding_kb] <dir>
+ * Parameters: argc - argument count, argv - argument vector
+ * Return: 0 on success, 1 on failure
+ */
+int main(int argc, char *argv[])
+{
+  CorpusSpec spec = {NULL, 100, 1, 1.0, 1.0, 512, 16}; // Defaults: 100 files of 1 MB audio
+  int opt;
+  uint64_t total = 0;
+
+  while ((opt = getopt(argc, argv, "n:s:a:c:p:")) != -1)
+  {
+    switch (opt)
+    {
+    case 'n':
+      spec.files = strtoul(optarg, NULL, 10);
+      break;
+    case 's':
+      spec.seed = strtoull(optarg, NULL, 10);
+      break;
+    case 'a':
+      if (sscanf(optarg, "%lf:%lf", &spec.min_audio_mb, &spec.max_audio_mb) == 1)
+      {
+        spec.max_audio_mb = spec.min_audio_mb; // Single value: fixed length
+      }
+      break;
+    case 'c':
+      spec.cover_kb = strtoul(optarg, NULL, 10);
+      break;
+    case 'p':
+      spec.pad_kb = strtoul(optarg, NULL, 10);
+      break;
+    default:
+      optind = argc + 1; // Force the usage message
+      break;
+    }
+  }
+  if (optind != argc - 1 || spec.min_audio_mb <= 0 || spec.max_audio_mb < spec.min_audio_mb) // Error handling: bad usage
+  {
+    fprintf(stderr, "\033[1;91mUsage: \033[1;97m%s [-n files] [-s seed] [-a min_mb:max_mb] [-c max_cover_kb] [-p max_padding_kb] <dir>\033[0m\n", argv[0]);
+    return 1;
+  }
+  spec.dir = argv[optind];
+  mkdir(spec.dir, 0755); // May already exist
+
+  unsigned char *block = malloc(AUDIO_BLOCK);
+  if (block == NULL)
+  {
+    return 1;
+  }
+  for (unsigned long i = 0; i < spec.files; i++)
+  {
+    if (write_file(&spec, i, block, &total) == e_failure)
+    {
+      free(block);
+      return 1;
+    }
+  }
+  free(block);
+
+  printf("%lu file(s), %llu byte(s) in %s\n", spec.files, (unsigned long long)total, spec.dir);
+  return 0;
+}
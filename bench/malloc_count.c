@@ -0,0 +1,61 @@
+/**
+ * ----------------------------------------------------------------------------------------------------------------
+ * TITLE: Allocation counter (benchmark helper)
+ * DESCRIPTION: Counts every malloc / calloc / realloc of the process and forwards it to glibc. Linked only into the
+ *              benchmark build of the tool (bench/run.sh), where --stats then reports "allocations"; the tool and
+ *              the library never replace the allocator themselves.
+ *              Build: cc -O2 *.c bench/malloc_count.c -o mp3_tag -pthread (glibc only)
+ * ----------------------------------------------------------------------------------------------------------------
+ */
+
+#include <stdlib.h> // Header file for size_t and the allocation functions replaced below
+
+#if defined(__GLIBC__)
+
+extern void *__libc_malloc(size_t size);               // glibc entry points behind malloc & co.
+extern void *__libc_calloc(size_t count, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+
+static unsigned long alloc_calls;      // malloc + calloc + realloc calls
+static unsigned long long alloc_bytes; // Bytes requested by those calls
+
+/*
+ * Function: malloc / calloc / realloc
+ * Description: Count the call and its size, then forward to glibc
+ * Parameters: as the C library functions
+ * Return: as the C library functions
+ */
+void *malloc(size_t size)
+{
+  __atomic_add_fetch(&alloc_calls, 1, __ATOMIC_RELAXED);
+  __atomic_add_fetch(&alloc_bytes, size, __ATOMIC_RELAXED);
+  return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size)
+{
+  __atomic_add_fetch(&alloc_calls, 1, __ATOMIC_RELAXED);
+  __atomic_add_fetch(&alloc_bytes, (unsigned long long)count * size, __ATOMIC_RELAXED);
+  return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, size_t size)
+{
+  __atomic_add_fetch(&alloc_calls, 1, __ATOMIC_RELAXED);
+  __atomic_add_fetch(&alloc_bytes, size, __ATOMIC_RELAXED);
+  return __libc_realloc(ptr, size);
+}
+
+/*
+ * Function: malloc_count_read
+ * Description: Reads the counters (called by the --stats report at exit)
+ * Parameters: calls - receives the allocation calls, bytes - receives the bytes requested
+ * Return: void
+ */
+void malloc_count_read(unsigned long *calls, unsigned long long *bytes)
+{
+  *calls = __atomic_load_n(&alloc_calls, __ATOMIC_RELAXED);
+  *bytes = __atomic_load_n(&alloc_bytes, __ATOMIC_RELAXED);
+}
+
+#endif
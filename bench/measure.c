@@ -0,0 +1,291 @@
+/**
+ * ----------------------------------------------------------------------------------------------------------------
+ * TITLE: Benchmark runner (benchmark helper)
+ * DESCRIPTION: Runs one command over a list of files and reports files/s, MB/s, system calls per file and peak RSS.
+ *              A command containing {} runs once per file ({} is replaced by the path); any other command runs once
+ *              for the whole list (a directory scan). Timing and system-call counting are separate runs, so the
+ *              ptrace stops of the counting run never inflate the times.
+ *              Build: gcc -O2 bench/measure.c -o measure
+ * ----------------------------------------------------------------------------------------------------------------
+ */
+
+#include <stdio.h>      // Header file for standard input/output functions (printf, fprintf, getline)
+#include <stdlib.h>     // Header file for memory allocation functions (malloc, realloc, free)
+#include <string.h>     // Header file for string functions (strcmp, strlen)
+#include <signal.h>     // Header file for SIGTRAP / SIGSTOP
+#include <time.h>       // Header file for clock_gettime()
+#include <fcntl.h>      // Header file for open()
+#include <unistd.h>     // Header file for fork, execvp, dup2
+#include <sys/stat.h>   // Header file for stat() (file sizes)
+#include <sys/wait.h>   // Header file for waitpid / wait4 and status macros
+#include <sys/resource.h> // Header file for struct rusage (peak RSS)
+#include <sys/ptrace.h> // Header file for ptrace() (system-call counting)
+
+// Enumeration of return status used by the runner
+typedef enum // typedef used to give alternate name for enum here
+{
+  e_success, // Operation completed successfully
+  e_failure  // Operation failed
+} Status;    // Status is alternate name for this enum
+
+// Structure to store the result of one or more command runs
+typedef struct // typedef used to give alternate name for structure here
+{
+  double seconds;          // Wall-clock time of all runs
+  long peak_rss_kb;        // Largest resident set of any run
+  unsigned long syscalls;  // System calls of all runs (counting pass only)
+  int failures;            // Runs that exited with a non-zero status
+} RunResult;               // RunResult is alternate name for this structure
+
+/*
+ * Function: now_seconds
+ * Description: Reads the monotonic clock
+ * Parameters: None
+ * Return: double - seconds
+ */
+static double now_seconds(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+ * Function: count_syscalls
+ * Description: Resumes a traced child from syscall stop to syscall stop until it and every thread or process it
+ *              creates have exited. Each system call stops twice (entry and exit).
+ * Parameters: child - traced process (stopped after exec)
+ * Return: unsigned long - system calls made
+ */
+static unsigned long count_syscalls(pid_t child)
+{
+  unsigned long stops = 0;
+  int status;
+  pid_t tid = child;
+
+  ptrace(PTRACE_SETOPTIONS, child, 0, PTRACE_O_TRACESYSGOOD | PTRACE_O_TRACECLONE | PTRACE_O_TRACEFORK | PTRACE_O_TRACEVFORK | PTRACE_O_EXITKILL);
+  ptrace(PTRACE_SYSCALL, child, 0, 0);
+
+  while ((tid = waitpid(-1, &status, __WALL)) > 0)
+  {
+    int signal = 0; // Signal to pass on
+
+    if (WIFEXITED(status) || WIFSIGNALED(status))
+    {
+      continue;
+    }
+    if (WSTOPSIG(status) == (SIGTRAP | 0x80)) // System-call entry or exit
+    {
+      stops++;
+    }
+    else if (status >> 16 == 0 && WSTOPSIG(status) != SIGSTOP && WSTOPSIG(status) != SIGTRAP) // Real signal (the SIGSTOP of new threads is swallowed)
+    {
+      signal = WSTOPSIG(status);
+    }
+    ptrace(PTRACE_SYSCALL, tid, 0, signal);
+  }
+  return (stops + 1) / 2; // exit_group has no exit stop
+}
+
+/*
+ * Function: run_command
+ * Description: Runs a command with stdin, stdout and stderr on /dev/null and adds its time, peak RSS and (when traced)
+ *              system calls to the result
+ * Parameters: argv - command, trace - 1 to count system calls, result - accumulated result
+ * Return: Status (e_failure if the command could not be started)
+ */
+static Status run_command(char **argv, int trace, RunResult *result)
+{
+  double start = now_seconds();
+  struct rusage usage;
+  int status;
+  pid_t child = fork();
+
+  if (child == -1)
+  {
+    return e_failure;
+  }
+  if (child == 0) // Child: silence the output, optionally stop for the tracer, run the command
+  {
+    int null = open("/dev/null", O_RDWR);
+    dup2(null, STDIN_FILENO);
+    dup2(null, STDOUT_FILENO);
+    dup2(null, STDERR_FILENO); // Failures show up as a non-zero exit status
+    if (trace)
+    {
+      ptrace(PTRACE_TRACEME, 0, 0, 0);
+    }
+    execvp(argv[0], argv);
+    _exit(127);
+  }
+
+  if (trace)
+  {
+    waitpid(child, &status, 0); // Stopped at exec
+    result->syscalls += count_syscalls(child);
+    return e_success; // Reaped by count_syscalls; traced runs are not timed
+  }
+
+  wait4(child, &status, 0, &usage);
+  result->seconds += now_seconds() - start;
+  if (usage.ru_maxrss > result->peak_rss_kb)
+  {
+    result->peak_rss_kb = usage.ru_maxrss;
+  }
+  if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+  {
+    result->failures++;
+  }
+  return e_success;
+}
+
+/*
+ * Function: run_all
+ * Description: Runs the command once, or once per file when it contains {}
+ * Parameters: argv - command, files / count - file list, trace - 1 to count system calls, result - accumulated result
+ * Return: Status (e_success/e_failure)
+ */
+static Status run_all(char **argv, char **files, unsigned long count, int trace, RunResult *result)
+{
+  int slot = -1; // Argument holding {}
+
+  for (int i = 0; argv[i] != NULL; i++)
+  {
+    if (strcmp(argv[i], "{}") == 0)
+    {
+      slot = i;
+    }
+  }
+  if (slot == -1)
+  {
+    return run_command(argv, trace, result);
+  }
+  for (unsigned long i = 0; i < count; i++)
+  {
+    argv[slot] = files[i];
+    if (run_command(argv, trace, result) == e_failure)
+    {
+      return e_failure;
+    }
+  }
+  argv[slot] = "{}";
+  return e_success;
+}
+
+/*
+ * Function: read_list
+ * Description: Reads one path per line and adds up the file sizes
+ * Parameters: list - list file, files / count - receive the paths, bytes - receives the total size
+ * Return: Status (e_success/e_failure)
+ */
+static Status read_list(const char *list, char ***files, unsigned long *count, unsigned long long *bytes)
+{
+  FILE *fptr = fopen(list, "r");
+  char *line = NULL;
+  size_t cap = 0;
+  ssize_t len;
+  unsigned long allocated = 0;
+
+  if (fptr == NULL)
+  {
+    fprintf(stderr, "\033[1;91mERROR: \033[1;97m%s: unable to open list\033[0m\n", list);
+    return e_failure;
+  }
+  while ((len = getline(&line, &cap, fptr)) > 0)
+  {
+    struct stat st;
+    if (line[len - 1] == '\n')
+    {
+      line[--len] = '\0';
+    }
+    if (len == 0 || stat(line, &st) != 0)
+    {
+      continue;
+    }
+    if (*count == allocated)
+    {
+      allocated = allocated ? allocated * 2 : 256;
+      *files = realloc(*files, allocated * sizeof(char *));
+    }
+    (*files)[(*count)++] = strdup(line);
+    *bytes += (unsigned long long)st.st_size;
+  }
+  free(line);
+  fclose(fptr);
+  return (*count > 0) ? e_success : e_failure;
+}
+
+/*
+ * Function: main
+ * Description: Usage: measure [-s] [-r repeats] <label> <file-list> <command...>
+ *              Prints: label, files, seconds, files/s, MB/s, syscalls/file (with -s), peak RSS
+ * Parameters: argc - argument count, argv - argument vector
+ * Return: 0 on success, 1 on failure
+ */
+int main(int argc, char *argv[])
+{
+  int trace = 0;
+  int repeats = 1;
+  int opt;
+  char **files = NULL;
+  unsigned long count = 0;
+  unsigned long long bytes = 0;
+  RunResult result = {0, 0, 0, 0};
+
+  while ((opt = getopt(argc, argv, "+sr:")) != -1)
+  {
+    if (opt == 's')
+    {
+      trace = 1;
+    }
+    else if (opt == 'r')
+    {
+      repeats = atoi(optarg) > 0 ? atoi(optarg) : 1;
+    }
+    else
+    {
+      optind = argc;
+    }
+  }
+  if (argc - optind < 3) // Error handling: bad usage
+  {
+    fprintf(stderr, "\033[1;91mUsage: \033[1;97m%s [-s] [-r repeats] <label> <file-list> <command...>\033[0m\n", argv[0]);
+    return 1;
+  }
+  const char *label = argv[optind];
+  char **command = argv + optind + 2;
+
+  if (read_list(argv[optind + 1], &files, &count, &bytes) == e_failure)
+  {
+    return 1;
+  }
+
+  for (int r = 0; r < repeats; r++) // Timed runs
+  {
+    if (run_all(command, files, count, 0, &result) == e_failure)
+    {
+      fprintf(stderr, "\033[1;91mERROR: \033[1;97m%s: unable to run command\033[0m\n", label);
+      return 1;
+    }
+  }
+  if (trace) // Counting run
+  {
+    run_all(command, files, count, 1, &result);
+  }
+
+  double seconds = result.seconds / repeats;
+  printf("%-14s %7lu files %9.3f s %10.1f files/s %9.1f MB/s", label, count, seconds, count / seconds, bytes / 1048576.0 / seconds);
+  if (trace)
+  {
+    printf(" %8.1f syscalls/file", (double)result.syscalls / count);
+  }
+  printf(" %8ld KB peak RSS%s\n", result.peak_rss_kb, result.failures ? "  (some runs failed)" : "");
+
+  for (unsigned long i = 0; i < count; i++)
+  {
+    free(files[i]);
+  }
+  free(files);
+  return result.failures ? 1 : 0;
+}
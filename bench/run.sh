@@ -0,0 +1,109 @@
+#!/bin/sh
+# ----------------------------------------------------------------------------------------------------------------
+# TITLE: Benchmark of view, version and edit throughput
+# DESCRIPTION: Builds the tool and the two helpers, generates a reproducible corpus per profile (bench/gencorpus.c)
+#              and measures each command with bench/measure.c: files/s, MB/s, system calls per file, peak RSS.
+#              The scan is also checked for heap allocations per file in steady state: the tool is built with
+#              bench/malloc_count.c, whose counter --stats then reports (ordinary builds keep the libc allocator).
+#
+# Usage: bench/run.sh [small|mixed|large|all] [work-dir]
+#   small : 200 files, 1 MB of audio each, covers up to 512 KB, padding up to 16 KB
+#   mixed : 100 files, 1 MB .. 64 MB of audio (log-uniform), covers up to 2 MB, padding up to 64 KB
+#   large :   3 files, 256 MB .. 1 GB of audio, covers up to 4 MB, padding up to 4 KB
+#
+# Environment: SEED (corpus seed, default 1), REPEATS (timed runs of read-only commands, default 3),
+#              CFLAGS (default -O2)
+# Corpora are kept in the work directory (default /tmp/mp3tag-bench) and reused while their settings match, so
+# later runs measure only the tool. Edits run on a fresh copy of the corpus.
+# ----------------------------------------------------------------------------------------------------------------
+
+set -e
+
+PROFILE=${1:-small}
+WORK=${2:-/tmp/mp3tag-bench}
+SEED=${SEED:-1}
+REPEATS=${REPEATS:-3}
+CFLAGS=${CFLAGS:--O2}
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+
+case "$PROFILE" in
+  small|mixed|large|all) ;;
+  *) echo "Usage: $0 [small|mixed|large|all] [work-dir]" >&2; exit 1 ;;
+esac
+
+mkdir -p "$WORK"
+cc $CFLAGS "$ROOT"/*.c "$ROOT/bench/malloc_count.c" -o "$WORK/mp3_tag" -pthread
+cc $CFLAGS "$ROOT/bench/gencorpus.c" -o "$WORK/gencorpus" -lm
+cc $CFLAGS "$ROOT/bench/measure.c" -o "$WORK/measure"
+
+TAG="$WORK/mp3_tag"
+MEASURE="$WORK/measure"
+
+# Allocations of a scan of the first n files of a list: scan_allocated <list> <n> (empty without the counter)
+scan_allocated()
+{
+  head -n "$2" "$1" | tr '\n' '\0' | "$TAG" -v --format=tsv - --stats=json 2>&1 >/dev/null |
+    sed -n 's/.*"allocations":\([0-9]*\).*/\1/p'
+}
+
+# Heap allocations per file of a scan in steady state: the difference between a scan of the whole list and of its
+# first half, divided by the extra files. Start-up and the worker arenas cancel out; the files that first fill the
+# reader's queue (BULK_QUEUE_DEPTH io_uring slots, POOL_QUEUE_CAPACITY jobs) allocate buffers that are reused afterwards.
+scan_allocations()
+{
+  files=$(wc -l < "$1")
+  half=$((files / 2))
+  full_allocs=$(scan_allocated "$1" "$files")
+  half_allocs=$(scan_allocated "$1" "$half")
+
+  if [ -z "$full_allocs" ] || [ -z "$half_allocs" ] || [ "$half" -eq 0 ]; then
+    echo "scan-allocs    allocation counter not available (glibc only)"
+    return
+  fi
+  awk -v f="$files" -v h="$half" -v a="$full_allocs" -v b="$half_allocs" 'BEGIN {
+    printf "%-14s %7d files %8.2f allocations/file in steady state (%d for %d files, %d for %d)\n", "scan-allocs", f, (a - b) / (f - h), a, f, b, h
+  }'
+}
+
+# Generates (or reuses) the corpus of one profile: bench_profile <name> <gencorpus options...>
+bench_profile()
+{
+  name=$1
+  shift
+  corpus="$WORK/$name"
+  settings="seed=$SEED $*"
+
+  if [ "$(cat "$corpus/.settings" 2>/dev/null)" != "$settings" ]; then
+    rm -rf "$corpus"
+    "$WORK/gencorpus" -s "$SEED" "$@" "$corpus"
+    echo "$settings" > "$corpus/.settings"
+  fi
+  find "$corpus" -name '*.mp3' | sort > "$WORK/$name.lst"
+
+  echo "== $name: $(wc -l < "$WORK/$name.lst") files, $(du -sh "$corpus" | cut -f1)"
+  "$MEASURE" -s -r "$REPEATS" view-scan "$WORK/$name.lst" "$TAG" -v --format=tsv "$corpus"
+  scan_allocations "$WORK/$name.lst"
+  "$MEASURE" -s -r "$REPEATS" view "$WORK/$name.lst" "$TAG" -v {}
+  "$MEASURE" -s -r "$REPEATS" version "$WORK/$name.lst" "$TAG" --version {}
+  "$MEASURE" -s -r "$REPEATS" info "$WORK/$name.lst" "$TAG" --info {}
+
+  # Edits change the files: work on a copy, one timed run each
+  rm -rf "$WORK/edit"
+  cp -r "$corpus" "$WORK/edit"
+  find "$WORK/edit" -name '*.mp3' | sort > "$WORK/edit.lst"
+  "$MEASURE" -s edit "$WORK/edit.lst" "$TAG" -e -t "Benchmark Title" {}
+  "$MEASURE" -s edit-grow "$WORK/edit.lst" "$TAG" -e -c "$(printf '%8192s' | tr ' ' x)" {}
+  sed 's/$/,title,Batch Title/' "$WORK/edit.lst" > "$WORK/edit.csv"
+  "$MEASURE" -s batch "$WORK/edit.lst" "$TAG" -b "$WORK/edit.csv"
+  rm -rf "$WORK/edit"
+}
+
+case "$PROFILE" in
+  small|all) bench_profile small -n 200 -a 1 -c 512 -p 16 ;;
+esac
+case "$PROFILE" in
+  mixed|all) bench_profile mixed -n 100 -a 1:64 -c 2048 -p 64 ;;
+esac
+case "$PROFILE" in
+  large|all) bench_profile large -n 3 -a 256:1024 -c 4096 -p 4 ;;
+esac
@@ -0,0 +1,857 @@
+#include <stdio.h>    // Header file for standard input/output functions (perror)
+#include <stdlib.h>   // Header file for memory allocation functions (malloc, realloc, calloc, free)
+#include <string.h>   // Header file for memory functions (memset, memcpy, strlen)
+#include <errno.h>    // Header file for error numbers reported by system calls
+#include <fcntl.h>    // Header file for open() and its flags (O_RDONLY, AT_FDCWD)
+#include <unistd.h>   // Header file for POSIX functions (pread, close, syscall)
+#include "type.h"     // User-defined header file for custom type definitions (Status, e_success, e_failure)
+#include "id3.h"      // User-defined header file for ID3v2 header parsing (tag size of the prefix to read)
+#include "pool.h"     // User-defined header file for the worker pool (thread backend)
+#include "arena.h"    // User-defined header file for the per-worker arena bound around every callback
+#include "trailer.h"  // User-defined header file for TRAILER_PROBE_SIZE (tail read of files without an ID3v2 tag)
+#include "bulkio.h"   // User-defined header file for bulk reader declarations
+
+#if defined(__linux__) && defined(__has_include) // io_uring is only built where the kernel header is available
+#if __has_include(<linux/io_uring.h>)
+#define HAVE_IO_URING 1 // Enables the io_uring backend below
+#endif
+#endif
+
+#ifdef HAVE_IO_URING
+#include <stdint.h>         // Header file for uint64_t (eventfd counter)
+#include <sys/mman.h>       // Header file for mmap/munmap (ring buffers are shared with the kernel)
+#include <sys/eventfd.h>    // Header file for eventfd() (workers wake the ring thread)
+#include <linux/stat.h>     // Header file for struct statx and STATX_SIZE (size of files without an ID3v2 header)
+#include <sys/syscall.h>    // Header file for system call numbers (__NR_io_uring_setup, ...)
+#include <linux/io_uring.h> // Header file for io_uring structures and opcodes
+#endif
+
+/*
+ * Function: prefix_wanted
+ * Description: Calculates how many bytes from the start of a file are needed: 10-byte header + declared tag size
+ * Parameters: data - bytes read so far, len - number of bytes read so far
+ * Return: size_t - total bytes wanted (len itself when there is no valid ID3v2 header or the tag is larger than
+ *         BULK_WHOLE_TAG_MAX, in which case the parser streams the rest and skips big binary frames by offset)
+ */
+static size_t prefix_wanted(const unsigned char *data, size_t len)
+{
+  Id3Header header; // Decoded header
+
+  if (len < ID3_HEADER_SIZE || id3_parse_header(data, &header) == e_failure) // No ID3v2 header: nothing more to read
+  {
+    return len;
+  }
+  if (header.tag_size > BULK_WHOLE_TAG_MAX) // Almost always an embedded picture: do not read it
+  {
+    return len;
+  }
+  return ID3_HEADER_SIZE + (size_t)header.tag_size; // Header + frames + padding
+}
+
+/*
+ * Function: bulk_read_prefix
+ * Description: Reads BULK_FIRST_READ bytes in one pread and, only when the tag is bigger, the rest in a second pread
+ * Parameters: fd - file descriptor, data - receives buffer from arena_malloc, len - receives bytes read
+ * Return: Status (e_success/e_failure)
+ */
+Status bulk_read_prefix(int fd, unsigned char **data, size_t *len)
+{
+  unsigned char *buf = arena_malloc(BULK_FIRST_READ); // Buffer for the first read
+
+  if (buf == NULL) // Error handling: allocation failed
+  {
+    return e_failure;
+  }
+
+  ssize_t n = pread(fd, buf, BULK_FIRST_READ, 0); // Header and, usually, the whole tag in one read
+
+  if (n < 0) // Error handling: read failed
+  {
+    arena_release(buf);
+    return e_failure;
+  }
+
+  size_t wanted = prefix_wanted(buf, (size_t)n); // Bytes needed for the complete tag
+
+  if (wanted > (size_t)n && n == BULK_FIRST_READ) // Tag larger than the first read and file not yet at EOF
+  {
+    unsigned char *bigger = arena_malloc(wanted); // Buffer for the whole tag (arena memory does not grow in place)
+
+    if (bigger == NULL)
+    {
+      arena_release(buf);
+      return e_failure;
+    }
+    memcpy(bigger, buf, (size_t)n);
+    arena_release(buf);
+    buf = bigger;
+
+    ssize_t m = pread(fd, buf + n, wanted - n, n); // Read the rest of the tag
+    if (m > 0)
+    {
+      n += m;
+    }
+  }
+
+  *data = buf;      // Hand buffer to caller
+  *len = (size_t)n; // Bytes actually read
+  return e_success;
+}
+
+/*
+ * Function: store_path
+ * Description: Copies a path into a buffer kept from file to file, growing it only for a longer path
+ * Parameters: buf - path buffer (may be NULL), cap - capacity of buf, path - path to copy
+ * Return: Status (e_success/e_failure)
+ */
+static Status store_path(char **buf, size_t *cap, const char *path)
+{
+  size_t size = strlen(path) + 1; // Path + '\0'
+
+  if (size > *cap) // First use, or a longer path than any before
+  {
+    char *bigger = realloc(*buf, size < 256 ? 256 : size);
+
+    if (bigger == NULL)
+    {
+      return e_failure;
+    }
+    *buf = bigger;
+    *cap = size < 256 ? 256 : size;
+  }
+  memcpy(*buf, path, size);
+  return e_success;
+}
+
+// Structure to store one file queued on the thread backend (finished jobs are kept in BulkReader.spare_jobs)
+typedef struct BulkJob // typedef used to give alternate name for structure here
+{
+  struct BulkJob *next; // Next spare job
+  char *path;           // File path (buffer reused by the next file)
+  size_t path_cap;      // Capacity of path
+  void *item;           // Caller's per-file item
+} BulkJob;              // BulkJob is alternate name for this structure
+
+/*
+ * Function: job_take
+ * Description: Takes a spare job, or allocates one while the pipeline is filling up
+ * Parameters: reader - pointer to BulkReader
+ * Return: BulkJob * - job, or NULL if none can be allocated
+ */
+static BulkJob *job_take(BulkReader *reader)
+{
+  pthread_mutex_lock(&reader->jobs_lock);
+  BulkJob *job = reader->spare_jobs;
+  if (job != NULL)
+  {
+    reader->spare_jobs = job->next;
+  }
+  pthread_mutex_unlock(&reader->jobs_lock);
+
+  return (job != NULL) ? job : calloc(1, sizeof(BulkJob));
+}
+
+/*
+ * Function: job_give
+ * Description: Keeps a finished job for the next file
+ * Parameters: reader - pointer to BulkReader, job - finished job
+ * Return: void
+ */
+static void job_give(BulkReader *reader, BulkJob *job)
+{
+  pthread_mutex_lock(&reader->jobs_lock);
+  job->next = reader->spare_jobs;
+  reader->spare_jobs = job;
+  pthread_mutex_unlock(&reader->jobs_lock);
+}
+
+/*
+ * Function: bulk_thread_task
+ * Description: Thread backend task: synchronous open/pread, the callback with the worker's arena bound to the thread
+ *              (so the read buffer and everything the parser allocates come from it), then close
+ * Parameters: item - BulkJob (given back to the spare list here), ctx - pointer to BulkReader
+ * Return: void
+ */
+static void bulk_thread_task(void *item, void *ctx)
+{
+  BulkReader *reader = ctx;            // Reader this task belongs to
+  BulkJob *job = item;                 // File to read + caller's item
+  BulkFile file = {job->path, job->item, -1, NULL, 0, NULL, 0, 0}; // Nothing read yet (trailers are read through fd)
+  Arena *arena = arena_worker();       // This worker's arena (NULL: heap allocations)
+  Arena *previous = arena_bind(arena); // Every parse allocation of this file draws from it
+
+  file.fd = open(job->path, O_RDONLY); // Open source MP3 file in read mode
+  if (file.fd != -1)                   // File opened: read header + tag
+  {
+    unsigned char *data = NULL;
+
+    if (bulk_read_prefix(file.fd, &data, &file.len) == e_success)
+    {
+      file.data = data;
+    }
+  }
+
+  reader->done(&file, reader->ctx);       // Feed the existing frame parsing
+  arena_release((void *)file.data); // Release read buffer
+  if (file.fd != -1)
+  {
+    close(file.fd); // Close source file (the parser may have read more through it)
+  }
+  arena_bind(previous);
+  if (arena != NULL)
+  {
+    arena_reset(arena); // Memory of the whole file reclaimed at once, blocks kept for the next file
+  }
+  job_give(reader, job); // Job and its path buffer serve the next file
+}
+
+#ifdef HAVE_IO_URING
+
+// Enumeration of the stages a file goes through in the io_uring backend
+typedef enum
+{
+  e_slot_free,      // Slot not in use
+  e_slot_open,      // OPENAT in flight
+  e_slot_read,      // First READ in flight
+  e_slot_read_more, // READ of the rest of a large tag in flight
+  e_slot_stat,      // STATX in flight (file without an ID3v2 header: size needed for the tail read)
+  e_slot_read_tail, // READ of the last TRAILER_PROBE_SIZE bytes in flight
+  e_slot_parse,     // Callback running on a pool worker (the slot belongs to that worker until it is returned)
+  e_slot_close      // CLOSE in flight
+} SlotState;
+
+#define RING_WAKE BULK_QUEUE_DEPTH // user_data of the eventfd READ that wakes the ring when a worker returns a slot
+
+// Structure to store one in-flight file of the io_uring backend
+typedef struct
+{
+  SlotState state;    // Current stage
+  char *path;         // File path (buffer kept by the slot)
+  size_t path_cap;    // Capacity of path
+  void *item;         // Caller's per-file item
+  int fd;             // Descriptor returned by OPENAT
+  unsigned char *buf; // Read buffer (kept by the slot: at most BULK_WHOLE_TAG_MAX + header per slot)
+  size_t buf_cap;     // Capacity of buf
+  size_t len;         // Bytes read so far
+  int ok;             // 1 when the reads of buf succeeded
+  const unsigned char *tail;              // Last bytes of the file (tail_buf, or the end of buf for a short file)
+  size_t tail_len;    // Bytes in tail (0: no tail read)
+  off_t size;         // File size (valid with a tail)
+  struct statx stx;   // STATX result
+  unsigned char tail_buf[TRAILER_PROBE_SIZE]; // Target of the tail READ
+} BulkSlot;
+
+// Structure to store the rings shared with the kernel plus the slot table
+typedef struct
+{
+  int ring_fd;                  // io_uring instance descriptor
+  unsigned *sq_tail;            // Submission queue tail (written by us)
+  unsigned *sq_head;            // Submission queue head (written by the kernel)
+  unsigned sq_mask;             // Submission ring index mask
+  unsigned *sq_array;           // Submission index array
+  unsigned *cq_head;            // Completion queue head (written by us)
+  unsigned *cq_tail;            // Completion queue tail (written by the kernel)
+  unsigned cq_mask;             // Completion ring index mask
+  struct io_uring_sqe *sqes;    // Submission queue entries
+  struct io_uring_cqe *cqes;    // Completion queue entries
+  void *sq_ptr;                 // Mapping of the submission ring
+  size_t sq_len;                // Length of the submission ring mapping
+  void *cq_ptr;                 // Mapping of the completion ring (same as sq_ptr with a single mmap)
+  size_t cq_len;                // Length of the completion ring mapping
+  size_t sqes_len;              // Length of the SQE array mapping
+  unsigned pending;             // Entries queued but not yet submitted to the kernel
+  int in_flight;                // Slots currently in use (kernel operations or parsing)
+  int wake_fd;                  // eventfd written by a worker after it returned a slot
+  uint64_t wake_count;          // Target of the eventfd READ kept in flight
+  pthread_mutex_t returned_lock; // Protects returned / returned_count
+  int returned[BULK_QUEUE_DEPTH]; // Slots whose callback finished, waiting for their CLOSE
+  int returned_count;           // Entries in returned
+  BulkSlot slots[BULK_QUEUE_DEPTH]; // One slot per file in flight
+} BulkRing;
+
+/*
+ * Function: ring_supported
+ * Description: Asks the kernel whether OPENAT, STATX, READ and CLOSE are supported by this io_uring instance
+ * Parameters: ring_fd - io_uring descriptor
+ * Return: int - 1 if all needed operations exist, 0 otherwise
+ */
+static int ring_supported(int ring_fd)
+{
+  size_t size = sizeof(struct io_uring_probe) + 256 * sizeof(struct io_uring_probe_op); // Probe with room for 256 opcodes
+  struct io_uring_probe *probe = calloc(1, size);                                        // Zeroed probe buffer
+  int ok = 0;                                                                            // Result
+
+  if (probe != NULL && syscall(__NR_io_uring_register, ring_fd, IORING_REGISTER_PROBE, probe, 256) == 0)
+  {
+    static const int ops[] = {IORING_OP_OPENAT, IORING_OP_STATX, IORING_OP_READ, IORING_OP_CLOSE}; // Operations the backend uses
+    ok = 1;
+    for (size_t i = 0; i < sizeof(ops) / sizeof(ops[0]); i++) // Every operation must be supported
+    {
+      if (ops[i] > probe->last_op || !(probe->ops[ops[i]].flags & IO_URING_OP_SUPPORTED))
+      {
+        ok = 0;
+      }
+    }
+  }
+  free(probe); // Free probe buffer
+  return ok;
+}
+
+/*
+ * Function: ring_close
+ * Description: Unmaps the rings and closes the io_uring descriptor
+ * Parameters: ring - pointer to BulkRing
+ * Return: void
+ */
+static void ring_close(BulkRing *ring)
+{
+  if (ring->sqes != NULL && ring->sqes != MAP_FAILED)
+  {
+    munmap(ring->sqes, ring->sqes_len); // Unmap SQE array
+  }
+  if (ring->cq_ptr != NULL && ring->cq_ptr != MAP_FAILED && ring->cq_ptr != ring->sq_ptr)
+  {
+    munmap(ring->cq_ptr, ring->cq_len); // Unmap separate completion ring
+  }
+  if (ring->sq_ptr != NULL && ring->sq_ptr != MAP_FAILED)
+  {
+    munmap(ring->sq_ptr, ring->sq_len); // Unmap submission ring
+  }
+  close(ring->ring_fd); // Close io_uring instance (cancels the pending eventfd READ)
+  if (ring->wake_fd != -1)
+  {
+    close(ring->wake_fd);
+  }
+  pthread_mutex_destroy(&ring->returned_lock);
+  for (int i = 0; i < BULK_QUEUE_DEPTH; i++) // Buffers the slots kept from file to file
+  {
+    free(ring->slots[i].path);
+    free(ring->slots[i].buf);
+  }
+  free(ring); // Free ring state
+}
+
+/*
+ * Function: ring_open
+ * Description: Creates an io_uring instance and maps its rings (raw system calls, no external library needed)
+ * Parameters: None
+ * Return: BulkRing * - ring state, or NULL when io_uring is unavailable
+ */
+static BulkRing *ring_open(void)
+{
+  struct io_uring_params params; // Setup parameters and ring offsets returned by the kernel
+  memset(&params, 0, sizeof(params));
+
+  int fd = (int)syscall(__NR_io_uring_setup, BULK_QUEUE_DEPTH + 1, &params); // One entry per slot + the eventfd READ (rounded up by the kernel)
+
+  if (fd < 0) // Kernel without io_uring, or blocked by seccomp
+  {
+    return NULL;
+  }
+
+  BulkRing *ring = calloc(1, sizeof(BulkRing)); // Ring state with all slots free
+  if (ring == NULL)
+  {
+    close(fd);
+    return NULL;
+  }
+  ring->ring_fd = fd;
+  ring->wake_fd = eventfd(0, EFD_CLOEXEC); // Workers wake the ring through it
+  pthread_mutex_init(&ring->returned_lock, NULL);
+  for (int i = 0; i < BULK_QUEUE_DEPTH; i++)
+  {
+    ring->slots[i].fd = -1;
+  }
+
+  if (ring->wake_fd == -1 || !ring_supported(fd)) // Kernel too old for OPENAT/STATX/READ/CLOSE
+  {
+    ring_close(ring);
+    return NULL;
+  }
+
+  ring->sq_len = params.sq_off.array + params.sq_entries * sizeof(unsigned);           // Submission ring size
+  ring->cq_len = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe); // Completion ring size
+  if (params.features & IORING_FEAT_SINGLE_MMAP) // Both rings share one mapping
+  {
+    ring->sq_len = ring->cq_len = ring->sq_len > ring->cq_len ? ring->sq_len : ring->cq_len;
+  }
+
+  ring->sq_ptr = mmap(NULL, ring->sq_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+  ring->cq_ptr = (params.features & IORING_FEAT_SINGLE_MMAP)
+                     ? ring->sq_ptr
+                     : mmap(NULL, ring->cq_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+  ring->sqes_len = params.sq_entries * sizeof(struct io_uring_sqe);
+  ring->sqes = mmap(NULL, ring->sqes_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+
+  if (ring->sq_ptr == MAP_FAILED || ring->cq_ptr == MAP_FAILED || ring->sqes == MAP_FAILED) // Error handling: mapping failed
+  {
+    ring_close(ring);
+    return NULL;
+  }
+
+  char *sq = ring->sq_ptr; // Byte pointers for applying the kernel-provided offsets
+  char *cq = ring->cq_ptr;
+  ring->sq_tail = (unsigned *)(sq + params.sq_off.tail);
+  ring->sq_head = (unsigned *)(sq + params.sq_off.head);
+  ring->sq_mask = *(unsigned *)(sq + params.sq_off.ring_mask);
+  ring->sq_array = (unsigned *)(sq + params.sq_off.array);
+  ring->cq_head = (unsigned *)(cq + params.cq_off.head);
+  ring->cq_tail = (unsigned *)(cq + params.cq_off.tail);
+  ring->cq_mask = *(unsigned *)(cq + params.cq_off.ring_mask);
+  ring->cqes = (struct io_uring_cqe *)(cq + params.cq_off.cqes);
+  return ring;
+}
+
+/*
+ * Function: ring_queue
+ * Description: Fills the next submission entry (submitted to the kernel in batches by ring_reap)
+ * Parameters: ring - pointer to BulkRing, slot - slot index (user_data), opcode - io_uring operation,
+ *             fd - descriptor, addr - buffer or path, len - length or STATX mask, offset - file offset or statx buffer
+ * Return: void
+ */
+static void ring_queue(BulkRing *ring, int slot, int opcode, int fd, void *addr, unsigned len, unsigned long long offset)
+{
+  unsigned tail = *ring->sq_tail;                      // Only this thread writes the tail
+  unsigned index = tail & ring->sq_mask;               // Ring position
+  struct io_uring_sqe *sqe = &ring->sqes[index];       // Entry to fill
+
+  memset(sqe, 0, sizeof(*sqe)); // Unused fields must be zero
+  sqe->opcode = (unsigned char)opcode;
+  sqe->fd = fd;
+  sqe->addr = (unsigned long long)(unsigned long)addr;
+  sqe->len = len;
+  sqe->off = offset;
+  sqe->user_data = (unsigned long long)slot; // Completion is routed back to this slot
+  if (opcode == IORING_OP_OPENAT)
+  {
+    sqe->open_flags = O_RDONLY; // Open read-only
+  }
+
+  ring->sq_array[index] = index;                                   // Publish entry index
+  __atomic_store_n(ring->sq_tail, tail + 1, __ATOMIC_RELEASE);     // Make entry visible to the kernel
+  ring->pending++;                                                 // Submitted on the next io_uring_enter
+}
+
+/*
+ * Function: ring_parse_task
+ * Description: Pool task of the io_uring backend: runs the callback for one slot with the worker's arena bound, then
+ *              hands the slot back to the ring thread (which queues its CLOSE) and wakes it through the eventfd
+ * Parameters: item - BulkSlot, ctx - pointer to BulkReader
+ * Return: void
+ */
+static void ring_parse_task(void *item, void *ctx)
+{
+  BulkReader *reader = ctx;            // Reader this task belongs to
+  BulkRing *ring = reader->ring;       // Ring the slot belongs to
+  BulkSlot *slot = item;               // File to parse (owned by this worker until returned)
+  Arena *arena = arena_worker();       // This worker's arena (NULL: heap allocations)
+  Arena *previous = arena_bind(arena); // Parse allocations of this file draw from it
+  BulkFile file = {slot->path, slot->item, slot->fd, slot->ok ? slot->buf : NULL, slot->ok ? slot->len : 0,
+                   slot->tail_len ? slot->tail : NULL, slot->tail_len, slot->size};
+
+  reader->done(&file, reader->ctx); // Feed the existing frame parsing
+  arena_bind(previous);
+  if (arena != NULL)
+  {
+    arena_reset(arena);
+  }
+
+  uint64_t one = 1; // eventfd increment
+  pthread_mutex_lock(&ring->returned_lock);
+  ring->returned[ring->returned_count++] = (int)(slot - ring->slots);
+  pthread_mutex_unlock(&ring->returned_lock);
+  if (write(ring->wake_fd, &one, sizeof(one)) == -1) // Cannot fail for a counter far below its maximum
+  {
+    perror("eventfd");
+  }
+}
+
+/*
+ * Function: slot_deliver
+ * Description: Hands a slot whose reads are finished to the pool for parsing (the ring thread never parses)
+ * Parameters: reader - pointer to BulkReader, slot - slot to parse, ok - 0 if reading failed
+ * Return: void
+ */
+static void slot_deliver(BulkReader *reader, BulkSlot *slot, int ok)
+{
+  slot->ok = ok;
+  slot->state = e_slot_parse;
+  if (pool_submit(&reader->pool, slot) == e_failure) // Queue holds BULK_QUEUE_DEPTH slots: only fails if the pool stopped
+  {
+    ring_parse_task(slot, reader);
+  }
+}
+
+/*
+ * Function: slot_read_tail
+ * Description: File without an ID3v2 header: uses the end of the first read when it holds the whole file, otherwise
+ *              queues a STATX for the size (the tail READ follows)
+ * Parameters: reader - pointer to BulkReader, ring - pointer to BulkRing, index - slot index
+ * Return: void
+ */
+static void slot_read_tail(BulkReader *reader, BulkRing *ring, int index)
+{
+  BulkSlot *slot = &ring->slots[index];
+
+  if (slot->len < BULK_FIRST_READ) // Short read: the whole file is in buf
+  {
+    slot->tail_len = slot->len < TRAILER_PROBE_SIZE ? slot->len : TRAILER_PROBE_SIZE;
+    slot->tail = slot->buf + slot->len - slot->tail_len;
+    slot->size = (off_t)slot->len;
+    slot_deliver(reader, slot, 1);
+    return;
+  }
+  slot->state = e_slot_stat;
+  ring_queue(ring, index, IORING_OP_STATX, AT_FDCWD, slot->path, STATX_SIZE, (unsigned long long)(unsigned long)&slot->stx);
+}
+
+/*
+ * Function: slot_release
+ * Description: Frees a slot after its last operation completed (its path and read buffers stay for the next file)
+ * Parameters: ring - pointer to BulkRing, slot - slot to release
+ * Return: void
+ */
+static void slot_release(BulkRing *ring, BulkSlot *slot)
+{
+  slot->state = e_slot_free;
+  slot->item = NULL;
+  slot->fd = -1;
+  slot->len = 0;
+  slot->ok = 0;
+  slot->tail = NULL;
+  slot->tail_len = 0;
+  ring->in_flight--; // One file fewer in flight
+}
+
+/*
+ * Function: slot_reserve
+ * Description: Makes the read buffer of a slot hold at least size bytes, keeping what was read
+ * Parameters: slot - pointer to BulkSlot, size - bytes needed
+ * Return: Status (e_success/e_failure)
+ */
+static Status slot_reserve(BulkSlot *slot, size_t size)
+{
+  if (size <= slot->buf_cap) // Steady state: the buffer of an earlier file is big enough
+  {
+    return e_success;
+  }
+
+  unsigned char *bigger = realloc(slot->buf, size);
+  if (bigger == NULL)
+  {
+    return e_failure;
+  }
+  slot->buf = bigger;
+  slot->buf_cap = size;
+  return e_success;
+}
+
+/*
+ * Function: slot_complete
+ * Description: Advances one slot to its next stage after the kernel completed an operation
+ * Parameters: reader - pointer to BulkReader, ring - pointer to BulkRing, index - slot index, res - operation result
+ * Return: void
+ */
+static void slot_complete(BulkReader *reader, BulkRing *ring, int index, int res)
+{
+  BulkSlot *slot = &ring->slots[index]; // Slot the completion belongs to
+  Id3Header header;                     // Header of the first read
+
+  switch (slot->state)
+  {
+  case e_slot_open: // OPENAT finished
+    if (res < 0 || slot_reserve(slot, BULK_FIRST_READ) == e_failure) // Open failed (or no memory): report from the pool
+    {
+      if (res >= 0)
+      {
+        close(res); // Descriptor opened but unusable
+      }
+      slot_deliver(reader, slot, 0);
+      return;
+    }
+    slot->fd = res;             // Remember descriptor
+    slot->state = e_slot_read;  // Next stage: first read
+    ring_queue(ring, index, IORING_OP_READ, slot->fd, slot->buf, BULK_FIRST_READ, 0);
+    return;
+
+  case e_slot_read: // First READ finished
+    if (res < 0)    // Read failed
+    {
+      slot_deliver(reader, slot, 0);
+      return;
+    }
+    slot->len = (size_t)res; // Bytes read
+    if (slot->len < ID3_HEADER_SIZE || id3_parse_header(slot->buf, &header) == e_failure) // No ID3v2 tag: trailer tags
+    {
+      slot_read_tail(reader, ring, index);
+      return;
+    }
+    {
+      size_t wanted = prefix_wanted(slot->buf, slot->len); // Bytes needed for the whole tag
+
+      if (wanted > slot->len && res == BULK_FIRST_READ && slot_reserve(slot, wanted) == e_success) // Large tag: read the rest
+      {
+        slot->state = e_slot_read_more;
+        ring_queue(ring, index, IORING_OP_READ, slot->fd, slot->buf + slot->len, (unsigned)(wanted - slot->len), slot->len);
+        return;
+      }
+    }
+    slot_deliver(reader, slot, 1); // Tag complete (a tag over BULK_WHOLE_TAG_MAX is continued by the parser through fd)
+    return;
+
+  case e_slot_read_more: // Second READ finished
+    if (res > 0)
+    {
+      slot->len += (size_t)res; // Append bytes read
+    }
+    slot_deliver(reader, slot, 1); // Deliver whatever was read
+    return;
+
+  case e_slot_stat: // STATX finished: read the last bytes of the file
+    if (res < 0)    // No size: the parser probes the tail through fd
+    {
+      slot_deliver(reader, slot, 1);
+      return;
+    }
+    slot->size = (off_t)slot->stx.stx_size;
+    slot->tail_len = (slot->stx.stx_size < TRAILER_PROBE_SIZE) ? (size_t)slot->stx.stx_size : TRAILER_PROBE_SIZE;
+    slot->state = e_slot_read_tail;
+    ring_queue(ring, index, IORING_OP_READ, slot->fd, slot->tail_buf, (unsigned)slot->tail_len, (unsigned long long)(slot->size - (off_t)slot->tail_len));
+    return;
+
+  case e_slot_read_tail: // Tail READ finished
+    if (res == (int)slot->tail_len)
+    {
+      slot->tail = slot->tail_buf;
+    }
+    else // Short or failed read: the parser probes the tail through fd
+    {
+      slot->tail_len = 0;
+    }
+    slot_deliver(reader, slot, 1);
+    return;
+
+  case e_slot_close: // CLOSE finished: slot can be reused
+    slot_release(ring, slot);
+    return;
+
+  default:
+    return;
+  }
+}
+
+/*
+ * Function: ring_collect
+ * Description: Takes back the slots whose callback finished and queues the CLOSE of their descriptors
+ * Parameters: ring - pointer to BulkRing
+ * Return: void
+ */
+static void ring_collect(BulkRing *ring)
+{
+  int returned[BULK_QUEUE_DEPTH]; // Copy taken under the lock
+  int count;
+
+  pthread_mutex_lock(&ring->returned_lock);
+  count = ring->returned_count;
+  memcpy(returned, ring->returned, (size_t)count * sizeof(int));
+  ring->returned_count = 0;
+  pthread_mutex_unlock(&ring->returned_lock);
+
+  for (int i = 0; i < count; i++)
+  {
+    BulkSlot *slot = &ring->slots[returned[i]];
+
+    if (slot->fd == -1) // Open failed: nothing to close
+    {
+      slot_release(ring, slot);
+      continue;
+    }
+    slot->state = e_slot_close; // Next stage: close descriptor
+    ring_queue(ring, returned[i], IORING_OP_CLOSE, slot->fd, NULL, 0, 0);
+  }
+}
+
+/*
+ * Function: ring_reap
+ * Description: Submits all queued entries and waits for at least one completion (the eventfd READ kept in flight
+ *              completes when a worker returns a slot), then processes every completion and returned slot
+ * Parameters: reader - pointer to BulkReader, ring - pointer to BulkRing
+ * Return: Status (e_success/e_failure)
+ */
+static Status ring_reap(BulkReader *reader, BulkRing *ring)
+{
+  long ret = syscall(__NR_io_uring_enter, ring->ring_fd, ring->pending, 1, IORING_ENTER_GETEVENTS, NULL, 0); // Submit batch + wait
+
+  if (ret < 0 && errno != EINTR) // Error handling: ring unusable
+  {
+    perror("io_uring_enter");
+    return e_failure;
+  }
+  if (ret > 0)
+  {
+    ring->pending -= (unsigned)ret; // Entries consumed by the kernel
+  }
+
+  unsigned head = *ring->cq_head; // Only this thread advances the head
+
+  while (head != __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE)) // Process every available completion
+  {
+    struct io_uring_cqe *cqe = &ring->cqes[head & ring->cq_mask]; // Completion entry
+    int index = (int)cqe->user_data;                               // Slot it belongs to
+    int res = cqe->res;                                            // Operation result
+
+    head++;
+    __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE); // Free the completion entry for the kernel
+    if (index == RING_WAKE) // A worker returned a slot: keep the next wake-up in flight
+    {
+      ring_queue(ring, RING_WAKE, IORING_OP_READ, ring->wake_fd, &ring->wake_count, sizeof(ring->wake_count), 0);
+      continue;
+    }
+    slot_complete(reader, ring, index, res); // Advance slot (may queue the next operation)
+  }
+  ring_collect(ring); // Slots parsed since the last call
+  return e_success;
+}
+
+#endif // HAVE_IO_URING
+
+/*
+ * Function: bulk_start
+ * Description: Chooses the backend (io_uring if requested and supported, worker pool otherwise) and starts it
+ * Parameters: reader, use_io_uring, done, ctx - see bulkio.h
+ * Return: Status (e_success/e_failure)
+ */
+Status bulk_start(BulkReader *reader, int use_io_uring, BulkReadDone done, void *ctx)
+{
+  reader->done = done;  // Per-file callback
+  reader->ctx = ctx;    // Callback context
+  reader->ring = NULL;  // No ring yet
+
+#ifdef HAVE_IO_URING
+  BulkRing *ring = use_io_uring ? ring_open() : NULL; // Deep asynchronous queue, if available
+
+  if (ring != NULL)
+  {
+    if (pool_start(&reader->pool, 0, BULK_QUEUE_DEPTH, ring_parse_task, reader) == e_failure) // Parsers for completed reads
+    {
+      ring_close(ring);
+      return e_failure;
+    }
+    reader->ring = ring;
+    reader->backend = e_bulk_io_uring;
+    ring_queue(ring, RING_WAKE, IORING_OP_READ, ring->wake_fd, &ring->wake_count, sizeof(ring->wake_count), 0); // Workers returning slots complete this READ
+    return e_success;
+  }
+#else
+  (void)use_io_uring; // io_uring not built on this platform
+#endif
+
+  reader->backend = e_bulk_threads; // Portable fallback
+  reader->spare_jobs = NULL;
+  pthread_mutex_init(&reader->jobs_lock, NULL);
+  if (pool_start(&reader->pool, 0, 0, bulk_thread_task, reader) == e_failure) // One worker per CPU
+  {
+    pthread_mutex_destroy(&reader->jobs_lock);
+    return e_failure;
+  }
+  return e_success;
+}
+
+/*
+ * Function: bulk_submit
+ * Description: Queues a file on the active backend
+ * Parameters: reader - pointer to BulkReader, path - file path (copied), item - caller's per-file item
+ * Return: Status (e_success/e_failure)
+ */
+Status bulk_submit(BulkReader *reader, const char *path, void *item)
+{
+#ifdef HAVE_IO_URING
+  if (reader->backend == e_bulk_io_uring)
+  {
+    BulkRing *ring = reader->ring; // io_uring state
+
+    while (ring->in_flight == BULK_QUEUE_DEPTH) // Every slot busy: let completions free one
+    {
+      if (ring_reap(reader, ring) == e_failure)
+      {
+        return e_failure;
+      }
+    }
+
+    for (int i = 0; i < BULK_QUEUE_DEPTH; i++) // Find a free slot
+    {
+      BulkSlot *slot = &ring->slots[i];
+
+      if (slot->state == e_slot_free)
+      {
+        if (store_path(&slot->path, &slot->path_cap, path) == e_failure) // Slot keeps its own copy for OPENAT
+        {
+          return e_failure;
+        }
+        slot->item = item; // Handed back to the callback
+        slot->state = e_slot_open;
+        ring->in_flight++;
+        ring_queue(ring, i, IORING_OP_OPENAT, AT_FDCWD, slot->path, 0, 0); // Open asynchronously (submitted with the next batch)
+        return e_success;
+      }
+    }
+    return e_failure; // Unreachable: in_flight < depth guarantees a free slot
+  }
+#endif
+  BulkJob *job = job_take(reader); // Thread backend: path + item travel together through the pool queue
+
+  if (job == NULL)
+  {
+    return e_failure;
+  }
+  if (store_path(&job->path, &job->path_cap, path) == e_failure)
+  {
+    job_give(reader, job);
+    return e_failure;
+  }
+  job->item = item;
+  if (pool_submit(&reader->pool, job) == e_failure)
+  {
+    job_give(reader, job);
+    return e_failure;
+  }
+  return e_success;
+}
+
+/*
+ * Function: bulk_finish
+ * Description: Drains all in-flight files and releases the backend
+ * Parameters: reader - pointer to BulkReader
+ * Return: void
+ */
+void bulk_finish(BulkReader *reader)
+{
+#ifdef HAVE_IO_URING
+  if (reader->backend == e_bulk_io_uring)
+  {
+    BulkRing *ring = reader->ring; // io_uring state
+
+    while (ring->in_flight > 0) // Keep reaping until every file has been parsed and closed
+    {
+      if (ring_reap(reader, ring) == e_failure)
+      {
+        break;
+      }
+    }
+    pool_finish(&reader->pool); // No slot is with a worker any more
+    ring_close(ring);    // Unmap rings and close instance
+    reader->ring = NULL;
+    return;
+  }
+#endif
+  pool_finish(&reader->pool); // Thread backend: wait for workers
+
+  while (reader->spare_jobs != NULL) // Every job is back on the spare list
+  {
+    BulkJob *job = reader->spare_jobs;
+    reader->spare_jobs = job->next;
+    free(job->path);
+    free(job);
+  }
+  pthread_mutex_destroy(&reader->jobs_lock);
+}
@@ -0,0 +1,91 @@
+#ifndef BULKIO_H // If not defined BULKIO_H ---> Checks if BULKIO_H was previously defined: If not present, code is processed; else code below till #endif is ignored
+#define BULKIO_H // Defines the macro BULKIO_H if macro was not previously defined
+
+#include <stddef.h> // Header file for size_t
+#include <sys/types.h> // Header file for off_t
+#include "type.h"   // User-defined header file for custom type definitions (Status, e_success, e_failure)
+#include "pool.h"   // User-defined header file for the worker pool (portable fallback backend)
+
+#define BULK_QUEUE_DEPTH 64             // Number of files kept in flight by the io_uring backend
+#define BULK_FIRST_READ (64 * 1024)     // Bytes read from the start of every file in the first request (header + most tags)
+#define BULK_WHOLE_TAG_MAX (256 * 1024) // Larger tags (cover art) are not read whole: the parser streams past their big frames
+
+// Structure to store what the bulk reader hands to the callback for one file (valid only during the call)
+typedef struct // typedef used to give alternate name for structure here
+{
+  const char *path;          // File path
+  void *item;                // Caller's per-file pointer given to bulk_submit
+  int fd;                    // Descriptor of the file, open during the call (-1 if it could not be opened)
+  const unsigned char *data; // The 10-byte ID3v2 header followed by as much of the tag as it declares (len may be
+                             // shorter for truncated files and tags over BULK_WHOLE_TAG_MAX); NULL if unreadable
+  size_t len;                // Number of bytes in data
+  const unsigned char *tail; // Last bytes of a file without an ID3v2 header (trailer tags), NULL when not read
+  size_t tail_len;           // Number of bytes in tail
+  off_t size;                // File size (valid when tail is set)
+} BulkFile;                  // BulkFile is alternate name for this structure
+
+/*
+ * Function type called once per file with the bytes read from it. The callback always runs on a pool worker (never
+ * on the io_uring submission thread), so several run at once and it must be thread-safe; any further reads it needs
+ * (the rest of a large tag) go through file->fd. The callback runs with the worker's arena bound (arena.h): parsing
+ * memory is reclaimed after the call, so nothing allocated with arena_malloc may be kept beyond it.
+ */
+typedef void (*BulkReadDone)(const BulkFile *file, void *ctx);
+
+// Enumeration of the available I/O backends
+typedef enum // typedef used to give alternate name for enum here
+{
+  e_bulk_io_uring, // io_uring: many open/stat/read/close operations in flight from one thread, parsing on the pool
+  e_bulk_threads   // Worker pool doing synchronous open/pread/close (portable fallback)
+} BulkBackend;     // BulkBackend is alternate name for this enum
+
+// Structure to store the state of a bulk tag reader
+typedef struct // typedef used to give alternate name for structure here
+{
+  BulkBackend backend;       // Backend in use
+  BulkReadDone done;         // Callback run for every file
+  void *ctx;                 // Context passed to the callback
+  WorkPool pool;             // Worker pool: reads and parses (thread backend) or parses only (io_uring backend)
+  void *spare_jobs;          // Finished jobs kept for the next files (thread backend only, opaque)
+  pthread_mutex_t jobs_lock; // Protects spare_jobs
+  void *ring;                // io_uring state (io_uring backend only, opaque)
+} BulkReader;                // BulkReader is alternate name for this structure
+
+/*
+ * Function: bulk_start
+ * Description: Starts a bulk reader, using io_uring when the kernel supports the needed operations and falling back
+ *              to a worker pool otherwise (or when use_io_uring is 0); both backends parse on one worker per CPU
+ * Parameters: reader - pointer to BulkReader, use_io_uring - 1 to try io_uring first, done - per-file callback,
+ *             ctx - callback context
+ * Return: Status (e_success/e_failure)
+ */
+Status bulk_start(BulkReader *reader, int use_io_uring, BulkReadDone done, void *ctx);
+
+/*
+ * Function: bulk_submit
+ * Description: Queues one file; blocks (or reaps completions) while the maximum number of files is in flight
+ * Parameters: reader - pointer to BulkReader, path - file path (copied into storage the reader reuses),
+ *             item - caller's per-file pointer handed back to the callback (may be NULL)
+ * Return: Status (e_success/e_failure)
+ */
+Status bulk_submit(BulkReader *reader, const char *path, void *item);
+
+/*
+ * Function: bulk_finish
+ * Description: Waits for all queued files to complete and releases the reader
+ * Parameters: reader - pointer to BulkReader
+ * Return: void
+ */
+void bulk_finish(BulkReader *reader);
+
+/*
+ * Function: bulk_read_prefix
+ * Description: Synchronously reads the ID3v2 header and the tag it declares from the start of a file
+ *              (one pread of BULK_FIRST_READ bytes, plus one more only if the tag is larger)
+ * Parameters: fd - file descriptor, data - receives a buffer from arena_malloc (caller releases it with arena_release),
+ *             len - receives bytes read
+ * Return: Status (e_success/e_failure)
+ */
+Status bulk_read_prefix(int fd, unsigned char **data, size_t *len);
+
+#endif // End of header guard: Marks the end of conditional compilation block started by #ifndef BULKIO_H
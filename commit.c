@@ -0,0 +1,217 @@
+#include <stdio.h>     // Header file for standard input/output functions (rename, snprintf, etc.)
+#include <stdlib.h>    // Header file for memory allocation and utility functions (malloc, free, mkstemp, realpath)
+#include <string.h>    // Header file for string manipulation functions (strrchr, strlen, memcpy, etc.)
+#include <errno.h>     // Header file for error numbers reported by system calls
+#include <fcntl.h>     // Header file for open() flags (O_RDONLY, O_DIRECTORY)
+#include <unistd.h>    // Header file for POSIX functions (fsync, fchown, unlink, close)
+#include <sys/stat.h>  // Header file for file status information (fstat, fchmod)
+#include <sys/xattr.h> // Header file for extended attribute functions (flistxattr, fgetxattr, fsetxattr)
+#include "type.h"      // User-defined header file for custom type definitions (Status, e_success, e_failure)
+#include "commit.h"    // User-defined header file for atomic commit declarations
+
+/*
+ * Function: commit_create_temp
+ * Description: Creates ".<name>.XXXXXX" next to the resolved target so a later rename stays on the same filesystem
+ * Parameters: target, temp_path, real_path, fd - see commit.h
+ * Return: Status (e_success/e_failure)
+ */
+Status commit_create_temp(const char *target, char **temp_path, char **real_path, int *fd)
+{
+  *temp_path = NULL; // Nothing created yet
+  *real_path = realpath(target, NULL); // Resolve symbolic links so the real file is replaced
+
+  if (*real_path == NULL) // Error handling: target cannot be resolved
+  {
+    return e_failure; // Caller falls back to a copy-back commit
+  }
+
+  const char *slash = strrchr(*real_path, '/');       // Last separator splits directory and file name
+  size_t dir_len = (size_t)(slash - *real_path) + 1;  // Length of directory part including the '/'
+  const char *name = slash + 1;                       // File name part
+
+  *temp_path = malloc(dir_len + 1 + strlen(name) + 8); // Directory + "." + name + ".XXXXXX" + '\0'
+
+  if (*temp_path == NULL) // Error handling: allocation failed
+  {
+    free(*real_path);
+    *real_path = NULL;
+    return e_failure;
+  }
+
+  memcpy(*temp_path, *real_path, dir_len);                            // Copy directory part
+  sprintf(*temp_path + dir_len, ".%s.XXXXXX", name);                  // Hidden temporary name in the same directory
+
+  *fd = mkstemp(*temp_path); // Create the file with a unique name (mode 0600 until the commit copies the original mode)
+
+  if (*fd == -1) // Error handling: directory not writable, quota, ...
+  {
+    free(*temp_path);
+    free(*real_path);
+    *temp_path = NULL;
+    *real_path = NULL;
+    return e_failure; // Caller falls back to a copy-back commit
+  }
+  return e_success; // Temporary file created beside the original
+}
+
+/*
+ * Function: copy_xattrs
+ * Description: Copies every extended attribute of the original file onto the temporary file
+ * Parameters: fd_src - original file descriptor, fd_dest - temporary file descriptor
+ * Return: Status (e_success/e_failure)
+ */
+static Status copy_xattrs(int fd_src, int fd_dest)
+{
+  ssize_t list_len = flistxattr(fd_src, NULL, 0); // Ask for the size of the attribute name list
+
+  if (list_len <= 0) // No attributes, or filesystem without xattr support
+  {
+    return (list_len == 0 || errno == ENOTSUP) ? e_success : e_failure;
+  }
+
+  char *names = malloc(list_len); // Buffer for the null-separated name list
+  Status status = e_success;      // Result of the copy
+
+  if (names == NULL || (list_len = flistxattr(fd_src, names, list_len)) < 0) // Error handling: allocation or listing failed
+  {
+    free(names);
+    return e_failure;
+  }
+
+  for (char *name = names; name < names + list_len; name += strlen(name) + 1) // Visit every attribute name
+  {
+    ssize_t value_len = fgetxattr(fd_src, name, NULL, 0); // Size of this attribute's value
+    char *value = malloc(value_len > 0 ? value_len : 1);  // Buffer for the value
+
+    if (value == NULL || value_len < 0 || fgetxattr(fd_src, name, value, value_len) != value_len ||
+        fsetxattr(fd_dest, name, value, value_len, 0) == -1) // Read value from original and set it on the new file
+    {
+      if (errno != EPERM && errno != ENOTSUP) // Attributes we are not allowed to set (e.g. security.*) are skipped
+      {
+        status = e_failure;
+      }
+    }
+    free(value); // Free value buffer
+  }
+
+  free(names); // Free name list
+  return status;
+}
+
+/*
+ * Function: sync_parent_directory
+ * Description: Flushes the directory entry change made by rename() to disk
+ * Parameters: real_path - resolved path of the renamed file
+ * Return: void
+ */
+static void sync_parent_directory(const char *real_path)
+{
+  const char *slash = strrchr(real_path, '/');         // Last separator ends the directory part
+  size_t dir_len = slash == real_path ? 1 : (size_t)(slash - real_path); // Keep "/" for files in the root directory
+  char *dir = malloc(dir_len + 1);                      // Buffer for the directory path
+
+  if (dir == NULL) // Allocation failed: the rename itself already happened
+  {
+    return;
+  }
+
+  memcpy(dir, real_path, dir_len); // Copy directory part
+  dir[dir_len] = '\0';             // Null-terminate directory path
+
+  int fd = open(dir, O_RDONLY | O_DIRECTORY); // Open directory to fsync it
+  if (fd != -1)
+  {
+    fsync(fd); // Persist the new directory entry
+    close(fd);
+  }
+  free(dir); // Free directory path
+}
+
+/*
+ * Function: commit_can_rename
+ * Description: Rename would split a multiply-linked file, so only allow it for single-link files
+ * Parameters: fd_original - descriptor of the original file
+ * Return: 1 if replace-by-rename is safe, 0 otherwise
+ */
+int commit_can_rename(int fd_original)
+{
+  struct stat st; // File status of the original
+
+  return fstat(fd_original, &st) == 0 && S_ISREG(st.st_mode) && st.st_nlink == 1;
+}
+
+/*
+ * Function: discard_temp
+ * Description: Removes the unused temporary file after a failed commit step, keeping the errno of that step
+ * Parameters: temp_path - temporary file
+ * Return: Status (always e_failure)
+ */
+static Status discard_temp(const char *temp_path)
+{
+  int saved = errno; // unlink must not hide the real cause
+
+  unlink(temp_path);
+  errno = saved;
+  return e_failure;
+}
+
+/*
+ * Function: commit_take_owner
+ * Description: Gives the temporary file the owner and group of the original. fchown may fail for a user who is not
+ *              root (another owner, a group the user is not in); that only matters if the ids really differ.
+ * Parameters: fd_original - descriptor of the original file, fd_temp - descriptor of the temporary file
+ * Return: Status (e_success when the temporary file now has the original's owner and group)
+ */
+Status commit_take_owner(int fd_original, int fd_temp)
+{
+  struct stat st;   // File status of the original (owner to preserve)
+  struct stat temp; // File status of the temporary file
+
+  if (fstat(fd_original, &st) == -1 || fstat(fd_temp, &temp) == -1)
+  {
+    return e_failure;
+  }
+  if (temp.st_uid == st.st_uid && temp.st_gid == st.st_gid) // Already right (the common case: user edits own file)
+  {
+    return e_success;
+  }
+  if (fchown(fd_temp, st.st_uid, st.st_gid) == 0)
+  {
+    return e_success;
+  }
+  return e_failure; // Renaming would silently change the owner
+}
+
+/*
+ * Function: commit_by_rename
+ * Description: fsync temp, copy metadata from original, then rename temp over original
+ * Parameters: fd_original, fd_temp, temp_path, real_path - see commit.h
+ * Return: Status (e_success/e_failure)
+ */
+Status commit_by_rename(int fd_original, int fd_temp, const char *temp_path, const char *real_path)
+{
+  struct stat st; // File status of the original (mode to preserve)
+
+  if (fstat(fd_original, &st) == -1) // Error handling: cannot read original metadata
+  {
+    return discard_temp(temp_path); // Remove the unused temporary file
+  }
+
+  if (fchmod(fd_temp, st.st_mode & 07777) == -1 || copy_xattrs(fd_original, fd_temp) == e_failure) // Keep permission bits and extended attributes
+  {
+    return discard_temp(temp_path); // Remove the unused temporary file
+  }
+
+  if (fsync(fd_temp) == -1) // New content must be on disk before it becomes visible under the original name
+  {
+    return discard_temp(temp_path); // Remove the unused temporary file
+  }
+
+  if (rename(temp_path, real_path) == -1) // Atomically replace the original with the new file
+  {
+    return discard_temp(temp_path); // Remove the unused temporary file
+  }
+
+  sync_parent_directory(real_path); // Persist the rename itself
+  return e_success;                 // Original now has the edited content
+}
@@ -0,0 +1,46 @@
+#ifndef COMMIT_H // If not defined COMMIT_H ---> Checks if COMMIT_H was previously defined: If not present, code is processed; else code below till #endif is ignored
+#define COMMIT_H // Defines the macro COMMIT_H if macro was not previously defined
+
+#include "type.h" // User-defined header file for custom type definitions (Status, e_success, e_failure)
+
+/*
+ * Function: commit_create_temp
+ * Description: Creates a new, empty file in the same directory as the target (".<name>.XXXXXX") so that it can
+ *              later replace the target with a single rename(). Symbolic links are resolved first so the real
+ *              file is replaced, not the link.
+ * Parameters: target - path of the file being edited, temp_path - receives malloc'd path of the new file,
+ *             real_path - receives malloc'd resolved path of the target, fd - receives descriptor of the new file
+ * Return: Status (e_success/e_failure; on failure nothing is left behind)
+ */
+Status commit_create_temp(const char *target, char **temp_path, char **real_path, int *fd);
+
+/*
+ * Function: commit_take_owner
+ * Description: Gives the temporary file the owner and group of the original (fchown when they differ)
+ * Parameters: fd_original - descriptor of the original file, fd_temp - descriptor of the temporary file
+ * Return: Status (e_failure when the owner or group cannot be kept: the caller must not rename)
+ */
+Status commit_take_owner(int fd_original, int fd_temp);
+
+/*
+ * Function: commit_by_rename
+ * Description: Makes the fully written temporary file durable, copies mode and extended attributes from the
+ *              original, and atomically renames it over the original (its owner must already match, see
+ *              commit_take_owner). A crash at any point leaves either the old
+ *              or the new file in place, never a torn one.
+ * Parameters: fd_original - descriptor of the original file, fd_temp - descriptor of the temporary file,
+ *             temp_path - path of the temporary file, real_path - resolved path of the original file
+ * Return: Status (e_success/e_failure; the temporary file is removed on failure)
+ */
+Status commit_by_rename(int fd_original, int fd_temp, const char *temp_path, const char *real_path);
+
+/*
+ * Function: commit_can_rename
+ * Description: Checks whether the original file can be replaced by rename without changing its identity for other
+ *              users (a file with several hard links must be overwritten in place instead)
+ * Parameters: fd_original - descriptor of the original file
+ * Return: 1 if replace-by-rename is safe, 0 otherwise
+ */
+int commit_can_rename(int fd_original);
+
+#endif // End of header guard: Marks the end of conditional compilation block started by #ifndef COMMIT_H
@@ -0,0 +1,257 @@
+#define _GNU_SOURCE // Enables GNU extensions (copy_file_range) declared in unistd.h
+
+#include <stdio.h>        // Header file for standard input/output functions (fflush, ftell, fseek, fileno, etc.)
+#include <stdlib.h>       // Header file for memory allocation functions (malloc, free, etc.)
+#include <errno.h>        // Header file for error numbers reported by system calls (errno, EINTR, EXDEV, etc.)
+#include <unistd.h>       // Header file for POSIX I/O functions (pread, pwrite, lseek, copy_file_range)
+#include <sys/stat.h>     // Header file for file status information (fstat, S_ISREG)
+#include <sys/sendfile.h> // Header file for the sendfile system call
+#include "type.h"         // User-defined header file for custom type definitions (Status, e_success, e_failure)
+#include "copy.h"         // User-defined header file for copy engine declarations
+
+/*
+ * Function: is_regular_fd
+ * Description: Checks whether a file descriptor refers to a regular file (kernel-side copies need this)
+ * Parameters: fd - file descriptor to check
+ * Return: 1 if regular file, 0 otherwise
+ */
+static int is_regular_fd(int fd)
+{
+  struct stat st; // Structure to store file status information
+
+  if (fstat(fd, &st) == -1) // Error handling: Unable to query the descriptor
+  {
+    return 0; // Treat unknown descriptors as non-regular (buffered path will be used)
+  }
+  return S_ISREG(st.st_mode); // Return non-zero only for regular files
+}
+
+/*
+ * Function: next_chunk
+ * Description: Calculates how many bytes to request in the next copy call
+ * Parameters: remaining - bytes left to copy (negative when copying to end of file)
+ * Return: size_t - number of bytes to request
+ */
+static size_t next_chunk(off_t remaining)
+{
+  if (remaining < 0 || remaining > COPY_BLOCK_SIZE) // Copying to EOF or more than one block left
+  {
+    return COPY_BLOCK_SIZE; // Request one full block
+  }
+  return (size_t)remaining; // Request only what is left
+}
+
+/*
+ * Function: copy_with_copy_file_range
+ * Description: Copies data entirely inside the kernel using copy_file_range (may share extents on reflink filesystems)
+ * Parameters: fd_src, src_offset, fd_dest, dest_offset - descriptors and offsets (offsets advanced on progress),
+ *             remaining - bytes left to copy (advanced on progress, negative for EOF)
+ * Return: Status (e_success if finished, e_failure if this method is not usable and nothing more was copied)
+ */
+static Status copy_with_copy_file_range(int fd_src, off_t *src_offset, int fd_dest, off_t *dest_offset, off_t *remaining)
+{
+  while (*remaining != 0) // Keep copying until the requested length has been moved
+  {
+    ssize_t n = copy_file_range(fd_src, src_offset, fd_dest, dest_offset, next_chunk(*remaining), 0); // Kernel copies one block and advances both offsets
+
+    if (n == -1) // Error handling: copy_file_range failed
+    {
+      if (errno == EINTR) // Interrupted by a signal before copying anything
+      {
+        continue; // Retry the same block
+      }
+      return e_failure; // Not supported for this pair (EXDEV, ENOSYS, EINVAL, ...): let the caller fall back
+    }
+    if (n == 0) // Reached end of source file
+    {
+      break; // Nothing more to copy
+    }
+    if (*remaining > 0) // Fixed-length copy
+    {
+      *remaining -= n; // Reduce bytes left by the amount copied
+    }
+  }
+  *remaining = 0; // Copy finished
+  return e_success;
+}
+
+/*
+ * Function: copy_with_sendfile
+ * Description: Copies data inside the kernel using sendfile (works across filesystems where copy_file_range does not)
+ * Parameters: same as copy_with_copy_file_range
+ * Return: Status (e_success if finished, e_failure if this method is not usable)
+ */
+static Status copy_with_sendfile(int fd_src, off_t *src_offset, int fd_dest, off_t *dest_offset, off_t *remaining)
+{
+  off_t saved = lseek(fd_dest, 0, SEEK_CUR); // Remember destination position (sendfile writes at the current position)
+
+  if (saved == -1 || lseek(fd_dest, *dest_offset, SEEK_SET) == -1) // Error handling: destination is not seekable
+  {
+    return e_failure; // Let the caller use the buffered path
+  }
+
+  Status status = e_success; // Result of this copy method
+
+  while (*remaining != 0) // Keep copying until the requested length has been moved
+  {
+    ssize_t n = sendfile(fd_dest, fd_src, src_offset, next_chunk(*remaining)); // Kernel copies one block and advances source offset
+
+    if (n == -1) // Error handling: sendfile failed
+    {
+      if (errno == EINTR) // Interrupted by a signal
+      {
+        continue; // Retry the same block
+      }
+      status = e_failure; // Method not usable: let the caller fall back
+      break;
+    }
+    if (n == 0) // Reached end of source file
+    {
+      break; // Nothing more to copy
+    }
+    *dest_offset += n; // Advance destination offset by the amount written
+    if (*remaining > 0) // Fixed-length copy
+    {
+      *remaining -= n; // Reduce bytes left by the amount copied
+    }
+  }
+
+  lseek(fd_dest, saved, SEEK_SET); // Restore destination position so the caller sees an untouched descriptor
+  if (status == e_success)
+  {
+    *remaining = 0; // Copy finished
+  }
+  return status;
+}
+
+/*
+ * Function: copy_with_buffer
+ * Description: Copies data through a user-space block buffer using pread/pwrite (works for any descriptor pair)
+ * Parameters: same as copy_with_copy_file_range
+ * Return: Status (e_success/e_failure)
+ */
+static Status copy_with_buffer(int fd_src, off_t *src_offset, int fd_dest, off_t *dest_offset, off_t *remaining)
+{
+  char *buffer = malloc(COPY_BLOCK_SIZE); // Allocate one block for the transfer
+
+  if (buffer == NULL) // Error handling: allocation failed (errno is ENOMEM)
+  {
+    return e_failure;
+  }
+
+  while (*remaining != 0) // Keep copying until the requested length has been moved
+  {
+    ssize_t n = pread(fd_src, buffer, next_chunk(*remaining), *src_offset); // Read one block from source
+
+    if (n == -1 && errno == EINTR) // Interrupted by a signal
+    {
+      continue; // Retry the same block
+    }
+    if (n <= 0) // End of file or read error
+    {
+      if (n == -1)
+      {
+        free(buffer); // errno still holds the read error
+        return e_failure;
+      }
+      break; // End of source file reached
+    }
+
+    for (ssize_t done = 0; done < n;) // Write the whole block (pwrite may write less than requested)
+    {
+      ssize_t w = pwrite(fd_dest, buffer + done, n - done, *dest_offset + done); // Write the unwritten part of the block
+
+      if (w == -1) // Error handling: write failed
+      {
+        if (errno == EINTR) // Interrupted by a signal
+        {
+          continue; // Retry the same write
+        }
+        free(buffer); // errno still holds the write error
+        return e_failure;
+      }
+      done += w; // Account for the bytes written
+    }
+
+    *src_offset += n;  // Advance source offset
+    *dest_offset += n; // Advance destination offset
+    if (*remaining > 0) // Fixed-length copy
+    {
+      *remaining -= n; // Reduce bytes left by the amount copied
+    }
+  }
+
+  free(buffer); // Free block buffer
+  *remaining = 0; // Copy finished
+  return e_success;
+}
+
+/*
+ * Function: copy_fd_range
+ * Description: Copies a byte range between two descriptors, preferring kernel-side copies over the buffered loop
+ * Parameters: fd_src, src_offset, fd_dest, dest_offset, length, copied - see copy.h
+ * Return: Status (e_success/e_failure)
+ */
+Status copy_fd_range(int fd_src, off_t src_offset, int fd_dest, off_t dest_offset, off_t length, off_t *copied)
+{
+  off_t start = src_offset;                                  // Remember where the copy started to report progress
+  off_t remaining = (length == COPY_TO_EOF) ? -1 : length;   // Bytes left to copy (-1 means up to end of file)
+  int kernel_copy = is_regular_fd(fd_src) && is_regular_fd(fd_dest); // Kernel-side copies need regular files on both ends
+  Status status = e_failure;                                 // Result of the copy
+
+  if (kernel_copy) // Both ends are regular files: try the zero-copy methods first
+  {
+    status = copy_with_copy_file_range(fd_src, &src_offset, fd_dest, &dest_offset, &remaining); // Fastest: no data enters user space
+
+    if (status == e_failure) // copy_file_range not available for this pair (e.g. across filesystems)
+    {
+      status = copy_with_sendfile(fd_src, &src_offset, fd_dest, &dest_offset, &remaining); // Still no user-space copy
+    }
+  }
+
+  if (status == e_failure) // Kernel-side copy not possible: use the buffered fallback for what is left
+  {
+    status = copy_with_buffer(fd_src, &src_offset, fd_dest, &dest_offset, &remaining);
+  }
+
+  if (copied != NULL) // Caller wants to know how much was copied
+  {
+    *copied = src_offset - start; // Bytes copied is how far the source offset moved
+  }
+  return status;
+}
+
+/*
+ * Function: copy_stream_data
+ * Description: Copies the rest of a source stream into a destination stream in blocks and resynchronises both streams
+ * Parameters: src - source stream, dest - destination stream
+ * Return: Status (e_success/e_failure)
+ */
+Status copy_stream_data(FILE *src, FILE *dest)
+{
+  if (fflush(dest) == EOF) // Push any pending stdio output so the descriptor is up to date
+  {
+    return e_failure;
+  }
+
+  off_t src_offset = ftell(src);   // Logical read position of the source stream (accounts for stdio read-ahead)
+  off_t dest_offset = ftell(dest); // Logical write position of the destination stream
+
+  if (src_offset == -1 || dest_offset == -1) // Error handling: streams are not seekable
+  {
+    return e_failure;
+  }
+
+  off_t copied = 0; // Number of bytes moved by the copy engine
+
+  if (copy_fd_range(fileno(src), src_offset, fileno(dest), dest_offset, COPY_TO_EOF, &copied) == e_failure)
+  {
+    return e_failure; // Return failure if the copy engine could not move the data
+  }
+
+  // Reposition both streams past the copied data (fseek also discards stale stdio buffers)
+  fseek(src, src_offset + copied, SEEK_SET);
+  fseek(dest, dest_offset + copied, SEEK_SET);
+
+  return e_success; // Return success after copying all remaining data
+}
@@ -0,0 +1,33 @@
+#ifndef COPY_H // If not defined COPY_H ---> Checks if COPY_H was previously defined: If not present, code is processed; else code below till #endif is ignored
+#define COPY_H // Defines the macro COPY_H if macro was not previously defined
+
+#include <stdio.h>     // Header file for standard input and output (FILE, fflush(), ftell(), fseek(), etc.)
+#include <sys/types.h> // Header file for system data types (off_t)
+#include "type.h"      // User-defined header file for custom type definitions (Status, e_success, e_failure)
+
+#define COPY_BLOCK_SIZE (1024 * 1024) // Size of one block (1 MiB) moved per system call by the copy engine
+#define COPY_TO_EOF ((off_t)-1)       // Length value meaning "copy everything up to the end of the source file"
+
+/*
+ * Function: copy_fd_range
+ * Description: Copies a byte range between two file descriptors in large blocks, using kernel-side copies
+ *              (copy_file_range, then sendfile) when both ends are regular files and a buffered pread/pwrite
+ *              loop otherwise. File offsets of both descriptors are left untouched.
+ * Parameters: fd_src - source descriptor, src_offset - first byte to copy from source,
+ *             fd_dest - destination descriptor, dest_offset - position in destination to write the first byte,
+ *             length - number of bytes to copy (COPY_TO_EOF copies up to end of source),
+ *             copied - optional pointer to store the number of bytes actually copied (may be NULL)
+ * Return: Status (e_success/e_failure)
+ */
+Status copy_fd_range(int fd_src, off_t src_offset, int fd_dest, off_t dest_offset, off_t length, off_t *copied);
+
+/*
+ * Function: copy_stream_data
+ * Description: Copies everything from the current position of one stdio stream to the end of that stream into
+ *              the current position of another stream through copy_fd_range, then resynchronises both streams
+ * Parameters: src - source stream, dest - destination stream
+ * Return: Status (e_success/e_failure)
+ */
+Status copy_stream_data(FILE *src, FILE *dest);
+
+#endif // End of header guard: Marks the end of conditional compilation block started by #ifndef COPY_H
@@ -0,0 +1,348 @@
+#include <stdio.h>    // Header file for standard input/output functions (fprintf, perror, snprintf)
+#include <stdlib.h>   // Header file for memory allocation functions (malloc, free)
+#include <string.h>   // Header file for string/memory functions (memcpy, memchr, strstr, strcmp, strerror)
+#include <errno.h>    // Header file for errno (cause of a failed copy, reported once)
+#include <fcntl.h>    // Header file for open() and its flags (O_RDONLY, O_WRONLY, O_CREAT, O_TRUNC)
+#include <unistd.h>   // Header file for POSIX I/O functions (pread, write, lseek, close)
+#include <sys/stat.h> // Header file for file status information (fstat, S_ISREG)
+#include "type.h"     // User-defined header file for custom type definitions (Status, e_success, e_failure)
+#include "id3.h"      // User-defined header file for the streaming frame walker (id3_stream_frames)
+#include "frames.h"   // User-defined header file for frame IDs as integers (ID3_FRAME_ID)
+#include "copy.h"     // User-defined header file for the block copy engine (copy_fd_range)
+#include "cover.h"    // User-defined header file for CoverInfo structure and function declarations
+
+/*
+ * Function: read_and_validate_for_cover
+ * Description: Validates the -x arguments: an .mp3 file and an optional output name
+ * Parameters: argc - argument count, argv[] - command-line argument array, coInfo - pointer to CoverInfo structure
+ * Return: Status (e_success/e_failure)
+ */
+Status read_and_validate_for_cover(int argc, char *argv[], CoverInfo *coInfo)
+{
+  memset(coInfo, 0, sizeof(*coInfo)); // Nothing found yet
+  coInfo->fd_src = -1;
+  coInfo->image_offset = -1;
+
+  if (argc < 3 || argc > 4 || strstr(argv[2], ".mp3") == NULL) // Error handling: missing or non-.mp3 source file
+  {
+    fprintf(stderr, "\033[1;91mERROR: \033[1;97mUsage: -x <file.mp3> [output|-]\033[0m\n"); // stderr: stdout may be the image stream
+    return e_failure;
+  }
+
+  coInfo->src_fname = argv[2];                      // MP3 file to extract from
+  coInfo->out_fname = (argc == 4) ? argv[3] : NULL; // Output named after the MIME type when not given
+  return e_success;
+}
+
+/*
+ * Function: head_byte
+ * Description: Returns the next byte of a frame head, skipping the 0x00 inserted after 0xFF by unsynchronisation
+ * Parameters: b - raw bytes, len - raw length, raw - read position (advanced), unsync - 1 if the bytes are unsynchronised
+ * Return: int - byte value, or -1 at the end of the bytes
+ */
+static int head_byte(const unsigned char *b, size_t len, size_t *raw, int unsync)
+{
+  if (*raw >= len)
+  {
+    return -1;
+  }
+
+  unsigned char c = b[(*raw)++];
+  if (unsync && c == 0xFF && *raw < len && b[*raw] == 0x00) // Inserted zero
+  {
+    (*raw)++;
+  }
+  return c;
+}
+
+/*
+ * Function: parse_picture_head
+ * Description: Decodes the fields in front of the image bytes of an APIC (or ID3v2.2 PIC) frame
+ * Parameters: b - first bytes of the frame data, len - bytes available, is_pic - 1 for PIC, unsync - 1 if unsynchronised,
+ *             mime - receives the MIME type (64 bytes), type - receives the picture type
+ * Return: long - raw offset of the image bytes inside the frame data, or -1 when the head is incomplete
+ *
+ * APIC structure: encoding, MIME type + '\0', picture type, description + terminator ('\0', or "\0\0" in UTF-16), image
+ * PIC structure:  encoding, 3-byte image format ("JPG", "PNG"), picture type, description + terminator, image
+ */
+static long parse_picture_head(const unsigned char *b, size_t len, int is_pic, int unsync, char *mime, int *type)
+{
+  size_t raw = 0; // Raw read position
+  int c;
+  size_t n = 0;   // MIME characters stored
+
+  int encoding = head_byte(b, len, &raw, unsync); // Text encoding of the description
+  if (encoding < 0)
+  {
+    return -1;
+  }
+
+  if (is_pic) // Image format instead of a MIME type
+  {
+    char format[4] = {0};
+    for (int i = 0; i < 3; i++)
+    {
+      if ((c = head_byte(b, len, &raw, unsync)) < 0)
+      {
+        return -1;
+      }
+      format[i] = (char)c;
+    }
+    snprintf(mime, 64, "%s", strcmp(format, "PNG") == 0 ? "image/png" : "image/jpeg");
+  }
+  else
+  {
+    while ((c = head_byte(b, len, &raw, unsync)) > 0) // MIME type up to its terminator
+    {
+      if (n < 63)
+      {
+        mime[n++] = (char)c;
+      }
+    }
+    if (c < 0)
+    {
+      return -1;
+    }
+    mime[n] = '\0';
+  }
+
+  if ((*type = head_byte(b, len, &raw, unsync)) < 0) // Picture type
+  {
+    return -1;
+  }
+
+  if (encoding == 1 || encoding == 2) // UTF-16 description: ends with a 16-bit zero
+  {
+    int lo, hi;
+    do
+    {
+      lo = head_byte(b, len, &raw, unsync);
+      hi = head_byte(b, len, &raw, unsync);
+    } while (hi >= 0 && (lo != 0 || hi != 0));
+    c = hi;
+  }
+  else // Single-byte description: ends with one zero
+  {
+    while ((c = head_byte(b, len, &raw, unsync)) > 0)
+    {
+    }
+  }
+  return (c < 0) ? -1 : (long)raw;
+}
+
+/*
+ * Function: picture_visitor
+ * Description: Frame visitor that records the front cover (or the first picture) without reading its image bytes
+ * Parameters: frame - current frame, data_offset - file offset of the frame data (-1 when in memory only),
+ *             data_avail - data bytes in memory, ctx - pointer to CoverInfo
+ * Return: int - 0 once the front cover was found, 1 to continue
+ */
+static int picture_visitor(const Id3Frame *frame, off_t data_offset, size_t data_avail, void *ctx)
+{
+  CoverInfo *coInfo = ctx;
+  int is_pic = (frame->id32 == ID3_FRAME_ID('P', 'I', 'C', 0)); // ID3v2.2 picture frame
+  unsigned char head[COVER_HEAD_MAX];                           // Frame head read from the file when the window is short
+  const unsigned char *b = frame->body;                         // Frame head bytes
+  size_t len = (frame->size < COVER_HEAD_MAX) ? frame->size : COVER_HEAD_MAX; // Head bytes needed at most
+  char mime[64];
+  int type;
+
+  if ((frame->id32 != ID3_FRAME_ID('A', 'P', 'I', 'C') && !is_pic) || frame->opaque) // Not a picture, or compressed/encrypted
+  {
+    return 1;
+  }
+  if (coInfo->found && coInfo->picture_type == COVER_FRONT) // Front cover already chosen
+  {
+    return 0;
+  }
+
+  if (data_avail < len) // Head crosses the window edge: read just the head
+  {
+    if (pread(coInfo->fd_src, head, len, data_offset) != (ssize_t)len)
+    {
+      return 1;
+    }
+    b = head;
+  }
+
+  long image = parse_picture_head(b, len, is_pic, frame->unsync, mime, &type);
+  if (image < 0 || (coInfo->found && type != COVER_FRONT)) // Unreadable head, or not better than the picture already chosen
+  {
+    return 1;
+  }
+
+  free(coInfo->image); // Replace an earlier, non-front picture
+  coInfo->image = NULL;
+  coInfo->found = 1;
+  coInfo->picture_type = type;
+  memcpy(coInfo->mime, mime, sizeof(mime));
+  coInfo->image_len = frame->size - (size_t)image;
+  coInfo->unsync = frame->unsync;
+  coInfo->image_offset = (data_offset < 0) ? -1 : data_offset + image;
+
+  if (data_offset < 0) // Tag was read whole (unsynchronised v2.2/2.3): keep the bytes before the buffer goes away
+  {
+    coInfo->image = malloc(coInfo->image_len ? coInfo->image_len : 1);
+    if (coInfo->image == NULL)
+    {
+      coInfo->found = 0;
+      return 0;
+    }
+    memcpy(coInfo->image, frame->body + image, coInfo->image_len);
+  }
+  return type != COVER_FRONT; // Stop at the front cover
+}
+
+/*
+ * Function: write_all
+ * Description: Writes a whole buffer to a descriptor (pipes may accept less than requested)
+ * Parameters: fd - output descriptor, buf - bytes, len - byte count
+ * Return: Status (e_success/e_failure)
+ */
+static Status write_all(int fd, const unsigned char *buf, size_t len)
+{
+  while (len > 0)
+  {
+    ssize_t n = write(fd, buf, len);
+    if (n <= 0)
+    {
+      return e_failure; // errno tells why (reported by extract_cover)
+    }
+    buf += n;
+    len -= (size_t)n;
+  }
+  return e_success;
+}
+
+/*
+ * Function: write_resynced
+ * Description: Writes bytes, removing the 0x00 inserted after every 0xFF when they are unsynchronised
+ * Parameters: fd - output descriptor, buf - bytes (modified in place), len - byte count, unsync - 1 to resynchronise,
+ *             after_ff - carries "previous byte was 0xFF" across chunks (updated)
+ * Return: Status (e_success/e_failure)
+ */
+static Status write_resynced(int fd, unsigned char *buf, size_t len, int unsync, int *after_ff)
+{
+  size_t out = len; // Bytes to write
+
+  if (unsync)
+  {
+    out = 0;
+    for (size_t i = 0; i < len; i++)
+    {
+      if (!(*after_ff && buf[i] == 0x00)) // Keep everything except an inserted zero
+      {
+        buf[out++] = buf[i];
+      }
+      *after_ff = (buf[i] == 0xFF) && !(*after_ff && buf[i] == 0x00);
+    }
+  }
+  return write_all(fd, buf, out);
+}
+
+/*
+ * Function: stream_image
+ * Description: Copies the image bytes from the MP3 file to the output without holding the picture in memory
+ * Parameters: coInfo - pointer to CoverInfo structure, fd_out - output descriptor
+ * Return: Status (e_success/e_failure)
+ */
+static Status stream_image(CoverInfo *coInfo, int fd_out)
+{
+  int after_ff = 0; // Resynchronisation state across chunks
+  struct stat st;
+
+  if (coInfo->image != NULL) // Picture of a tag that was read whole
+  {
+    return write_resynced(fd_out, coInfo->image, coInfo->image_len, coInfo->unsync, &after_ff);
+  }
+
+  if (!coInfo->unsync && fstat(fd_out, &st) == 0 && S_ISREG(st.st_mode)) // Regular output file: kernel-side copy
+  {
+    off_t at = lseek(fd_out, 0, SEEK_CUR); // Honour an output already positioned (stdout redirected with >>)
+    return copy_fd_range(coInfo->fd_src, coInfo->image_offset, fd_out, at < 0 ? 0 : at, (off_t)coInfo->image_len, NULL);
+  }
+
+  unsigned char *chunk = malloc(COVER_CHUNK_SIZE); // Pipe, terminal or unsynchronised picture: fixed-size chunks
+  if (chunk == NULL)
+  {
+    return e_failure;
+  }
+
+  Status status = e_success;
+  for (size_t done = 0; done < coInfo->image_len && status == e_success;)
+  {
+    size_t want = (coInfo->image_len - done < COVER_CHUNK_SIZE) ? coInfo->image_len - done : COVER_CHUNK_SIZE;
+    ssize_t n = pread(coInfo->fd_src, chunk, want, coInfo->image_offset + (off_t)done);
+    if (n <= 0) // Error handling: truncated file or read error
+    {
+      errno = (n == 0) ? EIO : errno; // Picture runs past the end of the file
+      status = e_failure;
+      break;
+    }
+    status = write_resynced(fd_out, chunk, (size_t)n, coInfo->unsync, &after_ff);
+    done += (size_t)n;
+  }
+  free(chunk);
+  return status;
+}
+
+/*
+ * Function: extract_cover
+ * Description: Locates the picture with the streaming walker and streams its bytes to the output
+ * Parameters: coInfo - pointer to CoverInfo structure
+ * Return: Status (e_success/e_failure)
+ */
+Status extract_cover(CoverInfo *coInfo)
+{
+  coInfo->fd_src = open(coInfo->src_fname, O_RDONLY); // Open source MP3 file in read mode
+  if (coInfo->fd_src == -1)
+  {
+    perror("open");
+    return e_failure;
+  }
+
+  if (id3_read_header(coInfo->fd_src, &coInfo->header) == e_failure ||
+      id3_stream_frames(coInfo->fd_src, &coInfo->header, NULL, 0, picture_visitor, coInfo) == e_failure || !coInfo->found)
+  {
+    fprintf(stderr, "\033[1;91mERROR: \033[1;97m%s: no embedded picture\033[0m\n", coInfo->src_fname); // Never into the image stream
+    close(coInfo->fd_src);
+    free(coInfo->image);
+    return e_failure;
+  }
+
+  const char *out = coInfo->out_fname;                                           // Output name
+  if (out == NULL)                                                               // Named after the MIME type
+  {
+    out = strstr(coInfo->mime, "png") ? "cover.png" : "cover.jpg";
+  }
+
+  int to_stdout = (strcmp(out, "-") == 0);
+  int fd_out = to_stdout ? STDOUT_FILENO : open(out, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd_out == -1)
+  {
+    perror("open");
+    close(coInfo->fd_src);
+    free(coInfo->image);
+    return e_failure;
+  }
+
+  Status status = stream_image(coInfo, fd_out);
+  int saved = errno; // Cause of a failed copy, before close/free can change it
+
+  if (!to_stdout)
+  {
+    close(fd_out);
+  }
+  close(coInfo->fd_src);
+  free(coInfo->image);
+
+  if (status == e_failure) // Reports go to stderr so the image can go to stdout
+  {
+    fprintf(stderr, "\033[1;91mERROR: \033[1;97m%s: cannot write picture: %s\033[0m\n", to_stdout ? "standard output" : out, strerror(saved));
+  }
+  else
+  {
+    fprintf(stderr, "\033[1;97mExtracted %s picture (%zu bytes) to %s\033[0m\n", coInfo->mime[0] ? coInfo->mime : "image", coInfo->image_len, to_stdout ? "standard output" : out);
+  }
+  return status;
+}
@@ -0,0 +1,46 @@
+#ifndef COVER_H // If not defined COVER_H ---> Checks if COVER_H was previously defined: If not present, code is processed; else code below till #endif is ignored
+#define COVER_H // Defines the macro COVER_H if macro was not previously defined
+
+#include <sys/types.h> // Header file for off_t
+#include "type.h"      // User-defined header file for custom type definitions (Status, e_success, e_failure)
+#include "id3.h"       // User-defined header file for Id3Header and the streaming frame walker
+
+#define COVER_HEAD_MAX 4096            // Most bytes of APIC/PIC fields (encoding, MIME type, picture type, description) accepted
+#define COVER_CHUNK_SIZE (64 * 1024)   // Chunk size used when the picture is streamed to a pipe or must be resynchronised
+#define COVER_FRONT 3                  // APIC picture type of the front cover (preferred over other pictures)
+
+// Structure to store the state of a cover-art extraction
+typedef struct // typedef used to give alternate name for structure here
+{
+  char *src_fname;      // MP3 file to extract from
+  char *out_fname;      // Output file ("-" for standard output, NULL to name it cover.jpg / cover.png from the MIME type)
+  int fd_src;           // Descriptor of the MP3 file
+  Id3Header header;     // Decoded ID3v2 header
+  int found;            // 1 once a picture frame was seen
+  int picture_type;     // APIC picture type of the chosen picture
+  char mime[64];        // MIME type of the chosen picture ("image/jpeg", ...)
+  off_t image_offset;   // File offset of the image bytes (-1 when they are only in memory)
+  size_t image_len;     // Length of the image bytes as stored (before resynchronisation)
+  int unsync;           // 1 if the stored image bytes are unsynchronised
+  unsigned char *image; // Image bytes of a tag that had to be read whole (NULL when streamed from the file)
+} CoverInfo;            // CoverInfo is alternate name for this structure
+
+/*
+ * Function: read_and_validate_for_cover
+ * Description: Stores the MP3 file (argv[2]) and the optional output (argv[3], "-" for standard output)
+ * Parameters: argc - argument count, argv[] - command-line argument array, coInfo - pointer to CoverInfo structure
+ * Return: Status (e_success/e_failure)
+ */
+Status read_and_validate_for_cover(int argc, char *argv[], CoverInfo *coInfo);
+
+/*
+ * Function: extract_cover
+ * Description: Finds the front cover (or the first picture) with the streaming frame walker, then copies the image
+ *              bytes straight from the MP3 file to the output: kernel-side through the copy engine for a regular
+ *              output file, in COVER_CHUNK_SIZE chunks for a pipe or terminal. The picture is never held in memory.
+ * Parameters: coInfo - pointer to CoverInfo structure
+ * Return: Status (e_failure when the file has no picture or a write fails)
+ */
+Status extract_cover(CoverInfo *coInfo);
+
+#endif // End of header guard: Marks the end of conditional compilation block started by #ifndef COVER_H
@@ -1,438 +1,795 @@
-#include <stdio.h>  // Header file for standard input/output functions (printf, fprintf, fopen, fread, fwrite, fseek, ftell, rewind, etc.)
-#include <string.h> // Header file for string manipulation functions (strcmp, strcpy, strlen, strstr, etc.)
-#include <stdlib.h> // Header file for memory allocation and utility functions (malloc, free, tmpfile, etc.)
-#include "type.h"   // User-defined header file for custom type definitions (Status, e_success, e_failure)
-#include "edit.h"   // User-defined header file for EditInfo structure and function declarations
-
-/*
- * Function: read_and_validate_for_edit
- * Description: Reads and validates command-line arguments for edit operation, maps user flags to ID3v2.3 and ID3v2.4 tags
- * Parameters: argv[] - command-line argument array, editInfo - pointer to EditInfo structure
- * Return: Status (e_success/e_failure)
- *
- * Flag mappings:
- * -t : TITLE  (TIT2)
- * -a : ARTIST (TPE1)
- * -y : YEAR   (TYER)
- * -A : ALBUM  (TALB)
- * -g : GENRE  (TCON)
- * -c : COMMENT(COMM)
- */
-Status read_and_validate_for_edit(char *argv[], EditInfo *editInfo)
-{
-  editInfo->mode = (char *)malloc(5 * sizeof(char)); // Allocate memory for 5 bytes to store tag mode identifier (4 chars + null terminator)
-
-  if (strcmp(argv[2], "-t") == 0) // Check if user wants to edit TITLE tag (-t flag)
-  {
-    strcpy(editInfo->user_tag, "TITLE"); // Copy "TITLE" to user_tag array
-    editInfo->user_tag[6] = '\0';        // Null-terminate the string (length 5 + '\0')
-    strcpy(editInfo->mode, "TIT2");      // Store corresponding ID3v2 tag identifier
-    editInfo->mode[4] = '\0';            // Null-terminate mode string
-  }
-  else if (strcmp(argv[2], "-a") == 0) // Check if user wants to edit ARTIST tag (-a flag)
-  {
-    strcpy(editInfo->user_tag, "ARTIST"); // Copy "ARTIST" to user_tag array
-    editInfo->user_tag[7] = '\0';         // Null-terminate the string (length 6 + '\0')
-    strcpy(editInfo->mode, "TPE1");       // Store corresponding ID3v2 tag identifier
-    editInfo->mode[4] = '\0';             // Null-terminate mode string
-  }
-  else if (strcmp(argv[2], "-y") == 0) // Check if user wants to edit YEAR tag (-y flag)
-  {
-    strcpy(editInfo->user_tag, "YEAR"); // Copy "YEAR" to user_tag array
-    editInfo->user_tag[5] = '\0';       // Null-terminate the string (length 4 + '\0')
-    strcpy(editInfo->mode, "TYER");     // Store corresponding ID3v2 tag identifier
-    editInfo->mode[4] = '\0';           // Null-terminate mode string
-  }
-  else if (strcmp(argv[2], "-A") == 0) // Check if user wants to edit ALBUM tag (-A flag)
-  {
-    strcpy(editInfo->user_tag, "ALBUM"); // Copy "ALBUM" to user_tag array
-    editInfo->user_tag[6] = '\0';        // Null-terminate the string (length 5 + '\0')
-    strcpy(editInfo->mode, "TALB");      // Store corresponding ID3v2 tag identifier
-    editInfo->mode[4] = '\0';            // Null-terminate mode string
-  }
-  else if (strcmp(argv[2], "-g") == 0) // Check if user wants to edit GENRE tag (-g flag)
-  {
-    strcpy(editInfo->user_tag, "GENRE"); // Copy "GENRE" to user_tag array
-    editInfo->user_tag[6] = '\0';        // Null-terminate the string (length 5 + '\0')
-    strcpy(editInfo->mode, "TCON");      // Store corresponding ID3v2 tag identifier
-    editInfo->mode[4] = '\0';            // Null-terminate mode string
-  }
-
-  else if (strcmp(argv[2], "-c") == 0) // Check if user wants to edit COMMENT tag (-c flag)
-  {
-    strcpy(editInfo->user_tag, "COMMENT"); // Copy "COMMENT" to user_tag array
-    editInfo->user_tag[8] = '\0';          // Null-terminate the string (length 7 + '\0')
-    strcpy(editInfo->mode, "COMM");        // Store corresponding ID3v2 tag identifier
-    editInfo->mode[4] = '\0';              // Null-terminate mode string
-  }
-  else
-  {
-    printf("\033[1;97mWrong TAG passed!\n"); // Print error message for invalid flag
-    return e_failure;                        // Return failure status
-  }
-
-  editInfo->user_content = malloc((strlen(argv[3]) + 1) * sizeof(char)); // Allocate memory for user-provided content (new tag value) based on its length
-  strcpy(editInfo->user_content, argv[3]);                               // Copy user-provided content from command-line argument to allocated memory
-
-  int i = 0;
-  while (editInfo->user_content[i])
-  {
-    i++; // Increment index until null character found
-  }
-  editInfo->user_content[i] = '\0'; // Ensure null termination
-
-  if (argv[4][0] != '.') // Validate that source filename doesn't start with '.' (hidden file or invalid format)
-  {
-    if (strstr(argv[4], ".mp3")) // Check if ".mp3" extension is present in the source filename
-    {
-      // Step 2: Store source MP3 filename in EditInfo structure
-      editInfo->original_fname = argv[4]; // Copy source filename (e.g., sample.mp3)
-    }
-    else
-    {
-      printf("\033[1;91mERROR: \033[1;97mInvalid source file without .mp3 extension\n"); // Print error message if file doesn't have .mp3 extension
-      return e_failure;                                                                  // Return failure if .mp3 extension not found
-    }
-  }
-  else
-  {
-    printf("\033[1;91mERROR: \033[1;97mInvalid source file without filename\n"); // Print error message if filename starts with '.' (invalid filename)
-    return e_failure;                                                            // Return failure if filename starts with '.'
-  }
-
-  return e_success; // Return success if all validation conditions are met
-}
-
-/*
- * Function: open_file
- * Description: Opens original MP3 file in read-write mode and creates a temporary file for editing
- * Parameters: editInfo - pointer to EditInfo structure
- * Return: Status (e_success/e_failure)
- */
-Status open_file(EditInfo *editInfo)
-{
-
-  editInfo->fptr_original = fopen(editInfo->original_fname, "r+"); // Open source MP3 file (e.g., sample.mp3) in read and write mode (r+)
-
-  if (editInfo->fptr_original == NULL) // Error handling: Check if original file pointer is NULL (file opening failed)
-  {
-    perror("fopen"); // Print system error message for file opening failure
-    // Print custom error message with red color formatting
-    fprintf(stderr, "\033[1;91mERROR: Unable to open file %s\033[0m\n", editInfo->original_fname);
-    return e_failure; // Return failure status
-  }
-
-  /**
-   * INFO:
-   * tmpfile() creates and opens a temporary file in read-write mode automatically.
-   * The file is deleted automatically when closed or when the program ends.
-   * This is safer than manually creating/deleting temp files.
-   */
-  editInfo->fptr_temp = tmpfile();
-
-  return e_success; // Return success if both files opened successfully
-}
-
-/*
- * Function: copy_header_edit
- * Description: Copies the 10-byte ID3v2 header from original file to temporary file
- * Parameters: editInfo - pointer to EditInfo structure
- * Return: Status (e_success/e_failure)
- *
- * ID3v2 Header structure (10 bytes):
- * - 3 bytes: "ID3" identifier
- * - 2 bytes: Version (major.minor)
- * - 1 byte:  Flags
- * - 4 bytes: Tag size (synchsafe integer)
- */
-Status copy_header_edit(EditInfo *editInfo)
-{
-  char arr[10]; // Array to store 10-byte ID3v2 header
-
-  fread(arr, 1, 10, editInfo->fptr_original); // Read first 10 bytes (header) from original file
-
-  fwrite(arr, 1, 10, editInfo->fptr_temp); // Write the 10-byte header to temporary file
-
-  if (ftell(editInfo->fptr_original) == ftell(editInfo->fptr_temp)) // Verify both file pointers are at the same position (byte 10) after copying
-  {
-    return e_success; // Return success if positions match
-  }
-  return e_failure; // Return failure if positions don't match (copy error)
-}
-
-/*
- * Function: convert_big_to_little_endian_for_edit
- * Description: Converts 4-byte integer from big-endian to little-endian format (byte reversal)
- * Parameters: arr - pointer to integer (treated as 4-byte array for byte manipulation)
- * Return: void
- *
- * Conversion: [0][1][2][3] → [3][2][1][0]
- */
-
-void convert_big_to_little_endian_for_edit(int *arr)
-{
-  char *p = (char *)arr; // Cast integer pointer to char pointer for byte-level access
-  char temp;             // Temporary variable for swapping bytes
-
-  // Swap byte 0 with byte 3
-  temp = p[0];
-  p[0] = p[3];
-  p[3] = temp;
-
-  // Swap byte 1 with byte 2
-  temp = p[1];
-  p[1] = p[2];
-  p[2] = temp;
-}
-
-/*
- * Function: skip_tag
- * Description: Copies a tag frame without modification when it doesn't match the target tag
- * Parameters: editInfo - pointer to EditInfo structure
- * Return: Status (e_success/e_failure)
- *
- * Frame structure:
- * - 4 bytes: Tag identifier (e.g., TIT2, TPE1)
- * - 4 bytes: Size
- * - 3 bytes: Flags
- * - N bytes: Content (N = size - 1)
- */
-Status skip_tag(EditInfo *editInfo)
-{
-  char tag[5]; // Array to store 4-byte tag identifier + null terminator
-
-  fseek(editInfo->fptr_original, -4, SEEK_CUR); // Move file pointer back 4 bytes (called after reading tag in compare_tag)
-
-  fread(tag, 1, 4, editInfo->fptr_original); // Read 4-byte tag identifier from original file
-
-  fwrite(tag, 1, 4, editInfo->fptr_temp); // Write tag identifier to temporary file
-
-  int size[1]; // Array to store tag size (4 bytes)
-
-  fread(size, 1, 4, editInfo->fptr_original); // Read 4-byte size field from original file
-
-  fwrite(size, 1, 4, editInfo->fptr_temp); // Write size field to temporary file
-
-  convert_big_to_little_endian_for_edit(&size[0]); // Convert size from big-endian to little-endian to get actual value
-
-  char flag[3]; // Array to store 3-byte flags field
-
-  fread(flag, 1, 3, editInfo->fptr_original); // Read 3-byte flags from original file
-
-  fwrite(flag, 1, 3, editInfo->fptr_temp); // Write flags to temporary file
-
-  char content[size[0]]; // Array to store tag content based on size
-
-  fread(content, 1, size[0] - 1, editInfo->fptr_original); // Read content (size-1 bytes) from original file
-
-  fwrite(content, 1, size[0] - 1, editInfo->fptr_temp); // Write content to temporary file
-
-  if (ftell(editInfo->fptr_original) == ftell(editInfo->fptr_temp)) // Verify both file pointers are at the same position after copying
-  {
-    return e_success; // Return success if positions match
-  }
-  return e_failure; // Return failure if copying 10 bytes of header from original file to temporary file failed
-}
-
-/*
- * Function: copy_remaining_data
- * Description: Copies all remaining data (tags and audio frames) from original to temporary file
- * Parameters: editInfo - pointer to EditInfo structure
- * Return: Status (e_success/e_failure)
- */
-Status copy_remaining_data(EditInfo *editInfo)
-{
-  char ch; // Variable to store one byte at a time
-
-  while (fread(&ch, 1, 1, editInfo->fptr_original) == 1) // Read one byte at a time until end of file
-  {
-    fwrite(&ch, 1, 1, editInfo->fptr_temp); // Write each byte to temporary file
-  }
-
-  return e_success; // Return failure after copying all remaining data
-}
-
-/*
- * Function: do_edit
- * Description: Edits the target tag by replacing old content with user-provided content
- * Parameters: editInfo - pointer to EditInfo structure
- * Return: Status (e_success/e_failure)
- *
- * Process:
- * 1. Copy tag identifier
- * 2. Replace old size with new size (based on user content length)
- * 3. Copy flags
- * 4. Write new user content
- * 5. Skip old content in original file
- * 6. Copy remaining data
- */
-Status do_edit(EditInfo *editInfo)
-{
-  char tag[5]; // Array to store 4-byte tag identifier + null terminator
-
-  fseek(editInfo->fptr_original, -4, SEEK_CUR); // Move file pointer back 4 bytes (called after reading tag in compare_tag)
-
-  fread(tag, 1, 4, editInfo->fptr_original); // Read 4-byte tag identifier from original file
-
-  fwrite(tag, 1, 4, editInfo->fptr_temp); // Write tag identifier to temporary file (keeping same tag name)
-
-  int size[1]; // Array to store old tag size (4 bytes)
-
-  fread(size, 1, 4, editInfo->fptr_original); // Read old size from original file
-
-  convert_big_to_little_endian_for_edit(&size[0]); // Convert old size from big-endian to little-endian to get actual value
-
-  editInfo->old_size = size[0]; // Store old size for later use
-
-  editInfo->user_content_size = strlen(editInfo->user_content) + 1; // Calculate new size: user content length + 1 (for encoding byte)
-
-  convert_big_to_little_endian_for_edit(&editInfo->user_content_size); // Convert new size from little-endian to big-endian format for writing to file
-
-  int new_size[1];
-  new_size[0] = editInfo->user_content_size;
-
-  fwrite(new_size, 1, 4, editInfo->fptr_temp); // Write new size to temporary file (in big-endian format)
-
-  char flag[3]; // Array to store 3-byte flags field
-
-  fread(flag, 1, 3, editInfo->fptr_original); // Read flags from original file
-
-  fwrite(flag, 1, 3, editInfo->fptr_temp); // Write flags to temporary file (keeping same flags)
-
-  fwrite(editInfo->user_content, 1, strlen(editInfo->user_content), editInfo->fptr_temp); // Write new user-provided content to temporary file
-
-  fseek(editInfo->fptr_original, editInfo->old_size - 1, SEEK_CUR); // Skip old content in original file (move pointer past old content)
-
-  if (copy_remaining_data(editInfo) == e_success) // Copy all remaining data (other tags and audio) to temporary file
-  {
-    return e_success; // Return success if remaining data copied successfully
-  }
-
-  printf("ERROR: Copying remaining data failed\n");
-  return e_failure; // Return failure if copying remaining data failed
-}
-
-/*
- * Function: compare_tag
- * Description: Compares each tag in the file with target tag and calls edit or skip accordingly
- * Parameters: editInfo - pointer to EditInfo structure
- * Return: Status (e_success/e_failure)
- *
- * Process: Loops through first 6 tags (TIT2, TPE1, TALB, TYER, TCON, COMM)
- */
-Status compare_tag(EditInfo *editInfo)
-{
-  editInfo->TAG = malloc(5 * sizeof(char)); // Allocate memory for 5 bytes to store tag identifier (4 bytes + null terminator)
-
-  for (int i = 0; i < 6; i++) // Loop through first 6 tags in the MP3 file
-  {
-    fread(editInfo->TAG, 1, 4, editInfo->fptr_original); // Read 4-byte tag identifier from original file
-    editInfo->TAG[5] = '\0';                             // Null-terminate the tag string
-
-    if (strcmp(editInfo->TAG, editInfo->mode) == 0) // Compare current tag with user-specified target tag (mode)
-    {
-      do_edit(editInfo);   // If tags match, edit this tag with user content
-      free(editInfo->TAG); // Free allocated memory for TAG identifier
-      return e_success;    // Return success after editing target tag
-    }
-    else
-    {
-      skip_tag(editInfo); // If tags don't match, skip (copy without modification)
-    }
-  }
-}
-
-/*
- * Function: close_all_file
- * Description: Closes all open file pointers and frees allocated memory
- * Parameters: editInfo - pointer to EditInfo structure
- * Return: Status (implied success)
- */
-Status close_all_file(EditInfo *editInfo)
-{
-  free(editInfo->user_content); // Free memory allocated for user content
-
-  fclose(editInfo->fptr_temp);     // Close temporary file pointer
-  fclose(editInfo->fptr_original); // Close original file pointer
-
-  return e_success;
-}
-
-/*
- * Function: do_edit_tags
- * Description: Main orchestration function for tag editing - coordinates all editing operations
- * Parameters: editInfo - pointer to EditInfo structure
- * Return: Status (e_success/e_failure)
- *
- * Workflow:
- * 1. Display selected tag for editing
- * 2. Open files (original and temporary)
- * 3. Copy ID3v2 header
- * 4. Compare and edit target tag
- * 5. Copy edited data back to original file
- * 6. Close all files and cleanup
- */
-Status do_edit_tags(EditInfo *editInfo)
-{
-
-  printf("\033[1;97mSELECTED FOR EDITING \033[1;92m%s\n", editInfo->user_tag); // Display which tag is selected for editing with green color formatting
-
-  if (open_file(editInfo) == e_failure) // Open original file (r+) and create temporary file
-  {
-    return e_failure; // Return failure if file opening fails
-  }
-
-  if (copy_header_edit(editInfo) == e_failure) // Copy 10-bytes header from original to temporary file
-  {
-    return e_failure; // Return failure if header copy fails
-  }
-
-  if (compare_tag(editInfo) == e_failure) // Compare tags and perform edit operation on target tag
-  {
-    return e_failure; // Return failure if tag comparison/editing fails
-  }
-
-  copy_data_from_temp_to_original_file(editInfo); // Copy all edited data from temporary file back to original file
-
-  close_all_file(editInfo); // Close all files and free allocated memory
-  return e_success;         // Return success if all edit operations are done successfully
-}
-
-/**
- * --------------------------------------------------------------------------------------
- * INFO: COPY ENTIRE DATA FROM TEMPORARY FILE TO ORIGINAL FILE
- * --------------------------------------------------------------------------------------
- * This function overwrites the original file with the edited content from temp file
- */
-
-/*
- * Function: copy_data_from_temp_to_original_file
- * Description: Copies all edited data from temporary file back to original file, replacing old content
- * Parameters: editinfo - pointer to EditInfo structure
- * Return: Status (e_success/e_failure)
- *
- * Process:
- * 1. Rewind both file pointers to beginning
- * 2. Copy byte-by-byte from temp to original
- * 3. Original file now contains edited data
- */
-Status copy_data_from_temp_to_original_file(EditInfo *editInfo)
-{
-  rewind(editInfo->fptr_original); // Move original file pointer to the beginning of the file
-
-  rewind(editInfo->fptr_temp); // Move temporary file pointer to the beginning of the file
-
-  char ch; // Variable to store one byte at a time
-
-  while (fread(&ch, 1, 1, editInfo->fptr_temp) == 1) // Read one byte at a time from temporary file until end of file
-  {
-
-    fwrite(&ch, 1, 1, editInfo->fptr_original); // Write each byte to original file (overwriting old content)
-  }
-  if (ftell(editInfo->fptr_original) == ftell(editInfo->fptr_temp)) // Verify both file pointers are at the same position after copying
-  {
-    return e_success; // Return success if positions match
-  }
-  printf("\033[1;91mCopying remaining data failed\033[1;97m\n");
-  return e_failure; // Return failure if copying all data back to original file failed
-}
\ No newline at end of file
+#include <stdio.h>  // Header file for standard input/output functions (fopen, fread, fwrite, fseek, ftell, rewind, etc.)
+#include <string.h> // Header file for string manipulation functions (strcmp, strcpy, strlen, strstr, etc.)
+#include <stdlib.h> // Header file for memory allocation and utility functions (malloc, free, tmpfile, etc.)
+#include <errno.h>  // Header file for errno (kept across cleanup so callers can report the cause)
+#include <unistd.h> // Header file for POSIX functions (ftruncate, pread, pwrite, close, unlink)
+#include "type.h"   // User-defined header file for custom type definitions (Status, e_success, e_failure)
+#include "edit.h"   // User-defined header file for EditInfo structure and function declarations
+#include "copy.h"   // User-defined header file for block copy engine (copy_stream_data)
+#include "id3.h"    // User-defined header file for ID3v2 header/frame parsing (in-place edit)
+#include "commit.h" // User-defined header file for atomic write-new-and-rename commit
+#include "frames.h" // User-defined header file for the frame registry (frame ID -> field)
+#include "trailer.h" // User-defined header file for the trailer probe and ID3v1 patching
+#include "text.h"   // User-defined header file for text encoding (encoding byte chosen per value)
+#include "mp3tag.h" // Library header file for Mp3TagError and the phase hook
+
+/*
+ * Function: init_edit_info
+ * Description: Clears every selected field, buffer and file pointer of an EditInfo structure
+ * Parameters: editInfo - pointer to EditInfo structure
+ * Return: void
+ */
+void init_edit_info(EditInfo *editInfo)
+{
+  memset(editInfo, 0, sizeof(*editInfo)); // No fields selected, no buffers, no files open
+}
+
+/*
+ * Function: set_edit_field
+ * Description: Stores a copy of the new content for one field
+ * Parameters: editInfo - pointer to EditInfo structure, field - field to change, value - new content
+ * Return: Status (e_success/e_failure)
+ */
+Status set_edit_field(EditInfo *editInfo, TagField field, const char *value)
+{
+  char *copy = malloc((strlen(value) + 1) * sizeof(char)); // Allocate memory for user-provided content (new tag value) based on its length
+
+  if (copy == NULL) // Error handling: allocation failed
+  {
+    editInfo->error = e_mp3tag_memory;
+    return e_failure;
+  }
+  strcpy(copy, value); // Copy user-provided content to allocated memory
+
+  if (editInfo->user_content[field] == NULL) // First value for this field
+  {
+    editInfo->edit_count++; // One more field changed in this rewrite
+  }
+  free(editInfo->user_content[field]);   // A repeated flag replaces the earlier value
+  editInfo->user_content[field] = copy;  // Store new content
+  return e_success;
+}
+
+/*
+ * Function: open_file
+ * Description: Opens original MP3 file in read-write mode (temporary file is created later, only if a full rewrite is needed)
+ * Parameters: editInfo - pointer to EditInfo structure
+ * Return: Status (e_success/e_failure)
+ */
+Status open_file(EditInfo *editInfo)
+{
+
+  editInfo->fptr_original = fopen(editInfo->original_fname, "r+"); // Open source MP3 file (e.g., sample.mp3) in read and write mode (r+)
+  editInfo->fptr_temp = NULL;                                       // No temporary file yet (in-place edits never need one)
+  editInfo->temp_fname = NULL;                                      // No temporary file name yet
+  editInfo->real_fname = NULL;                                      // Original path resolved only for rename commits
+
+  if (editInfo->fptr_original == NULL) // Error handling: Check if original file pointer is NULL (file opening failed)
+  {
+    editInfo->error = e_mp3tag_io; // errno holds the cause
+    return e_failure;              // Return failure status
+  }
+
+  return e_success; // Return success if original file opened successfully
+}
+
+/*
+ * Function: open_temp_file
+ * Description: Creates the temporary file used when the edited tag does not fit and the whole file must be rewritten
+ * Parameters: editInfo - pointer to EditInfo structure
+ * Return: Status (e_success/e_failure)
+ */
+Status open_temp_file(EditInfo *editInfo)
+{
+  int fd_temp; // Descriptor of the temporary file created beside the original
+
+  editInfo->temp_fname = NULL; // No named temporary file yet
+  editInfo->real_fname = NULL; // Original path not resolved yet
+
+  // Preferred: new file in the same directory, later renamed over the original (crash-atomic, single copy of the data)
+  if (editInfo->original_fname != NULL && commit_can_rename(fileno(editInfo->fptr_original)) &&
+      commit_create_temp(editInfo->original_fname, &editInfo->temp_fname, &editInfo->real_fname, &fd_temp) == e_success)
+  {
+    editInfo->fptr_temp = fdopen(fd_temp, "w+"); // Wrap descriptor in a stream for the frame writers
+
+    if (editInfo->fptr_temp != NULL)
+    {
+      return e_success; // Return success if temporary file created beside the original
+    }
+    close(fd_temp);                  // Error handling: fdopen failed, discard the temporary file
+    unlink(editInfo->temp_fname);    // Remove it from the directory
+    free(editInfo->temp_fname);      // Free temporary path
+    free(editInfo->real_fname);      // Free resolved original path
+    editInfo->temp_fname = NULL;
+    editInfo->real_fname = NULL;
+  }
+
+  /**
+   * INFO:
+   * Fallback when the directory is not writable or the file has several hard links:
+   * tmpfile() creates and opens a temporary file in read-write mode automatically.
+   * The file is deleted automatically when closed or when the program ends.
+   * Its content is copied back over the original by copy_data_from_temp_to_original_file().
+   */
+  editInfo->fptr_temp = tmpfile();
+
+  if (editInfo->fptr_temp == NULL) // Error handling: Check if temporary file could not be created
+  {
+    return e_failure; // Return failure status (errno holds the cause)
+  }
+  return e_success; // Return success if temporary file created successfully
+}
+
+/*
+ * Function: commit_edited_file
+ * Description: Makes the fully written temporary file the new content of the original file
+ * Parameters: editInfo - pointer to EditInfo structure
+ * Return: Status (e_success/e_failure)
+ *
+ * Commit modes:
+ * 1. Rename: temporary file beside the original is renamed over it (mode, owner and xattrs preserved)
+ * 2. Copy-back: temporary content is copied over the original (anonymous tmpfile(), or an owner/group the
+ *    editing user cannot give to a new file)
+ */
+Status commit_edited_file(EditInfo *editInfo)
+{
+  if (editInfo->temp_fname == NULL) // Anonymous temporary file: only copy-back is possible
+  {
+    return copy_data_from_temp_to_original_file(editInfo);
+  }
+
+  if (fflush(editInfo->fptr_temp) == EOF) // Push buffered frame data into the temporary file
+  {
+    return e_failure; // Temporary file is removed by close_all_file
+  }
+
+  if (commit_take_owner(fileno(editInfo->fptr_original), fileno(editInfo->fptr_temp)) == e_failure) // Owner/group cannot be kept
+  {
+    unlink(editInfo->temp_fname); // Content stays readable through fptr_temp
+    free(editInfo->temp_fname);
+    editInfo->temp_fname = NULL;
+    return copy_data_from_temp_to_original_file(editInfo); // The original inode keeps its owner
+  }
+
+  Status status = commit_by_rename(fileno(editInfo->fptr_original), fileno(editInfo->fptr_temp), editInfo->temp_fname, editInfo->real_fname);
+
+  free(editInfo->temp_fname);  // Temporary name is gone (renamed or removed)
+  editInfo->temp_fname = NULL; // Nothing left to clean up
+  return status;
+}
+
+/*
+ * Function: prepare_insert_tag
+ * Description: Sets up an empty ID3v2.3 tag for a file that has no ID3v2 tag, so the edit appends every selected
+ *              field and inserts the new tag at the start; only files with trailer tags are edited this way
+ * Parameters: editInfo - pointer to EditInfo structure (trailer probed), corrupt - 1 if an undecodable ID3v2 header is present
+ * Return: Status (e_failure with e_mp3tag_no_tag when there is no tag to start from)
+ */
+static Status prepare_insert_tag(EditInfo *editInfo, int corrupt)
+{
+  if (editInfo->trailer.found == 0 || corrupt) // No tag at all, or a corrupt ID3v2 header
+  {
+    editInfo->error = e_mp3tag_no_tag;
+    return e_failure;
+  }
+
+  memset(&editInfo->header, 0, sizeof(editInfo->header)); // Empty ID3v2.3 tag: every selected field is appended
+  editInfo->header.major = 3;
+  editInfo->tag = malloc(1);
+  editInfo->insert_tag = 1;
+  if (editInfo->tag == NULL)
+  {
+    editInfo->error = e_mp3tag_memory;
+    return e_failure;
+  }
+  return e_success;
+}
+
+/*
+ * Function: read_tag_for_edit
+ * Description: Loads the 10-byte header and the whole tag region of the original file with two preads, and probes
+ *              the trailer tags with one read of the file tail. A file with only trailer tags gets an empty
+ *              ID3v2.3 tag that the edit fills and inserts at the start.
+ * Parameters: editInfo - pointer to EditInfo structure
+ * Return: Status (e_success/e_failure)
+ */
+Status read_tag_for_edit(EditInfo *editInfo)
+{
+  int fd = fileno(editInfo->fptr_original); // Original file
+
+  if (trailer_probe(fd, &editInfo->trailer) == e_failure) // Error handling: tail of the file unreadable
+  {
+    return e_failure;
+  }
+
+  if (id3_read_tag(fd, &editInfo->header, &editInfo->tag) == e_success) // Header + whole tag
+  {
+    return e_success; // Tag loaded into memory
+  }
+
+  unsigned char magic[3]; // First bytes of the file
+  int corrupt = (pread(fd, magic, 3, 0) == 3 && memcmp(magic, "ID3", 3) == 0); // ID3v2 header that does not decode
+  return prepare_insert_tag(editInfo, corrupt);
+}
+
+/*
+ * Function: update_id3v1
+ * Description: Writes the selected values into the ID3v1 block of the file, if it has one, so both tags agree
+ * Parameters: editInfo - pointer to EditInfo structure, fd - file holding the block, offset - offset of the block
+ * Return: Status (e_success/e_failure)
+ */
+static Status update_id3v1(EditInfo *editInfo, int fd, off_t offset)
+{
+  if (!(editInfo->trailer.found & TRAILER_ID3V1)) // No ID3v1 block: nothing to update
+  {
+    return e_success;
+  }
+
+  trailer_patch_id3v1(&editInfo->trailer, editInfo->user_content); // Fixed-width fields, truncated
+  if (pwrite(fd, editInfo->trailer.id3v1, ID3V1_SIZE, offset) != ID3V1_SIZE)
+  {
+    return e_failure; // errno holds the write error
+  }
+  return e_success;
+}
+
+/*
+ * Function: build_frame
+ * Description: Writes a complete text frame for one field (header + encoding byte + text) into a buffer,
+ *              using the frame ID and size encoding of the tag version
+ * Parameters: field - field being written, content - new text (UTF-8), flags - two frame flag bytes to keep,
+ *             major - major version of the tag, out - output buffer
+ * Return: size_t - number of bytes written
+ *
+ * Frame structure:
+ * - 4 bytes: Tag identifier (e.g., TIT2, TPE1; 3 bytes in ID3v2.2)
+ * - 4 bytes: Size (big-endian in v2.3, synchsafe in v2.4; 3 bytes in v2.2)
+ * - 2 bytes: Flags (absent in v2.2)
+ * - 1 byte:  Encoding (0 = ISO-8859-1 when the text fits, else 3 = UTF-8 in v2.4, 1 = UTF-16 with BOM before)
+ * - COMM only: 3-byte language + empty description terminator (two bytes in UTF-16)
+ * - N bytes: Content
+ */
+static size_t build_frame(TagField field, const char *content, const unsigned char *flags, unsigned char major, unsigned char *out)
+{
+  unsigned char encoding = text_choose_encoding(content, major);  // Smallest encoding that holds the text
+  size_t terminator = (encoding == TEXT_UTF16) ? 2 : 1;           // Size of the empty COMM description
+  size_t prefix = (field == e_comment) ? 4 + terminator : 1;      // Encoding byte (+ language + description terminator for COMM)
+  size_t header = (major == 2) ? ID3_V22_FRAME_HEADER_SIZE : ID3_FRAME_HEADER_SIZE; // Frame header size of this version
+  unsigned char *p = out + header;                                // Start of the frame body
+  size_t body = prefix + text_encode(content, encoding, p + prefix); // Content first: the size depends on the encoding
+  const char *id = id3_field_frame_id(field, major);              // Frame identifier of this version
+
+  if (major == 2) // ID3v2.2: 3-byte ID + 3-byte size, no flags
+  {
+    memcpy(out, id, 3);
+    out[3] = (body >> 16) & 0xFF;
+    out[4] = (body >> 8) & 0xFF;
+    out[5] = body & 0xFF;
+  }
+  else
+  {
+    memcpy(out, id, 4);                                          // Frame identifier
+    if (major >= 4)
+    {
+      id3_syncsafe_encode((unsigned int)body, out + 4);          // Frame body size (synchsafe since v2.4)
+    }
+    else
+    {
+      id3_be32_encode((unsigned int)body, out + 4);              // Frame body size (big-endian)
+    }
+    out[8] = flags[0];                                           // Status flags
+    out[9] = 0x00;                                               // Format flags: the new body is plain (no compression, unsync, ...)
+  }
+
+  p[0] = encoding; // Encoding byte
+  if (field == e_comment)
+  {
+    memcpy(p + 1, "eng", 3);      // Language "eng"
+    memset(p + 4, 0, terminator); // Empty description
+  }
+  return header + body; // Total frame size
+}
+
+/*
+ * Function: compare_tag
+ * Description: Compares each frame in the tag with the selected fields in a single pass and builds the new frame list
+ * Parameters: editInfo - pointer to EditInfo structure
+ * Return: Status (e_success/e_failure)
+ *
+ * Process:
+ * 1. Every frame is walked once with the walker of the tag version (any number of frames, in any order)
+ * 2. The first frame of each selected field is replaced with the new content, other frames are copied as-is
+ * 3. Selected fields that have no frame yet are appended at the end
+ * 4. The extended header, whole-tag unsynchronisation and the v2.4 footer are not carried over (relayout)
+ */
+Status compare_tag(EditInfo *editInfo)
+{
+  static const unsigned char no_flags[2] = {0, 0}; // Flags for newly appended frames
+  size_t capacity = editInfo->header.tag_size;    // Worst case: every old frame kept ...
+  int written[TAG_FIELD_COUNT] = {0};             // Set once a field has been written
+  Id3TagView view;                                // Version-specific layout of the original tag
+
+  for (int i = 0; i < TAG_FIELD_COUNT; i++) // ... plus one new frame per selected field
+  {
+    if (editInfo->user_content[i] != NULL)
+    {
+      capacity += ID3_FRAME_HEADER_SIZE + 6 + TEXT_ENCODED_MAX(strlen(editInfo->user_content[i])); // Header + COMM prefix + worst-case UTF-16
+    }
+  }
+
+  if (id3_tag_open(&editInfo->header, editInfo->tag, editInfo->header.tag_size, &view) == e_failure) // Unknown version or corrupt layout
+  {
+    editInfo->error = e_mp3tag_unsupported;
+    return e_failure;
+  }
+
+  unsigned char major = editInfo->header.major;                  // Version the rebuilt frames are written in
+  int tag_unsync = (major >= 4) && (editInfo->header.flags & ID3_FLAG_UNSYNC); // v2.4: move the header flag onto every kept frame
+  editInfo->relayout = view.owned != NULL || view.start != 0 || tag_unsync || id3_tag_end(&editInfo->header) != ID3_HEADER_SIZE + editInfo->header.tag_size;
+
+  editInfo->new_tag = malloc(capacity ? capacity : 1); // Buffer for the rebuilt frames
+  editInfo->new_len = 0;                               // Nothing written yet
+
+  if (editInfo->new_tag == NULL) // Error handling: allocation failed
+  {
+    editInfo->error = e_mp3tag_memory;
+    id3_tag_close(&view);
+    return e_failure;
+  }
+
+  size_t pos = view.start; // Read offset inside the original tag (after the extended header)
+  Id3Frame frame;          // Current frame
+
+  while (view.next(view.data, view.len, &pos, &frame)) // Walk every frame until padding or end of tag
+  {
+    const FrameHandler *handler = id3_frame_handler(frame.id32); // Registry lookup (O(1), no string compares)
+    int field = -1;                                                // Selected field this frame belongs to
+
+    if (handler != NULL && editInfo->user_content[handler->field] != NULL && !written[handler->field]) // First frame of a selected field
+    {
+      field = handler->field;
+    }
+
+    if (field != -1) // Selected field: write it with the new content
+    {
+      editInfo->new_len += build_frame((TagField)field, editInfo->user_content[field], frame.flags, major, editInfo->new_tag + editInfo->new_len);
+      written[field] = 1; // Only the first matching frame is edited
+    }
+    else // Not selected: copy the frame unchanged
+    {
+      memcpy(editInfo->new_tag + editInfo->new_len, view.data + frame.offset, frame.length);
+      if (tag_unsync) // Body stays unsynchronised: say so in the frame's own format flags
+      {
+        editInfo->new_tag[editInfo->new_len + 9] |= ID3_FRAME_V24_UNSYNC;
+      }
+      editInfo->new_len += frame.length;
+    }
+  }
+  id3_tag_close(&view);
+
+  for (int i = 0; i < TAG_FIELD_COUNT; i++) // Append selected fields the file did not have yet
+  {
+    if (editInfo->user_content[i] != NULL && !written[i])
+    {
+      editInfo->new_len += build_frame((TagField)i, editInfo->user_content[i], no_flags, major, editInfo->new_tag + editInfo->new_len);
+    }
+  }
+  return e_success; // New frame list ready
+}
+
+/*
+ * Function: edit_tag_in_place
+ * Description: Rewrites only the tag region of the original file when the rebuilt frames still fit inside the
+ *              tag size declared in the 10-byte header (frames + padding). Audio data is never read or written.
+ * Parameters: editInfo - pointer to EditInfo structure
+ * Return: Status (e_success if edited in place, e_failure if a full rewrite is required)
+ *
+ * Process:
+ * 1. Zero-fill the rest of the tag region as padding
+ * 2. Compare with the original tag and pwrite only the byte range that changed
+ */
+Status edit_tag_in_place(EditInfo *editInfo)
+{
+  size_t tag_size = editInfo->header.tag_size; // Space available for frames + padding
+
+  if (editInfo->relayout || editInfo->new_len > tag_size) // Tag layout changes or rebuilt frames do not fit: a full rewrite is needed
+  {
+    return e_failure;
+  }
+
+  unsigned char *region = realloc(editInfo->new_tag, tag_size ? tag_size : 1); // Grow rebuilt frames to the full tag region
+  if (region == NULL)
+  {
+    return e_failure;
+  }
+  editInfo->new_tag = region;
+  memset(region + editInfo->new_len, 0, tag_size - editInfo->new_len); // Remaining bytes become padding
+
+  size_t first = 0, last = tag_size; // Range of bytes that actually changed
+
+  while (first < last && editInfo->tag[first] == region[first]) // Skip the unchanged prefix
+  {
+    first++;
+  }
+  while (last > first && editInfo->tag[last - 1] == region[last - 1]) // Skip the unchanged suffix
+  {
+    last--;
+  }
+
+  if (last != first && pwrite(fileno(editInfo->fptr_original), region + first, last - first, ID3_HEADER_SIZE + first) != (ssize_t)(last - first))
+  {
+    return e_failure; // Write error: the full rewrite is tried instead
+  }
+  return e_success; // Edit completed without touching the audio
+}
+
+/*
+ * Function: build_tag_header
+ * Description: Fills the 10-byte ID3v2 header of the rebuilt tag: same version, layout flags that were dropped cleared
+ * Parameters: editInfo - pointer to EditInfo structure, tag_size - frames + padding after the header, arr - 10-byte output
+ * Return: void
+ */
+static void build_tag_header(const EditInfo *editInfo, size_t tag_size, unsigned char *arr)
+{
+  memcpy(arr, "ID3", 3);                                          // Identifier
+  arr[3] = editInfo->header.major;                                // Keep version
+  arr[4] = editInfo->header.revision;
+  arr[5] = editInfo->header.flags & ~(ID3_FLAG_UNSYNC | ID3_FLAG_EXTENDED | ID3_FLAG_FOOTER); // Keep flags except the dropped layout
+  id3_syncsafe_encode((unsigned int)tag_size, arr + 6);           // New tag size
+}
+
+/*
+ * Function: padded_tag_size
+ * Description: Size of a newly written tag: the rebuilt frames plus the padding chosen by the policy
+ * Parameters: editInfo - pointer to EditInfo structure (new_len, pad_mode, pad_amount)
+ * Return: size_t - frames + padding, at most ID3_TAG_SIZE_MAX
+ */
+static size_t padded_tag_size(const EditInfo *editInfo)
+{
+  size_t frames = editInfo->new_len; // Bytes of the rebuilt frames
+  size_t padding = 0;                // Zero bytes reserved for later edits
+
+  switch (editInfo->pad_mode)
+  {
+  case e_mp3tag_pad_bytes:
+    padding = editInfo->pad_amount;
+    break;
+  case e_mp3tag_pad_percent:
+    padding = frames * editInfo->pad_amount / 100;
+    break;
+  case e_mp3tag_pad_align: // Audio then starts on a block boundary
+    padding = (editInfo->pad_amount - (ID3_HEADER_SIZE + frames) % editInfo->pad_amount) % editInfo->pad_amount;
+    break;
+  default: // e_mp3tag_pad_none: tag ends with its last frame
+    break;
+  }
+
+  if (frames >= ID3_TAG_SIZE_MAX || padding > ID3_TAG_SIZE_MAX - frames) // Size must fit the 28-bit header field
+  {
+    return (frames > ID3_TAG_SIZE_MAX) ? frames : ID3_TAG_SIZE_MAX;
+  }
+  return frames + padding;
+}
+
+/*
+ * Function: copy_header_edit
+ * Description: Writes the 10-byte ID3v2 header with the new tag size, followed by the rebuilt frames and the padding chosen
+ *              by the policy, to the temporary file
+ * Parameters: editInfo - pointer to EditInfo structure
+ * Return: Status (e_success/e_failure)
+ *
+ * ID3v2 Header structure (10 bytes):
+ * - 3 bytes: "ID3" identifier
+ * - 2 bytes: Version (major.minor)
+ * - 1 byte:  Flags
+ * - 4 bytes: Tag size (synchsafe integer)
+ */
+Status copy_header_edit(EditInfo *editInfo)
+{
+  static const unsigned char zeros[4096]; // Source of the padding bytes
+  unsigned char arr[ID3_HEADER_SIZE];     // Array to store 10-byte ID3v2 header
+  size_t tag_size = padded_tag_size(editInfo); // Rebuilt frames + padding policy
+
+  build_tag_header(editInfo, tag_size, arr); // Header with the size of the new tag
+
+  fwrite(arr, 1, ID3_HEADER_SIZE, editInfo->fptr_temp);                      // Write the 10-byte header to temporary file
+  fwrite(editInfo->new_tag, 1, editInfo->new_len, editInfo->fptr_temp);      // Write all rebuilt frames after it
+  for (size_t left = tag_size - editInfo->new_len; left > 0;)                // Then the padding
+  {
+    size_t chunk = (left < sizeof(zeros)) ? left : sizeof(zeros);
+    if (fwrite(zeros, 1, chunk, editInfo->fptr_temp) != chunk)
+    {
+      break; // Short write: caught by the position check below
+    }
+    left -= chunk;
+  }
+
+  if (ftell(editInfo->fptr_temp) == (long)(ID3_HEADER_SIZE + tag_size)) // Verify header, frames and padding were written completely
+  {
+    return e_success; // Return success if positions match
+  }
+  return e_failure; // Return failure if writing the tag failed
+}
+
+/*
+ * Function: copy_remaining_data
+ * Description: Copies the audio data following the original tag into the temporary file through the copy engine
+ * Parameters: editInfo - pointer to EditInfo structure
+ * Return: Status (e_success/e_failure)
+ */
+Status copy_remaining_data(EditInfo *editInfo)
+{
+  if (fflush(editInfo->fptr_temp) == EOF) // Push the buffered tag into the temporary file first
+  {
+    return e_failure;
+  }
+
+  off_t audio_start = editInfo->insert_tag ? 0 : (off_t)id3_tag_end(&editInfo->header); // Audio starts right after the original tag (and v2.4 footer)
+  off_t dest_offset = ftell(editInfo->fptr_temp);                          // Audio goes right after the new tag
+
+  if (copy_fd_range(fileno(editInfo->fptr_original), audio_start, fileno(editInfo->fptr_temp), dest_offset, COPY_TO_EOF, NULL) == e_failure)
+  {
+    return e_failure; // Return failure if the copy engine could not copy the data
+  }
+
+  fseek(editInfo->fptr_temp, 0, SEEK_END); // Keep the stream position at the end of the copied data
+  return e_success;                        // Return success after copying all remaining data
+}
+
+/*
+ * Function: close_all_file
+ * Description: Closes all open file pointers and frees allocated memory
+ * Parameters: editInfo - pointer to EditInfo structure
+ * Return: Status (implied success)
+ */
+Status close_all_file(EditInfo *editInfo)
+{
+  int saved = errno; // Cleanup must not hide the cause of a failed edit
+
+  for (int i = 0; i < TAG_FIELD_COUNT; i++) // Free memory allocated for user content
+  {
+    free(editInfo->user_content[i]);
+    editInfo->user_content[i] = NULL;
+  }
+  free(editInfo->tag);     // Free original tag region
+  trailer_free(&editInfo->trailer); // Free trailer values
+  free(editInfo->new_tag); // Free rebuilt frames
+  editInfo->tag = NULL;
+  editInfo->new_tag = NULL;
+
+  if (editInfo->fptr_temp != NULL) // Temporary file only exists when a full rewrite was needed
+  {
+    fclose(editInfo->fptr_temp); // Close temporary file pointer
+  }
+  if (editInfo->temp_fname != NULL) // Edit did not reach the commit: remove the half-written file beside the original
+  {
+    unlink(editInfo->temp_fname);
+    free(editInfo->temp_fname);
+  }
+  free(editInfo->real_fname); // Free resolved original path (NULL when never resolved)
+  editInfo->fptr_temp = NULL;
+  editInfo->temp_fname = NULL;
+  editInfo->real_fname = NULL;
+  if (editInfo->fptr_original != NULL) // Original file is not open when open_file failed
+  {
+    fclose(editInfo->fptr_original); // Close original file pointer
+    editInfo->fptr_original = NULL;
+  }
+
+  errno = saved;
+  return e_success;
+}
+
+/*
+ * Function: edit_phase
+ * Description: Tells the caller's phase hook, if any, that a step of the edit starts or stops
+ * Parameters: editInfo - pointer to EditInfo structure, phase - step, end - 0 at the start, 1 at the stop
+ * Return: void
+ */
+static void edit_phase(const EditInfo *editInfo, Mp3TagPhase phase, int end)
+{
+  if (editInfo->phase_hook != NULL)
+  {
+    editInfo->phase_hook(editInfo->phase_context, phase, end);
+  }
+}
+
+/*
+ * Function: edit_file_tags
+ * Description: Applies every selected field to one file without printing progress (shared by -e and batch mode)
+ * Parameters: editInfo - pointer to EditInfo structure (original_fname and user_content set)
+ * Return: Status (e_success/e_failure)
+ */
+Status edit_file_tags(EditInfo *editInfo)
+{
+  edit_phase(editInfo, e_mp3tag_phase_open, 0);
+  Status status = open_file(editInfo); // Open original file (r+)
+  edit_phase(editInfo, e_mp3tag_phase_open, 1);
+  if (status == e_failure)
+  {
+    close_all_file(editInfo); // Free the selected field values
+    return e_failure;         // Return failure if file opening fails
+  }
+  return edit_open_file_tags(editInfo);
+}
+
+/*
+ * Function: apply_edit
+ * Description: Load, rebuild and write steps of an edit of the already open original file; closes everything
+ * Parameters: editInfo - pointer to EditInfo structure
+ * Return: Status (e_success/e_failure)
+ */
+static Status apply_edit(EditInfo *editInfo)
+{
+  edit_phase(editInfo, e_mp3tag_phase_header, 0);
+  Status status = read_tag_for_edit(editInfo); // Load header, whole tag and trailer tags
+  edit_phase(editInfo, e_mp3tag_phase_header, 1);
+  if (status == e_success)
+  {
+    edit_phase(editInfo, e_mp3tag_phase_walk, 0);
+    status = compare_tag(editInfo); // Apply all changes in memory in one pass over the frames
+    edit_phase(editInfo, e_mp3tag_phase_walk, 1);
+  }
+  if (status == e_failure)
+  {
+    close_all_file(editInfo); // Close original file and free allocated memory
+    return e_failure;         // Return failure if tag loading/editing fails
+  }
+
+  edit_phase(editInfo, e_mp3tag_phase_commit, 0); // An in-place attempt that falls back to a full rewrite is charged here too
+  if (edit_tag_in_place(editInfo) == e_success) // Edited frames fit in the existing tag + padding: only the tag was rewritten
+  {
+    status = update_id3v1(editInfo, fileno(editInfo->fptr_original), editInfo->trailer.id3v1_offset); // Keep ID3v1 in step
+    edit_phase(editInfo, e_mp3tag_phase_commit, 1);
+
+    close_all_file(editInfo); // Close original file and free allocated memory
+    return status;            // Return success without copying any audio data
+  }
+  edit_phase(editInfo, e_mp3tag_phase_commit, 1);
+
+  edit_phase(editInfo, e_mp3tag_phase_open, 0);
+  status = open_temp_file(editInfo); // Tag does not fit: create temporary file for a full rewrite
+  edit_phase(editInfo, e_mp3tag_phase_open, 1);
+  if (status == e_failure)
+  {
+    close_all_file(editInfo); // Close original file and free allocated memory
+    return e_failure;         // Return failure if temporary file cannot be created
+  }
+
+  edit_phase(editInfo, e_mp3tag_phase_copy, 0);
+  if (copy_header_edit(editInfo) == e_failure || copy_remaining_data(editInfo) == e_failure ||
+      update_id3v1(editInfo, fileno(editInfo->fptr_temp), ftell(editInfo->fptr_temp) - ID3V1_SIZE) == e_failure) // New header + frames, audio, then ID3v1 (always the last 128 bytes)
+  {
+    edit_phase(editInfo, e_mp3tag_phase_copy, 1);
+    close_all_file(editInfo); // Close files and remove the unfinished temporary file
+    return e_failure;         // Return failure if writing the new file fails
+  }
+  edit_phase(editInfo, e_mp3tag_phase_copy, 1);
+
+  edit_phase(editInfo, e_mp3tag_phase_commit, 0);
+  status = commit_edited_file(editInfo); // Rename new file over the original (or copy back as fallback)
+  edit_phase(editInfo, e_mp3tag_phase_commit, 1);
+
+  close_all_file(editInfo); // Close all files and free allocated memory
+  return status;            // Return success if all edit operations are done successfully
+}
+
+/*
+ * Function: edit_open_file_tags
+ * Description: Applies every selected field to editInfo->fptr_original (already open read-write)
+ * Parameters: editInfo - pointer to EditInfo structure
+ * Return: Status (e_success/e_failure; editInfo->error tells why, e_mp3tag_io with errno set by default)
+ */
+Status edit_open_file_tags(EditInfo *editInfo)
+{
+  Status status = apply_edit(editInfo);
+
+  if (status == e_failure && editInfo->error == e_mp3tag_ok) // Failures without a more precise reason are I/O errors
+  {
+    editInfo->error = e_mp3tag_io;
+  }
+  return status;
+}
+
+/*
+ * Function: edit_buffer_tags
+ * Description: Applies every selected field to a file image in memory and builds the edited image: the rebuilt frames
+ *              keep the old tag size when they fit (padding reused), the audio and trailer tags are copied after them
+ *              and an ID3v1 block gets the same values
+ * Parameters: editInfo - pointer to EditInfo structure (user_content set), data / len - original image,
+ *             out / out_len - receive the malloc'd edited image
+ * Return: Status (e_success/e_failure; editInfo->error tells why)
+ */
+Status edit_buffer_tags(EditInfo *editInfo, const unsigned char *data, size_t len, unsigned char **out, size_t *out_len)
+{
+  Status status = e_failure;
+
+  trailer_probe_buffer(data, len, &editInfo->trailer); // Every trailer block is inside the image
+  if (len >= ID3_HEADER_SIZE && id3_parse_header(data, &editInfo->header) == e_success && id3_tag_end(&editInfo->header) <= len)
+  {
+    editInfo->tag = malloc(editInfo->header.tag_size ? editInfo->header.tag_size : 1); // Own copy, like the file path
+    if (editInfo->tag != NULL)
+    {
+      memcpy(editInfo->tag, data + ID3_HEADER_SIZE, editInfo->header.tag_size);
+      status = e_success;
+    }
+    else
+    {
+      editInfo->error = e_mp3tag_memory;
+    }
+  }
+  else
+  {
+    status = prepare_insert_tag(editInfo, len >= 3 && memcmp(data, "ID3", 3) == 0);
+  }
+  if (status == e_success)
+  {
+    status = compare_tag(editInfo); // Same one-pass rebuild as a file edit
+  }
+
+  if (status == e_success)
+  {
+    size_t tag_size = (!editInfo->relayout && editInfo->new_len <= editInfo->header.tag_size) ? editInfo->header.tag_size : padded_tag_size(editInfo); // Keep padding when it still fits
+    size_t audio_start = editInfo->insert_tag ? 0 : id3_tag_end(&editInfo->header);                                                          // First byte after the old tag
+    size_t total = ID3_HEADER_SIZE + tag_size + (len - audio_start);
+    unsigned char *image = malloc(total);
+
+    if (image != NULL)
+    {
+      build_tag_header(editInfo, tag_size, image);
+      memcpy(image + ID3_HEADER_SIZE, editInfo->new_tag, editInfo->new_len);
+      memset(image + ID3_HEADER_SIZE + editInfo->new_len, 0, tag_size - editInfo->new_len); // Padding
+      memcpy(image + ID3_HEADER_SIZE + tag_size, data + audio_start, len - audio_start);     // Audio and trailer tags
+      if (editInfo->trailer.found & TRAILER_ID3V1) // Keep ID3v1 in step (always the last 128 bytes)
+      {
+        trailer_patch_id3v1(&editInfo->trailer, editInfo->user_content);
+        memcpy(image + total - ID3V1_SIZE, editInfo->trailer.id3v1, ID3V1_SIZE);
+      }
+      *out = image;
+      *out_len = total;
+    }
+    else
+    {
+      editInfo->error = e_mp3tag_memory;
+      status = e_failure;
+    }
+  }
+  close_all_file(editInfo); // Free the selected values and both tag buffers
+  return status;
+}
+
+/**
+ * --------------------------------------------------------------------------------------
+ * INFO: COPY ENTIRE DATA FROM TEMPORARY FILE TO ORIGINAL FILE
+ * --------------------------------------------------------------------------------------
+ * This function overwrites the original file with the edited content from temp file
+ */
+
+/*
+ * Function: copy_data_from_temp_to_original_file
+ * Description: Copies all edited data from temporary file back to original file, replacing old content
+ * Parameters: editinfo - pointer to EditInfo structure
+ * Return: Status (e_success/e_failure)
+ *
+ * Process:
+ * 1. Rewind both file pointers to beginning
+ * 2. Copy temp into original in large blocks through the copy engine
+ * 3. Truncate original to the new length (edited file may be shorter than before)
+ */
+Status copy_data_from_temp_to_original_file(EditInfo *editInfo)
+{
+  rewind(editInfo->fptr_original); // Move original file pointer to the beginning of the file
+
+  rewind(editInfo->fptr_temp); // Move temporary file pointer to the beginning of the file
+
+  if (copy_stream_data(editInfo->fptr_temp, editInfo->fptr_original) == e_success) // Copy whole temp file over the original in blocks
+  {
+    fflush(editInfo->fptr_original); // Make sure no stdio data is pending before truncating
+
+    if (ftruncate(fileno(editInfo->fptr_original), ftell(editInfo->fptr_original)) == 0) // Drop stale bytes left over from a longer original
+    {
+      return e_success; // Return success if original now matches temp exactly
+    }
+  }
+  return e_failure; // Return failure if copying all data back to original file failed
+}
@@ -1,109 +1,159 @@
-#ifndef EDIT_H // If not defined EDIT_H ---> Checks if EDIT_H was previously defined: If not present, code is processed; else code below till #endif is ignored
-#define EDIT_H // Defines the macro EDIT_H if macro was not previously defined
-
-#include <stdio.h> // Header file for standard input and output (printf(), scanf(), fopen(), fread(), fwrite(), etc.)
-#include "type.h"  // User-defined header file for custom type definitions (Status, e_success, e_failure)
-
-// Structure to store MP3 file edit information including tag data, file pointers, and user input
-typedef struct // typedef used to give alternate name for structure here
-{
-  char *TAG;             // Pointer to store current tag identifier (e.g., "TIT2", "TPE1", "TALB", etc.)
-  char *mode;            // Pointer to store edit mode/operation type
-  int old_size;          // Integer to store the original size of the tag being edited
-  char *user_content;    // Pointer to store new content provided by user for tag modification
-  int user_content_size; // Integer to store the size/length of user-provided content
-  char user_tag[8];      // Character array to store user-specified tag identifier (up to 7 chars + null terminator)
-  char *original_fname;  // Pointer to store original MP3 filename (e.g., sample.mp3)
-  FILE *fptr_original;   // File pointer to access original MP3 file for reading
-  FILE *fptr_temp;       // File pointer to access temporary file for writing modified data
-} EditInfo;              // EditInfo is alternate name for this structure
-
-/**
- * FUNCTION: read_and_validate_for_edit
- * DESCRIPTION: Reads and validates command-line arguments for edit operation, checks for valid tag and .mp3 file
- * PARAMETERS: argv[] - command-line argument vector, editInfo - pointer to EditInfo structure
- * RETURN: Status (e_success/e_failure)
- */
-Status read_and_validate_for_edit(char *argv[], EditInfo *editInfo);
-
-/*
- * Function: open_file
- * Description: Opens original MP3 file in read mode and temporary file in write mode for editing
- * Parameters: editInfo - pointer to EditInfo structure containing file information
- * Return: Status (e_success/e_failure)
- */
-Status open_file(EditInfo *editInfo);
-
-/*
- * Function: do_edit_tags
- * Description: Main orchestration function to perform complete tag editing operation on MP3 file
- * Parameters: editInfo - pointer to EditInfo structure
- * Return: Status (e_success/e_failure)
- */
-Status do_edit_tags(EditInfo *editInfo);
-
-/*
- * Function: copy_header_edit
- * Description: Copies ID3 header (first 10 bytes) from original file to temporary file
- * Parameters: editInfo - pointer to EditInfo structure
- * Return: Status (e_success/e_failure)
- */
-Status copy_header_edit(EditInfo *editInfo);
-
-/*
- * Function: convert_big_to_little_endian_for_edit
- * Description: Converts 4-byte integer from big-endian to little-endian format for size calculation
- * Parameters: arr - pointer to integer array containing bytes to be converted
- * Return: void
- */
-void convert_big_to_little_endian_for_edit(int *arr);
-
-/*
- * Function: tag_edit
- * Description: Edits/replaces the content of a specific tag with user-provided content
- * Parameters: editInfo - pointer to EditInfo structure containing tag and new content information
- * Return: Status (e_success/e_failure)
- */
-Status tag_edit(EditInfo *editInfo);
-
-/*
- * Function: skip_tag
- * Description: Skips/copies a tag without modification when it doesn't match the target tag
- * Parameters: editInfo - pointer to EditInfo structure (note: parameter name has typo "editInfoeditinfo")
- * Return: Status (e_success/e_failure)
- */
-Status skip_tag(EditInfo *editInfoeditinfo);
-
-/*
- * Function: compare_tag
- * Description: Compares current tag identifier with user-specified tag to determine edit or skip operation
- * Parameters: editInfo - pointer to EditInfo structure
- * Return: Status (e_success/e_failure)
- */
-Status compare_tag(EditInfo *editInfo);
-
-/*
- * Function: copy_remaining_data
- * Description: Copies all remaining data (including audio frames) from original file to temporary file after tag editing
- * Parameters: editInfo - pointer to EditInfo structure
- * Return: Status (e_success/e_failure)
- */
-Status copy_remaining_data(EditInfo *editInfo);
-
-/*
- * Function: copy_data_from_temp_to_original_file
- * Description: Copies edited data from temporary file back to original file, replacing old content
- * Parameters: editInfo - pointer to EditInfo structure
- * Return: Status (e_success/e_failure)
- */
-Status copy_data_from_temp_to_original_file(EditInfo *editInfo);
-
-/*
- * Function: close_all_file
- * Description: Closes all open file pointers (original and temporary files) and performs cleanup
- * Parameters: editInfo - pointer to EditInfo structure
- * Return: Status (e_success/e_failure)
- */
-Status close_all_file(EditInfo *editInfo);
-
+#ifndef EDIT_H // If not defined EDIT_H ---> Checks if EDIT_H was previously defined: If not present, code is processed; else code below till #endif is ignored
+#define EDIT_H // Defines the macro EDIT_H if macro was not previously defined
+
+#include <stdio.h> // Header file for standard input and output (printf(), scanf(), fopen(), fread(), fwrite(), etc.)
+#include <stddef.h> // Header file for size_t
+#include "type.h"  // User-defined header file for custom type definitions (Status, e_success, e_failure)
+#include "id3.h"   // User-defined header file for ID3v2 header/frame parsing (Id3Header, TagField)
+#include "trailer.h" // User-defined header file for trailer tags (the ID3v1 block is updated with the same values)
+#include "mp3tag.h"  // Library header file for Mp3TagError (reason of a failed edit)
+
+// Structure to store MP3 file edit information including tag data, file pointers, and user input
+typedef struct // typedef used to give alternate name for structure here
+{
+  char *user_content[TAG_FIELD_COUNT]; // New content per field provided by user (NULL = leave field unchanged)
+  int edit_count;                      // Number of fields being changed in this single rewrite
+  Id3Header header;                    // Decoded 10-byte ID3v2 header of the original file
+  unsigned char *tag;                  // Original tag region (frames + padding) loaded with one read
+  unsigned char *new_tag;              // Rebuilt frames with every requested change applied
+  size_t new_len;                      // Length of the rebuilt frames in bytes
+  int relayout;                        // 1 when the extended header, unsynchronisation or footer is dropped (full rewrite only)
+  int insert_tag;                      // 1 when the file only had trailer tags: a new ID3v2.3 tag is inserted at the start
+  Mp3TagPadMode pad_mode;              // Padding reserved when a new tag is written (none by default)
+  size_t pad_amount;                   // Bytes, percent of the frames or block size of pad_mode
+  TrailerInfo trailer;                 // Tags at the end of the original file (probed with one read)
+  char *original_fname;                // Pointer to store original MP3 filename (e.g., sample.mp3)
+  FILE *fptr_original;                 // File pointer to access original MP3 file for reading
+  FILE *fptr_temp;                     // File pointer to access temporary file for writing modified data
+  char *temp_fname;                    // Path of the temporary file beside the original (NULL for an anonymous tmpfile)
+  char *real_fname;                    // Resolved path of the original file that the temporary file is renamed over
+  Mp3TagError error;                   // Reason of a failed edit (nothing is printed by the edit engine)
+  Mp3TagPhaseHook phase_hook;          // Told about each step of the edit (NULL = none; the CLI times them for --stats)
+  void *phase_context;                 // Passed to phase_hook
+} EditInfo;                            // EditInfo is alternate name for this structure
+
+/*
+ * Function: init_edit_info
+ * Description: Resets an EditInfo structure so that no field is selected and no file is open
+ * Parameters: editInfo - pointer to EditInfo structure
+ * Return: void
+ */
+void init_edit_info(EditInfo *editInfo);
+
+/*
+ * Function: set_edit_field
+ * Description: Selects one field for editing with its new content (a later value for the same field replaces the earlier one)
+ * Parameters: editInfo - pointer to EditInfo structure, field - field to change, value - new content
+ * Return: Status (e_success/e_failure)
+ */
+Status set_edit_field(EditInfo *editInfo, TagField field, const char *value);
+
+/*
+ * Function: open_file
+ * Description: Opens original MP3 file in read-write mode for editing
+ * Parameters: editInfo - pointer to EditInfo structure containing file information
+ * Return: Status (e_success/e_failure)
+ */
+Status open_file(EditInfo *editInfo);
+
+/*
+ * Function: open_temp_file
+ * Description: Creates the temporary file used when the whole MP3 file has to be rewritten
+ * Parameters: editInfo - pointer to EditInfo structure
+ * Return: Status (e_success/e_failure)
+ */
+Status open_temp_file(EditInfo *editInfo);
+
+/*
+ * Function: edit_tag_in_place
+ * Description: Writes only the changed bytes of the tag region when the rebuilt frames fit in the existing tag size plus padding
+ * Parameters: editInfo - pointer to EditInfo structure
+ * Return: Status (e_success if edited in place, e_failure if a full rewrite is required)
+ */
+Status edit_tag_in_place(EditInfo *editInfo);
+
+/*
+ * Function: edit_file_tags
+ * Description: Applies all selected fields to one file (load tag, rebuild frames, in-place write or full rewrite)
+ *              without printing anything; safe to call from several threads on different files
+ * Parameters: editInfo - pointer to EditInfo structure
+ * Return: Status (e_success/e_failure; editInfo->error tells why)
+ */
+Status edit_file_tags(EditInfo *editInfo);
+
+/*
+ * Function: edit_open_file_tags
+ * Description: Same as edit_file_tags for an original file the caller already opened (editInfo->fptr_original,
+ *              read-write); without original_fname a full rewrite is copied back instead of renamed
+ * Parameters: editInfo - pointer to EditInfo structure
+ * Return: Status (e_success/e_failure; editInfo->error tells why)
+ */
+Status edit_open_file_tags(EditInfo *editInfo);
+
+/*
+ * Function: edit_buffer_tags
+ * Description: Applies all selected fields to a whole file held in memory and returns the edited image
+ * Parameters: editInfo - pointer to EditInfo structure, data / len - original image (not modified),
+ *             out / out_len - receive the malloc'd edited image (caller frees)
+ * Return: Status (e_success/e_failure; editInfo->error tells why)
+ */
+Status edit_buffer_tags(EditInfo *editInfo, const unsigned char *data, size_t len, unsigned char **out, size_t *out_len);
+
+/*
+ * Function: read_tag_for_edit
+ * Description: Loads the ID3v2 header and the whole tag region of the original file (two reads)
+ * Parameters: editInfo - pointer to EditInfo structure
+ * Return: Status (e_success/e_failure)
+ */
+Status read_tag_for_edit(EditInfo *editInfo);
+
+/*
+ * Function: compare_tag
+ * Description: Walks every frame once, replaces the frames of all selected fields and appends selected fields that
+ *              are missing, producing the new frame list in editInfo->new_tag
+ * Parameters: editInfo - pointer to EditInfo structure
+ * Return: Status (e_success/e_failure)
+ */
+Status compare_tag(EditInfo *editInfo);
+
+/*
+ * Function: copy_header_edit
+ * Description: Writes the ID3v2 header (with the new tag size) and the rebuilt frames to the temporary file
+ * Parameters: editInfo - pointer to EditInfo structure
+ * Return: Status (e_success/e_failure)
+ */
+Status copy_header_edit(EditInfo *editInfo);
+
+/*
+ * Function: copy_remaining_data
+ * Description: Copies all audio data after the original tag from original file to temporary file (copy engine)
+ * Parameters: editInfo - pointer to EditInfo structure
+ * Return: Status (e_success/e_failure)
+ */
+Status copy_remaining_data(EditInfo *editInfo);
+
+/*
+ * Function: copy_data_from_temp_to_original_file
+ * Description: Copies edited data from temporary file back to original file, replacing old content
+ * Parameters: editInfo - pointer to EditInfo structure
+ * Return: Status (e_success/e_failure)
+ */
+Status copy_data_from_temp_to_original_file(EditInfo *editInfo);
+
+/*
+ * Function: commit_edited_file
+ * Description: Replaces the original file with the temporary file (atomic rename, or copy-back as a fallback)
+ * Parameters: editInfo - pointer to EditInfo structure
+ * Return: Status (e_success/e_failure)
+ */
+Status commit_edited_file(EditInfo *editInfo);
+
+/*
+ * Function: close_all_file
+ * Description: Closes all open file pointers (original and temporary files) and performs cleanup
+ * Parameters: editInfo - pointer to EditInfo structure
+ * Return: Status (e_success/e_failure)
+ */
+Status close_all_file(EditInfo *editInfo);
+
 #endif // End of header guard: Marks the end of conditional compilation block started by #ifndef EDIT_H
\ No newline at end of file
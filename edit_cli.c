@@ -0,0 +1,221 @@
+#include <stdio.h>    // Header file for standard input/output functions (printf)
+#include <string.h>   // Header file for string functions (strcmp, strncmp, strstr)
+#include <stdlib.h>   // Header file for strtoul
+#include "type.h"     // User-defined header file for custom type definitions (Status, e_success, e_failure)
+#include "id3.h"      // User-defined header file for TagField names and frame IDs (id3_field_names, id3_field_ids)
+#include "edit.h"     // User-defined header file for the edit engine (init_edit_info, set_edit_field, close_all_file)
+#include "mp3tag.h"   // Library header file used by the -e command (open, set frame, commit)
+#include "output.h"   // User-defined header file for output_tag_error (reason of a failed -e edit)
+#include "edit_cli.h" // User-defined header file for the -e command-line declarations
+
+/*
+ * Function: edit_take_padding
+ * Description: Removes --padding=... from argv and stores the policy for every edit of this run
+ * Parameters: argc - pointer to argument count, argv[] - argument array, padding - policy to fill
+ * Return: Status (e_success/e_failure)
+ */
+Status edit_take_padding(int *argc, char *argv[], EditPadding *padding)
+{
+  padding->mode = e_mp3tag_pad_none; // Default: rewritten tags keep no padding
+  padding->amount = 0;
+
+  for (int i = 1; i < *argc; i++) // Option may appear anywhere
+  {
+    if (strncmp(argv[i], "--padding=", 10) != 0)
+    {
+      continue;
+    }
+
+    const char *spec = argv[i] + 10; // none, BYTES, PERCENT% or align:BYTES
+    Mp3TagPadMode mode = e_mp3tag_pad_bytes;
+    const char *end = NULL;
+    unsigned long amount = 0;
+
+    if (strcmp(spec, "none") == 0)
+    {
+      mode = e_mp3tag_pad_none;
+      end = spec + 4; // Points at the terminating NUL
+    }
+    else
+    {
+      if (strncmp(spec, "align:", 6) == 0) // Round header + tag up to a block boundary
+      {
+        mode = e_mp3tag_pad_align;
+        spec += 6;
+      }
+      if (*spec >= '0' && *spec <= '9') // strtoul alone would accept signs and spaces
+      {
+        char *digits_end;
+        amount = strtoul(spec, &digits_end, 10);
+        end = digits_end;
+      }
+      if (end != NULL && *end == '%' && mode == e_mp3tag_pad_bytes) // Percentage of the frame bytes
+      {
+        mode = e_mp3tag_pad_percent;
+        end++;
+      }
+    }
+    unsigned long limit = (mode == e_mp3tag_pad_percent) ? MP3TAG_PAD_PERCENT_MAX : ID3_TAG_SIZE_MAX; // Same limits as mp3tag_set_padding
+    if (end == NULL || *end != '\0' || amount > limit || (mode == e_mp3tag_pad_align && amount == 0))
+    {
+      printf("\033[1;91mERROR: \033[1;97mUnknown padding %s (use none, BYTES, PERCENT%% or align:BYTES)\n", argv[i] + 10);
+      return e_failure;
+    }
+    padding->mode = mode;
+    padding->amount = amount;
+
+    for (int j = i; j < *argc; j++) // Remove the option so commands see their usual arguments (argv[argc] stays NULL)
+    {
+      argv[j] = argv[j + 1];
+    }
+    (*argc)--;
+    i--;
+  }
+  return e_success;
+}
+
+/*
+ * Function: edit_set_padding
+ * Description: Applies the --padding policy to a library handle
+ * Parameters: tag - handle about to be committed, padding - policy taken by edit_take_padding
+ * Return: Mp3TagError - result of mp3tag_set_padding
+ */
+Mp3TagError edit_set_padding(Mp3Tag *tag, const EditPadding *padding)
+{
+  return mp3tag_set_padding(tag, padding->mode, padding->amount);
+}
+
+/*
+ * Function: read_and_validate_for_edit
+ * Description: Reads and validates command-line arguments for edit operation, maps user flags to ID3v2.3 and ID3v2.4 tags
+ * Parameters: argc - argument count, argv[] - command-line argument array, editInfo - pointer to EditInfo structure
+ * Return: Status (e_success/e_failure)
+ *
+ * Any number of flag/value pairs may be given before the filename; all of them are applied in one rewrite.
+ *
+ * Flag mappings:
+ * -t : TITLE  (TIT2)
+ * -a : ARTIST (TPE1)
+ * -y : YEAR   (TYER)
+ * -A : ALBUM  (TALB)
+ * -g : GENRE  (TCON)
+ * -c : COMMENT(COMM)
+ */
+Status read_and_validate_for_edit(int argc, char *argv[], EditInfo *editInfo)
+{
+  static const char *const flags[TAG_FIELD_COUNT] = {"-t", "-a", "-A", "-y", "-g", "-c"}; // Command-line flag of every TagField
+
+  init_edit_info(editInfo); // Start with no fields selected
+
+  for (int i = 2; i + 1 < argc - 1; i += 2) // argv[i] = flag, argv[i + 1] = value; argv[argc - 1] = filename
+  {
+    int field = -1; // Field selected by this flag
+
+    for (int f = 0; f < TAG_FIELD_COUNT; f++) // Map flag to field
+    {
+      if (strcmp(argv[i], flags[f]) == 0)
+      {
+        field = f;
+        break;
+      }
+    }
+
+    if (field == -1) // Unknown flag
+    {
+      printf("\033[1;97mWrong TAG passed!\n"); // Print error message for invalid flag
+      return e_failure;                        // Return failure status
+    }
+
+    if (set_edit_field(editInfo, (TagField)field, argv[i + 1]) == e_failure) // Store new content for this field
+    {
+      return e_failure;
+    }
+  }
+
+  char *fname = argv[argc - 1]; // Last argument is the MP3 file
+
+  if (fname[0] != '.') // Validate that source filename doesn't start with '.' (hidden file or invalid format)
+  {
+    if (strstr(fname, ".mp3")) // Check if ".mp3" extension is present in the source filename
+    {
+      // Step 2: Store source MP3 filename in EditInfo structure
+      editInfo->original_fname = fname; // Copy source filename (e.g., sample.mp3)
+    }
+    else
+    {
+      printf("\033[1;91mERROR: \033[1;97mInvalid source file without .mp3 extension\n"); // Print error message if file doesn't have .mp3 extension
+      return e_failure;                                                                  // Return failure if .mp3 extension not found
+    }
+  }
+  else
+  {
+    printf("\033[1;91mERROR: \033[1;97mInvalid source file without filename\n"); // Print error message if filename starts with '.' (invalid filename)
+    return e_failure;                                                            // Return failure if filename starts with '.'
+  }
+
+  return e_success; // Return success if all validation conditions are met
+}
+
+/*
+ * Function: do_edit_tags
+ * Description: Main orchestration function for tag editing - coordinates all editing operations
+ * Parameters: editInfo - pointer to EditInfo structure
+ * Return: Status (e_success/e_failure)
+ *
+ * Workflow:
+ * 1. Display selected tags for editing
+ * 2. Tag library (mp3tag.h): open original file, stage every field, commit; the engine below loads the whole tag (two reads)
+ * 3. Apply every selected field in one pass over the frames
+ * 4. If the frames fit in the existing tag size, write only the tag region in place
+ * 5. Otherwise create temporary file (beside the original when possible), write header + frames, copy audio
+ * 6. Commit: rename the new file over the original, or copy it back as a fallback
+ * 7. Close all files and cleanup
+ */
+Status do_edit_tags(EditInfo *editInfo, const EditPadding *padding)
+{
+  for (int i = 0; i < TAG_FIELD_COUNT; i++) // Display which tags are selected for editing with green color formatting
+  {
+    if (editInfo->user_content[i] != NULL)
+    {
+      printf("\033[1;97mSELECTED FOR EDITING \033[1;92m%s\n", id3_field_names[i]);
+    }
+  }
+
+  Mp3Tag *tag = NULL; // Library handle of the file (opened read-write)
+  if (editInfo->phase_hook != NULL) // The library only reports the steps after the open
+  {
+    editInfo->phase_hook(editInfo->phase_context, e_mp3tag_phase_open, 0);
+  }
+  Mp3TagError error = mp3tag_open_file(editInfo->original_fname, 1, &tag);
+  if (editInfo->phase_hook != NULL)
+  {
+    editInfo->phase_hook(editInfo->phase_context, e_mp3tag_phase_open, 1);
+  }
+
+  if (error == e_mp3tag_ok)
+  {
+    error = edit_set_padding(tag, padding); // Padding reserved if the tag has to be rewritten
+  }
+  if (error == e_mp3tag_ok)
+  {
+    error = mp3tag_set_phase_hook(tag, editInfo->phase_hook, editInfo->phase_context); // Commit steps for --stats
+  }
+  for (int i = 0; i < TAG_FIELD_COUNT && error == e_mp3tag_ok; i++) // Stage every selected field
+  {
+    if (editInfo->user_content[i] != NULL)
+    {
+      error = mp3tag_set_frame(tag, id3_field_ids[i], editInfo->user_content[i]);
+    }
+  }
+  if (error == e_mp3tag_ok)
+  {
+    error = mp3tag_commit(tag); // All fields in one rewrite
+  }
+  if (error != e_mp3tag_ok)
+  {
+    output_tag_error(editInfo->original_fname, error); // Reason of the failure (the library never prints)
+  }
+  mp3tag_close(tag);
+  close_all_file(editInfo); // Free the selected field values
+  return (error == e_mp3tag_ok) ? e_success : e_failure;
+}
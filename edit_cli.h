@@ -0,0 +1,54 @@
+#ifndef EDIT_CLI_H // If not defined EDIT_CLI_H ---> Checks if EDIT_CLI_H was previously defined: If not present, code is processed; else code below till #endif is ignored
+#define EDIT_CLI_H // Defines the macro EDIT_CLI_H if macro was not previously defined
+
+#include "type.h"   // User-defined header file for custom type definitions (Status, e_success, e_failure)
+#include "edit.h"   // User-defined header file for EditInfo (filled from the command line)
+#include "mp3tag.h" // Library header file for Mp3Tag and Mp3TagError
+
+// Padding policy given with --padding (kept by main and handed to -e, -b and --serve)
+typedef struct // typedef used to give alternate name for structure here
+{
+  Mp3TagPadMode mode; // none (default), bytes, percent or align
+  size_t amount;      // Bytes, percent or block size of mode
+} EditPadding;        // EditPadding is alternate name for this structure
+
+/*
+ * Command-line side of tag editing (-e arguments, --padding, progress and error messages). The edit engine in edit.c
+ * never prints and keeps no process-wide state, so it can be linked into the library without this file.
+ */
+
+/**
+ * FUNCTION: read_and_validate_for_edit
+ * DESCRIPTION: Reads and validates command-line arguments for edit operation: any number of flag/value pairs followed
+ *              by one .mp3 file (e.g. -t "Title" -a "Artist" sample.mp3)
+ * PARAMETERS: argc - command-line argument count, argv[] - command-line argument vector, editInfo - pointer to EditInfo structure
+ * RETURN: Status (e_success/e_failure)
+ */
+Status read_and_validate_for_edit(int argc, char *argv[], EditInfo *editInfo);
+
+/*
+ * Function: edit_take_padding
+ * Description: Removes --padding=none|BYTES|PERCENT%|align:BYTES from argv and stores the policy of every tag this
+ *              run writes (-e, -b and --serve edits); padding is left at none when the option is absent
+ * Parameters: argc - pointer to argument count, argv[] - argument array, padding - policy to fill
+ * Return: Status (e_failure for an unknown or out-of-range value)
+ */
+Status edit_take_padding(int *argc, char *argv[], EditPadding *padding);
+
+/*
+ * Function: edit_set_padding
+ * Description: Applies a padding policy taken by edit_take_padding to a library handle
+ * Parameters: tag - handle opened for writing, padding - policy to apply
+ * Return: Mp3TagError - e_mp3tag_ok, or the error of mp3tag_set_padding
+ */
+Mp3TagError edit_set_padding(Mp3Tag *tag, const EditPadding *padding);
+
+/*
+ * Function: do_edit_tags
+ * Description: Main orchestration function to perform complete tag editing operation on MP3 file
+ * Parameters: editInfo - pointer to EditInfo structure, padding - --padding policy for a rewritten tag
+ * Return: Status (e_success/e_failure)
+ */
+Status do_edit_tags(EditInfo *editInfo, const EditPadding *padding);
+
+#endif // End of EDIT_CLI_H
@@ -0,0 +1,121 @@
+#include <pthread.h> // Header file for pthread_once (registry is built once, even with many scan workers)
+#include "id3.h"     // User-defined header file for Id3Frame and TagField
+#include "frames.h"  // User-defined header file for the frame registry declarations
+#include "text.h"    // User-defined header file for text encoding conversion to UTF-8
+
+/*
+ * Function: decode_text
+ * Description: Decodes a text frame (T***): encoding byte followed by the text, converted to UTF-8
+ * Parameters: frame - pointer to Id3Frame
+ * Return: char * - null-terminated UTF-8 text from arena_malloc
+ */
+static char *decode_text(const Id3Frame *frame)
+{
+  if (frame->size == 0) // Empty body
+  {
+    return text_to_utf8(TEXT_LATIN1, frame->body, 0);
+  }
+  return text_to_utf8(frame->body[0], frame->body + 1, frame->size - 1); // Encoding byte selects the decoder
+}
+
+/*
+ * Function: decode_comment
+ * Description: Decodes a COMM frame: encoding byte, 3-byte language, short description + terminator, then the comment
+ * Parameters: frame - pointer to Id3Frame
+ * Return: char * - null-terminated UTF-8 comment text from arena_malloc
+ */
+static char *decode_comment(const Id3Frame *frame)
+{
+  const unsigned char *text = frame->body;                // Start of frame body
+  size_t len = frame->size;                               // Bytes available
+  size_t skip = len < 4 ? len : 4;                        // Encoding byte + language code
+  unsigned char encoding = len > 0 ? frame->body[0] : 0; // Encoding of description and comment
+
+  text += skip;
+  len -= skip;
+
+  size_t desc = text_skip(encoding, text, len); // Short description and its terminator (two bytes in UTF-16)
+  return text_to_utf8(encoding, text + desc, len - desc);
+}
+
+// Registry of the frames the tool interprets (one entry per frame ID; add aliases or new fields here)
+static const FrameHandler frame_handlers[] = {
+    {ID3_FRAME_ID('T', 'I', 'T', '2'), e_title, decode_text},      // Title
+    {ID3_FRAME_ID('T', 'P', 'E', '1'), e_artist, decode_text},     // Lead artist
+    {ID3_FRAME_ID('T', 'A', 'L', 'B'), e_album, decode_text},      // Album
+    {ID3_FRAME_ID('T', 'Y', 'E', 'R'), e_year, decode_text},       // Year (ID3v2.3)
+    {ID3_FRAME_ID('T', 'C', 'O', 'N'), e_genre, decode_text},      // Genre
+    {ID3_FRAME_ID('C', 'O', 'M', 'M'), e_comment, decode_comment}, // Comment
+    {ID3_FRAME_ID('T', 'D', 'R', 'C'), e_year, decode_text},       // Recording time (ID3v2.4 replacement of TYER)
+    {ID3_FRAME_ID('T', 'T', '2', 0), e_title, decode_text},        // ID3v2.2 aliases: 3-byte IDs end with a zero byte
+    {ID3_FRAME_ID('T', 'P', '1', 0), e_artist, decode_text},
+    {ID3_FRAME_ID('T', 'A', 'L', 0), e_album, decode_text},
+    {ID3_FRAME_ID('T', 'Y', 'E', 0), e_year, decode_text},
+    {ID3_FRAME_ID('T', 'C', 'O', 0), e_genre, decode_text},
+    {ID3_FRAME_ID('C', 'O', 'M', 0), e_comment, decode_comment},
+};
+
+static const FrameHandler *registry[FRAME_REGISTRY_SLOTS]; // Hash table over frame_handlers (NULL = empty slot)
+static pthread_once_t registry_once = PTHREAD_ONCE_INIT;   // Guards the one-time build
+
+/*
+ * Function: registry_slot
+ * Description: Multiplicative hash of a frame ID into the registry
+ * Parameters: id - frame ID as an integer
+ * Return: unsigned int - home slot
+ */
+static unsigned int registry_slot(uint32_t id)
+{
+  return (unsigned int)((id * 0x9E3779B1u) >> 26) & (FRAME_REGISTRY_SLOTS - 1); // Top 6 bits of the product
+}
+
+/*
+ * Function: registry_build
+ * Description: Inserts every handler into the hash table (linear probing)
+ * Parameters: None
+ * Return: void
+ */
+static void registry_build(void)
+{
+  for (size_t i = 0; i < sizeof(frame_handlers) / sizeof(frame_handlers[0]); i++)
+  {
+    unsigned int slot = registry_slot(frame_handlers[i].id);
+
+    while (registry[slot] != NULL) // Collision: next slot
+    {
+      slot = (slot + 1) & (FRAME_REGISTRY_SLOTS - 1);
+    }
+    registry[slot] = &frame_handlers[i];
+  }
+}
+
+/*
+ * Function: id3_frame_handler
+ * Description: Returns the handler registered for a frame ID
+ * Parameters: id - frame ID as an integer
+ * Return: const FrameHandler * - handler or NULL
+ */
+const FrameHandler *id3_frame_handler(uint32_t id)
+{
+  pthread_once(&registry_once, registry_build); // Built on first use
+
+  for (unsigned int slot = registry_slot(id); registry[slot] != NULL; slot = (slot + 1) & (FRAME_REGISTRY_SLOTS - 1)) // Probe until an empty slot
+  {
+    if (registry[slot]->id == id)
+    {
+      return registry[slot];
+    }
+  }
+  return NULL; // Frame not interpreted by this tool
+}
+
+/*
+ * Function: id3_frame_id
+ * Description: Packs a 4-character frame ID string
+ * Parameters: id - frame ID string
+ * Return: uint32_t - integer ID
+ */
+uint32_t id3_frame_id(const char *id)
+{
+  return ID3_FRAME_ID(id[0], id[1], id[2], id[3]);
+}
@@ -0,0 +1,40 @@
+#ifndef FRAMES_H // If not defined FRAMES_H ---> Checks if FRAMES_H was previously defined: If not present, code is processed; else code below till #endif is ignored
+#define FRAMES_H // Defines the macro FRAMES_H if macro was not previously defined
+
+#include <stdint.h> // Header file for uint32_t (frame IDs as integers)
+#include "id3.h"    // User-defined header file for Id3Frame and TagField
+
+// Packs a 4-character frame ID ('T','I','T','2') into a 32-bit integer (same value as the big-endian ID bytes)
+#define ID3_FRAME_ID(a, b, c, d) (((uint32_t)(unsigned char)(a) << 24) | ((uint32_t)(unsigned char)(b) << 16) | ((uint32_t)(unsigned char)(c) << 8) | (uint32_t)(unsigned char)(d))
+
+#define FRAME_REGISTRY_SLOTS 64 // Hash table size of the registry (power of two, well above the number of handlers)
+
+// Function type decoding a frame body into a null-terminated string from arena_malloc (NULL on allocation failure)
+typedef char *(*FrameDecoder)(const Id3Frame *frame);
+
+// Structure to store how one frame ID is handled
+typedef struct // typedef used to give alternate name for structure here
+{
+  uint32_t id;         // Frame ID as an integer (ID3_FRAME_ID)
+  TagField field;      // Field the frame fills
+  FrameDecoder decode; // Body decoder
+} FrameHandler;        // FrameHandler is alternate name for this structure
+
+/*
+ * Function: id3_frame_handler
+ * Description: Looks up the handler of a frame ID in the registry with one hash probe sequence (O(1) per frame,
+ *              no string compares). Frames without a handler (TRCK, APIC, TXXX, ...) return NULL and are skipped.
+ * Parameters: id - frame ID as an integer (Id3Frame.id32)
+ * Return: const FrameHandler * - handler, or NULL for frames the tool does not interpret
+ */
+const FrameHandler *id3_frame_handler(uint32_t id);
+
+/*
+ * Function: id3_frame_id
+ * Description: Converts a 4-character frame ID string to its integer form
+ * Parameters: id - frame ID string ("TIT2")
+ * Return: uint32_t - integer ID
+ */
+uint32_t id3_frame_id(const char *id);
+
+#endif // End of header guard: Marks the end of conditional compilation block started by #ifndef FRAMES_H
@@ -0,0 +1,559 @@
+#include <stdio.h>    // Header file for standard input/output functions (printf, fprintf, flockfile)
+#include <stdlib.h>   // Header file for memory allocation functions (malloc, realloc, free, qsort)
+#include <string.h>   // Header file for string/memory functions (strcmp, strdup, memcpy)
+#include <fcntl.h>    // Header file for open(), O_RDONLY and posix_fadvise
+#include <unistd.h>   // Header file for POSIX I/O functions (pread, close)
+#include "type.h"     // User-defined header file for custom type definitions (Status, e_success, e_failure)
+#include "audio.h"    // User-defined header file for the audio region (audio_locate, audio_bounds)
+#include "scan.h"     // User-defined header file for the recursive path walk (scan_walk)
+#include "output.h"   // User-defined header file for JSON Lines / TSV output
+#include "pool.h"     // User-defined header file for the worker pool
+#include "hash.h"     // User-defined header file for HashInfo structure and function declarations
+
+#define XXH_PRIME1 0x9E3779B185EBCA87ULL // XXH64 constants
+#define XXH_PRIME2 0xC2B2AE3D27D4EB4FULL
+#define XXH_PRIME3 0x165667B19E3779F9ULL
+#define XXH_PRIME4 0x85EBCA77C2B2AE63ULL
+#define XXH_PRIME5 0x27D4EB2F165667C5ULL
+
+// Structure to store the running state of an XXH64 hash over data arriving in blocks
+typedef struct // typedef used to give alternate name for structure here
+{
+  uint64_t acc[4];         // Four lane accumulators
+  uint64_t total;          // Bytes hashed so far
+  unsigned char mem[32];   // Bytes of an incomplete 32-byte stripe
+  size_t mem_len;          // Bytes in mem
+} Xxh64;                   // Xxh64 is alternate name for this structure
+
+/*
+ * Function: rotl64
+ * Description: Rotates a 64-bit value left
+ * Parameters: x - value, r - bit count (1..63)
+ * Return: uint64_t - rotated value
+ */
+static uint64_t rotl64(uint64_t x, int r)
+{
+  return (x << r) | (x >> (64 - r));
+}
+
+/*
+ * Function: le64
+ * Description: Reads 8 little-endian bytes (compiles to one load on little-endian CPUs)
+ * Parameters: p - pointer to 8 bytes
+ * Return: uint64_t - decoded value
+ */
+static uint64_t le64(const unsigned char *p)
+{
+  return (uint64_t)p[0] | (uint64_t)p[1] << 8 | (uint64_t)p[2] << 16 | (uint64_t)p[3] << 24 |
+         (uint64_t)p[4] << 32 | (uint64_t)p[5] << 40 | (uint64_t)p[6] << 48 | (uint64_t)p[7] << 56;
+}
+
+/*
+ * Function: xxh_round
+ * Description: Mixes one 8-byte input into a lane accumulator
+ * Parameters: acc - accumulator, input - 8 input bytes as an integer
+ * Return: uint64_t - new accumulator
+ */
+static uint64_t xxh_round(uint64_t acc, uint64_t input)
+{
+  acc += input * XXH_PRIME2;
+  return rotl64(acc, 31) * XXH_PRIME1;
+}
+
+/*
+ * Function: xxh_stripes
+ * Description: Consumes whole 32-byte stripes (one 8-byte word per lane)
+ * Parameters: state - hash state, p - input, len - input length (a multiple of 32)
+ * Return: void
+ */
+static void xxh_stripes(Xxh64 *state, const unsigned char *p, size_t len)
+{
+  uint64_t a0 = state->acc[0], a1 = state->acc[1], a2 = state->acc[2], a3 = state->acc[3]; // Kept in registers
+
+  for (const unsigned char *end = p + len; p < end; p += 32)
+  {
+    a0 = xxh_round(a0, le64(p));
+    a1 = xxh_round(a1, le64(p + 8));
+    a2 = xxh_round(a2, le64(p + 16));
+    a3 = xxh_round(a3, le64(p + 24));
+  }
+  state->acc[0] = a0;
+  state->acc[1] = a1;
+  state->acc[2] = a2;
+  state->acc[3] = a3;
+}
+
+/*
+ * Function: xxh64_init
+ * Description: Starts an XXH64 hash with seed 0
+ * Parameters: state - hash state
+ * Return: void
+ */
+static void xxh64_init(Xxh64 *state)
+{
+  memset(state, 0, sizeof(*state));
+  state->acc[0] = XXH_PRIME1 + XXH_PRIME2;
+  state->acc[1] = XXH_PRIME2;
+  state->acc[2] = 0;
+  state->acc[3] = 0 - XXH_PRIME1;
+}
+
+/*
+ * Function: xxh64_update
+ * Description: Adds a block of input (any length)
+ * Parameters: state - hash state, p - input, len - input length
+ * Return: void
+ */
+static void xxh64_update(Xxh64 *state, const unsigned char *p, size_t len)
+{
+  state->total += len;
+
+  if (state->mem_len > 0) // Complete the stripe left by the previous block
+  {
+    size_t fill = 32 - state->mem_len;
+    if (len < fill)
+    {
+      memcpy(state->mem + state->mem_len, p, len);
+      state->mem_len += len;
+      return;
+    }
+    memcpy(state->mem + state->mem_len, p, fill);
+    xxh_stripes(state, state->mem, 32);
+    state->mem_len = 0;
+    p += fill;
+    len -= fill;
+  }
+
+  size_t whole = len & ~(size_t)31; // Whole stripes straight from the input
+  xxh_stripes(state, p, whole);
+  memcpy(state->mem, p + whole, len - whole); // Keep the rest for the next block
+  state->mem_len = len - whole;
+}
+
+/*
+ * Function: xxh64_digest
+ * Description: Finishes the hash (the state is not modified)
+ * Parameters: state - hash state
+ * Return: uint64_t - XXH64 value
+ */
+static uint64_t xxh64_digest(const Xxh64 *state)
+{
+  uint64_t h;
+  const unsigned char *p = state->mem;
+  const unsigned char *end = p + state->mem_len;
+
+  if (state->total >= 32) // Merge the four lanes
+  {
+    h = rotl64(state->acc[0], 1) + rotl64(state->acc[1], 7) + rotl64(state->acc[2], 12) + rotl64(state->acc[3], 18);
+    for (int i = 0; i < 4; i++)
+    {
+      h ^= xxh_round(0, state->acc[i]);
+      h = h * XXH_PRIME1 + XXH_PRIME4;
+    }
+  }
+  else // Short input: lanes were never used
+  {
+    h = XXH_PRIME5;
+  }
+  h += state->total;
+
+  for (; p + 8 <= end; p += 8) // Remaining words, half-words and bytes
+  {
+    h ^= xxh_round(0, le64(p));
+    h = rotl64(h, 27) * XXH_PRIME1 + XXH_PRIME4;
+  }
+  if (p + 4 <= end)
+  {
+    h ^= (uint64_t)((uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24) * XXH_PRIME1;
+    h = rotl64(h, 23) * XXH_PRIME2 + XXH_PRIME3;
+    p += 4;
+  }
+  for (; p < end; p++)
+  {
+    h ^= *p * XXH_PRIME5;
+    h = rotl64(h, 11) * XXH_PRIME1;
+  }
+
+  h ^= h >> 33; // Final avalanche
+  h *= XXH_PRIME2;
+  h ^= h >> 29;
+  h *= XXH_PRIME3;
+  h ^= h >> 32;
+  return h;
+}
+
+/*
+ * Function: read_and_validate_for_hash
+ * Description: Records the mode and the paths to hash
+ * Parameters: argc - argument count, argv[] - command-line argument array, haInfo - pointer to HashInfo structure
+ * Return: Status (e_success/e_failure)
+ */
+Status read_and_validate_for_hash(int argc, char *argv[], HashInfo *haInfo)
+{
+  memset(haInfo, 0, sizeof(*haInfo)); // No files yet
+
+  if (argc < 3) // Error handling: nothing to hash
+  {
+    printf("\033[1;91mERROR: \033[1;97mUsage: %s <dir|files...|->\n", argv[1]);
+    return e_failure;
+  }
+  haInfo->dupes = (strcmp(argv[1], "--dupes") == 0);
+  haInfo->paths = argv + 2;
+  haInfo->path_count = argc - 2;
+  return e_success;
+}
+
+/*
+ * Function: locate_audio
+ * Description: Finds the audio payload of an open file: first MPEG frame to trailer, or the whole region between
+ *              the tags when the data is not recognised as MPEG audio
+ * Parameters: fd - file descriptor, entry - receives audio_start and audio_bytes
+ * Return: Status (e_success/e_failure)
+ */
+static Status locate_audio(int fd, HashEntry *entry)
+{
+  AudioStream stream;
+  off_t start, end;
+
+  if (audio_locate(fd, &stream) == e_success)
+  {
+    start = stream.audio_start;
+    end = stream.audio_end;
+  }
+  else if (audio_bounds(fd, &start, &end) == e_failure)
+  {
+    return e_failure;
+  }
+  entry->audio_start = start;
+  entry->audio_bytes = end - start;
+  return e_success;
+}
+
+/*
+ * Function: hash_range
+ * Description: Hashes the located payload with large sequential reads
+ * Parameters: fd - file descriptor, entry - entry with audio_start/audio_bytes (hash and hashed are set)
+ * Return: Status (e_success/e_failure)
+ */
+static Status hash_range(int fd, HashEntry *entry)
+{
+  unsigned char *buf = malloc(HASH_READ_SIZE);
+  Xxh64 state;
+  off_t done = 0;
+
+  if (buf == NULL)
+  {
+    return e_failure;
+  }
+  posix_fadvise(fd, entry->audio_start, entry->audio_bytes, POSIX_FADV_SEQUENTIAL); // Larger kernel read-ahead
+
+  xxh64_init(&state);
+  while (done < entry->audio_bytes)
+  {
+    off_t left = entry->audio_bytes - done;
+    ssize_t n = pread(fd, buf, left < HASH_READ_SIZE ? (size_t)left : HASH_READ_SIZE, entry->audio_start + done);
+    if (n <= 0) // Error handling: read error or file shrank
+    {
+      free(buf);
+      return e_failure;
+    }
+    xxh64_update(&state, buf, (size_t)n);
+    done += n;
+  }
+  free(buf);
+
+  entry->hash = xxh64_digest(&state);
+  entry->hashed = 1;
+  return e_success;
+}
+
+/*
+ * Function: hash_audio
+ * Description: Opens a file, locates its audio payload and hashes it
+ * Parameters: path - file path, entry - receives audio_start, audio_bytes and hash
+ * Return: Status (e_success/e_failure)
+ */
+Status hash_audio(const char *path, HashEntry *entry)
+{
+  int fd = open(path, O_RDONLY);
+
+  if (fd == -1)
+  {
+    return e_failure;
+  }
+  Status status = (locate_audio(fd, entry) == e_success) ? hash_range(fd, entry) : e_failure;
+  close(fd);
+  return status;
+}
+
+/*
+ * Function: print_hash
+ * Description: Prints the hash of one file (group 0 = plain --hash listing, else the duplicate group number)
+ * Parameters: entry - hashed file, group - duplicate group
+ * Return: void
+ */
+static void print_hash(const HashEntry *entry, unsigned long group)
+{
+  char hex[17]; // 16 hex digits
+
+  snprintf(hex, sizeof(hex), "%016llx", (unsigned long long)entry->hash);
+  if (output_porcelain()) // JSON Lines / TSV record
+  {
+    output_hash(entry->path, hex, (unsigned long long)entry->audio_bytes, group);
+    return;
+  }
+
+  flockfile(stdout); // Keep the whole line together when several workers print
+  printf("\033[1;93m%s\033[0m  \033[1;92m%s\033[0m\n", hex, entry->path);
+  funlockfile(stdout);
+}
+
+/*
+ * Function: report_failure
+ * Description: Reports a file that could not be hashed
+ * Parameters: haInfo - pointer to HashInfo, path - file path
+ * Return: void
+ */
+static void report_failure(HashInfo *haInfo, const char *path)
+{
+  fprintf(stderr, "\033[1;91mERROR: \033[1;97m%s: unable to read audio\033[0m\n", path);
+  __atomic_add_fetch(&haInfo->files_failed, 1, __ATOMIC_RELAXED);
+}
+
+/*
+ * Function: hash_task
+ * Description: Worker task of --hash: hashes and prints one file
+ * Parameters: item - malloc'd HashEntry with its path, ctx - pointer to HashInfo
+ * Return: void
+ */
+static void hash_task(void *item, void *ctx)
+{
+  HashEntry *entry = item;
+
+  if (hash_audio(entry->path, entry) == e_success)
+  {
+    print_hash(entry, 0);
+    __atomic_add_fetch(&((HashInfo *)ctx)->files_hashed, 1, __ATOMIC_RELAXED);
+  }
+  else
+  {
+    report_failure(ctx, entry->path);
+  }
+  free(entry->path);
+  free(entry);
+}
+
+/*
+ * Function: locate_task
+ * Description: Worker task of the first --dupes pass: finds the payload length of one file and records it
+ * Parameters: item - malloc'd HashEntry with its path, ctx - pointer to HashInfo
+ * Return: void
+ */
+static void locate_task(void *item, void *ctx)
+{
+  HashInfo *haInfo = ctx;
+  HashEntry *entry = item;
+  int fd = open(entry->path, O_RDONLY);
+  Status status = (fd != -1) ? locate_audio(fd, entry) : e_failure;
+
+  if (fd != -1)
+  {
+    close(fd);
+  }
+  if (status == e_success)
+  {
+    pthread_mutex_lock(&haInfo->lock);
+    if (haInfo->entry_count == haInfo->entry_capacity) // Grow the list
+    {
+      size_t capacity = haInfo->entry_capacity ? haInfo->entry_capacity * 2 : 256;
+      HashEntry *grown = realloc(haInfo->entries, capacity * sizeof(HashEntry));
+      if (grown == NULL)
+      {
+        status = e_failure;
+      }
+      else
+      {
+        haInfo->entries = grown;
+        haInfo->entry_capacity = capacity;
+      }
+    }
+    if (status == e_success)
+    {
+      haInfo->entries[haInfo->entry_count++] = *entry; // The list now owns the path
+    }
+    pthread_mutex_unlock(&haInfo->lock);
+  }
+
+  if (status == e_failure)
+  {
+    report_failure(haInfo, entry->path);
+    free(entry->path);
+  }
+  free(entry);
+}
+
+/*
+ * Function: rehash_task
+ * Description: Worker task of the second --dupes pass: hashes one located file in place
+ * Parameters: item - HashEntry inside HashInfo.entries, ctx - pointer to HashInfo
+ * Return: void
+ */
+static void rehash_task(void *item, void *ctx)
+{
+  HashEntry *entry = item;
+  int fd = open(entry->path, O_RDONLY);
+
+  if (fd != -1 && hash_range(fd, entry) == e_success)
+  {
+    __atomic_add_fetch(&((HashInfo *)ctx)->files_hashed, 1, __ATOMIC_RELAXED);
+  }
+  else
+  {
+    report_failure(ctx, entry->path);
+  }
+  if (fd != -1)
+  {
+    close(fd);
+  }
+}
+
+/*
+ * Function: hash_visit
+ * Description: Walk callback: queues one file for the workers
+ * Parameters: path - file path, ctx - pointer to HashInfo
+ * Return: void
+ */
+static void hash_visit(const char *path, void *ctx)
+{
+  HashInfo *haInfo = ctx;
+  HashEntry *entry = calloc(1, sizeof(HashEntry)); // Worker owns and frees this entry
+
+  if (entry == NULL || (entry->path = strdup(path)) == NULL || pool_submit(&haInfo->pool, entry) == e_failure)
+  {
+    if (entry != NULL)
+    {
+      free(entry->path);
+    }
+    free(entry);
+    __atomic_add_fetch(&haInfo->files_failed, 1, __ATOMIC_RELAXED);
+  }
+}
+
+/*
+ * Function: compare_entries
+ * Description: qsort comparator: payload length, then hash, then path (duplicate groups become adjacent)
+ * Parameters: a, b - pointers to HashEntry
+ * Return: int - ordering
+ */
+static int compare_entries(const void *a, const void *b)
+{
+  const HashEntry *x = a;
+  const HashEntry *y = b;
+
+  if (x->audio_bytes != y->audio_bytes)
+  {
+    return x->audio_bytes < y->audio_bytes ? -1 : 1;
+  }
+  if (x->hashed != y->hashed || x->hash != y->hash)
+  {
+    return (x->hashed != y->hashed) ? x->hashed - y->hashed : (x->hash < y->hash ? -1 : 1);
+  }
+  return strcmp(x->path, y->path);
+}
+
+/*
+ * Function: report_dupes
+ * Description: Hashes the files that share a payload length with another file, then prints each group of
+ *              identical payloads
+ * Parameters: haInfo - pointer to HashInfo structure
+ * Return: void
+ */
+static void report_dupes(HashInfo *haInfo)
+{
+  HashEntry *e = haInfo->entries;
+  size_t n = haInfo->entry_count;
+  unsigned long groups = 0;          // Duplicate groups printed
+  unsigned long long wasted = 0;     // Bytes held by the extra copies
+
+  qsort(e, n, sizeof(HashEntry), compare_entries); // Equal lengths become adjacent
+
+  if (pool_start(&haInfo->pool, 0, 0, rehash_task, haInfo) == e_success) // Second pass: only lengths seen twice
+  {
+    for (size_t i = 0; i < n; i++)
+    {
+      int shared = (i > 0 && e[i - 1].audio_bytes == e[i].audio_bytes) || (i + 1 < n && e[i + 1].audio_bytes == e[i].audio_bytes);
+      if (shared && e[i].audio_bytes > 0)
+      {
+        pool_submit(&haInfo->pool, &e[i]);
+      }
+    }
+    pool_finish(&haInfo->pool);
+  }
+
+  qsort(e, n, sizeof(HashEntry), compare_entries); // Identical payloads become adjacent
+  for (size_t i = 0; i < n;)
+  {
+    size_t j = i + 1; // End of the run of identical payloads
+    while (j < n && e[i].hashed && e[j].hashed && e[j].audio_bytes == e[i].audio_bytes && e[j].hash == e[i].hash)
+    {
+      j++;
+    }
+    if (j - i > 1) // Duplicate group
+    {
+      groups++;
+      wasted += (unsigned long long)e[i].audio_bytes * (j - i - 1);
+      if (!output_porcelain())
+      {
+        printf("\033[1;97mDuplicate audio \033[1;93m%016llx\033[1;97m (%zu files, %lld bytes each)\033[0m\n", (unsigned long long)e[i].hash, j - i, (long long)e[i].audio_bytes);
+      }
+      for (size_t k = i; k < j; k++)
+      {
+        if (output_porcelain())
+        {
+          print_hash(&e[k], groups);
+        }
+        else
+        {
+          printf("  \033[1;92m%s\033[0m\n", e[k].path);
+        }
+      }
+    }
+    i = j;
+  }
+  fflush(stdout); // Groups before the summary
+  fprintf(stderr, "\033[1;97m%lu duplicate group(s), %llu byte(s) in extra copies\033[0m\n", groups, wasted);
+}
+
+/*
+ * Function: hash_library
+ * Description: Runs --hash or --dupes over every file of the given paths
+ * Parameters: haInfo - pointer to HashInfo structure
+ * Return: Status (e_success/e_failure)
+ */
+Status hash_library(HashInfo *haInfo)
+{
+  if (pthread_mutex_init(&haInfo->lock, NULL) != 0 ||
+      pool_start(&haInfo->pool, 0, 0, haInfo->dupes ? locate_task : hash_task, haInfo) == e_failure) // One worker per CPU
+  {
+    return e_failure;
+  }
+
+  unsigned long bad = scan_walk(haInfo->paths, haInfo->path_count, hash_visit, haInfo); // Command-line paths, then stdin
+  pool_finish(&haInfo->pool);                                                           // Wait for the last file
+  haInfo->files_failed += bad;
+
+  if (haInfo->dupes)
+  {
+    report_dupes(haInfo);
+    for (size_t i = 0; i < haInfo->entry_count; i++)
+    {
+      free(haInfo->entries[i].path);
+    }
+    free(haInfo->entries);
+  }
+  pthread_mutex_destroy(&haInfo->lock);
+
+  fflush(stdout); // Records before the summary
+  fprintf(stderr, "\033[1;97mHashed %lu file(s), %lu failed\033[0m\n", haInfo->files_hashed, haInfo->files_failed);
+  return haInfo->files_failed ? e_failure : e_success;
+}
@@ -0,0 +1,65 @@
+#ifndef HASH_H // If not defined HASH_H ---> Checks if HASH_H was previously defined: If not present, code is processed; else code below till #endif is ignored
+#define HASH_H // Defines the macro HASH_H if macro was not previously defined
+
+#include <stdint.h>    // Header file for fixed-width integers (uint64_t)
+#include <pthread.h>   // Header file for pthread_mutex_t (workers append results)
+#include <sys/types.h> // Header file for off_t
+#include "type.h"      // User-defined header file for custom type definitions (Status, e_success, e_failure)
+#include "pool.h"      // User-defined header file for the worker pool
+
+#define HASH_READ_SIZE (1024 * 1024) // Sequential read size while hashing the audio
+
+// Structure to store one hashed file
+typedef struct // typedef used to give alternate name for structure here
+{
+  char *path;        // File path
+  off_t audio_start; // Offset of the audio payload
+  off_t audio_bytes; // Length of the audio payload (tags excluded)
+  uint64_t hash;     // XXH64 of the audio payload
+  int hashed;        // 1 once hash is valid
+} HashEntry;         // HashEntry is alternate name for this structure
+
+// Structure to store the state of a --hash or --dupes run
+typedef struct // typedef used to give alternate name for structure here
+{
+  char **paths;                // Files and directories given on the command line ("-" = NUL-separated list on stdin)
+  int path_count;              // Number of entries in paths
+  int dupes;                   // 1 for the duplicate report, 0 to print every hash
+  WorkPool pool;               // Workers hashing files concurrently
+  HashEntry *entries;          // Located files (duplicate report only)
+  size_t entry_count;          // Number of entries in use
+  size_t entry_capacity;       // Number of entries allocated
+  pthread_mutex_t lock;        // Protects entries while workers append
+  unsigned long files_hashed;  // Files hashed (updated atomically by workers)
+  unsigned long files_failed;  // Files that could not be read
+} HashInfo;                    // HashInfo is alternate name for this structure
+
+/*
+ * Function: read_and_validate_for_hash
+ * Description: Stores the paths after --hash / --dupes (argv[1] selects the mode)
+ * Parameters: argc - argument count, argv[] - command-line argument array, haInfo - pointer to HashInfo structure
+ * Return: Status (e_success/e_failure)
+ */
+Status read_and_validate_for_hash(int argc, char *argv[], HashInfo *haInfo);
+
+/*
+ * Function: hash_audio
+ * Description: Computes the XXH64 of the audio payload of one file: from the first MPEG frame after the ID3v2 tag
+ *              up to the ID3v1 / APEv2 / Lyrics3v2 trailer, read sequentially in HASH_READ_SIZE blocks.
+ *              Retagging changes none of these bytes, so the hash stays the same.
+ * Parameters: path - file path, entry - receives audio_bytes and hash
+ * Return: Status (e_success/e_failure)
+ */
+Status hash_audio(const char *path, HashEntry *entry);
+
+/*
+ * Function: hash_library
+ * Description: --hash: prints the audio hash of every file (in parallel, in completion order).
+ *              --dupes: locates the audio of every file, hashes only files whose payload length is shared with
+ *              another file, then prints the groups of identical payloads.
+ * Parameters: haInfo - pointer to HashInfo structure
+ * Return: Status (e_failure if any file could not be read)
+ */
+Status hash_library(HashInfo *haInfo);
+
+#endif // End of header guard: Marks the end of conditional compilation block started by #ifndef HASH_H
@@ -0,0 +1,705 @@
+#include <stdlib.h> // Header file for memory allocation functions (malloc, free, etc.)
+#include <string.h> // Header file for string/memory functions (memcmp, memcpy, memchr, etc.)
+#include <strings.h> // Header file for strcasecmp
+#include <unistd.h> // Header file for POSIX I/O functions (pread)
+#include "type.h"   // User-defined header file for custom type definitions (Status, e_success, e_failure)
+#include "id3.h"    // User-defined header file for ID3v2 header and frame parsing declarations
+#include "frames.h" // User-defined header file for the frame registry (ID -> field + decoder)
+#include "arena.h"  // User-defined header file for the per-worker arena (parse buffers of bulk scans)
+
+const char *const id3_field_ids[TAG_FIELD_COUNT] = {"TIT2", "TPE1", "TALB", "TYER", "TCON", "COMM"};         // Frame ID for every TagField
+static const char *const v22_field_ids[TAG_FIELD_COUNT] = {"TT2", "TP1", "TAL", "TYE", "TCO", "COM"};       // ID3v2.2 frame ID for every TagField
+static const char *const v24_field_ids[TAG_FIELD_COUNT] = {"TIT2", "TPE1", "TALB", "TDRC", "TCON", "COMM"};  // ID3v2.4 replaced TYER by TDRC
+const char *const id3_field_names[TAG_FIELD_COUNT] = {"TITLE", "ARTIST", "ALBUM", "YEAR", "GENRE", "COMMENT"}; // Display name for every TagField
+
+/*
+ * Function: id3_field_lookup
+ * Description: Finds the TagField named by a display name ("title", any case) or a frame ID of any version ("TIT2", "TDRC", "TT2")
+ * Parameters: name - field name or frame ID
+ * Return: int - TagField index, or -1 if the name is unknown
+ */
+int id3_field_lookup(const char *name)
+{
+  for (int i = 0; i < TAG_FIELD_COUNT; i++) // Compare with every known field
+  {
+    if (strcasecmp(name, id3_field_names[i]) == 0 || strcmp(name, id3_field_ids[i]) == 0 ||
+        strcmp(name, v24_field_ids[i]) == 0 || strcmp(name, v22_field_ids[i]) == 0) // Name, or frame ID of any version
+    {
+      return i;
+    }
+  }
+  return -1; // Unknown field
+}
+
+/*
+ * Function: id3_field_frame_id
+ * Description: Picks the frame ID of a field from the ID table of the tag version
+ * Parameters: field - TagField, major - major version
+ * Return: const char * - frame ID
+ */
+const char *id3_field_frame_id(TagField field, unsigned char major)
+{
+  if (major == 2)
+  {
+    return v22_field_ids[field];
+  }
+  return (major >= 4) ? v24_field_ids[field] : id3_field_ids[field];
+}
+
+/*
+ * Function: id3_syncsafe_decode
+ * Description: Decodes a 4-byte synchsafe integer (bit 7 of every byte is zero)
+ * Parameters: p - pointer to 4 bytes
+ * Return: unsigned int - decoded value
+ */
+unsigned int id3_syncsafe_decode(const unsigned char *p)
+{
+  return ((unsigned int)(p[0] & 0x7F) << 21) | ((unsigned int)(p[1] & 0x7F) << 14) | ((unsigned int)(p[2] & 0x7F) << 7) | (unsigned int)(p[3] & 0x7F);
+}
+
+/*
+ * Function: id3_syncsafe_encode
+ * Description: Encodes an integer (< 2^28) as a 4-byte synchsafe integer
+ * Parameters: value - integer to encode, p - pointer to 4 output bytes
+ * Return: void
+ */
+void id3_syncsafe_encode(unsigned int value, unsigned char *p)
+{
+  p[0] = (value >> 21) & 0x7F; // Highest 7 bits
+  p[1] = (value >> 14) & 0x7F; // Next 7 bits
+  p[2] = (value >> 7) & 0x7F;  // Next 7 bits
+  p[3] = value & 0x7F;         // Lowest 7 bits
+}
+
+/*
+ * Function: id3_be32_decode
+ * Description: Decodes a 4-byte big-endian integer
+ * Parameters: p - pointer to 4 bytes
+ * Return: unsigned int - decoded value
+ */
+unsigned int id3_be32_decode(const unsigned char *p)
+{
+  return ((unsigned int)p[0] << 24) | ((unsigned int)p[1] << 16) | ((unsigned int)p[2] << 8) | (unsigned int)p[3];
+}
+
+/*
+ * Function: id3_be32_encode
+ * Description: Encodes an integer as 4 big-endian bytes
+ * Parameters: value - integer to encode, p - pointer to 4 output bytes
+ * Return: void
+ */
+void id3_be32_encode(unsigned int value, unsigned char *p)
+{
+  p[0] = (value >> 24) & 0xFF; // Most significant byte first
+  p[1] = (value >> 16) & 0xFF;
+  p[2] = (value >> 8) & 0xFF;
+  p[3] = value & 0xFF; // Least significant byte last
+}
+
+/*
+ * Function: id3_parse_header
+ * Description: Validates the "ID3" magic and decodes version, flags and tag size from the 10-byte header
+ * Parameters: buf - pointer to 10 header bytes, header - pointer to Id3Header to fill
+ * Return: Status (e_success/e_failure)
+ */
+Status id3_parse_header(const unsigned char *buf, Id3Header *header)
+{
+  if (memcmp(buf, "ID3", 3) != 0) // Validate the 3-byte "ID3" identifier
+  {
+    return e_failure; // Not an ID3v2 tag
+  }
+
+  if (buf[3] == 0xFF || buf[4] == 0xFF || (buf[6] | buf[7] | buf[8] | buf[9]) & 0x80) // Version bytes are never 0xFF and size bytes are synchsafe
+  {
+    return e_failure; // Corrupt header
+  }
+
+  header->major = buf[3];                             // Major version (e.g., 3 for ID3v2.3)
+  header->revision = buf[4];                          // Revision number
+  header->flags = buf[5];                             // Header flags
+  header->tag_size = id3_syncsafe_decode(buf + 6);    // Tag size is always stored as a synchsafe integer
+  return e_success;                                   // Header is valid
+}
+
+/*
+ * Function: frame_fits
+ * Description: Checks that a frame header of hdr bytes and a body of size bytes fit at *pos, and that *pos is not padding
+ * Parameters: tag_len - buffer length, pos - frame offset, first - first byte at pos, hdr - frame header size, size - body size
+ * Return: int - 1 if the frame fits
+ */
+static int frame_fits(size_t tag_len, size_t pos, unsigned char first, size_t hdr, unsigned int size)
+{
+  return first != 0 && size <= tag_len - pos - hdr; // Zero byte = padding; body must end inside the tag
+}
+
+/*
+ * Function: next_frame_v22
+ * Description: ID3v2.2 walker: 3-byte ID, 3-byte big-endian size, no flags
+ * Parameters: tag - tag buffer, tag_len - buffer length, pos - current offset, frame - Id3Frame to fill
+ * Return: 1 if a frame was produced, 0 at padding or end of tag
+ */
+static int next_frame_v22(const unsigned char *tag, size_t tag_len, size_t *pos, Id3Frame *frame)
+{
+  if (*pos + ID3_V22_FRAME_HEADER_SIZE > tag_len) // No room for another frame header
+  {
+    return 0;
+  }
+
+  const unsigned char *p = tag + *pos;                                                       // Start of the frame header
+  unsigned int size = ((unsigned int)p[3] << 16) | ((unsigned int)p[4] << 8) | (unsigned int)p[5]; // 24-bit body size
+
+  if (!frame_fits(tag_len, *pos, p[0], ID3_V22_FRAME_HEADER_SIZE, size)) // Padding reached or frame runs past the tag
+  {
+    return 0;
+  }
+
+  memcpy(frame->id, p, 3);                                                           // 3-byte frame identifier
+  frame->id[3] = '\0';                                                              // Null-terminate the identifier
+  frame->id32 = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8); // Integer form, last byte zero
+  frame->size = size;
+  frame->flags[0] = frame->flags[1] = 0;                   // ID3v2.2 frames have no flags
+  frame->body = p + ID3_V22_FRAME_HEADER_SIZE;             // Body follows the 6-byte header
+  frame->offset = *pos;
+  frame->length = ID3_V22_FRAME_HEADER_SIZE + size;
+  frame->unsync = 0;                                       // Unsynchronisation is tag-wide in v2.2 (already removed)
+  frame->opaque = 0;
+
+  *pos += frame->length; // Advance to the next frame header
+  return 1;
+}
+
+/*
+ * Function: next_frame_v23
+ * Description: ID3v2.3 walker: 4-byte ID, 32-bit big-endian size, two flag bytes
+ * Parameters: tag - tag buffer, tag_len - buffer length, pos - current offset, frame - Id3Frame to fill
+ * Return: 1 if a frame was produced, 0 at padding or end of tag
+ */
+static int next_frame_v23(const unsigned char *tag, size_t tag_len, size_t *pos, Id3Frame *frame)
+{
+  if (*pos + ID3_FRAME_HEADER_SIZE > tag_len) // No room for another frame header
+  {
+    return 0;
+  }
+
+  const unsigned char *p = tag + *pos;       // Start of the frame header
+  unsigned int size = id3_be32_decode(p + 4); // Frame body size (4 bytes, big-endian)
+
+  if (!frame_fits(tag_len, *pos, p[0], ID3_FRAME_HEADER_SIZE, size)) // Padding reached or frame runs past the tag
+  {
+    return 0; // Treat as end of frames rather than reading out of bounds
+  }
+
+  memcpy(frame->id, p, 4);                 // Copy the 4-byte frame identifier
+  frame->id[4] = '\0';                    // Null-terminate the identifier
+  frame->id32 = id3_be32_decode(p);        // Identifier as an integer for O(1) registry lookups
+  frame->flags[0] = p[8];                  // First flag byte (status flags)
+  frame->flags[1] = p[9];                  // Second flag byte (format flags)
+  frame->body = p + ID3_FRAME_HEADER_SIZE; // Body starts right after the frame header
+  frame->size = size;
+  frame->offset = *pos;                    // Remember where this frame starts
+  frame->length = ID3_FRAME_HEADER_SIZE + size;
+  frame->unsync = 0;                                                                   // Unsynchronisation is tag-wide in v2.3 (already removed)
+  frame->opaque = (p[9] & (ID3_FRAME_V23_COMPRESSED | ID3_FRAME_V23_ENCRYPTED)) != 0; // zlib or encrypted data cannot be decoded here
+
+  if ((p[9] & ID3_FRAME_V23_GROUPED) && !frame->opaque && frame->size >= 1) // Skip the group ID byte
+  {
+    frame->body++;
+    frame->size--;
+  }
+
+  *pos += frame->length; // Advance to the next frame header
+  return 1;              // Frame produced
+}
+
+/*
+ * Function: next_frame_v24_common
+ * Description: ID3v2.4 walker body: 4-byte ID, synchsafe size, two flag bytes with optional group ID and data length prefixes
+ * Parameters: tag - tag buffer, tag_len - buffer length, pos - current offset, frame - Id3Frame to fill,
+ *             tag_unsync - 1 when the header declares every frame unsynchronised
+ * Return: 1 if a frame was produced, 0 at padding or end of tag
+ */
+static inline int next_frame_v24_common(const unsigned char *tag, size_t tag_len, size_t *pos, Id3Frame *frame, int tag_unsync)
+{
+  if (*pos + ID3_FRAME_HEADER_SIZE > tag_len) // No room for another frame header
+  {
+    return 0;
+  }
+
+  const unsigned char *p = tag + *pos;             // Start of the frame header
+  unsigned int size = id3_syncsafe_decode(p + 4);  // Frame body size (4 bytes, synchsafe since v2.4)
+
+  if ((p[4] | p[5] | p[6] | p[7]) & 0x80 || !frame_fits(tag_len, *pos, p[0], ID3_FRAME_HEADER_SIZE, size)) // Corrupt size, padding or overrun
+  {
+    return 0;
+  }
+
+  unsigned char format = p[9]; // Format flags
+
+  memcpy(frame->id, p, 4);
+  frame->id[4] = '\0';
+  frame->id32 = id3_be32_decode(p);
+  frame->flags[0] = p[8];
+  frame->flags[1] = format;
+  frame->body = p + ID3_FRAME_HEADER_SIZE;
+  frame->size = size;
+  frame->offset = *pos;
+  frame->length = ID3_FRAME_HEADER_SIZE + size;
+  frame->unsync = tag_unsync || (format & ID3_FRAME_V24_UNSYNC); // Removed by id3_frame_data before decoding
+  frame->opaque = (format & (ID3_FRAME_V24_COMPRESSED | ID3_FRAME_V24_ENCRYPTED)) != 0;
+
+  size_t prefix = ((format & ID3_FRAME_V24_GROUPED) ? 1 : 0) + ((format & ID3_FRAME_V24_LENGTH) ? 4 : 0); // Group ID + data length indicator
+  if (!frame->opaque && prefix <= frame->size)
+  {
+    frame->body += prefix;
+    frame->size -= (unsigned int)prefix;
+  }
+
+  *pos += frame->length; // Advance to the next frame header
+  return 1;
+}
+
+/*
+ * Function: next_frame_v24 / next_frame_v24_unsync
+ * Description: ID3v2.4 walkers for tags without / with the header unsynchronisation flag
+ * Parameters: tag - tag buffer, tag_len - buffer length, pos - current offset, frame - Id3Frame to fill
+ * Return: 1 if a frame was produced, 0 at padding or end of tag
+ */
+static int next_frame_v24(const unsigned char *tag, size_t tag_len, size_t *pos, Id3Frame *frame)
+{
+  return next_frame_v24_common(tag, tag_len, pos, frame, 0);
+}
+
+static int next_frame_v24_unsync(const unsigned char *tag, size_t tag_len, size_t *pos, Id3Frame *frame)
+{
+  return next_frame_v24_common(tag, tag_len, pos, frame, 1);
+}
+
+/*
+ * Function: resync
+ * Description: Copies bytes while dropping the 0x00 inserted after every 0xFF by unsynchronisation
+ * Parameters: src - source bytes, len - source length, dst - destination (at least len bytes)
+ * Return: size_t - bytes written to dst
+ */
+static size_t resync(const unsigned char *src, size_t len, unsigned char *dst)
+{
+  size_t out = 0; // Bytes written
+
+  for (size_t i = 0; i < len; i++)
+  {
+    dst[out++] = src[i];
+    if (src[i] == 0xFF && i + 1 < len && src[i + 1] == 0x00) // Inserted zero: skip it
+    {
+      i++;
+    }
+  }
+  return out;
+}
+
+/*
+ * Function: id3_tag_open
+ * Description: Selects the walker of the tag version, undoes whole-tag unsynchronisation and skips the extended header
+ * Parameters: header - decoded header, tag - tag buffer, tag_len - buffer length, view - Id3TagView to fill
+ * Return: Status (e_success/e_failure)
+ */
+Status id3_tag_open(const Id3Header *header, const unsigned char *tag, size_t tag_len, Id3TagView *view)
+{
+  memset(view, 0, sizeof(*view)); // Empty view: id3_tag_close is always safe
+  view->data = tag;
+  view->len = tag_len;
+
+  switch (header->major) // The version is tested once per tag, never per frame
+  {
+  case 2:
+    if (header->flags & ID3_FLAG_EXTENDED) // v2.2 used this bit for a compression scheme that was never defined
+    {
+      return e_failure;
+    }
+    view->next = next_frame_v22;
+    break;
+  case 3:
+    view->next = next_frame_v23;
+    break;
+  case 4:
+    view->next = (header->flags & ID3_FLAG_UNSYNC) ? next_frame_v24_unsync : next_frame_v24;
+    break;
+  default:
+    return e_failure; // Unknown major version: frame layout cannot be trusted
+  }
+
+  if (header->major < 4 && (header->flags & ID3_FLAG_UNSYNC)) // v2.2/2.3: sizes refer to the resynchronised tag
+  {
+    view->owned = arena_malloc(tag_len ? tag_len : 1);
+    if (view->owned == NULL)
+    {
+      return e_failure;
+    }
+    view->len = resync(tag, tag_len, view->owned);
+    view->data = view->owned;
+  }
+
+  if (header->major >= 3 && (header->flags & ID3_FLAG_EXTENDED)) // Skip the extended header
+  {
+    if (view->len < 4)
+    {
+      id3_tag_close(view);
+      return e_failure;
+    }
+    size_t ext = (header->major == 3) ? 4 + (size_t)id3_be32_decode(view->data) // v2.3: size excludes the 4 size bytes
+                                      : (size_t)id3_syncsafe_decode(view->data); // v2.4: synchsafe, includes itself
+    if (ext < 6 || ext > view->len) // Error handling: corrupt extended header
+    {
+      id3_tag_close(view);
+      return e_failure;
+    }
+    view->start = ext;
+  }
+  return e_success;
+}
+
+/*
+ * Function: id3_tag_close
+ * Description: Frees the resynchronised copy of a view
+ * Parameters: view - pointer to Id3TagView
+ * Return: void
+ */
+void id3_tag_close(Id3TagView *view)
+{
+  arena_release(view->owned); // NULL is ignored
+  view->owned = NULL;
+}
+
+/*
+ * Function: id3_tag_end
+ * Description: Adds header, declared tag size and the v2.4 footer
+ * Parameters: header - decoded header
+ * Return: size_t - offset of the first byte after the tag
+ */
+size_t id3_tag_end(const Id3Header *header)
+{
+  size_t end = ID3_HEADER_SIZE + (size_t)header->tag_size; // Header + extended header + frames + padding
+
+  if (header->major >= 4 && (header->flags & ID3_FLAG_FOOTER)) // v2.4 footer repeats the header after the tag
+  {
+    end += ID3_FOOTER_SIZE;
+  }
+  return end;
+}
+
+/*
+ * Function: id3_frame_data
+ * Description: Makes the frame data decodable, copying it without unsynchronisation bytes when needed
+ * Parameters: frame - pointer to Id3Frame, scratch - receives a copy from arena_malloc or NULL
+ * Return: Status (e_success/e_failure)
+ */
+Status id3_frame_data(Id3Frame *frame, unsigned char **scratch)
+{
+  *scratch = NULL; // Nothing allocated yet
+
+  if (frame->opaque) // Compressed or encrypted: not decodable without the codec
+  {
+    return e_failure;
+  }
+  if (!frame->unsync) // Common case: data used where it lies
+  {
+    return e_success;
+  }
+
+  *scratch = arena_malloc(frame->size ? frame->size : 1);
+  if (*scratch == NULL)
+  {
+    return e_failure;
+  }
+  frame->size = (unsigned int)resync(frame->body, frame->size, *scratch);
+  frame->body = *scratch;
+  frame->unsync = 0;
+  return e_success;
+}
+
+/*
+ * Function: id3_read_header
+ * Description: Reads the 10-byte header with one pread and validates it
+ * Parameters: fd - file descriptor, header - Id3Header to fill
+ * Return: Status (e_success/e_failure)
+ */
+Status id3_read_header(int fd, Id3Header *header)
+{
+  unsigned char header_buf[ID3_HEADER_SIZE]; // Raw 10-byte ID3v2 header
+
+  if (pread(fd, header_buf, ID3_HEADER_SIZE, 0) != ID3_HEADER_SIZE || id3_parse_header(header_buf, header) == e_failure)
+  {
+    return e_failure; // File too short or no ID3v2 header
+  }
+  return e_success;
+}
+
+/*
+ * Function: id3_read_tag
+ * Description: Reads the 10-byte header and then the whole declared tag region with one pread each
+ * Parameters: fd - file descriptor, header - Id3Header to fill, tag - receives malloc'd tag buffer
+ * Return: Status (e_success/e_failure)
+ */
+Status id3_read_tag(int fd, Id3Header *header, unsigned char **tag)
+{
+  *tag = NULL; // Nothing loaded yet
+
+  if (id3_read_header(fd, header) == e_failure)
+  {
+    return e_failure; // File too short or no ID3v2 header
+  }
+
+  *tag = malloc(header->tag_size ? header->tag_size : 1); // Buffer for frames + padding
+
+  if (*tag == NULL) // Error handling: allocation failed
+  {
+    return e_failure;
+  }
+
+  ssize_t n = pread(fd, *tag, header->tag_size, ID3_HEADER_SIZE); // Whole tag in a single read
+
+  if (n < 0) // Error handling: read failed
+  {
+    free(*tag);
+    *tag = NULL;
+    return e_failure;
+  }
+  if ((size_t)n < header->tag_size) // Truncated file: parse what exists, frame walker stops at the end
+  {
+    memset(*tag + n, 0, header->tag_size - n); // Zero-fill so the missing part reads as padding
+  }
+  return e_success; // Tag loaded
+}
+
+/*
+ * Function: stream_whole_tag
+ * Description: Fallback of id3_stream_frames for tags that are unsynchronised as a whole: walks the complete tag in memory
+ * Parameters: fd - file descriptor, header - decoded header, prefix - tag bytes already read, prefix_len - bytes in prefix,
+ *             visit - visitor, ctx - visitor context
+ * Return: Status (e_success/e_failure)
+ */
+static Status stream_whole_tag(int fd, const Id3Header *header, const unsigned char *prefix, size_t prefix_len, Id3FrameVisitor visit, void *ctx)
+{
+  const unsigned char *tag = prefix; // Complete tag
+  unsigned char *loaded = NULL;      // Tag read here when the prefix is short
+  size_t tag_len = header->tag_size;
+  Id3TagView view;
+  Id3Frame frame;
+
+  if (prefix_len < tag_len) // Read the whole tag (zero-filled when the file is truncated)
+  {
+    ssize_t n = -1; // Bytes read
+
+    if (fd == -1 || (loaded = arena_malloc(tag_len)) == NULL || (n = pread(fd, loaded, tag_len, ID3_HEADER_SIZE)) < 0)
+    {
+      arena_release(loaded);
+      return e_failure;
+    }
+    memset(loaded + n, 0, tag_len - (size_t)n); // Arena memory is not zeroed
+    tag = loaded;
+  }
+
+  Status status = id3_tag_open(header, tag, tag_len, &view);
+  if (status == e_success)
+  {
+    size_t pos = view.start;
+    while (view.next(view.data, view.len, &pos, &frame) && visit(&frame, -1, frame.size, ctx)) // All data is in memory
+    {
+    }
+    id3_tag_close(&view);
+  }
+  arena_release(loaded);
+  return status;
+}
+
+/*
+ * Function: id3_stream_frames
+ * Description: Windowed frame walk: refills the window only at frame headers that lie outside it
+ * Parameters: fd - file descriptor, header - decoded header, prefix - bytes already read, prefix_len - bytes in prefix,
+ *             visit - visitor, ctx - visitor context
+ * Return: Status (e_success/e_failure)
+ */
+Status id3_stream_frames(int fd, const Id3Header *header, const unsigned char *prefix, size_t prefix_len, Id3FrameVisitor visit, void *ctx)
+{
+  size_t tag_len = header->tag_size; // Declared tag size
+
+  if (header->major < 4 && (header->flags & ID3_FLAG_UNSYNC)) // Frame offsets refer to the resynchronised tag
+  {
+    return stream_whole_tag(fd, header, prefix, prefix_len, visit, ctx);
+  }
+
+  unsigned char *buf = NULL;                                   // Window buffer, allocated on the first refill
+  const unsigned char *win = prefix;                           // Current window
+  size_t win_off = 0;                                          // Tag offset of win[0]
+  size_t win_len = (prefix_len < tag_len) ? prefix_len : tag_len; // Bytes in the window
+  size_t pos = 0;                                              // Tag offset of the next frame header
+  Status status = e_success;
+  Id3TagView view;
+  Id3Frame frame;
+
+  for (int first = 1;; first = 0)
+  {
+    size_t need = (tag_len - pos < ID3_FRAME_HEADER_SIZE) ? tag_len - pos : ID3_FRAME_HEADER_SIZE; // Frame header bytes (or what is left)
+
+    if (pos < win_off || pos + need > win_off + win_len) // Header not in the window: refill at the header
+    {
+      if (fd == -1 || (buf == NULL && (buf = arena_malloc(ID3_READ_WINDOW)) == NULL))
+      {
+        status = (fd == -1) ? e_success : e_failure; // Prefix-only walk ends here
+        break;
+      }
+
+      size_t want = (tag_len - pos < ID3_READ_WINDOW) ? tag_len - pos : ID3_READ_WINDOW; // Never read past the tag
+      ssize_t n = pread(fd, buf, want, ID3_HEADER_SIZE + (off_t)pos);
+      if (n <= 0) // End of a truncated file or read error
+      {
+        break;
+      }
+      win = buf;
+      win_off = pos;
+      win_len = (size_t)n;
+    }
+
+    if (first) // Version layout from the first bytes of the tag (extended header size)
+    {
+      if (id3_tag_open(header, win, tag_len, &view) == e_failure)
+      {
+        status = e_failure;
+        break;
+      }
+      pos = view.start;
+      continue;
+    }
+
+    size_t local = pos - win_off;                                 // Header offset inside the window
+    if (!view.next(win, tag_len - win_off, &local, &frame))       // Sizes are checked against the whole tag, only the header is read
+    {
+      break; // Padding or end of tag
+    }
+
+    size_t data_local = (size_t)(frame.body - win); // Frame data offset inside the window
+    size_t avail = (data_local >= win_len) ? 0 : win_len - data_local;
+    if (avail > frame.size)
+    {
+      avail = frame.size;
+    }
+    frame.offset += win_off; // Offsets relative to the whole tag
+
+    if (!visit(&frame, ID3_HEADER_SIZE + (off_t)(win_off + data_local), avail, ctx)) // Visitor asked to stop
+    {
+      break;
+    }
+    pos = win_off + local; // Next frame header (possibly far beyond the window: skipped by offset)
+  }
+
+  arena_release(buf);
+  return status;
+}
+
+// Context of the field-collecting frame visitor
+typedef struct // typedef used to give alternate name for structure here
+{
+  int fd;            // File the frames come from
+  TagFields *fields; // Fields being filled
+} FieldStream;       // FieldStream is alternate name for this structure
+
+/*
+ * Function: collect_visitor
+ * Description: Decodes a frame that has a handler and whose field is still absent; other frames are skipped unread
+ * Parameters: frame - current frame, data_offset - file offset of the frame data, data_avail - data bytes in memory,
+ *             ctx - pointer to FieldStream
+ * Return: int - 1 to continue the walk
+ */
+static int collect_visitor(const Id3Frame *frame, off_t data_offset, size_t data_avail, void *ctx)
+{
+  FieldStream *fs = ctx;
+  const FrameHandler *handler = id3_frame_handler(frame->id32); // Registry lookup
+  Id3Frame f = *frame;                                          // Local copy: body may be redirected
+  unsigned char *loaded = NULL;                                 // Frame data read outside the window
+  unsigned char *scratch;                                       // Resynchronised copy, if any
+
+  if (handler == NULL || fs->fields->value[handler->field] != NULL) // Not interpreted, or already known: skip by offset
+  {
+    return 1;
+  }
+
+  if (data_avail < f.size) // Text frame crosses the window edge
+  {
+    if (f.size > ID3_TEXT_FRAME_MAX || (loaded = arena_malloc(f.size)) == NULL || pread(fs->fd, loaded, f.size, data_offset) != (ssize_t)f.size)
+    {
+      arena_release(loaded);
+      return 1; // Implausible or unreadable text frame: leave the field absent
+    }
+    f.body = loaded;
+  }
+
+  if (id3_frame_data(&f, &scratch) == e_success) // Decodable
+  {
+    fs->fields->value[handler->field] = handler->decode(&f);
+    arena_release(scratch);
+  }
+  arena_release(loaded);
+  return 1;
+}
+
+/*
+ * Function: id3_stream_fields
+ * Description: Streams the frames of a tag and keeps the known fields
+ * Parameters: fd - file descriptor, header - decoded header, prefix - bytes already read, prefix_len - bytes in prefix,
+ *             fields - TagFields to fill
+ * Return: Status (e_success/e_failure)
+ */
+Status id3_stream_fields(int fd, const Id3Header *header, const unsigned char *prefix, size_t prefix_len, TagFields *fields)
+{
+  FieldStream fs = {fd, fields};
+
+  memset(fields, 0, sizeof(*fields)); // All fields start absent
+  return id3_stream_frames(fd, header, prefix, prefix_len, collect_visitor, &fs);
+}
+
+/*
+ * Function: id3_collect_fields
+ * Description: Walks every frame until padding or end of tag and keeps the known fields
+ * Parameters: tag - tag buffer, tag_len - buffer length, fields - TagFields to fill
+ * Return: void
+ */
+void id3_collect_fields(const Id3Header *header, const unsigned char *tag, size_t tag_len, TagFields *fields)
+{
+  Id3TagView view; // Version-specific layout of the tag
+  Id3Frame frame;  // Current frame
+
+  memset(fields, 0, sizeof(*fields)); // All fields start absent
+
+  if (id3_tag_open(header, tag, tag_len, &view) == e_failure) // Unknown version or corrupt layout: no fields
+  {
+    return;
+  }
+
+  size_t pos = view.start; // Offset of the next frame inside the tag
+
+  while (view.next(view.data, view.len, &pos, &frame)) // Walk all frames in any order (no per-frame version test)
+  {
+    const FrameHandler *handler = id3_frame_handler(frame.id32); // One hash lookup instead of a compare per field
+    unsigned char *scratch;                                      // Resynchronised copy of the frame data, if any
+
+    if (handler != NULL && fields->value[handler->field] == NULL && id3_frame_data(&frame, &scratch) == e_success) // Known frame, first occurrence, decodable
+    {
+      fields->value[handler->field] = handler->decode(&frame); // Decode and store the text
+      arena_release(scratch);
+    }
+  }
+  id3_tag_close(&view);
+}
+
+/*
+ * Function: id3_free_fields
+ * Description: Frees all stored field values
+ * Parameters: fields - pointer to TagFields
+ * Return: void
+ */
+void id3_free_fields(TagFields *fields)
+{
+  for (int i = 0; i < TAG_FIELD_COUNT; i++) // Visit every field
+  {
+    arena_release(fields->value[i]); // Free value (values of the bound arena wait for its reset)
+    fields->value[i] = NULL;
+  }
+}
@@ -0,0 +1,230 @@
+#ifndef ID3_H // If not defined ID3_H ---> Checks if ID3_H was previously defined: If not present, code is processed; else code below till #endif is ignored
+#define ID3_H // Defines the macro ID3_H if macro was not previously defined
+
+#include <stddef.h> // Header file for size_t
+#include <stdint.h> // Header file for uint32_t (frame IDs as integers)
+#include <sys/types.h> // Header file for off_t
+#include "type.h"   // User-defined header file for custom type definitions (Status, e_success, e_failure)
+
+#define ID3_HEADER_SIZE 10                // Size of the ID3v2 tag header ("ID3" + version + flags + size)
+#define ID3_FRAME_HEADER_SIZE 10          // Size of an ID3v2.3/2.4 frame header (ID + size + flags)
+#define ID3_V22_FRAME_HEADER_SIZE 6       // Size of an ID3v2.2 frame header (3-byte ID + 3-byte size, no flags)
+#define ID3_FOOTER_SIZE 10                // Size of the ID3v2.4 footer ("3DI" copy of the header)
+#define ID3_TAG_SIZE_MAX 0x0FFFFFFF       // Largest tag size a header can declare (28-bit synchsafe integer)
+#define ID3_READ_WINDOW (64 * 1024)       // Bytes of tag read at a time by the streaming frame walker
+#define ID3_TEXT_FRAME_MAX (1024 * 1024)  // Largest text frame loaded when it does not fit in the read window
+
+#define ID3_FLAG_UNSYNC 0x80              // Header flag: unsynchronisation applied (whole tag in v2.2/2.3, every frame in v2.4)
+#define ID3_FLAG_EXTENDED 0x40            // Header flag: extended header follows (v2.3/2.4; compression in v2.2)
+#define ID3_FLAG_FOOTER 0x10              // Header flag: footer follows the tag (v2.4)
+#define ID3_FRAME_V23_COMPRESSED 0x80     // v2.3 format flag: body is zlib compressed (4-byte decompressed size first)
+#define ID3_FRAME_V23_ENCRYPTED 0x40      // v2.3 format flag: body is encrypted (1-byte method first)
+#define ID3_FRAME_V23_GROUPED 0x20        // v2.3 format flag: 1-byte group ID first
+#define ID3_FRAME_V24_GROUPED 0x40        // v2.4 format flag: 1-byte group ID first
+#define ID3_FRAME_V24_COMPRESSED 0x08     // v2.4 format flag: body is zlib compressed
+#define ID3_FRAME_V24_ENCRYPTED 0x04      // v2.4 format flag: body is encrypted (1-byte method first)
+#define ID3_FRAME_V24_UNSYNC 0x02         // v2.4 format flag: body is unsynchronised
+#define ID3_FRAME_V24_LENGTH 0x01         // v2.4 format flag: 4-byte synchsafe data length indicator first
+
+// Structure to store the decoded 10-byte ID3v2 tag header
+typedef struct // typedef used to give alternate name for structure here
+{
+  unsigned char major;    // Major version byte (2, 3 or 4 for ID3v2.2/2.3/2.4)
+  unsigned char revision; // Revision byte
+  unsigned char flags;    // Header flags (unsynchronisation, extended header, ...)
+  unsigned int tag_size;  // Size of the tag after the 10-byte header (extended header + frames + padding), decoded from synchsafe form
+} Id3Header;              // Id3Header is alternate name for this structure
+
+// Structure describing one frame found inside an in-memory tag buffer (no data is copied)
+typedef struct // typedef used to give alternate name for structure here
+{
+  char id[5];                // Frame identifier (e.g., "TIT2", or "TT2" for ID3v2.2) + null terminator
+  uint32_t id32;             // Same identifier as a 32-bit integer (ID3_FRAME_ID; 3-byte IDs end with a zero byte)
+  unsigned int size;         // Size of the frame data in bytes (after group ID / length indicator prefixes)
+  unsigned char flags[2];    // Two frame flag bytes (zero for ID3v2.2)
+  const unsigned char *body; // Pointer to the frame data inside the tag buffer
+  size_t offset;             // Offset of the frame header from the start of the tag buffer
+  size_t length;             // Bytes the whole frame occupies in the tag (header + stored body), used to copy it unchanged
+  unsigned char unsync;      // 1 if the data still contains unsynchronisation bytes (0xFF 0x00) to remove before decoding
+  unsigned char opaque;      // 1 if the data is compressed or encrypted: it can be copied but not decoded
+} Id3Frame;                  // Id3Frame is alternate name for this structure
+
+// Function type of a version-specific frame walker: decodes the frame at *pos and advances *pos past it
+typedef int (*Id3FrameWalker)(const unsigned char *tag, size_t tag_len, size_t *pos, Id3Frame *frame);
+
+// Function type called by id3_stream_frames for every frame: frame->body holds data_avail bytes of the frame data
+// (the rest, up to frame->size, is only in the file at data_offset + data_avail); returns 0 to stop the walk
+typedef int (*Id3FrameVisitor)(const Id3Frame *frame, off_t data_offset, size_t data_avail, void *ctx);
+
+// Structure describing the frame area of a tag once the version-specific layout has been resolved
+typedef struct // typedef used to give alternate name for structure here
+{
+  const unsigned char *data; // Tag bytes with tag-level unsynchronisation removed (the caller's buffer when there was none)
+  size_t len;                // Length of data in bytes
+  size_t start;              // Offset of the first frame inside data (after the extended header)
+  Id3FrameWalker next;       // Frame walker of this ID3v2 version
+  unsigned char *owned;      // Resynchronised copy owned by the view (NULL when data is the caller's buffer)
+} Id3TagView;                // Id3TagView is alternate name for this structure
+
+// Enumeration of the tag fields shown and edited by this tool
+typedef enum // typedef used to give alternate name for enum here
+{
+  e_title,        // TIT2 frame
+  e_artist,       // TPE1 frame
+  e_album,        // TALB frame
+  e_year,         // TYER frame
+  e_genre,        // TCON frame
+  e_comment,      // COMM frame
+  TAG_FIELD_COUNT // Number of fields (must stay last)
+} TagField;       // TagField is alternate name for this enum
+
+// Structure to store decoded text values of the known fields (NULL when the frame is absent)
+typedef struct // typedef used to give alternate name for structure here
+{
+  char *value[TAG_FIELD_COUNT]; // Null-terminated field values indexed by TagField
+} TagFields;                    // TagFields is alternate name for this structure
+
+extern const char *const id3_field_ids[TAG_FIELD_COUNT];   // Frame ID of every TagField ("TIT2", "TPE1", ...)
+extern const char *const id3_field_names[TAG_FIELD_COUNT]; // Display name of every TagField ("TITLE", "ARTIST", ...)
+
+/*
+ * Function: id3_field_lookup
+ * Description: Maps a field name ("title", case-insensitive) or frame ID of any version ("TIT2", "TDRC", "TT2") to its TagField
+ * Parameters: name - field name or frame ID
+ * Return: int - TagField index, or -1 if unknown
+ */
+int id3_field_lookup(const char *name);
+
+/*
+ * Function: id3_field_frame_id
+ * Description: Returns the frame ID used for a field in a given ID3v2 version
+ *              (v2.2: "TT2", "TP1", ...; v2.3: "TIT2", ..., "TYER"; v2.4: same but "TDRC" for the year)
+ * Parameters: field - TagField, major - major version of the tag being written
+ * Return: const char * - 3- or 4-character frame ID
+ */
+const char *id3_field_frame_id(TagField field, unsigned char major);
+
+/*
+ * Function: id3_parse_header
+ * Description: Validates and decodes the 10-byte ID3v2 header at the start of a file
+ * Parameters: buf - pointer to 10 header bytes, header - pointer to Id3Header to fill
+ * Return: Status (e_success if "ID3" magic and a valid size are present, e_failure otherwise)
+ */
+Status id3_parse_header(const unsigned char *buf, Id3Header *header);
+
+/*
+ * Function: id3_syncsafe_decode / id3_syncsafe_encode
+ * Description: Converts between a 4-byte synchsafe integer (7 bits per byte) and a plain integer
+ * Parameters: p - pointer to 4 bytes, value - integer to encode
+ */
+unsigned int id3_syncsafe_decode(const unsigned char *p);
+void id3_syncsafe_encode(unsigned int value, unsigned char *p);
+
+/*
+ * Function: id3_be32_decode / id3_be32_encode
+ * Description: Converts between a 4-byte big-endian integer and a plain integer
+ * Parameters: p - pointer to 4 bytes, value - integer to encode
+ */
+unsigned int id3_be32_decode(const unsigned char *p);
+void id3_be32_encode(unsigned int value, unsigned char *p);
+
+/*
+ * Function: id3_tag_open
+ * Description: Resolves the layout of a loaded tag for its ID3v2 version: removes whole-tag unsynchronisation
+ *              (v2.2/2.3), skips the extended header (v2.3: size excludes itself, v2.4: synchsafe size includes itself)
+ *              and selects the frame walker of the version, so the frame loop itself never tests the version:
+ *              v2.2: 3-byte ID + 24-bit size, v2.3: 32-bit big-endian size, v2.4: synchsafe size + frame-level flags
+ * Parameters: header - decoded header, tag - tag buffer (bytes after the 10-byte header), tag_len - buffer length,
+ *             view - pointer to Id3TagView to fill (walk with view->next starting at view->start)
+ * Return: Status (e_failure for unknown versions, compressed v2.2 tags or a corrupt extended header)
+ */
+Status id3_tag_open(const Id3Header *header, const unsigned char *tag, size_t tag_len, Id3TagView *view);
+
+/*
+ * Function: id3_tag_close
+ * Description: Frees the resynchronised copy held by a view (safe on a view that failed to open)
+ * Parameters: view - pointer to Id3TagView
+ * Return: void
+ */
+void id3_tag_close(Id3TagView *view);
+
+/*
+ * Function: id3_tag_end
+ * Description: Offset of the first byte after the tag in the file: header + tag size + footer (v2.4)
+ * Parameters: header - decoded header
+ * Return: size_t - offset where the audio starts
+ */
+size_t id3_tag_end(const Id3Header *header);
+
+/*
+ * Function: id3_frame_data
+ * Description: Returns the decodable data of a frame: unsynchronised bodies are copied with the 0x00 after
+ *              every 0xFF removed, other bodies are returned as they are
+ * Parameters: frame - pointer to Id3Frame (body and size are updated), scratch - receives a copy from arena_malloc
+ *             when one was needed (NULL otherwise; caller releases it with arena_release)
+ * Return: Status (e_failure for compressed/encrypted frames or when allocation fails)
+ */
+Status id3_frame_data(Id3Frame *frame, unsigned char **scratch);
+
+/*
+ * Function: id3_read_tag
+ * Description: Loads a complete ID3v2 tag with two positional reads: the 10-byte header, then the whole tag region
+ *              (frames + padding) whose size the header declares
+ * Parameters: fd - file descriptor of the MP3 file, header - pointer to Id3Header to fill,
+ *             tag - receives malloc'd buffer holding header->tag_size bytes (caller frees)
+ * Return: Status (e_success/e_failure)
+ */
+Status id3_read_tag(int fd, Id3Header *header, unsigned char **tag);
+
+/*
+ * Function: id3_read_header
+ * Description: Reads and validates the 10-byte ID3v2 header at the start of a file (one pread)
+ * Parameters: fd - file descriptor of the MP3 file, header - pointer to Id3Header to fill
+ * Return: Status (e_failure if the file is too short or has no ID3v2 header)
+ */
+Status id3_read_header(int fd, Id3Header *header);
+
+/*
+ * Function: id3_stream_frames
+ * Description: Walks the frames of a tag through a ID3_READ_WINDOW-byte window instead of loading the whole tag.
+ *              Only frame headers have to be inside the window: a frame larger than the window (cover art, ...)
+ *              is skipped by offset, and the window is refilled at the next frame header. Frame data beyond the
+ *              window is never read unless the visitor reads it itself.
+ *              Whole-tag unsynchronisation (v2.2/2.3) needs the complete tag and falls back to one full read.
+ * Parameters: fd - file descriptor (-1 to walk only what prefix holds), header - decoded header,
+ *             prefix - tag bytes already in memory from offset 0 (NULL if none), prefix_len - bytes in prefix,
+ *             visit - function called for every frame, ctx - passed to visit
+ * Return: Status (e_failure on allocation failure or an undecodable tag layout)
+ */
+Status id3_stream_frames(int fd, const Id3Header *header, const unsigned char *prefix, size_t prefix_len, Id3FrameVisitor visit, void *ctx);
+
+/*
+ * Function: id3_stream_fields
+ * Description: Decodes the known fields with id3_stream_frames: frames without a handler are skipped by offset,
+ *              so a file with a multi-megabyte picture costs a few small reads instead of a read of the whole tag
+ * Parameters: fd - file descriptor, header - decoded header, prefix - tag bytes already read (or NULL),
+ *             prefix_len - bytes in prefix, fields - pointer to TagFields to fill
+ * Return: Status (e_success/e_failure)
+ */
+Status id3_stream_fields(int fd, const Id3Header *header, const unsigned char *prefix, size_t prefix_len, TagFields *fields);
+
+/*
+ * Function: id3_collect_fields
+ * Description: Walks every frame of an in-memory tag until padding or the end of the tag with the walker of its
+ *              version and dispatches each one through the frame registry; stores the text of the known fields
+ *              (first occurrence wins). Tags that cannot be decoded leave every field absent.
+ * Parameters: header - decoded header, tag - tag buffer, tag_len - buffer length, fields - pointer to TagFields to fill
+ * Return: void
+ */
+void id3_collect_fields(const Id3Header *header, const unsigned char *tag, size_t tag_len, TagFields *fields);
+
+/*
+ * Function: id3_free_fields
+ * Description: Frees all values stored in a TagFields structure and resets them to NULL (arena_release: values
+ *              decoded into the bound arena of a bulk worker are reclaimed by its reset)
+ * Parameters: fields - pointer to TagFields structure
+ * Return: void
+ */
+void id3_free_fields(TagFields *fields);
+
+#endif // End of header guard: Marks the end of conditional compilation block started by #ifndef ID3_H
@@ -0,0 +1,534 @@
+#include <stdio.h>    // Header file for standard input/output functions (fopen, fread, fwrite, fprintf, rename, etc.)
+#include <stdlib.h>   // Header file for memory allocation functions (malloc, calloc, free, mkstemp)
+#include <string.h>   // Header file for string/memory functions (memcmp, memcpy, strlen, strdup, strcmp)
+#include <unistd.h>   // Header file for POSIX functions (fsync, unlink)
+#include <sys/stat.h> // Header file for file status information (stat, fstat, fchmod)
+#include "type.h"     // User-defined header file for custom type definitions (Status, e_success, e_failure)
+#include "id3.h"      // User-defined header file for TagFields
+#include "index.h"    // User-defined header file for TagIndex structure and function declarations
+
+#define INDEX_ABSENT 0xFFFFFFFFu // Stored length of a field the file does not have
+
+/*
+ * Function: index_identity
+ * Description: Copies device, inode, size and modification time from stat() results
+ * Parameters: st - file status, id - pointer to FileIdentity to fill
+ * Return: void
+ */
+void index_identity(const struct stat *st, FileIdentity *id)
+{
+  id->dev = (unsigned long long)st->st_dev;
+  id->ino = (unsigned long long)st->st_ino;
+  id->size = (long long)st->st_size;
+  id->mtime_sec = (long long)st->st_mtim.tv_sec;
+  id->mtime_nsec = (long long)st->st_mtim.tv_nsec;
+}
+
+/*
+ * Function: hash_identity
+ * Description: Mixes device and inode into a hash table index
+ * Parameters: id - file identity, mask - capacity - 1
+ * Return: size_t - slot index
+ */
+static size_t hash_identity(const FileIdentity *id, size_t mask)
+{
+  unsigned long long h = id->ino * 0x9E3779B97F4A7C15ull ^ id->dev; // Inode numbers are dense: spread them out
+
+  h ^= h >> 29;
+  h *= 0xBF58476D1CE4E5B9ull;
+  h ^= h >> 32;
+  return (size_t)h & mask;
+}
+
+/*
+ * Function: find_slot
+ * Description: Finds the slot holding this device/inode, or the empty slot where it belongs
+ * Parameters: index - pointer to TagIndex, id - file identity
+ * Return: size_t - slot index
+ */
+static size_t find_slot(const TagIndex *index, const FileIdentity *id)
+{
+  size_t mask = index->capacity - 1;        // Capacity is a power of two
+  size_t slot = hash_identity(id, mask);    // Home slot
+
+  while (index->slots[slot] != NULL && (index->slots[slot]->id.dev != id->dev || index->slots[slot]->id.ino != id->ino)) // Linear probing
+  {
+    slot = (slot + 1) & mask;
+  }
+  return slot;
+}
+
+/*
+ * Function: grow_table
+ * Description: Doubles the hash table when it is more than half full
+ * Parameters: index - pointer to TagIndex
+ * Return: Status (e_success/e_failure)
+ */
+static Status grow_table(TagIndex *index)
+{
+  if (index->capacity != 0 && (index->count + 1) * 2 <= index->capacity) // Still room
+  {
+    return e_success;
+  }
+
+  TagIndex bigger = *index;                                  // Same entries, new slot array
+  bigger.capacity = index->capacity ? index->capacity * 2 : 1024;
+  bigger.slots = calloc(bigger.capacity, sizeof(IndexEntry *));
+
+  if (bigger.slots == NULL) // Error handling: allocation failed
+  {
+    return e_failure;
+  }
+
+  for (size_t i = 0; i < index->capacity; i++) // Re-insert every entry
+  {
+    if (index->slots[i] != NULL)
+    {
+      bigger.slots[find_slot(&bigger, &index->slots[i]->id)] = index->slots[i];
+    }
+  }
+  free(index->slots);
+  index->slots = bigger.slots;
+  index->capacity = bigger.capacity;
+  return e_success;
+}
+
+/*
+ * Function: free_entry
+ * Description: Frees one entry with its path and field values
+ * Parameters: entry - entry to free
+ * Return: void
+ */
+static void free_entry(IndexEntry *entry)
+{
+  id3_free_fields(&entry->fields);
+  free(entry->path);
+  free(entry);
+}
+
+/*
+ * Function: insert_entry
+ * Description: Puts an entry in the table, replacing an older entry for the same device/inode
+ * Parameters: index - pointer to TagIndex, entry - entry to insert (owned by the index afterwards)
+ * Return: Status (e_success/e_failure)
+ */
+static Status insert_entry(TagIndex *index, IndexEntry *entry)
+{
+  if (grow_table(index) == e_failure)
+  {
+    free_entry(entry);
+    return e_failure;
+  }
+
+  size_t slot = find_slot(index, &entry->id); // Existing or empty slot
+
+  if (index->slots[slot] != NULL) // Same file seen before: replace
+  {
+    free_entry(index->slots[slot]);
+  }
+  else
+  {
+    index->count++;
+  }
+  index->slots[slot] = entry;
+  return e_success;
+}
+
+/*
+ * Function: get_u32 / get_u64
+ * Description: Read little-endian integers from the index buffer with bounds checking
+ * Parameters: p - read position (advanced), end - end of buffer, value - receives the integer
+ * Return: int - 1 on success, 0 if the buffer is too short
+ */
+static int get_u32(const unsigned char **p, const unsigned char *end, unsigned int *value)
+{
+  if (end - *p < 4)
+  {
+    return 0;
+  }
+  *value = (unsigned int)(*p)[0] | (unsigned int)(*p)[1] << 8 | (unsigned int)(*p)[2] << 16 | (unsigned int)(*p)[3] << 24;
+  *p += 4;
+  return 1;
+}
+
+static int get_u64(const unsigned char **p, const unsigned char *end, unsigned long long *value)
+{
+  unsigned int low, high;
+
+  if (!get_u32(p, end, &low) || !get_u32(p, end, &high))
+  {
+    return 0;
+  }
+  *value = (unsigned long long)high << 32 | low;
+  return 1;
+}
+
+/*
+ * Function: get_string
+ * Description: Reads a length-prefixed string from the index buffer
+ * Parameters: p - read position (advanced), end - end of buffer, value - receives malloc'd string (NULL if absent)
+ * Return: int - 1 on success, 0 on a corrupt record or allocation failure
+ */
+static int get_string(const unsigned char **p, const unsigned char *end, char **value)
+{
+  unsigned int len; // Stored length
+
+  *value = NULL;
+  if (!get_u32(p, end, &len))
+  {
+    return 0;
+  }
+  if (len == INDEX_ABSENT) // Field not present in the file
+  {
+    return 1;
+  }
+  if ((size_t)(end - *p) < len || (*value = malloc(len + 1)) == NULL)
+  {
+    return 0;
+  }
+  memcpy(*value, *p, len);
+  (*value)[len] = '\0';
+  *p += len;
+  return 1;
+}
+
+/*
+ * Function: index_load
+ * Description: Reads the whole index file at once and rebuilds the hash table. Unreadable or corrupt index files are
+ *              reported and ignored (the index is only a cache, the scan then reads every file).
+ * Parameters: index - pointer to TagIndex, fname - index file name
+ * Return: Status (e_success/e_failure on allocation failure)
+ */
+Status index_load(TagIndex *index, const char *fname)
+{
+  memset(index, 0, sizeof(*index));          // Empty table
+  pthread_mutex_init(&index->lock, NULL);    // Lock shared by the scan workers
+  if (grow_table(index) == e_failure)        // Initial slots
+  {
+    return e_failure;
+  }
+
+  FILE *fptr = fopen(fname, "rb"); // Open existing index
+  if (fptr == NULL)                // First scan: start empty
+  {
+    return e_success;
+  }
+
+  struct stat st;              // Index file size
+  unsigned char *buf = NULL;   // Whole index file
+  Status status = e_success;   // Result of the load
+  int corrupt = 1;             // Cleared when every record parsed
+
+  if (fstat(fileno(fptr), &st) == 0 && (buf = malloc(st.st_size ? st.st_size : 1)) != NULL &&
+      fread(buf, 1, st.st_size, fptr) == (size_t)st.st_size && st.st_size >= 12 && memcmp(buf, INDEX_MAGIC, 8) == 0) // One read, then check the magic
+  {
+    const unsigned char *p = buf + 8;              // Read position
+    const unsigned char *end = buf + st.st_size;   // End of data
+    unsigned int count;                            // Number of records
+
+    get_u32(&p, end, &count);
+    corrupt = 0;
+    for (unsigned int i = 0; i < count && !corrupt; i++) // Decode every record
+    {
+      IndexEntry *entry = calloc(1, sizeof(IndexEntry));
+      unsigned long long size, sec, nsec;
+
+      if (entry == NULL)
+      {
+        status = e_failure;
+        break;
+      }
+      corrupt = !get_u64(&p, end, &entry->id.dev) || !get_u64(&p, end, &entry->id.ino) || !get_u64(&p, end, &size) ||
+                !get_u64(&p, end, &sec) || !get_u64(&p, end, &nsec) || !get_string(&p, end, &entry->path) || entry->path == NULL;
+      entry->id.size = (long long)size;
+      entry->id.mtime_sec = (long long)sec;
+      entry->id.mtime_nsec = (long long)nsec;
+      for (int f = 0; f < TAG_FIELD_COUNT && !corrupt; f++) // Field values
+      {
+        corrupt = !get_string(&p, end, &entry->fields.value[f]);
+      }
+
+      if (corrupt)
+      {
+        free_entry(entry);
+      }
+      else if (insert_entry(index, entry) == e_failure)
+      {
+        status = e_failure;
+        break;
+      }
+    }
+  }
+
+  if (corrupt && status == e_success) // Cache unusable: drop what was loaded and rebuild it
+  {
+    fprintf(stderr, "\033[1;91mWARNING: \033[1;97m%s: index unreadable, rebuilding\033[0m\n", fname);
+    for (size_t i = 0; i < index->capacity; i++)
+    {
+      if (index->slots[i] != NULL)
+      {
+        free_entry(index->slots[i]);
+        index->slots[i] = NULL;
+      }
+    }
+    index->count = 0;
+  }
+
+  free(buf);    // Free file contents
+  fclose(fptr); // Close index file
+  return status;
+}
+
+/*
+ * Function: index_lookup
+ * Description: Returns copies of the indexed fields when the file identity is unchanged
+ * Parameters: index - pointer to TagIndex, id - current identity, path - current path, fields - receives copies
+ * Return: int - 1 on a hit, 0 on a miss
+ */
+int index_lookup(TagIndex *index, const FileIdentity *id, const char *path, TagFields *fields)
+{
+  int hit = 0; // Result of the lookup
+
+  pthread_mutex_lock(&index->lock);
+  IndexEntry *entry = index->slots[find_slot(index, id)]; // Entry for this device/inode (or NULL)
+
+  if (entry != NULL && entry->id.size == id->size && entry->id.mtime_sec == id->mtime_sec && entry->id.mtime_nsec == id->mtime_nsec) // Unchanged since indexed
+  {
+    hit = 1;
+    memset(fields, 0, sizeof(*fields));
+    for (int f = 0; f < TAG_FIELD_COUNT; f++) // Caller owns its copies (entry may be replaced later)
+    {
+      if (entry->fields.value[f] != NULL && (fields->value[f] = strdup(entry->fields.value[f])) == NULL)
+      {
+        id3_free_fields(fields);
+        hit = 0; // Out of memory: fall back to reading the file
+        break;
+      }
+    }
+
+    if (hit && strcmp(entry->path, path) != 0) // Renamed or reached through another path: remember the new one
+    {
+      char *renamed = strdup(path);
+      if (renamed != NULL)
+      {
+        free(entry->path);
+        entry->path = renamed;
+      }
+    }
+    entry->seen = hit;
+  }
+  pthread_mutex_unlock(&index->lock);
+  return hit;
+}
+
+/*
+ * Function: index_store
+ * Description: Copies the parsed fields of a file into the index
+ * Parameters: index - pointer to TagIndex, id - identity taken before reading, path - file path, fields - parsed values
+ * Return: Status (e_success/e_failure)
+ */
+Status index_store(TagIndex *index, const FileIdentity *id, const char *path, const TagFields *fields)
+{
+  IndexEntry *entry = calloc(1, sizeof(IndexEntry)); // New record
+
+  if (entry == NULL || (entry->path = strdup(path)) == NULL)
+  {
+    free(entry);
+    return e_failure;
+  }
+  entry->id = *id;
+  entry->seen = 1;
+  for (int f = 0; f < TAG_FIELD_COUNT; f++) // Copy every value
+  {
+    if (fields->value[f] != NULL && (entry->fields.value[f] = strdup(fields->value[f])) == NULL)
+    {
+      free_entry(entry);
+      return e_failure;
+    }
+  }
+
+  pthread_mutex_lock(&index->lock);
+  Status status = insert_entry(index, entry); // Replaces any older record of the same file
+  pthread_mutex_unlock(&index->lock);
+  return status;
+}
+
+/*
+ * Function: put_u32 / put_u64 / put_string
+ * Description: Write little-endian integers and length-prefixed strings to the index file
+ * Parameters: fptr - index stream, value - integer or string (NULL string = absent field)
+ * Return: void
+ */
+static void put_u32(FILE *fptr, unsigned int value)
+{
+  unsigned char b[4] = {value & 0xFF, (value >> 8) & 0xFF, (value >> 16) & 0xFF, (value >> 24) & 0xFF};
+
+  fwrite(b, 1, 4, fptr);
+}
+
+static void put_u64(FILE *fptr, unsigned long long value)
+{
+  put_u32(fptr, (unsigned int)(value & 0xFFFFFFFFu));
+  put_u32(fptr, (unsigned int)(value >> 32));
+}
+
+static void put_string(FILE *fptr, const char *value)
+{
+  if (value == NULL) // Absent field
+  {
+    put_u32(fptr, INDEX_ABSENT);
+    return;
+  }
+  size_t len = strlen(value);
+  put_u32(fptr, (unsigned int)len);
+  fwrite(value, 1, len, fptr);
+}
+
+/*
+ * Function: still_present
+ * Description: Checks that an entry not visited by this scan still describes an existing file
+ * Parameters: entry - index entry
+ * Return: int - 1 if the path still names the same device/inode
+ */
+static int still_present(const IndexEntry *entry)
+{
+  struct stat st; // Current status of the path
+
+  return stat(entry->path, &st) == 0 && (unsigned long long)st.st_dev == entry->id.dev && (unsigned long long)st.st_ino == entry->id.ino;
+}
+
+/*
+ * Function: prune_entries
+ * Description: Moves live entries into a fresh table (open addressing cannot simply empty a slot) and frees the rest
+ * Parameters: index - pointer to TagIndex
+ * Return: void
+ */
+static void prune_entries(TagIndex *index)
+{
+  IndexEntry **slots = calloc(index->capacity, sizeof(IndexEntry *)); // Same capacity: never more entries than before
+
+  if (slots == NULL) // Out of memory: keep every entry
+  {
+    return;
+  }
+
+  TagIndex kept = *index; // Table receiving the live entries
+  kept.slots = slots;
+  kept.count = 0;
+
+  for (size_t i = 0; i < index->capacity; i++)
+  {
+    IndexEntry *entry = index->slots[i];
+
+    if (entry == NULL)
+    {
+      continue;
+    }
+    if (!entry->seen && !still_present(entry)) // File deleted or replaced since it was indexed
+    {
+      free_entry(entry);
+      continue;
+    }
+    kept.slots[find_slot(&kept, &entry->id)] = entry;
+    kept.count++;
+  }
+
+  free(index->slots);
+  index->slots = kept.slots;
+  index->count = kept.count;
+}
+
+/*
+ * Function: index_save
+ * Description: Writes all live entries to a temporary file beside fname, then renames it over fname
+ * Parameters: index - pointer to TagIndex, fname - index file name
+ * Return: Status (e_success/e_failure)
+ */
+Status index_save(TagIndex *index, const char *fname)
+{
+  char *temp = malloc(strlen(fname) + 8); // fname + ".XXXXXX" + '\0'
+
+  if (temp == NULL)
+  {
+    return e_failure;
+  }
+  sprintf(temp, "%s.XXXXXX", fname);
+
+  int fd = mkstemp(temp);                            // New index is written beside the old one
+  if (fd != -1)
+  {
+    fchmod(fd, 0644); // mkstemp creates 0600; the index holds nothing the music files do not
+  }
+  FILE *fptr = (fd == -1) ? NULL : fdopen(fd, "wb"); // Buffered writes for the many small fields
+
+  if (fptr == NULL) // Error handling: directory not writable
+  {
+    perror("index");
+    if (fd != -1)
+    {
+      close(fd);
+      unlink(temp);
+    }
+    free(temp);
+    return e_failure;
+  }
+
+  prune_entries(index); // Deleted or replaced files drop out
+
+  fwrite(INDEX_MAGIC, 1, 8, fptr); // Header: magic + record count
+  put_u32(fptr, (unsigned int)index->count);
+  for (size_t i = 0; i < index->capacity; i++) // One record per entry
+  {
+    IndexEntry *entry = index->slots[i];
+    if (entry == NULL)
+    {
+      continue;
+    }
+    put_u64(fptr, entry->id.dev);
+    put_u64(fptr, entry->id.ino);
+    put_u64(fptr, (unsigned long long)entry->id.size);
+    put_u64(fptr, (unsigned long long)entry->id.mtime_sec);
+    put_u64(fptr, (unsigned long long)entry->id.mtime_nsec);
+    put_string(fptr, entry->path);
+    for (int f = 0; f < TAG_FIELD_COUNT; f++)
+    {
+      put_string(fptr, entry->fields.value[f]);
+    }
+  }
+
+  int failed = (fflush(fptr) == EOF || ferror(fptr) || fsync(fd) == -1); // Data must be on disk before the rename
+  failed |= (fclose(fptr) == EOF);
+
+  if (failed || rename(temp, fname) == -1) // Replace the old index atomically
+  {
+    perror("index");
+    unlink(temp);
+    free(temp);
+    return e_failure;
+  }
+
+  free(temp);
+  return e_success;
+}
+
+/*
+ * Function: index_free
+ * Description: Frees every entry and the hash table
+ * Parameters: index - pointer to TagIndex
+ * Return: void
+ */
+void index_free(TagIndex *index)
+{
+  for (size_t i = 0; i < index->capacity; i++)
+  {
+    if (index->slots[i] != NULL)
+    {
+      free_entry(index->slots[i]);
+    }
+  }
+  free(index->slots);
+  index->slots = NULL;
+  index->capacity = 0;
+  index->count = 0;
+  pthread_mutex_destroy(&index->lock);
+}
@@ -0,0 +1,90 @@
+#ifndef INDEX_H // If not defined INDEX_H ---> Checks if INDEX_H was previously defined: If not present, code is processed; else code below till #endif is ignored
+#define INDEX_H // Defines the macro INDEX_H if macro was not previously defined
+
+#include <stddef.h>    // Header file for size_t
+#include <pthread.h>   // Header file for pthread_mutex_t (index is shared by scan workers)
+#include <sys/stat.h>  // Header file for struct stat
+#include "type.h"      // User-defined header file for custom type definitions (Status, e_success, e_failure)
+#include "id3.h"       // User-defined header file for TagFields
+
+#define INDEX_MAGIC "MP3TIDX1" // First 8 bytes of an index file (format version included)
+
+// Structure to store the identity of a file: when none of these change, the tag is assumed unchanged
+typedef struct // typedef used to give alternate name for structure here
+{
+  unsigned long long dev;  // Device the file lives on
+  unsigned long long ino;  // Inode number
+  long long size;          // File size in bytes
+  long long mtime_sec;     // Modification time (seconds)
+  long long mtime_nsec;    // Modification time (nanoseconds)
+} FileIdentity;            // FileIdentity is alternate name for this structure
+
+// Structure to store one indexed file
+typedef struct // typedef used to give alternate name for structure here
+{
+  FileIdentity id;  // Identity when the tag was parsed
+  char *path;       // Path the file was last seen under
+  TagFields fields; // Parsed field values
+  int seen;         // Set when the file was visited by the current scan
+} IndexEntry;       // IndexEntry is alternate name for this structure
+
+// Structure to store the in-memory tag index (open-addressing hash table keyed by device + inode)
+typedef struct // typedef used to give alternate name for structure here
+{
+  IndexEntry **slots;   // Hash table slots (NULL = empty)
+  size_t capacity;      // Number of slots (power of two)
+  size_t count;         // Number of entries
+  pthread_mutex_t lock; // Serialises lookups and updates from the scan workers
+} TagIndex;             // TagIndex is alternate name for this structure
+
+/*
+ * Function: index_identity
+ * Description: Fills a FileIdentity from stat() results
+ * Parameters: st - file status, id - pointer to FileIdentity to fill
+ * Return: void
+ */
+void index_identity(const struct stat *st, FileIdentity *id);
+
+/*
+ * Function: index_load
+ * Description: Loads an index file with a single read; a missing, unreadable or corrupt file gives an empty index
+ * Parameters: index - pointer to TagIndex, fname - index file name
+ * Return: Status (e_success/e_failure on allocation failure)
+ */
+Status index_load(TagIndex *index, const char *fname);
+
+/*
+ * Function: index_lookup
+ * Description: Copies the fields of the file with this identity if the index holds it unchanged (same device,
+ *              inode, size and mtime) and marks the entry as seen
+ * Parameters: index - pointer to TagIndex, id - current identity, path - current path, fields - receives copies of the values
+ * Return: int - 1 on a hit, 0 if the file must be read
+ */
+int index_lookup(TagIndex *index, const FileIdentity *id, const char *path, TagFields *fields);
+
+/*
+ * Function: index_store
+ * Description: Records (or replaces) the parsed fields of a file
+ * Parameters: index - pointer to TagIndex, id - identity before the file was read, path - file path, fields - parsed values
+ * Return: Status (e_success/e_failure)
+ */
+Status index_store(TagIndex *index, const FileIdentity *id, const char *path, const TagFields *fields);
+
+/*
+ * Function: index_save
+ * Description: Writes the index next to fname and renames it into place. Entries not seen by this scan are kept
+ *              only while their path still names the same file (deleted and replaced files drop out).
+ * Parameters: index - pointer to TagIndex, fname - index file name
+ * Return: Status (e_success/e_failure)
+ */
+Status index_save(TagIndex *index, const char *fname);
+
+/*
+ * Function: index_free
+ * Description: Frees every entry and the hash table
+ * Parameters: index - pointer to TagIndex
+ * Return: void
+ */
+void index_free(TagIndex *index);
+
+#endif // End of header guard: Marks the end of conditional compilation block started by #ifndef INDEX_H
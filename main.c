@@ -1,218 +1,426 @@
-/**
- * ----------------------------------------------------------------------------------------------------------------
- * TITLE: MP3 Tag Reader and Editor
- * AUTHOR: Manu H P
- * DATE: 27-Nov-2025
- * DESCRIPTION: Main program to read, view, and edit MP3 ID3 tag data with command-line interface.
- *              Supports viewing tags, editing specific tags, and displaying version information.
- * ----------------------------------------------------------------------------------------------------------------
- */
-
-#include <stdio.h>   // Header file for standard input/output functions (printf, scanf, etc.)
-#include <string.h>  // Header file for string manipulation functions (strcmp, strlen, strcpy, etc.)
-#include "type.h"    // User-defined header file for custom type definitions (Status, e_success, e_failure)
-#include "view.h"    // User-defined header file for MP3 tag viewing operations and ViewInfo structure
-#include "edit.h"    // User-defined header file for MP3 tag editing operations and EditInfo structure
-#include "version.h" // User-defined header file for MP3 version reading operations and VersionInfo structure
-
-/**
- * -----------------------------------------------------------------------------------------------------------
- * INFO: DISPLAY HELP
- * -----------------------------------------------------------------------------------------------------------
- * Function: display_help
- * Description: Displays usage instructions, valid command-line options, and example commands for the user
- * Parameters: None
- * Return: void
- * -----------------------------------------------------------------------------------------------------------
- * This function prints comprehensive help information explaining how to use the MP3 Tag Reader and Editor,
- * including all valid options, their meanings, and syntax for different operations.
- * -----------------------------------------------------------------------------------------------------------
- * Sample Commands:
- *  ./a.out --help                              → Display help information
- *  ./a.out --version sample.mp3                → Display ID3 version information
- *  ./a.out -v sample.mp3                       → View all tags (Title, Artist, Album, Year, Genre, Comment)
- *  ./a.out -e -t "Song Name" sample.mp3        → Edit title tag
- *  ./a.out -e -a "Artist Name" sample.mp3      → Edit artist tag
- *  ./a.out -e -A "Album Name" sample.mp3       → Edit album tag
- *  ./a.out -e -y "2025" sample.mp3             → Edit year tag
- *  ./a.out -e -g "Pop" sample.mp3              → Edit genre tag
- *  ./a.out -e -c "My Comment" sample.mp3       → Edit comment tag
- * -----------------------------------------------------------------------------------------------------------
- */
-void display_help()
-{
-  printf("\033[1;91mUsage: \033[1;97m./a.out [\033[1;91moptions\033[0m] \033[1;97mfilename\n"); // Display usage syntax with color formatting (red for options, white for text)
-
-  printf("\033[1;91mOptions:\n"); // Display "Options:" header in red color
-
-  printf("  \033[1;91m--help               \033[1;97mDisplay help\n"); // Display --help option: Shows this help menu
-
-  printf("  \033[1;91m--version            \033[1;97mDisplay version\n"); // Display --version option: Shows ID3 version information from MP3 file
-
-  printf("  \033[1;91m-v\033[0m                   \033[1;97mView tags\n"); // Display -v option: Views all tags in the MP3 file (TIT2, TPE1, TALB, TYER, TCON, COMM)
-
-  // Display -e option: Edit tags with various sub-options
-  // -t: Title, -a: Artist, -A: Album, -y: Year, -g: Genre, -c: Comment
-  printf("  \033[1;91m-e \033[1;93m-t/-a/-A/-y/-g/-c/\033[0m \033[1;97m<\033[1;96mvalue\033[1;0m\033[1;97m>  Edit tags\n");
-}
-
-/**
- * -----------------------------------------------------------------------------------------------------------
- * INFO: DISPLAY ERROR
- * -----------------------------------------------------------------------------------------------------------
- * Function: display_error
- * Description: Displays an error message when invalid command-line arguments are passed
- * Parameters: argv - command-line argument vector (to display program name)
- * Return: void
- * -----------------------------------------------------------------------------------------------------------
- * This function is called when the user provides incorrect arguments or insufficient parameters.
- * It displays the program name and suggests using --help for proper usage instructions.
- * -----------------------------------------------------------------------------------------------------------
- */
-void display_error(char **argv)
-{
-
-  printf("\033[1;91mERROR: \033[1;97m%s: Invalid Arguments\n", argv[0]); // Display error message with program name (argv[0]) in red and white color formatting
-
-  printf("\033[1;92mUsage: \033[1;97m\"%s --help\" for help\n", argv[0]); // Suggest using --help option for correct usage information (green "Usage:", white text)
-}
-
-/**
- * --------------------------------------------------------------------------------------------------
- * INFO: MAIN FUNCTION
- * --------------------------------------------------------------------------------------------------
- * Function: main
- * Description: Entry point of MP3 Tag Reader and Editor program
- *
- * This function processes command-line arguments and routes control to appropriate functionality:
- * 1. --help      : Displays help information
- * 2. --version   : Displays ID3 version from MP3 file
- * 3. -v          : Views all tags from MP3 file
- * 4. -e          : Edits a specific tag with user-provided value
- *
- * Parameters:
- *   argc - Argument count (number of command-line arguments)
- *   argv - Argument vector (array of command-line argument strings)
- *
- * Return:
- *   0 - Success
- *   1 - Failure (invalid arguments or operation failed)
- *
- * Command-line Argument Structure:
- *   argv[0] → Program name (./a.out)
- *   argv[1] → Primary option (--help, --version, -v, -e)
- *   argv[2] → Secondary option or filename (-t, -a, -A, -y, -g, -c, or sample.mp3)
- *   argv[3] → User-provided value (for edit operation)
- *   argv[4] → Filename (for edit operation)
- *
- * Example Usage:
- *    ./a.out --help                           → Display help
- *    ./a.out --version sample.mp3             → Display ID3 version
- *    ./a.out -v sample.mp3                    → View all tags
- *    ./a.out -e -t "Hello Song" sample.mp3    → Edit title tag to "Hello Song"
- *    ./a.out -e -a "Artist" sample.mp3        → Edit artist tag to "Artist"
- * --------------------------------------------------------------------------------------------------
- */
-int main(int argc, char *argv[])
-{
-  // ----------------------- ARGUMENT COUNT VALIDATION -----------------------
-  if (argc < 2) // Check if minimum number of arguments provided (at least program name (./a.out) + one option)
-  {
-    display_error(argv); // Display error message for insufficient arguments
-    return 1;            // Return failure status
-  }
-
-  // ----------------------- HELP OPTION -----------------------
-  if (strcmp(argv[1], "--help") == 0) // Check if user requested help information (--help)
-  {
-    display_help(); // Display comprehensive help information
-    return 0;       // Return success status after displaying help
-  }
-
-  /**
-   * ----------------------- FILENAME VALIDATION -----------------------
-   * Check if options that require a filename have sufficient arguments
-   * Most options (--version, -v, -e) need at least 3 arguments
-   */
-  if (argc < 3)
-  {
-    display_error(argv); // Display error if filename not provided
-    return 1;            // Return failure status (added missing return)
-  }
-
-  /**
-   * ----------------------- VERSION OPTION -----------------------
-   * Check if user wants to view ID3 version (--version) with exactly 3 arguments
-   * Expected: ./a.out --version sample.mp3
-   */
-  else if (strcmp(argv[1], "--version") == 0 && argc == 3)
-  {
-    VersionInfo VERInfo; // Declare VersionInfo structure to store version data
-
-    if (read_and_validate_for_version(argv, &VERInfo) == e_failure) // Validate command-line arguments for version operation
-    {
-      return 0; // Return if validation fails (file not found or invalid)
-    }
-    else
-    {
-      version_read(&VERInfo); // Read and display ID3 version information from MP3 file
-    }
-  }
-
-  /**
-   * ----------------------- VIEW TAG OPTION -----------------------
-   * Check if user wants to view all tags (-v) with exactly 3 arguments
-   * Expected: ./a.out -v sample.mp3
-   */
-  else if (strcmp(argv[1], "-v") == 0 && argc == 3)
-  {
-    ViewInfo viInfo; // Declare ViewInfo structure to store tag information
-
-    if (read_and_validate_for_view(argv, &viInfo) == e_failure) // Validate command-line arguments for view operation
-    {
-      return 0; // Return if validation fails (file not found or invalid format)
-    }
-    else
-    {
-      view_tags(&viInfo); // View all tags (TITLE, ARTIST, ALBUM, YEAR, GENRE, COMMENT) from MP3 file
-    }
-  }
-  /**
-   * ----------------------- EDIT TAG OPTION -----------------------
-   * Check if user wants to edit a specific tag (-e) with exactly 5 arguments
-   * Expected: ./a.out -e -t "New Title" sample.mp3
-      argv[1] = "-e" (edit mode)
-      argv[2] = "-t/-a/-A/-y/-g/-c" (tag specifier)
-      argv[3] = "New Value" (user-provided content)
-      argv[4] = "sample.mp3" (filename)
-  */
-  else if (strcmp(argv[1], "-e") == 0 && argc == 5)
-  {
-    EditInfo editInfo; // Declare EditInfo structure to store edit information
-
-    // Validate command-line arguments for edit operation
-    // This maps tag flags (-t, -a, -A, -y, -g, -c) to ID3 tags (TIT2, TPE1, TALB, TYER, TCON, COMM)
-    if (read_and_validate_for_edit(argv, &editInfo) == e_failure)
-    {
-
-      printf("\033[1;91mFailed to edit tag.\033[0m\n"); // Display error message if validation fails (invalid flag or file)
-      return 1;                                         // Return failure status
-    }
-    else
-    {
-      do_edit_tags(&editInfo); // Perform tag editing operation (opens files, edits tag, writes back)
-    }
-
-    printf("\033[1;97mTag edited successfully.\n"); // Display success message after tag editing completes
-  }
-
-  // ----------------------- INVALID OPTION -----------------------
-  // Handle any invalid or unrecognized command-line options
-  else
-  {
-    display_error(argv); // Display error message for invalid arguments
-    return 1;            // Return failure status
-  }
-
-  return 0; // Return success status if program executed successfully
-}
+/**
+ * ----------------------------------------------------------------------------------------------------------------
+ * TITLE: MP3 Tag Reader and Editor
+ * AUTHOR: Manu H P
+ * DATE: 27-Nov-2025
+ * DESCRIPTION: Main program to read, view, and edit MP3 ID3 tag data with command-line interface.
+ *              Supports viewing tags, editing specific tags, and displaying version information.
+ * ----------------------------------------------------------------------------------------------------------------
+ */
+
+#include <stdio.h>   // Header file for standard input/output functions (printf, scanf, etc.)
+#include <string.h>  // Header file for string manipulation functions (strcmp, strlen, strcpy, etc.)
+#include <stdlib.h>  // Header file for memory allocation functions (malloc, free)
+#include "type.h"    // User-defined header file for custom type definitions (Status, e_success, e_failure)
+#include "view.h"    // User-defined header file for MP3 tag viewing operations and ViewInfo structure
+#include "edit.h"    // User-defined header file for MP3 tag editing operations and EditInfo structure
+#include "edit_cli.h" // User-defined header file for -e arguments and the --padding option
+#include "version.h" // User-defined header file for MP3 version reading operations and VersionInfo structure
+#include "scan.h"    // User-defined header file for recursive parallel library scan (ScanInfo structure)
+#include "batch.h"   // User-defined header file for manifest-driven batch editing (BatchInfo structure)
+#include "query.h"   // User-defined header file for indexed tag queries (QueryInfo structure)
+#include "output.h"  // User-defined header file for JSON Lines / TSV output (--format)
+#include "cover.h"   // User-defined header file for streamed cover-art extraction (CoverInfo structure)
+#include "audio.h"   // User-defined header file for MPEG audio analysis (AudioInfo structure)
+#include "hash.h"    // User-defined header file for audio payload hashing and duplicate report (HashInfo structure)
+#include "stats.h"   // User-defined header file for per-run phase timing and I/O counters (--stats)
+#include "serve.h"   // User-defined header file for the tag service on a Unix socket (ServeInfo structure)
+
+/**
+ * -----------------------------------------------------------------------------------------------------------
+ * INFO: DISPLAY HELP
+ * -----------------------------------------------------------------------------------------------------------
+ * Function: display_help
+ * Description: Displays usage instructions, valid command-line options, and example commands for the user
+ * Parameters: None
+ * Return: void
+ * -----------------------------------------------------------------------------------------------------------
+ * This function prints comprehensive help information explaining how to use the MP3 Tag Reader and Editor,
+ * including all valid options, their meanings, and syntax for different operations.
+ * -----------------------------------------------------------------------------------------------------------
+ * Sample Commands:
+ *  ./a.out --help                              → Display help information
+ *  ./a.out --version sample.mp3                → Display ID3 version information
+ *  ./a.out -v sample.mp3                       → View all tags (Title, Artist, Album, Year, Genre, Comment)
+ *  ./a.out -v music/ extra.mp3                 → Scan directories/files in parallel, one line per file
+ *  find . -print0 | ./a.out -v -               → Scan NUL-separated paths read from standard input
+ *  ./a.out -e -t "Song Name" sample.mp3        → Edit title tag
+ *  ./a.out -e -a "Artist Name" sample.mp3      → Edit artist tag
+ *  ./a.out -e -A "Album Name" sample.mp3       → Edit album tag
+ *  ./a.out -e -y "2025" sample.mp3             → Edit year tag
+ *  ./a.out -e -g "Pop" sample.mp3              → Edit genre tag
+ *  ./a.out -e -c "My Comment" sample.mp3       → Edit comment tag
+ *  ./a.out -e -t "Song" -a "Artist" sample.mp3 → Edit several tags in one rewrite
+ *  ./a.out -b edits.csv                        → Apply a CSV / JSON Lines manifest of edits in parallel
+ *  ./a.out -q music.idx artist=X year=1998..2003 → Query the index built by a scan with --index=music.idx
+ *  ./a.out -v --format=json music/             → Scan with one JSON object per file (no escape sequences)
+ *  ./a.out -x sample.mp3 - | feh -             → Stream the front cover to another program
+ *  ./a.out --info sample.mp3                   → Duration, bitrate, sample rate and channel mode of the audio
+ *  ./a.out --dupes music/                      → Groups of files with identical audio, whatever their tags
+ *  ./a.out -b edits.csv --stats=json           → Batch edit, then phase timings and I/O counters as JSON on stderr
+ *  ./a.out -e -t "Song" --padding=align:4096 sample.mp3 → Rewritten tag padded so the audio starts on a 4 KiB boundary
+ *  ./a.out --serve /run/mp3tag.sock            → Long-running tag service (e.g. printf 'VIEW\tsample.mp3\n' | nc -U ...)
+ * -----------------------------------------------------------------------------------------------------------
+ */
+void display_help()
+{
+  printf("\033[1;91mUsage: \033[1;97m./a.out [\033[1;91moptions\033[0m] \033[1;97mfilename\n"); // Display usage syntax with color formatting (red for options, white for text)
+
+  printf("\033[1;91mOptions:\n"); // Display "Options:" header in red color
+
+  printf("  \033[1;91m--help               \033[1;97mDisplay help\n"); // Display --help option: Shows this help menu
+
+  printf("  \033[1;91m--version            \033[1;97mDisplay version\n"); // Display --version option: Shows ID3 version information from MP3 file
+
+  printf("  \033[1;91m-v\033[0m                   \033[1;97mView tags\n"); // Display -v option: Views all tags in the MP3 file (TIT2, TPE1, TALB, TYER, TCON, COMM)
+
+  printf("  \033[1;91m-v \033[1;93m<dir|files...|->\033[0m    \033[1;97mScan directories recursively (\"-\" reads NUL-separated paths from stdin)\n"); // Display scan mode of -v
+
+  printf("  \033[1;91m   \033[1;93m--io=uring|threads\033[0m   \033[1;97mScan I/O backend (thread pool by default; io_uring when available)\n"); // Display scan backend option
+
+  printf("  \033[1;91m   \033[1;93m--index=FILE\033[0m         \033[1;97mScan index: unchanged files are answered without being opened\n"); // Display scan index option
+
+  // Display -e option: Edit tags with various sub-options
+  // -t: Title, -a: Artist, -A: Album, -y: Year, -g: Genre, -c: Comment
+  printf("  \033[1;91m-e \033[1;93m-t/-a/-A/-y/-g/-c/\033[0m \033[1;97m<\033[1;96mvalue\033[1;0m\033[1;97m>  Edit tags (repeat pairs to edit several tags at once)\n");
+
+  printf("  \033[1;91m-b \033[1;93m<manifest|->\033[0m         \033[1;97mBatch edit from CSV (path,field,value,...) or JSON Lines ({\"path\":...,\"title\":...})\n"); // Display -b option
+
+  printf("  \033[1;91m-q \033[1;93m<index> <terms...>\033[0m   \033[1;97mQuery an index: field=value, field^=prefix, year=from..to (case-insensitive)\n"); // Display -q option
+
+  printf("  \033[1;91m-x \033[1;93m<file.mp3> [out|-]\033[0m   \033[1;97mExtract the front cover (default cover.jpg / cover.png, \"-\" for stdout)\n"); // Display -x option
+
+  printf("  \033[1;91m--info \033[1;93m<files...>\033[0m       \033[1;97mAudio analysis: duration, bitrate, sample rate, channels (Xing/Info/VBRI header or frame walk)\n"); // Display --info option
+
+  printf("  \033[1;91m--serve \033[1;93m<socket>\033[0m        \033[1;97mServe VIEW / VERSION / EDIT requests on a Unix socket (tab-separated lines, JSON replies, warm tag cache)\n"); // Display --serve option
+
+  printf("  \033[1;91m--stats\033[1;93m[=json]\033[0m          \033[1;97mAt exit: wall/CPU time per phase, bytes and calls read/written, heap growth, peak RSS, batch latency histogram\n"); // Display --stats option
+
+  printf("  \033[1;91m--hash \033[1;93m<dir|files...>\033[0m   \033[1;97mHash of the audio payload only (ID3v2, ID3v1 and APE tags excluded)\n"); // Display --hash option
+
+  printf("  \033[1;91m--dupes \033[1;93m<dir|files...>\033[0m  \033[1;97mReport files whose audio is identical, whatever their tags\n"); // Display --dupes option
+
+  printf("  \033[1;91m--padding=\033[1;93m<policy>\033[0m  \033[1;97mPadding of rewritten tags: none (default), BYTES, PERCENT%% of the frames or align:BYTES (later edits then fit in place)\n"); // Display --padding option
+
+  printf("  \033[1;91m--format=\033[1;93mjson|tsv\033[0m   \033[1;97mOne JSON object / TSV row per file for -v, --version and -q (path, title, artist, album, year, genre, comment)\n"); // Display --format option
+}
+
+/**
+ * -----------------------------------------------------------------------------------------------------------
+ * INFO: DISPLAY ERROR
+ * -----------------------------------------------------------------------------------------------------------
+ * Function: display_error
+ * Description: Displays an error message when invalid command-line arguments are passed
+ * Parameters: argv - command-line argument vector (to display program name)
+ * Return: void
+ * -----------------------------------------------------------------------------------------------------------
+ * This function is called when the user provides incorrect arguments or insufficient parameters.
+ * It displays the program name and suggests using --help for proper usage instructions.
+ * -----------------------------------------------------------------------------------------------------------
+ */
+void display_error(char **argv)
+{
+
+  printf("\033[1;91mERROR: \033[1;97m%s: Invalid Arguments\n", argv[0]); // Display error message with program name (argv[0]) in red and white color formatting
+
+  printf("\033[1;92mUsage: \033[1;97m\"%s --help\" for help\n", argv[0]); // Suggest using --help option for correct usage information (green "Usage:", white text)
+}
+
+/**
+ * --------------------------------------------------------------------------------------------------
+ * INFO: MAIN FUNCTION
+ * --------------------------------------------------------------------------------------------------
+ * Function: main
+ * Description: Entry point of MP3 Tag Reader and Editor program
+ *
+ * This function processes command-line arguments and routes control to appropriate functionality:
+ * 1. --help      : Displays help information
+ * 2. --version   : Displays ID3 version from MP3 file
+ * 3. -v          : Views all tags from MP3 file (or scans directories / many files / stdin list in parallel)
+ * 4. -e          : Edits one or more tags with user-provided values
+ * 5. -b          : Applies a manifest of edits to many files in parallel
+ * 6. -q          : Queries the tag index without touching the music files
+ * 7. -x          : Extracts the embedded cover art without loading it into memory
+ * 8. --info      : Reports duration, bitrate and format of the audio without decoding it
+ * 9. --hash      : Hashes the audio payload of each file, ignoring the tags
+ * 10. --dupes    : Groups files with identical audio payloads across a directory tree
+ * 11. --serve    : Answers view / version / edit requests on a Unix domain socket
+ *
+ * Parameters:
+ *   argc - Argument count (number of command-line arguments)
+ *   argv - Argument vector (array of command-line argument strings)
+ *
+ * Return:
+ *   0 - Success
+ *   1 - Failure (invalid arguments or operation failed)
+ *
+ * Command-line Argument Structure:
+ *   argv[0] → Program name (./a.out)
+ *   argv[1] → Primary option (--help, --version, -v, -e)
+ *   argv[2] → Secondary option or filename (-t, -a, -A, -y, -g, -c, or sample.mp3)
+ *   argv[3] → User-provided value (for edit operation)
+ *   argv[4] → Filename (for edit operation; more tag/value pairs may come first, the filename is always last)
+ *
+ * Example Usage:
+ *    ./a.out --help                           → Display help
+ *    ./a.out --version sample.mp3             → Display ID3 version
+ *    ./a.out -v sample.mp3                    → View all tags
+ *    ./a.out -e -t "Hello Song" sample.mp3    → Edit title tag to "Hello Song"
+ *    ./a.out -e -a "Artist" sample.mp3        → Edit artist tag to "Artist"
+ * --------------------------------------------------------------------------------------------------
+ */
+int main(int argc, char *argv[])
+{
+  // ----------------------- RUN STATISTICS -----------------------
+  // "--stats" or "--stats=json" may appear anywhere; the report is printed on stderr when the program exits
+  if (stats_take_option(&argc, argv) == e_failure)
+  {
+    return 1; // Return failure status for an unknown stats format
+  }
+
+  // ----------------------- OUTPUT FORMAT -----------------------
+  // "--format=json|tsv" may appear anywhere; it is removed here so every command sees its usual arguments
+  if (output_take_format(&argc, argv) == e_failure)
+  {
+    return 1; // Return failure status for an unknown format
+  }
+
+  // ----------------------- TAG PADDING -----------------------
+  // "--padding=none|BYTES|PERCENT%|align:BYTES" may appear anywhere; it sizes every tag that -e, -b or --serve rewrites
+  EditPadding padding; // Handed to every command that rewrites tags
+  if (edit_take_padding(&argc, argv, &padding) == e_failure)
+  {
+    return 1; // Return failure status for an unknown padding
+  }
+
+  // ----------------------- ARGUMENT COUNT VALIDATION -----------------------
+  if (argc < 2) // Check if minimum number of arguments provided (at least program name (./a.out) + one option)
+  {
+    display_error(argv); // Display error message for insufficient arguments
+    return 1;            // Return failure status
+  }
+
+  // ----------------------- HELP OPTION -----------------------
+  if (strcmp(argv[1], "--help") == 0) // Check if user requested help information (--help)
+  {
+    display_help(); // Display comprehensive help information
+    return 0;       // Return success status after displaying help
+  }
+
+  /**
+   * ----------------------- FILENAME VALIDATION -----------------------
+   * Check if options that require a filename have sufficient arguments
+   * Most options (--version, -v, -e) need at least 3 arguments
+   */
+  if (argc < 3)
+  {
+    display_error(argv); // Display error if filename not provided
+    return 1;            // Return failure status (added missing return)
+  }
+
+  /**
+   * ----------------------- VERSION OPTION -----------------------
+   * Check if user wants to view ID3 version (--version) with exactly 3 arguments
+   * Expected: ./a.out --version sample.mp3
+   */
+  else if (strcmp(argv[1], "--version") == 0 && argc == 3)
+  {
+    VersionInfo VERInfo; // Declare VersionInfo structure to store version data
+
+    if (read_and_validate_for_version(argv, &VERInfo) == e_failure) // Validate command-line arguments for version operation
+    {
+      return 0; // Return if validation fails (file not found or invalid)
+    }
+    else
+    {
+      version_read(&VERInfo); // Read and display ID3 version information from MP3 file
+    }
+  }
+
+  /**
+   * ----------------------- LIBRARY SCAN OPTION -----------------------
+   * Check if user wants to scan many files (-v) given as directories, several paths or a NUL-separated stdin list
+   * Expected: ./a.out -v music/ more.mp3      or      find . -name '*.mp3' -print0 | ./a.out -v -
+   */
+  else if (strcmp(argv[1], "-v") == 0 && is_scan_request(argc, argv))
+  {
+    ScanInfo scInfo; // Declare ScanInfo structure to store scan paths and counters
+
+    if (read_and_validate_for_scan(argc, argv, &scInfo) == e_failure) // Store paths to scan
+    {
+      return 1; // Return failure status for an unknown scan option
+    }
+
+    if (scan_library(&scInfo) == e_failure) // Read tags of every .mp3 file on a worker pool
+    {
+      return 1; // Return failure if any file could not be read
+    }
+  }
+
+  /**
+   * ----------------------- VIEW TAG OPTION -----------------------
+   * Check if user wants to view all tags (-v) with exactly 3 arguments
+   * Expected: ./a.out -v sample.mp3
+   */
+  else if (strcmp(argv[1], "-v") == 0 && argc == 3)
+  {
+    ViewInfo viInfo; // Declare ViewInfo structure to store tag information
+
+    if (read_and_validate_for_view(argv, &viInfo) == e_failure) // Validate command-line arguments for view operation
+    {
+      return 0; // Return if validation fails (file not found or invalid format)
+    }
+    else
+    {
+      view_tags(&viInfo); // View all tags (TITLE, ARTIST, ALBUM, YEAR, GENRE, COMMENT) from MP3 file
+    }
+  }
+  /**
+   * ----------------------- EDIT TAG OPTION -----------------------
+   * Check if user wants to edit tags (-e) with one or more flag/value pairs
+   * Expected: ./a.out -e -t "New Title" -a "New Artist" sample.mp3
+      argv[1] = "-e" (edit mode)
+      argv[2] = "-t/-a/-A/-y/-g/-c" (tag specifier)
+      argv[3] = "New Value" (user-provided content)
+      ...       more tag specifier / value pairs (all applied in one rewrite)
+      argv[argc - 1] = "sample.mp3" (filename)
+  */
+  else if (strcmp(argv[1], "-e") == 0 && argc >= 5 && argc % 2 == 1)
+  {
+    EditInfo editInfo; // Declare EditInfo structure to store edit information
+
+    // Validate command-line arguments for edit operation
+    // This maps tag flags (-t, -a, -A, -y, -g, -c) to ID3 tags (TIT2, TPE1, TALB, TYER, TCON, COMM)
+    if (read_and_validate_for_edit(argc, argv, &editInfo) == e_failure)
+    {
+
+      printf("\033[1;91mFailed to edit tag.\033[0m\n"); // Display error message if validation fails (invalid flag or file)
+      return 1;                                         // Return failure status
+    }
+
+    StatsTimer phase_timer; // Library steps of the edit (--stats)
+    editInfo.phase_hook = stats_phase_hook;
+    editInfo.phase_context = &phase_timer;
+    if (do_edit_tags(&editInfo, &padding) == e_failure) // Perform tag editing operation (opens file, edits all selected tags, writes back)
+    {
+      printf("\033[1;91mFailed to edit tag.\033[0m\n"); // Display error message if the file could not be edited
+      return 1;                                         // Return failure status
+    }
+
+    printf("\033[1;97mTag edited successfully.\n"); // Display success message after tag editing completes
+  }
+
+  /**
+   * ----------------------- BATCH EDIT OPTION -----------------------
+   * Check if user wants to apply a manifest of edits (-b) to many files
+   * Expected: ./a.out -b edits.csv      or      ./a.out -b - < edits.jsonl
+   */
+  else if (strcmp(argv[1], "-b") == 0)
+  {
+    BatchInfo batchInfo; // Declare BatchInfo structure to store manifest entries and counters
+
+    if (read_and_validate_for_batch(argc, argv, &batchInfo) == e_failure) // Validate manifest argument
+    {
+      return 1; // Return failure status
+    }
+
+    batchInfo.padding = padding;
+    if (do_batch_edit(&batchInfo) == e_failure) // Edit every file listed in the manifest
+    {
+      return 1; // Return failure if any line or file failed
+    }
+  }
+
+  /**
+   * ----------------------- QUERY OPTION -----------------------
+   * Check if user wants to search the index built by "-v --index=FILE" (-q)
+   * Expected: ./a.out -q music.idx artist=radiohead year=1998..2003 title^=kar
+   */
+  else if (strcmp(argv[1], "-q") == 0)
+  {
+    QueryInfo qInfo; // Declare QueryInfo structure to store the terms and the mapped query index
+
+    if (read_and_validate_for_query(argc, argv, &qInfo) == e_failure || run_query(&qInfo) == e_failure) // Parse terms, search
+    {
+      return 1; // Return failure status
+    }
+  }
+
+  /**
+   * ----------------------- COVER OPTION -----------------------
+   * Check if user wants to extract the embedded picture (-x)
+   * Expected: ./a.out -x sample.mp3 [cover.jpg|-]
+   */
+  else if (strcmp(argv[1], "-x") == 0)
+  {
+    CoverInfo coInfo; // Declare CoverInfo structure to store the source, output and picture location
+
+    if (read_and_validate_for_cover(argc, argv, &coInfo) == e_failure || extract_cover(&coInfo) == e_failure) // Locate, stream
+    {
+      return 1; // Return failure status
+    }
+  }
+
+  /**
+   * ----------------------- INFO OPTION -----------------------
+   * Check if user wants the audio analysis (--info)
+   * Expected: ./a.out --info sample.mp3 [more.mp3 ...]
+   */
+  else if (strcmp(argv[1], "--info") == 0)
+  {
+    AudioInfo auInfo; // Declare AudioInfo structure to store the files to analyse
+
+    if (read_and_validate_for_info(argc, argv, &auInfo) == e_failure || audio_info(&auInfo) == e_failure) // Analyse every file
+    {
+      return 1; // Return failure status
+    }
+  }
+
+  /**
+   * ----------------------- HASH / DUPES OPTION -----------------------
+   * Check if user wants the audio hashes (--hash) or the duplicate report (--dupes)
+   * Expected: ./a.out --hash|--dupes music/ [more paths ...]
+   */
+  else if (strcmp(argv[1], "--hash") == 0 || strcmp(argv[1], "--dupes") == 0)
+  {
+    HashInfo haInfo; // Declare HashInfo structure to store the paths and results
+
+    if (read_and_validate_for_hash(argc, argv, &haInfo) == e_failure || hash_library(&haInfo) == e_failure) // Hash every file
+    {
+      return 1; // Return failure status
+    }
+  }
+
+  /**
+   * ----------------------- SERVE OPTION -----------------------
+   * Check if user wants the long-running tag service (--serve)
+   * Expected: ./a.out --serve /run/mp3tag.sock
+   */
+  else if (strcmp(argv[1], "--serve") == 0)
+  {
+    ServeInfo *seInfo = malloc(sizeof(ServeInfo)); // Cache table is too large for the stack
+
+    if (seInfo == NULL || read_and_validate_for_serve(argc, argv, seInfo) == e_failure)
+    {
+      free(seInfo);
+      return 1; // Return failure status
+    }
+
+    seInfo->padding = padding;
+    if (serve_requests(seInfo) == e_failure) // Runs until SIGINT / SIGTERM
+    {
+      free(seInfo);
+      return 1; // Return failure status
+    }
+  }
+
+  // ----------------------- INVALID OPTION -----------------------
+  // Handle any invalid or unrecognized command-line options
+  else
+  {
+    display_error(argv); // Display error message for invalid arguments
+    return 1;            // Return failure status
+  }
+
+  return 0; // Return success status if program executed successfully
+}
@@ -0,0 +1,119 @@
+#include <stdio.h>    // Header file for standard input/output functions (perror)
+#include <string.h>   // Header file for string/memory functions (memset)
+#include <fcntl.h>    // Header file for open() and its flags (O_RDONLY)
+#include <unistd.h>   // Header file for POSIX functions (close)
+#include <sys/mman.h> // Header file for memory mapping functions (mmap, munmap, madvise)
+#include <sys/stat.h> // Header file for file status information (fstat)
+#include "type.h"     // User-defined header file for custom type definitions (Status, e_success, e_failure)
+#include "id3.h"      // User-defined header file for ID3v2 header/frame parsing
+#include "frames.h"   // User-defined header file for frame IDs as integers (id3_frame_id)
+#include "mapview.h"  // User-defined header file for memory-mapped frame view declarations
+
+/*
+ * Function: id3_map_open
+ * Description: mmaps the file read-only, validates the ID3v2 header and records where the tag region lies
+ * Parameters: path - MP3 filename, map - pointer to Id3Map to fill
+ * Return: Status (e_success/e_failure)
+ */
+Status id3_map_open(const char *path, Id3Map *map)
+{
+  memset(map, 0, sizeof(*map)); // Start with an empty map so id3_map_close is always safe
+
+  int fd = open(path, O_RDONLY); // Open source MP3 file in read mode
+
+  if (fd == -1) // Error handling: file opening failed
+  {
+    perror("open");
+    return e_failure;
+  }
+
+  struct stat st; // File status (size of the mapping)
+
+  if (fstat(fd, &st) == -1 || st.st_size < ID3_HEADER_SIZE) // Error handling: unknown size or too small for a header
+  {
+    close(fd);
+    return e_failure;
+  }
+
+  void *p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0); // Map whole file; pages are read only when touched
+  close(fd);                                                              // Mapping stays valid after the descriptor is closed
+
+  if (p == MAP_FAILED) // Error handling: mapping failed
+  {
+    perror("mmap");
+    return e_failure;
+  }
+
+  map->map = p;                          // Start of mapping
+  map->map_len = (size_t)st.st_size;     // Length of mapping
+
+  if (id3_parse_header(map->map, &map->header) == e_failure) // Validate "ID3" header inside the mapping
+  {
+    id3_map_close(map); // Unmap file without an ID3v2 tag
+    return e_failure;
+  }
+
+  map->tag = map->map + ID3_HEADER_SIZE;                            // Tag region follows the 10-byte header
+  map->tag_len = map->header.tag_size;                              // Declared tag size
+  if (map->tag_len > map->map_len - ID3_HEADER_SIZE)                // Truncated file: expose only bytes that exist
+  {
+    map->tag_len = map->map_len - ID3_HEADER_SIZE;
+  }
+
+  madvise((void *)map->map, ID3_HEADER_SIZE + map->tag_len, MADV_WILLNEED); // Ask the kernel to fault in the tag pages up front
+
+  if (id3_tag_open(&map->header, map->tag, map->tag_len, &map->view) == e_failure) // Unknown version or corrupt layout
+  {
+    id3_map_close(map);
+    return e_failure;
+  }
+  return e_success;
+}
+
+/*
+ * Function: id3_map_next
+ * Description: Produces a zero-copy view of the next frame in the mapped tag
+ * Parameters: map - opened map, pos - frame offset, frame - Id3Frame to fill
+ * Return: 1 if a frame was produced, 0 at padding or end of tag
+ */
+int id3_map_next(const Id3Map *map, size_t *pos, Id3Frame *frame)
+{
+  return map->view.next(map->view.data, map->view.len, pos, frame); // Frame body pointer refers into the mapping (or the resynchronised copy)
+}
+
+/*
+ * Function: id3_map_find
+ * Description: Linear walk over mapped frames until the requested ID is found
+ * Parameters: map - opened map, id - 4-character frame ID, frame - Id3Frame to fill
+ * Return: Status (e_success/e_failure)
+ */
+Status id3_map_find(const Id3Map *map, const char *id, Id3Frame *frame)
+{
+  size_t pos = map->view.start;       // Start at the first frame (after the extended header)
+  uint32_t wanted = id3_frame_id(id); // Compare integers instead of 4-byte strings
+
+  while (id3_map_next(map, &pos, frame)) // Walk frames without copying
+  {
+    if (frame->id32 == wanted) // Requested frame found
+    {
+      return e_success;
+    }
+  }
+  return e_failure; // Frame not present in this tag
+}
+
+/*
+ * Function: id3_map_close
+ * Description: Releases the mapping
+ * Parameters: map - pointer to Id3Map
+ * Return: void
+ */
+void id3_map_close(Id3Map *map)
+{
+  id3_tag_close(&map->view); // Resynchronised copy, if one was made
+  if (map->map != NULL)      // Only unmap what was mapped
+  {
+    munmap((void *)map->map, map->map_len);
+  }
+  memset(map, 0, sizeof(*map)); // Views from this map are no longer valid
+}
@@ -0,0 +1,52 @@
+#ifndef MAPVIEW_H // If not defined MAPVIEW_H ---> Checks if MAPVIEW_H was previously defined: If not present, code is processed; else code below till #endif is ignored
+#define MAPVIEW_H // Defines the macro MAPVIEW_H if macro was not previously defined
+
+#include <stddef.h> // Header file for size_t
+#include "type.h"   // User-defined header file for custom type definitions (Status, e_success, e_failure)
+#include "id3.h"    // User-defined header file for Id3Header and Id3Frame (frame views)
+
+// Structure describing a read-only memory mapping of an MP3 file and the ID3v2 tag inside it
+typedef struct // typedef used to give alternate name for structure here
+{
+  const unsigned char *map; // Start of the read-only mapping (whole file)
+  size_t map_len;           // Length of the mapping in bytes
+  Id3Header header;         // Decoded 10-byte ID3v2 header
+  const unsigned char *tag; // Start of the tag region (frames + padding) inside the mapping
+  size_t tag_len;           // Length of the tag region actually present in the file
+  Id3TagView view;          // Frame area of the tag for its version (points into the mapping unless resynchronised)
+} Id3Map;                   // Id3Map is alternate name for this structure
+
+/*
+ * Function: id3_map_open
+ * Description: Maps an MP3 file read-only and locates its ID3v2 tag. No frame body is copied or allocated;
+ *              frames returned by id3_map_next/id3_map_find point straight into the mapping.
+ * Parameters: path - MP3 filename, map - pointer to Id3Map to fill
+ * Return: Status (e_success/e_failure)
+ */
+Status id3_map_open(const char *path, Id3Map *map);
+
+/*
+ * Function: id3_map_next
+ * Description: Returns a view (ID, flags, pointer + length) of the frame at *pos and advances *pos
+ * Parameters: map - pointer to opened Id3Map, pos - frame offset (start with map->view.start), frame - pointer to Id3Frame to fill
+ * Return: 1 if a frame was produced, 0 at padding or end of tag
+ */
+int id3_map_next(const Id3Map *map, size_t *pos, Id3Frame *frame);
+
+/*
+ * Function: id3_map_find
+ * Description: Finds the first frame with the given 4-character ID and returns a view of it
+ * Parameters: map - pointer to opened Id3Map, id - frame ID (e.g., "TIT2"), frame - pointer to Id3Frame to fill
+ * Return: Status (e_success if found, e_failure otherwise)
+ */
+Status id3_map_find(const Id3Map *map, const char *id, Id3Frame *frame);
+
+/*
+ * Function: id3_map_close
+ * Description: Unmaps the file; all frame views obtained from this map become invalid
+ * Parameters: map - pointer to Id3Map
+ * Return: void
+ */
+void id3_map_close(Id3Map *map);
+
+#endif // End of header guard: Marks the end of conditional compilation block started by #ifndef MAPVIEW_H
@@ -0,0 +1,585 @@
+#include <stdlib.h> // Header file for memory allocation functions (malloc, calloc, free)
+#include <string.h> // Header file for string functions (strdup, memcpy)
+#include <errno.h>  // Header file for errno (EINVAL for bad descriptors, kept across cleanup)
+#include <fcntl.h>  // Header file for open() / fcntl() and access mode flags
+#include <unistd.h> // Header file for POSIX functions (close, dup)
+#include "type.h"   // User-defined header file for custom type definitions (Status, e_success, e_failure)
+#include "mp3tag.h" // Library header file for the public API (Mp3Tag, Mp3TagError)
+#include "id3.h"    // User-defined header file for ID3v2 header and frame decoding (Id3Header, TagFields)
+#include "trailer.h" // User-defined header file for the trailer probe (ID3v1, APEv2, Lyrics3v2, appended ID3v2)
+#include "edit.h"   // User-defined header file for the edit engine (EditInfo, edit_open_file_tags, edit_buffer_tags)
+
+// Structure behind the opaque Mp3Tag handle: everything one open source needs, nothing shared between handles
+struct Mp3Tag
+{
+  int fd;                         // Source descriptor (-1 for a buffer source)
+  int owns_fd;                    // 1 when the library opened the file and closes it
+  int stale;                      // 1 when a commit renamed a new file over the path and it could not be reopened
+  int writable;                   // 1 when mp3tag_commit may write the source
+  char *path;                     // Path of a file source (commits rename beside it; NULL for descriptor and buffer sources)
+  const unsigned char *data;      // Caller's buffer (NULL for file sources)
+  size_t len;                     // Length of the caller's buffer
+  unsigned char *image;           // Edited image of a buffer source after a commit (NULL before)
+  size_t image_len;               // Length of image
+  int has_id3v2;                  // 1 when the source starts with a valid ID3v2 header
+  Id3Header header;               // Decoded ID3v2 header
+  int parsed;                     // 1 after a successful mp3tag_parse
+  TagFields fields;               // Parsed values (ID3v2 first, trailer tags for missing fields)
+  char *pending[TAG_FIELD_COUNT]; // Values staged by mp3tag_set_frame (NULL = unchanged)
+  Mp3TagPadMode pad_mode;         // Padding policy of commits that write a new tag
+  size_t pad_amount;              // Bytes, percent or block size of the policy
+  Mp3TagPhaseHook phase_hook;     // Caller's phase callback (NULL = none)
+  void *phase_context;            // Passed to phase_hook
+};
+
+/*
+ * Function: phase
+ * Description: Tells the handle's phase hook, if any, that a phase starts or stops
+ * Parameters: tag - handle, which - phase, end - 0 at the start, 1 at the stop
+ * Return: void
+ */
+static void phase(const Mp3Tag *tag, Mp3TagPhase which, int end)
+{
+  if (tag->phase_hook != NULL)
+  {
+    tag->phase_hook(tag->phase_context, which, end);
+  }
+}
+
+/*
+ * Function: source_bytes
+ * Description: Current bytes of a buffer source: the edited image after a commit, else the caller's buffer
+ * Parameters: tag - handle, len - receives the length
+ * Return: const unsigned char * - image bytes
+ */
+static const unsigned char *source_bytes(const Mp3Tag *tag, size_t *len)
+{
+  *len = tag->image ? tag->image_len : tag->len;
+  return tag->image ? tag->image : tag->data;
+}
+
+/*
+ * Function: read_header
+ * Description: Decodes the ID3v2 header of the source (one pread for file sources)
+ * Parameters: tag - handle
+ * Return: void (has_id3v2 tells whether a header was found)
+ */
+static void read_header(Mp3Tag *tag)
+{
+  if (tag->stale) // fd still names the replaced file: keep the header of the last parse
+  {
+    return;
+  }
+  if (tag->fd != -1)
+  {
+    tag->has_id3v2 = (id3_read_header(tag->fd, &tag->header) == e_success);
+    return;
+  }
+
+  size_t len;
+  const unsigned char *data = source_bytes(tag, &len);
+  tag->has_id3v2 = (len >= ID3_HEADER_SIZE && id3_parse_header(data, &tag->header) == e_success);
+}
+
+/*
+ * Function: new_handle
+ * Description: Allocates a handle with no source
+ * Parameters: tag - receives the handle
+ * Return: Mp3TagError (e_mp3tag_ok/e_mp3tag_argument/e_mp3tag_memory)
+ */
+static Mp3TagError new_handle(Mp3Tag **tag)
+{
+  if (tag == NULL)
+  {
+    return e_mp3tag_argument;
+  }
+  *tag = calloc(1, sizeof(Mp3Tag)); // No fields, no staged values, no image
+  if (*tag == NULL)
+  {
+    return e_mp3tag_memory;
+  }
+  (*tag)->fd = -1;
+  return e_mp3tag_ok;
+}
+
+/*
+ * Function: mp3tag_open_file
+ * Description: Opens the file (read-write when writable) and reads its ID3v2 header
+ * Parameters: path - file to open, writable - 1 to allow commits, tag - receives the handle
+ * Return: Mp3TagError (e_mp3tag_ok/e_mp3tag_argument/e_mp3tag_io/e_mp3tag_memory)
+ */
+Mp3TagError mp3tag_open_file(const char *path, int writable, Mp3Tag **tag)
+{
+  Mp3TagError error = (path != NULL) ? new_handle(tag) : e_mp3tag_argument;
+
+  if (error != e_mp3tag_ok)
+  {
+    return error;
+  }
+
+  (*tag)->fd = open(path, writable ? O_RDWR : O_RDONLY);
+  (*tag)->owns_fd = 1;
+  (*tag)->writable = writable;
+  (*tag)->path = strdup(path); // Kept for rename commits
+  if ((*tag)->fd == -1 || (*tag)->path == NULL)
+  {
+    error = ((*tag)->fd == -1) ? e_mp3tag_io : e_mp3tag_memory;
+    mp3tag_close(*tag);
+    *tag = NULL;
+    return error;
+  }
+
+  read_header(*tag);
+  return e_mp3tag_ok;
+}
+
+/*
+ * Function: mp3tag_open_fd
+ * Description: Wraps a caller's descriptor (writable when it was opened O_RDWR) and reads its ID3v2 header
+ * Parameters: fd - open descriptor, tag - receives the handle
+ * Return: Mp3TagError (e_mp3tag_ok/e_mp3tag_argument/e_mp3tag_io/e_mp3tag_memory)
+ */
+Mp3TagError mp3tag_open_fd(int fd, Mp3Tag **tag)
+{
+  int flags = fcntl(fd, F_GETFL); // Access mode decides whether commits are allowed
+
+  if (flags == -1)
+  {
+    return e_mp3tag_io; // errno is EBADF
+  }
+  Mp3TagError error = new_handle(tag);
+  if (error != e_mp3tag_ok)
+  {
+    return error;
+  }
+  (*tag)->fd = fd;
+  (*tag)->writable = ((flags & O_ACCMODE) == O_RDWR);
+  read_header(*tag);
+  return e_mp3tag_ok;
+}
+
+/*
+ * Function: mp3tag_open_buffer
+ * Description: Wraps a caller's file image and decodes its ID3v2 header
+ * Parameters: data - file bytes, len - length of data, tag - receives the handle
+ * Return: Mp3TagError (e_mp3tag_ok/e_mp3tag_argument/e_mp3tag_memory)
+ */
+Mp3TagError mp3tag_open_buffer(const void *data, size_t len, Mp3Tag **tag)
+{
+  Mp3TagError error = (data != NULL || len == 0) ? new_handle(tag) : e_mp3tag_argument;
+
+  if (error != e_mp3tag_ok)
+  {
+    return error;
+  }
+  (*tag)->data = data;
+  (*tag)->len = len;
+  (*tag)->writable = 1; // Commits build a new image; the caller's bytes are never written
+  read_header(*tag);
+  return e_mp3tag_ok;
+}
+
+/*
+ * Function: mp3tag_parse
+ * Description: Probes the trailer tags, then decodes the ID3v2 frames (streamed for file sources, walked in place
+ *              for buffers) and completes missing fields from the trailer tags
+ * Parameters: tag - handle
+ * Return: Mp3TagError (e_mp3tag_ok/e_mp3tag_argument/e_mp3tag_io/e_mp3tag_no_tag)
+ */
+Mp3TagError mp3tag_parse(Mp3Tag *tag)
+{
+  TrailerInfo trailer;
+  size_t len = 0;
+  const unsigned char *data = NULL;
+
+  if (tag == NULL)
+  {
+    return e_mp3tag_argument;
+  }
+  if (tag->stale) // Descriptor names the file a commit replaced
+  {
+    errno = ESTALE;
+    return e_mp3tag_io;
+  }
+  id3_free_fields(&tag->fields); // A second parse starts over
+  tag->parsed = 0;
+
+  phase(tag, e_mp3tag_phase_header, 0);
+  if (tag->fd != -1)
+  {
+    if (trailer_probe(tag->fd, &trailer) == e_failure) // Error handling: tail of the file unreadable
+    {
+      phase(tag, e_mp3tag_phase_header, 1);
+      return e_mp3tag_io;
+    }
+  }
+  else
+  {
+    data = source_bytes(tag, &len);
+    trailer_probe_buffer(data, len, &trailer);
+  }
+  phase(tag, e_mp3tag_phase_header, 1);
+
+  if (!tag->has_id3v2 && trailer.found == 0) // Neither an ID3v2 tag nor any trailer tag
+  {
+    trailer_free(&trailer);
+    return e_mp3tag_no_tag;
+  }
+
+  phase(tag, e_mp3tag_phase_walk, 0);
+  if (tag->has_id3v2 && tag->fd != -1)
+  {
+    id3_stream_fields(tag->fd, &tag->header, NULL, 0, &tag->fields); // Frame headers and text frames only
+  }
+  else if (tag->has_id3v2)
+  {
+    size_t avail = len - ID3_HEADER_SIZE; // Tag bytes present in the image (a truncated image stops the walk early)
+    id3_collect_fields(&tag->header, data + ID3_HEADER_SIZE, avail < tag->header.tag_size ? avail : tag->header.tag_size, &tag->fields);
+  }
+  trailer_fill(&trailer, &tag->fields); // Missing fields from ID3v1 / APEv2 / Lyrics3v2 / appended ID3v2
+  phase(tag, e_mp3tag_phase_walk, 1);
+
+  trailer_free(&trailer);
+  tag->parsed = 1;
+  return e_mp3tag_ok;
+}
+
+/*
+ * Function: mp3tag_version
+ * Description: Copies the version bytes of the ID3v2 header
+ * Parameters: tag - handle, major / revision - receive the version (either may be NULL)
+ * Return: Mp3TagError (e_mp3tag_ok/e_mp3tag_argument/e_mp3tag_not_found)
+ */
+Mp3TagError mp3tag_version(const Mp3Tag *tag, int *major, int *revision)
+{
+  if (tag == NULL)
+  {
+    return e_mp3tag_argument;
+  }
+  if (!tag->has_id3v2)
+  {
+    return e_mp3tag_not_found;
+  }
+  if (major != NULL)
+  {
+    *major = tag->header.major;
+  }
+  if (revision != NULL)
+  {
+    *revision = tag->header.revision;
+  }
+  return e_mp3tag_ok;
+}
+
+/*
+ * Function: mp3tag_get_frame
+ * Description: Looks up the staged value of a frame, then the parsed one
+ * Parameters: tag - parsed handle, id - frame ID or field name, value - receives the text
+ * Return: Mp3TagError (e_mp3tag_ok/e_mp3tag_argument/e_mp3tag_unknown_frame/e_mp3tag_not_found)
+ */
+Mp3TagError mp3tag_get_frame(const Mp3Tag *tag, const char *id, const char **value)
+{
+  if (tag == NULL || id == NULL || value == NULL || !tag->parsed)
+  {
+    return e_mp3tag_argument;
+  }
+
+  int field = id3_field_lookup(id); // Field name or frame ID of any version
+  if (field == -1)
+  {
+    return e_mp3tag_unknown_frame;
+  }
+  *value = tag->pending[field] ? tag->pending[field] : tag->fields.value[field];
+  return (*value != NULL) ? e_mp3tag_ok : e_mp3tag_not_found;
+}
+
+/*
+ * Function: mp3tag_set_frame
+ * Description: Stores a copy of the new value of a frame until the next commit
+ * Parameters: tag - handle, id - frame ID or field name, value - new text
+ * Return: Mp3TagError (e_mp3tag_ok/e_mp3tag_argument/e_mp3tag_unknown_frame/e_mp3tag_memory)
+ */
+Mp3TagError mp3tag_set_frame(Mp3Tag *tag, const char *id, const char *value)
+{
+  if (tag == NULL || id == NULL || value == NULL)
+  {
+    return e_mp3tag_argument;
+  }
+
+  int field = id3_field_lookup(id);
+  if (field == -1)
+  {
+    return e_mp3tag_unknown_frame;
+  }
+  char *copy = strdup(value);
+  if (copy == NULL)
+  {
+    return e_mp3tag_memory;
+  }
+  free(tag->pending[field]); // A later value replaces the earlier one
+  tag->pending[field] = copy;
+  return e_mp3tag_ok;
+}
+
+/*
+ * Function: mp3tag_set_padding
+ * Description: Stores the padding policy used by the next commits
+ * Parameters: tag - handle, mode - padding policy, amount - bytes, percent or block size
+ * Return: Mp3TagError (e_mp3tag_ok/e_mp3tag_argument)
+ */
+Mp3TagError mp3tag_set_padding(Mp3Tag *tag, Mp3TagPadMode mode, size_t amount)
+{
+  if (tag == NULL)
+  {
+    return e_mp3tag_argument;
+  }
+  switch (mode)
+  {
+  case e_mp3tag_pad_none:
+    amount = 0;
+    break;
+  case e_mp3tag_pad_bytes:
+    if (amount > ID3_TAG_SIZE_MAX) // More than any tag can hold
+    {
+      return e_mp3tag_argument;
+    }
+    break;
+  case e_mp3tag_pad_percent:
+    if (amount > MP3TAG_PAD_PERCENT_MAX)
+    {
+      return e_mp3tag_argument;
+    }
+    break;
+  case e_mp3tag_pad_align:
+    if (amount == 0 || amount > ID3_TAG_SIZE_MAX)
+    {
+      return e_mp3tag_argument;
+    }
+    break;
+  default:
+    return e_mp3tag_argument; // Unknown policy
+  }
+  tag->pad_mode = mode;
+  tag->pad_amount = amount;
+  return e_mp3tag_ok;
+}
+
+/*
+ * Function: mp3tag_set_phase_hook
+ * Description: Stores the phase callback used by later parse and commit calls
+ * Parameters: tag - handle, hook - callback or NULL, context - passed to the callback
+ * Return: Mp3TagError (e_mp3tag_ok/e_mp3tag_argument)
+ */
+Mp3TagError mp3tag_set_phase_hook(Mp3Tag *tag, Mp3TagPhaseHook hook, void *context)
+{
+  if (tag == NULL)
+  {
+    return e_mp3tag_argument;
+  }
+  tag->phase_hook = hook;
+  tag->phase_context = context;
+  return e_mp3tag_ok;
+}
+
+/*
+ * Function: commit_file
+ * Description: Runs the edit engine on the file behind the handle through a private stream on a duplicate of its
+ *              descriptor; a file opened by path is reopened afterwards because a rename commit replaces its inode
+ *              (if that fails the commit still happened: the handle is marked stale and later reads fail with io)
+ * Parameters: tag - handle, editInfo - edit with every staged field selected
+ * Return: Mp3TagError (e_mp3tag_ok or the reason from the edit engine)
+ */
+static Mp3TagError commit_file(Mp3Tag *tag, EditInfo *editInfo)
+{
+  int fd = dup(tag->fd); // The stream closes its own descriptor
+
+  editInfo->original_fname = tag->path; // NULL for descriptor sources: a full rewrite is copied back in place
+  editInfo->fptr_original = (fd != -1) ? fdopen(fd, "r+") : NULL;
+  if (editInfo->fptr_original == NULL)
+  {
+    if (fd != -1)
+    {
+      close(fd);
+    }
+    close_all_file(editInfo); // Free the selected values
+    return e_mp3tag_io;
+  }
+  if (edit_open_file_tags(editInfo) == e_failure) // Closes the stream and frees every buffer
+  {
+    return editInfo->error;
+  }
+
+  if (tag->path != NULL) // The path may name a new inode now
+  {
+    int reopened = open(tag->path, O_RDWR);
+    if (reopened == -1) // The file on disk is already edited: only this handle lost it
+    {
+      tag->stale = 1;
+      return e_mp3tag_ok;
+    }
+    close(tag->fd);
+    tag->fd = reopened;
+  }
+  return e_mp3tag_ok;
+}
+
+/*
+ * Function: mp3tag_commit
+ * Description: Applies every staged frame in one edit (file, descriptor or buffer source), then makes the staged
+ *              values the parsed values and re-reads the header (a tag may have been inserted)
+ * Parameters: tag - handle
+ * Return: Mp3TagError (e_mp3tag_ok/e_mp3tag_argument/e_mp3tag_read_only or the reason of the failed edit)
+ */
+Mp3TagError mp3tag_commit(Mp3Tag *tag)
+{
+  EditInfo editInfo; // One edit for every staged field
+  Mp3TagError error = e_mp3tag_ok;
+  int staged = 0;
+
+  if (tag == NULL)
+  {
+    return e_mp3tag_argument;
+  }
+  for (int i = 0; i < TAG_FIELD_COUNT; i++)
+  {
+    staged += (tag->pending[i] != NULL);
+  }
+  if (staged == 0) // Nothing to write
+  {
+    return e_mp3tag_ok;
+  }
+  if (!tag->writable)
+  {
+    return e_mp3tag_read_only;
+  }
+  if (tag->stale) // Writing through the old descriptor would edit the replaced file
+  {
+    errno = ESTALE;
+    return e_mp3tag_io;
+  }
+
+  init_edit_info(&editInfo);
+  editInfo.pad_mode = tag->pad_mode; // Padding of a new tag
+  editInfo.pad_amount = tag->pad_amount;
+  editInfo.phase_hook = tag->phase_hook; // The engine reports its steps to the caller's hook
+  editInfo.phase_context = tag->phase_context;
+  for (int i = 0; i < TAG_FIELD_COUNT && error == e_mp3tag_ok; i++)
+  {
+    if (tag->pending[i] != NULL && set_edit_field(&editInfo, (TagField)i, tag->pending[i]) == e_failure)
+    {
+      error = editInfo.error;
+    }
+  }
+  if (error != e_mp3tag_ok)
+  {
+    close_all_file(&editInfo);
+    return error;
+  }
+
+  if (tag->fd != -1)
+  {
+    error = commit_file(tag, &editInfo);
+  }
+  else
+  {
+    size_t len;
+    const unsigned char *data = source_bytes(tag, &len);
+    unsigned char *image = NULL;
+    size_t image_len = 0;
+
+    if (edit_buffer_tags(&editInfo, data, len, &image, &image_len) == e_success)
+    {
+      free(tag->image); // Previous edited image (never the caller's buffer)
+      tag->image = image;
+      tag->image_len = image_len;
+    }
+    else
+    {
+      error = editInfo.error;
+    }
+  }
+  if (error != e_mp3tag_ok)
+  {
+    return error; // Staged values are kept so the commit can be retried
+  }
+
+  for (int i = 0; i < TAG_FIELD_COUNT; i++) // Written values are now the values of the source
+  {
+    if (tag->pending[i] != NULL)
+    {
+      free(tag->fields.value[i]);
+      tag->fields.value[i] = tag->pending[i];
+      tag->pending[i] = NULL;
+    }
+  }
+  read_header(tag);
+  return e_mp3tag_ok;
+}
+
+/*
+ * Function: mp3tag_buffer
+ * Description: Returns the current image of a buffer source
+ * Parameters: tag - handle, data / len - receive the image
+ * Return: Mp3TagError (e_mp3tag_ok/e_mp3tag_argument)
+ */
+Mp3TagError mp3tag_buffer(const Mp3Tag *tag, const void **data, size_t *len)
+{
+  if (tag == NULL || data == NULL || len == NULL || tag->fd != -1)
+  {
+    return e_mp3tag_argument;
+  }
+  *data = source_bytes(tag, len);
+  return e_mp3tag_ok;
+}
+
+/*
+ * Function: mp3tag_close
+ * Description: Closes a file opened by path and frees every value, the edited image and the handle
+ * Parameters: tag - handle (NULL is ignored)
+ * Return: void
+ */
+void mp3tag_close(Mp3Tag *tag)
+{
+  if (tag == NULL)
+  {
+    return;
+  }
+  int saved = errno; // Closing must not hide the cause of a failed call
+
+  if (tag->owns_fd && tag->fd != -1)
+  {
+    close(tag->fd);
+  }
+  for (int i = 0; i < TAG_FIELD_COUNT; i++)
+  {
+    free(tag->pending[i]);
+  }
+  id3_free_fields(&tag->fields);
+  free(tag->image);
+  free(tag->path);
+  free(tag);
+  errno = saved;
+}
+
+/*
+ * Function: mp3tag_strerror
+ * Description: Maps a result code to a short description
+ * Parameters: error - Mp3TagError
+ * Return: const char * - static text
+ */
+const char *mp3tag_strerror(Mp3TagError error)
+{
+  static const char *const messages[MP3TAG_ERROR_COUNT] = {
+      "success",
+      "invalid argument",
+      "input/output error",
+      "no ID3 tag",
+      "unsupported tag layout",
+      "unknown frame",
+      "frame not found",
+      "out of memory",
+      "opened read-only",
+  };
+
+  return ((unsigned)error < MP3TAG_ERROR_COUNT) ? messages[error] : "unknown error";
+}
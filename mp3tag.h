@@ -0,0 +1,195 @@
+#ifndef MP3TAG_H // If not defined MP3TAG_H ---> Checks if MP3TAG_H was previously defined: If not present, code is processed; else code below till #endif is ignored
+#define MP3TAG_H // Defines the macro MP3TAG_H if macro was not previously defined
+
+/*
+ * Tag library: the reading and editing engine of the tool without its command line.
+ *
+ * - No global state: everything lives in the Mp3Tag handle, so different handles may be used from different threads
+ *   at the same time (one handle must not be shared between threads without a lock).
+ * - No console output: every function returns an Mp3TagError; for e_mp3tag_io, errno holds the cause.
+ * - Sources: a path (opened and closed by the library), a caller's file descriptor (never closed) or a caller's
+ *   buffer holding a whole file (never modified; commit produces a new image).
+ *
+ * Typical use:
+ *   Mp3Tag *tag;
+ *   if (mp3tag_open_file("song.mp3", 1, &tag) == e_mp3tag_ok && mp3tag_parse(tag) == e_mp3tag_ok)
+ *   {
+ *     mp3tag_set_frame(tag, "TIT2", "New Title");
+ *     mp3tag_commit(tag);
+ *   }
+ *   mp3tag_close(tag);
+ *
+ * Frames are named by frame ID ("TIT2", "TPE1", "TALB", "TYER", "TCON", "COMM"; "TDRC" and the ID3v2.2 IDs are
+ * accepted too) or by field name ("title", "artist", "album", "year", "genre", "comment").
+ */
+
+#include <stddef.h> // Header file for size_t
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Enumeration of the results of the library functions
+typedef enum // typedef used to give alternate name for enum here
+{
+  e_mp3tag_ok,            // Operation completed successfully
+  e_mp3tag_argument,      // NULL handle / argument, or a call out of order (get before parse, buffer of a file handle)
+  e_mp3tag_io,            // Open, read, write or rename failed (errno holds the cause)
+  e_mp3tag_no_tag,        // Neither an ID3v2 tag nor any trailer tag (ID3v1, APEv2, Lyrics3v2)
+  e_mp3tag_unsupported,   // Tag layout that cannot be rewritten (unknown ID3v2 version, compressed ID3v2.2 tag)
+  e_mp3tag_unknown_frame, // Frame ID or field name the library does not handle
+  e_mp3tag_not_found,     // Frame absent from the tag (or no ID3v2 tag for mp3tag_version)
+  e_mp3tag_memory,        // Allocation failed
+  e_mp3tag_read_only,     // Commit on a handle opened for reading only
+  MP3TAG_ERROR_COUNT      // Number of results (must stay last)
+} Mp3TagError;            // Mp3TagError is alternate name for this enum
+
+#define MP3TAG_PAD_PERCENT_MAX 1000 // Largest percentage accepted by mp3tag_set_padding
+
+// Enumeration of the padding policies applied when a commit writes a new tag (in-place commits keep the tag size)
+typedef enum // typedef used to give alternate name for enum here
+{
+  e_mp3tag_pad_none,    // Tag exactly as large as its frames (default)
+  e_mp3tag_pad_bytes,   // A fixed number of padding bytes
+  e_mp3tag_pad_percent, // Padding as a percentage of the frame bytes
+  e_mp3tag_pad_align    // Padding up to the next multiple of a block size for header + tag (audio starts on a boundary)
+} Mp3TagPadMode;        // Mp3TagPadMode is alternate name for this enum
+
+// Enumeration of the steps reported to a phase hook (mp3tag_set_phase_hook)
+typedef enum // typedef used to give alternate name for enum here
+{
+  e_mp3tag_phase_open,   // Creating the temporary file of a full rewrite
+  e_mp3tag_phase_header, // Trailer probe of a parse; header, whole-tag load and trailer probe of a commit
+  e_mp3tag_phase_walk,   // Frame walk: decoding fields, or rebuilding frames for a commit
+  e_mp3tag_phase_copy,   // Full rewrite: new header + frames and the audio copy into the temporary file
+  e_mp3tag_phase_commit, // Making the edit visible: in-place tag write, rename, or copy-back
+  MP3TAG_PHASE_COUNT     // Number of phases (must stay last)
+} Mp3TagPhase;           // Mp3TagPhase is alternate name for this enum
+
+// Callback told when a phase starts (end = 0) and stops (end = 1); the calls always pair, phases never nest
+typedef void (*Mp3TagPhaseHook)(void *context, Mp3TagPhase phase, int end);
+
+typedef struct Mp3Tag Mp3Tag; // Opaque handle: one open file, descriptor or buffer with its parsed and pending tags
+
+/*
+ * Function: mp3tag_open_file
+ * Description: Opens a file and reads its 10-byte ID3v2 header (one pread)
+ * Parameters: path - file to open, writable - 1 to allow mp3tag_commit, tag - receives the handle
+ * Return: Mp3TagError (e_mp3tag_io if the file cannot be opened)
+ */
+Mp3TagError mp3tag_open_file(const char *path, int writable, Mp3Tag **tag);
+
+/*
+ * Function: mp3tag_open_fd
+ * Description: Uses a descriptor the caller already opened; it is never closed by the library. Commits through a
+ *              descriptor rewrite the file in place (no rename), so the descriptor stays valid.
+ * Parameters: fd - descriptor opened O_RDONLY or O_RDWR (positional I/O only: its offset is not used),
+ *             tag - receives the handle
+ * Return: Mp3TagError (e_mp3tag_ok/e_mp3tag_io/e_mp3tag_memory)
+ */
+Mp3TagError mp3tag_open_fd(int fd, Mp3Tag **tag);
+
+/*
+ * Function: mp3tag_open_buffer
+ * Description: Uses a whole file held in the caller's memory; the buffer must stay valid until mp3tag_close and is
+ *              never written (mp3tag_commit builds a new image, read with mp3tag_buffer)
+ * Parameters: data - file bytes, len - length of data, tag - receives the handle
+ * Return: Mp3TagError (e_mp3tag_ok/e_mp3tag_argument/e_mp3tag_memory)
+ */
+Mp3TagError mp3tag_open_buffer(const void *data, size_t len, Mp3Tag **tag);
+
+/*
+ * Function: mp3tag_parse
+ * Description: Decodes the known frames: ID3v2 frames are streamed (large pictures skipped by offset), fields the
+ *              ID3v2 tag does not have are taken from ID3v1 / APEv2 / Lyrics3v2 / an appended ID3v2 tag
+ * Parameters: tag - handle
+ * Return: Mp3TagError (e_mp3tag_no_tag if the source has no tag at all)
+ */
+Mp3TagError mp3tag_parse(Mp3Tag *tag);
+
+/*
+ * Function: mp3tag_version
+ * Description: Reports the ID3v2 version read by the open call (no parse needed)
+ * Parameters: tag - handle, major - receives 2, 3 or 4, revision - receives the revision byte
+ * Return: Mp3TagError (e_mp3tag_not_found if the source has no ID3v2 header)
+ */
+Mp3TagError mp3tag_version(const Mp3Tag *tag, int *major, int *revision);
+
+/*
+ * Function: mp3tag_get_frame
+ * Description: Returns the text of a frame as UTF-8: a value set since the last commit, else the parsed value
+ * Parameters: tag - parsed handle, id - frame ID or field name, value - receives the text (owned by the handle,
+ *             valid until the frame is set again or the handle is closed)
+ * Return: Mp3TagError (e_mp3tag_not_found if the frame is absent)
+ */
+Mp3TagError mp3tag_get_frame(const Mp3Tag *tag, const char *id, const char **value);
+
+/*
+ * Function: mp3tag_set_frame
+ * Description: Stages a new value for a frame; nothing is written until mp3tag_commit, which applies every staged
+ *              frame in one rewrite (a later value for the same frame replaces the earlier one)
+ * Parameters: tag - handle, id - frame ID or field name, value - new UTF-8 text
+ * Return: Mp3TagError (e_mp3tag_ok/e_mp3tag_unknown_frame/e_mp3tag_memory)
+ */
+Mp3TagError mp3tag_set_frame(Mp3Tag *tag, const char *id, const char *value);
+
+/*
+ * Function: mp3tag_set_padding
+ * Description: Selects how much padding a commit reserves when it has to write a new tag (the frames outgrew the
+ *              old tag, its layout is dropped, or a tag is inserted), so that later, longer values are written in place
+ * Parameters: tag - handle, mode - padding policy, amount - bytes (e_mp3tag_pad_bytes), percent of the frame bytes
+ *             (e_mp3tag_pad_percent, at most 1000) or block size (e_mp3tag_pad_align, at least 1); ignored for none
+ * Return: Mp3TagError (e_mp3tag_ok/e_mp3tag_argument)
+ */
+Mp3TagError mp3tag_set_padding(Mp3Tag *tag, Mp3TagPadMode mode, size_t amount);
+
+/*
+ * Function: mp3tag_set_phase_hook
+ * Description: Installs a callback told about the steps of later parse and commit calls on this handle (timing,
+ *              tracing); it runs on the calling thread. The library keeps no counters of its own.
+ * Parameters: tag - handle, hook - callback (NULL removes it), context - passed to every call of the hook
+ * Return: Mp3TagError (e_mp3tag_ok/e_mp3tag_argument)
+ */
+Mp3TagError mp3tag_set_phase_hook(Mp3Tag *tag, Mp3TagPhaseHook hook, void *context);
+
+/*
+ * Function: mp3tag_commit
+ * Description: Writes the staged frames: in place when they fit in the tag and its padding, otherwise by a full
+ *              rewrite (a file opened by path is rewritten beside the original and renamed over it) whose new tag
+ *              gets the padding selected with mp3tag_set_padding. An ID3v1 block is updated with the same values.
+ *              A buffer source gets a new image instead (see mp3tag_buffer). If the renamed file cannot be reopened
+ *              the commit still succeeds, but later parses and commits on the handle fail with e_mp3tag_io (ESTALE).
+ * Parameters: tag - handle
+ * Return: Mp3TagError (e_mp3tag_read_only, e_mp3tag_io, e_mp3tag_unsupported, ...)
+ */
+Mp3TagError mp3tag_commit(Mp3Tag *tag);
+
+/*
+ * Function: mp3tag_buffer
+ * Description: Returns the current image of a buffer source: the caller's buffer, or the edited copy after a commit
+ * Parameters: tag - handle opened with mp3tag_open_buffer, data / len - receive the image (owned by the handle)
+ * Return: Mp3TagError (e_mp3tag_argument for file and descriptor handles)
+ */
+Mp3TagError mp3tag_buffer(const Mp3Tag *tag, const void **data, size_t *len);
+
+/*
+ * Function: mp3tag_close
+ * Description: Frees the handle (closes the file when it was opened by path; staged values are dropped)
+ * Parameters: tag - handle (NULL is ignored)
+ * Return: void
+ */
+void mp3tag_close(Mp3Tag *tag);
+
+/*
+ * Function: mp3tag_strerror
+ * Description: Describes a result code in a few words
+ * Parameters: error - Mp3TagError
+ * Return: const char * - static text
+ */
+const char *mp3tag_strerror(Mp3TagError error);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // End of header guard: Marks the end of conditional compilation block started by #ifndef MP3TAG_H
@@ -0,0 +1,152 @@
+#ifndef MP3TAG_HPP // If not defined MP3TAG_HPP ---> Checks if MP3TAG_HPP was previously defined: If not present, code is processed; else code below till #endif is ignored
+#define MP3TAG_HPP // Defines the macro MP3TAG_HPP if macro was not previously defined
+
+/*
+ * C++ wrapper of the tag library (mp3tag.h): header only, C++11.
+ *
+ * - mp3tag::Tag owns one Mp3Tag handle and closes it in its destructor (movable, not copyable).
+ * - Every failing library call throws mp3tag::Error carrying the Mp3TagError code; absent frames are not errors
+ *   (get() returns false).
+ *
+ *   mp3tag::Tag tag = mp3tag::Tag::open("song.mp3", true);
+ *   std::string title;
+ *   if (tag.get("title", title)) { ... }
+ *   tag.set("TPE1", "Artist");
+ *   tag.commit();
+ */
+
+#include <cerrno>    // Header file for errno (cause of e_mp3tag_io)
+#include <cstring>   // Header file for std::strerror
+#include <stdexcept> // Header file for std::runtime_error
+#include <string>    // Header file for std::string
+#include <utility>   // Header file for std::swap
+#include "mp3tag.h"  // Library header file for the C API
+
+namespace mp3tag
+{
+
+// Exception thrown by every failing call: what() is the library description (plus errno text for I/O errors)
+class Error : public std::runtime_error
+{
+public:
+  Error(Mp3TagError code)
+      : std::runtime_error(code == e_mp3tag_io ? std::string(mp3tag_strerror(code)) + ": " + std::strerror(errno) : mp3tag_strerror(code)),
+        code_(code)
+  {
+  }
+
+  Mp3TagError code() const { return code_; } // Library result code
+
+private:
+  Mp3TagError code_;
+};
+
+// One open file, descriptor or buffer (RAII owner of an Mp3Tag handle)
+class Tag
+{
+public:
+  // Opens a file by path (commits are allowed when writable is true)
+  static Tag open(const std::string &path, bool writable = false)
+  {
+    Mp3Tag *handle = nullptr;
+    check(mp3tag_open_file(path.c_str(), writable ? 1 : 0, &handle));
+    return Tag(handle);
+  }
+
+  // Uses a caller's descriptor (never closed by the library)
+  static Tag from_fd(int fd)
+  {
+    Mp3Tag *handle = nullptr;
+    check(mp3tag_open_fd(fd, &handle));
+    return Tag(handle);
+  }
+
+  // Uses a caller's file image (must outlive the Tag; never written)
+  static Tag from_buffer(const void *data, size_t len)
+  {
+    Mp3Tag *handle = nullptr;
+    check(mp3tag_open_buffer(data, len, &handle));
+    return Tag(handle);
+  }
+
+  Tag(Tag &&other) noexcept : handle_(other.handle_) { other.handle_ = nullptr; }
+  Tag &operator=(Tag &&other) noexcept
+  {
+    std::swap(handle_, other.handle_); // Old handle is closed by other's destructor
+    return *this;
+  }
+  Tag(const Tag &) = delete;
+  Tag &operator=(const Tag &) = delete;
+  ~Tag() { mp3tag_close(handle_); }
+
+  // Decodes the known frames (ID3v2 first, trailer tags for missing fields)
+  void parse() { check(mp3tag_parse(handle_)); }
+
+  // ID3v2 version; false when the source has no ID3v2 header
+  bool version(int &major, int &revision) const
+  {
+    return found(mp3tag_version(handle_, &major, &revision));
+  }
+
+  // Value of a frame (frame ID or field name); false when the frame is absent
+  bool get(const std::string &id, std::string &value) const
+  {
+    const char *text = nullptr;
+    if (!found(mp3tag_get_frame(handle_, id.c_str(), &text)))
+    {
+      return false;
+    }
+    value = text;
+    return true;
+  }
+
+  // Stages a new value; written by commit()
+  void set(const std::string &id, const std::string &value) { check(mp3tag_set_frame(handle_, id.c_str(), value.c_str())); }
+
+  // Padding reserved when commit() has to write a new tag (Mp3TagPadMode; amount in bytes, percent or block size)
+  void set_padding(Mp3TagPadMode mode, size_t amount = 0) { check(mp3tag_set_padding(handle_, mode, amount)); }
+
+  // Callback told about the steps of later parse() and commit() calls (nullptr removes it)
+  void set_phase_hook(Mp3TagPhaseHook hook, void *context = nullptr) { check(mp3tag_set_phase_hook(handle_, hook, context)); }
+
+  // Writes every staged value in one edit
+  void commit() { check(mp3tag_commit(handle_)); }
+
+  // Current image of a buffer source (the edited copy after a commit)
+  std::string buffer() const
+  {
+    const void *data = nullptr;
+    size_t len = 0;
+    check(mp3tag_buffer(handle_, &data, &len));
+    return std::string(static_cast<const char *>(data), len);
+  }
+
+  Mp3Tag *handle() const { return handle_; } // Underlying handle for calls the wrapper does not cover
+
+private:
+  explicit Tag(Mp3Tag *handle) : handle_(handle) {}
+
+  static void check(Mp3TagError code)
+  {
+    if (code != e_mp3tag_ok)
+    {
+      throw Error(code);
+    }
+  }
+
+  static bool found(Mp3TagError code)
+  {
+    if (code == e_mp3tag_not_found)
+    {
+      return false;
+    }
+    check(code);
+    return true;
+  }
+
+  Mp3Tag *handle_; // Owned handle (nullptr after a move)
+};
+
+} // namespace mp3tag
+
+#endif // End of header guard: Marks the end of conditional compilation block started by #ifndef MP3TAG_HPP
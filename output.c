@@ -0,0 +1,304 @@
+#define _GNU_SOURCE // Enables GNU extensions (fwrite_unlocked, fputc_unlocked) declared in stdio.h
+
+#include <stdio.h>  // Header file for standard input/output functions (printf, setvbuf, flockfile, fwrite_unlocked, etc.)
+#include <string.h> // Header file for string manipulation functions (strcmp, strncmp, strlen, strerror)
+#include <errno.h>  // Header file for errno (cause of a library I/O failure)
+#include "type.h"   // User-defined header file for custom type definitions (Status, e_success, e_failure)
+#include "id3.h"    // User-defined header file for TagFields and field names
+#include "output.h" // User-defined header file for output format declarations
+#include "mp3tag.h" // Library header file for Mp3TagError and mp3tag_strerror
+
+static OutputFormat output_format = e_output_table; // Format selected on the command line (process-wide, like stdout)
+
+static const char *const json_keys[TAG_FIELD_COUNT] = {"title", "artist", "album", "year", "genre", "comment"}; // JSON member of every TagField
+
+/*
+ * Function: output_take_format
+ * Description: Removes --format=... from argv, selects the format and gives stdout a large buffer for porcelain output
+ * Parameters: argc - pointer to argument count, argv[] - argument array
+ * Return: Status (e_success/e_failure)
+ */
+Status output_take_format(int *argc, char *argv[])
+{
+  for (int i = 1; i < *argc; i++) // Option may appear anywhere
+  {
+    if (strncmp(argv[i], "--format=", 9) != 0)
+    {
+      continue;
+    }
+
+    const char *name = argv[i] + 9; // Requested format
+    if (strcmp(name, "json") == 0)
+    {
+      output_format = e_output_json;
+    }
+    else if (strcmp(name, "tsv") == 0)
+    {
+      output_format = e_output_tsv;
+    }
+    else if (strcmp(name, "table") == 0)
+    {
+      output_format = e_output_table;
+    }
+    else
+    {
+      printf("\033[1;91mERROR: \033[1;97mUnknown output format %s (use table, json or tsv)\n", name);
+      return e_failure;
+    }
+
+    for (int j = i; j < *argc; j++) // Remove the option so commands see their usual arguments (argv[argc] stays NULL)
+    {
+      argv[j] = argv[j + 1];
+    }
+    (*argc)--;
+    i--;
+  }
+
+  if (output_format != e_output_table) // Records are small: collect many before each write to stdout
+  {
+    setvbuf(stdout, NULL, _IOFBF, OUTPUT_BUFFER_SIZE);
+  }
+  return e_success;
+}
+
+/*
+ * Function: output_porcelain
+ * Description: Reports whether JSON Lines or TSV was selected
+ * Parameters: None
+ * Return: int - 1 for machine-readable output
+ */
+int output_porcelain(void)
+{
+  return output_format != e_output_table;
+}
+
+/*
+ * Function: output_json_string
+ * Description: Writes a JSON string literal; runs of safe bytes are copied with one write
+ * Parameters: out - stream (locked by the caller), s - string (NULL writes null)
+ * Return: void
+ */
+void output_json_string(FILE *out, const char *s)
+{
+  if (s == NULL) // Absent field
+  {
+    fwrite_unlocked("null", 1, 4, out);
+    return;
+  }
+
+  fputc_unlocked('"', out);
+  const char *run = s; // Start of bytes not yet written
+  for (const char *p = s; *p != '\0'; p++)
+  {
+    unsigned char c = (unsigned char)*p;
+    if (c >= 0x20 && c != '"' && c != '\\') // Safe byte (UTF-8 passes through unchanged)
+    {
+      continue;
+    }
+
+    fwrite_unlocked(run, 1, (size_t)(p - run), out); // Flush the safe run
+    run = p + 1;
+    switch (c)
+    {
+    case '"': fwrite_unlocked("\\\"", 1, 2, out); break;
+    case '\\': fwrite_unlocked("\\\\", 1, 2, out); break;
+    case '\n': fwrite_unlocked("\\n", 1, 2, out); break;
+    case '\r': fwrite_unlocked("\\r", 1, 2, out); break;
+    case '\t': fwrite_unlocked("\\t", 1, 2, out); break;
+    default:
+    {
+      char esc[7]; // \u00XX
+      snprintf(esc, sizeof(esc), "\\u%04x", c);
+      fwrite_unlocked(esc, 1, 6, out);
+    }
+    }
+  }
+  fwrite_unlocked(run, 1, strlen(run), out); // Remaining safe bytes
+  fputc_unlocked('"', out);
+}
+
+/*
+ * Function: put_tsv_field
+ * Description: Writes one TSV field with tab, newline, carriage return and backslash escaped
+ * Parameters: s - field text (NULL writes an empty field)
+ * Return: void
+ */
+static void put_tsv_field(const char *s)
+{
+  if (s == NULL) // Absent field
+  {
+    return;
+  }
+
+  const char *run = s; // Start of bytes not yet written
+  for (const char *p = s; *p != '\0'; p++)
+  {
+    const char *esc = (*p == '\t') ? "\\t" : (*p == '\n') ? "\\n" : (*p == '\r') ? "\\r" : (*p == '\\') ? "\\\\" : NULL;
+    if (esc == NULL)
+    {
+      continue;
+    }
+    fwrite_unlocked(run, 1, (size_t)(p - run), stdout);
+    fwrite_unlocked(esc, 1, 2, stdout);
+    run = p + 1;
+  }
+  fwrite_unlocked(run, 1, strlen(run), stdout);
+}
+
+/*
+ * Function: output_json_fields
+ * Description: Writes ,"title":...,"artist":... for all fields (members of an object already opened)
+ * Parameters: out - stream (locked by the caller), fields - field values
+ * Return: void
+ */
+void output_json_fields(FILE *out, const TagFields *fields)
+{
+  for (int i = 0; i < TAG_FIELD_COUNT; i++)
+  {
+    fputc_unlocked(',', out);
+    fputc_unlocked('"', out);
+    fwrite_unlocked(json_keys[i], 1, strlen(json_keys[i]), out);
+    fwrite_unlocked("\":", 1, 2, out);
+    output_json_string(out, fields->value[i]);
+  }
+}
+
+/*
+ * Function: output_tags
+ * Description: Writes the path and all fields of one file as a JSON object or TSV row
+ * Parameters: path - file path, fields - field values
+ * Return: void
+ */
+void output_tags(const char *path, const TagFields *fields)
+{
+  flockfile(stdout); // One lock per record; the pieces below use the unlocked stdio calls
+  if (output_format == e_output_json)
+  {
+    fwrite_unlocked("{\"path\":", 1, 8, stdout);
+    output_json_string(stdout, path);
+    output_json_fields(stdout, fields);
+    fwrite_unlocked("}\n", 1, 2, stdout);
+  }
+  else
+  {
+    put_tsv_field(path);
+    for (int i = 0; i < TAG_FIELD_COUNT; i++)
+    {
+      fputc_unlocked('\t', stdout);
+      put_tsv_field(fields->value[i]);
+    }
+    fputc_unlocked('\n', stdout);
+  }
+  funlockfile(stdout);
+}
+
+/*
+ * Function: output_version
+ * Description: Writes the path and "2.<major>.<revision>" version of one file
+ * Parameters: path - file path, major - major version, revision - revision number
+ * Return: void
+ */
+void output_version(const char *path, int major, int revision)
+{
+  char version[16]; // "2.3.0"
+
+  snprintf(version, sizeof(version), "2.%d.%d", major, revision);
+
+  flockfile(stdout);
+  if (output_format == e_output_json)
+  {
+    fwrite_unlocked("{\"path\":", 1, 8, stdout);
+    output_json_string(stdout, path);
+    fwrite_unlocked(",\"version\":", 1, 11, stdout);
+    output_json_string(stdout, version);
+    fwrite_unlocked("}\n", 1, 2, stdout);
+  }
+  else
+  {
+    put_tsv_field(path);
+    fputc_unlocked('\t', stdout);
+    put_tsv_field(version);
+    fputc_unlocked('\n', stdout);
+  }
+  funlockfile(stdout);
+}
+
+/*
+ * Function: output_audio
+ * Description: Writes the audio analysis of one file as a JSON object or TSV row
+ * Parameters: path - file path, duration .. source - analysis values (see output.h)
+ * Return: void
+ */
+void output_audio(const char *path, double duration, int bitrate, int sample_rate, const char *channels, const char *format,
+                  int vbr, unsigned long frames, const char *source)
+{
+  flockfile(stdout);
+  if (output_format == e_output_json)
+  {
+    fwrite_unlocked("{\"path\":", 1, 8, stdout);
+    output_json_string(stdout, path);
+    fprintf(stdout, ",\"duration\":%.3f,\"bitrate\":%d,\"sample_rate\":%d,\"channels\":\"%s\",\"format\":\"%s\",\"vbr\":%s,\"frames\":%lu,\"source\":\"%s\"}\n",
+            duration, bitrate, sample_rate, channels, format, vbr ? "true" : "false", frames, source); // Fixed ASCII values: no escaping needed
+  }
+  else
+  {
+    put_tsv_field(path);
+    fprintf(stdout, "\t%.3f\t%d\t%d\t%s\t%s\t%d\t%lu\t%s\n", duration, bitrate, sample_rate, channels, format, vbr, frames, source);
+  }
+  funlockfile(stdout);
+}
+
+/*
+ * Function: output_hash
+ * Description: Writes the audio hash of one file as a JSON object or TSV row
+ * Parameters: path - file path, hash - hex digits, bytes - payload length, group - duplicate group (0 = none)
+ * Return: void
+ */
+void output_hash(const char *path, const char *hash, unsigned long long bytes, unsigned long group)
+{
+  flockfile(stdout);
+  if (output_format == e_output_json)
+  {
+    fwrite_unlocked("{\"path\":", 1, 8, stdout);
+    output_json_string(stdout, path);
+    fprintf(stdout, ",\"audio_hash\":\"%s\",\"audio_bytes\":%llu", hash, bytes); // Hex digits: no escaping needed
+    if (group)
+    {
+      fprintf(stdout, ",\"group\":%lu", group);
+    }
+    fwrite_unlocked("}\n", 1, 2, stdout);
+  }
+  else
+  {
+    put_tsv_field(path);
+    fprintf(stdout, "\t%s\t%llu", hash, bytes);
+    if (group)
+    {
+      fprintf(stdout, "\t%lu", group);
+    }
+    fputc_unlocked('\n', stdout);
+  }
+  funlockfile(stdout);
+}
+
+/*
+ * Function: output_tag_error
+ * Description: Reports a library failure the way the tool always has: missing tags on stdout, system errors on stderr
+ * Parameters: path - file path, error - result of the library call
+ * Return: void
+ */
+void output_tag_error(const char *path, Mp3TagError error)
+{
+  if (error == e_mp3tag_io) // System error: errno still holds the cause
+  {
+    fprintf(stderr, "\033[1;91mERROR: Unable to access file %s: %s\033[0m\n", path, strerror(errno));
+  }
+  else if (error == e_mp3tag_no_tag)
+  {
+    printf("\033[1;91mERROR: \033[1;97mInvalid source file without ID3 tag\n"); // Print error message if no tag was found (invalid MP3 file format)
+  }
+  else
+  {
+    printf("\033[1;91mERROR: \033[1;97m%s: %s\n", path, mp3tag_strerror(error));
+  }
+}
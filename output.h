@@ -0,0 +1,104 @@
+#ifndef OUTPUT_H // If not defined OUTPUT_H ---> Checks if OUTPUT_H was previously defined: If not present, code is processed; else code below till #endif is ignored
+#define OUTPUT_H // Defines the macro OUTPUT_H if macro was not previously defined
+
+#include <stdio.h>  // Header file for FILE
+#include "type.h"  // User-defined header file for custom type definitions (Status, e_success, e_failure)
+#include "id3.h"   // User-defined header file for TagFields
+#include "mp3tag.h" // Library header file for Mp3TagError (library failures reported to the user)
+
+#define OUTPUT_BUFFER_SIZE (1024 * 1024) // stdout buffer used by the machine-readable formats
+
+// Enumeration of the output formats
+typedef enum // typedef used to give alternate name for enum here
+{
+  e_output_table, // Coloured tables and lines for terminals (default)
+  e_output_json,  // One JSON object per file (JSON Lines), no escape sequences
+  e_output_tsv    // One tab-separated row per file, no escape sequences
+} OutputFormat;   // OutputFormat is alternate name for this enum
+
+/*
+ * Function: output_take_format
+ * Description: Finds "--format=table|json|tsv" anywhere on the command line, applies it and removes it from argv
+ * Parameters: argc - pointer to argument count (decremented when the option is removed), argv[] - argument array
+ * Return: Status (e_failure for an unknown format)
+ */
+Status output_take_format(int *argc, char *argv[]);
+
+/*
+ * Function: output_porcelain
+ * Description: Tells whether a machine-readable format was selected
+ * Parameters: None
+ * Return: int - 1 for JSON Lines or TSV, 0 for tables
+ */
+int output_porcelain(void);
+
+/*
+ * Function: output_json_string
+ * Description: Writes a JSON string literal (quotes, backslashes and control characters escaped, UTF-8 unchanged)
+ * Parameters: out - stream (the caller holds its lock or owns it), s - string (NULL writes null)
+ * Return: void
+ */
+void output_json_string(FILE *out, const char *s);
+
+/*
+ * Function: output_json_fields
+ * Description: Writes the six field members ,"title":...,"comment":... of a JSON object already opened
+ * Parameters: out - stream (the caller holds its lock or owns it), fields - field values
+ * Return: void
+ */
+void output_json_fields(FILE *out, const TagFields *fields);
+
+/*
+ * Function: output_tags
+ * Description: Writes one record with the path and all fields of a file:
+ *              JSON: {"path":...,"title":...,"artist":...,"album":...,"year":...,"genre":...,"comment":...} (null if absent)
+ *              TSV:  path, title, artist, album, year, genre, comment (\t \n \r \\ escaped, empty if absent)
+ *              The whole record is written under one stdout lock, so lines from several threads never mix.
+ * Parameters: path - file path, fields - field values
+ * Return: void
+ */
+void output_tags(const char *path, const TagFields *fields);
+
+/*
+ * Function: output_version
+ * Description: Writes one record with the path and ID3v2 version of a file
+ *              JSON: {"path":...,"version":"2.3.0"}   TSV: path, version
+ * Parameters: path - file path, major - major version, revision - revision number
+ * Return: void
+ */
+void output_version(const char *path, int major, int revision);
+
+/*
+ * Function: output_audio
+ * Description: Writes one record with the audio analysis of a file
+ *              JSON: {"path":...,"duration":245.812,"bitrate":128,"sample_rate":44100,"channels":"joint stereo",
+ *                     "format":"MPEG-1 Layer III","vbr":false,"frames":9409,"source":"xing"}
+ *              TSV:  path, duration, bitrate, sample_rate, channels, format, vbr (0/1), frames, source
+ * Parameters: path - file path, duration - seconds, bitrate - average kbit/s, sample_rate - Hz, channels - channel mode,
+ *             format - "MPEG-1 Layer III" style name, vbr - 1 for variable bitrate, frames - frame count,
+ *             source - where the frame count came from (xing, info, vbri, walk)
+ * Return: void
+ */
+void output_audio(const char *path, double duration, int bitrate, int sample_rate, const char *channels, const char *format,
+                  int vbr, unsigned long frames, const char *source);
+
+/*
+ * Function: output_hash
+ * Description: Writes one record with the audio hash of a file
+ *              JSON: {"path":...,"audio_hash":"9f2c...","audio_bytes":4180032[,"group":1]}
+ *              TSV:  path, audio_hash, audio_bytes[, group]
+ * Parameters: path - file path, hash - 16 hex digits, bytes - audio payload length,
+ *             group - duplicate group number (0 = no group column)
+ * Return: void
+ */
+void output_hash(const char *path, const char *hash, unsigned long long bytes, unsigned long group);
+
+/*
+ * Function: output_tag_error
+ * Description: Prints the reason of a failed library call for one file (the library itself never prints)
+ * Parameters: path - file path, error - result of the library call (e_mp3tag_io reads errno)
+ * Return: void
+ */
+void output_tag_error(const char *path, Mp3TagError error);
+
+#endif // End of header guard: Marks the end of conditional compilation block started by #ifndef OUTPUT_H
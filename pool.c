@@ -0,0 +1,167 @@
+#include <stdio.h>   // Header file for standard input/output functions (perror)
+#include <stdlib.h>  // Header file for memory allocation functions (malloc, free)
+#include <unistd.h>  // Header file for POSIX functions (sysconf)
+#include <pthread.h> // Header file for POSIX threads
+#include "type.h"    // User-defined header file for custom type definitions (Status, e_success, e_failure)
+#include "pool.h"    // User-defined header file for worker pool declarations
+
+/*
+ * Function: pool_default_workers
+ * Description: Uses the number of online CPUs as the worker count
+ * Parameters: None
+ * Return: int - number of workers (1 .. POOL_MAX_WORKERS)
+ */
+int pool_default_workers(void)
+{
+  long cpus = sysconf(_SC_NPROCESSORS_ONLN); // Number of CPUs currently online
+
+  if (cpus < 1) // Unknown: fall back to a single worker
+  {
+    return 1;
+  }
+  return cpus > POOL_MAX_WORKERS ? POOL_MAX_WORKERS : (int)cpus; // Clamp to the thread array size
+}
+
+/*
+ * Function: pool_worker
+ * Description: Worker thread body: takes items from the queue and runs the task until the pool is closed and drained
+ * Parameters: arg - pointer to WorkPool
+ * Return: void * - always NULL
+ */
+static void *pool_worker(void *arg)
+{
+  WorkPool *pool = arg; // Pool this worker belongs to
+
+  for (;;) // Run until there is no more work
+  {
+    pthread_mutex_lock(&pool->lock); // Lock queue
+
+    while (pool->count == 0 && !pool->closed) // Wait for an item or for the pool to close
+    {
+      pthread_cond_wait(&pool->not_empty, &pool->lock);
+    }
+
+    if (pool->count == 0) // Closed and drained: worker exits
+    {
+      pthread_mutex_unlock(&pool->lock);
+      return NULL;
+    }
+
+    void *item = pool->queue[pool->head];             // Take the oldest item
+    pool->head = (pool->head + 1) % pool->capacity;   // Advance ring buffer head
+    pool->count--;                                    // One item fewer pending
+    pthread_cond_signal(&pool->not_full);             // Wake a producer waiting for space
+    pthread_mutex_unlock(&pool->lock);                // Unlock queue before doing the work
+
+    pool->task(item, pool->ctx); // Process the item outside the lock
+  }
+}
+
+/*
+ * Function: pool_start
+ * Description: Allocates the bounded queue and starts the workers
+ * Parameters: pool, workers, capacity, task, ctx - see pool.h
+ * Return: Status (e_success/e_failure)
+ */
+Status pool_start(WorkPool *pool, int workers, size_t capacity, PoolTask task, void *ctx)
+{
+  pool->workers = 0;                                                   // No threads started yet
+  pool->capacity = capacity ? capacity : POOL_QUEUE_CAPACITY;          // Queue length
+  pool->head = 0;                                                      // Queue starts empty
+  pool->count = 0;
+  pool->closed = 0;
+  pool->task = task;                                                   // Function run per item
+  pool->ctx = ctx;                                                     // Shared context
+  pool->queue = malloc(pool->capacity * sizeof(void *));               // Ring buffer storage
+
+  if (pool->queue == NULL) // Error handling: allocation failed
+  {
+    perror("malloc");
+    return e_failure;
+  }
+
+  pthread_mutex_init(&pool->lock, NULL);      // Initialise queue lock
+  pthread_cond_init(&pool->not_empty, NULL);  // Initialise consumer condition
+  pthread_cond_init(&pool->not_full, NULL);   // Initialise producer condition
+
+  if (workers <= 0) // Caller wants the machine-sized default
+  {
+    workers = pool_default_workers();
+  }
+  if (workers > POOL_MAX_WORKERS) // Clamp to the thread array size
+  {
+    workers = POOL_MAX_WORKERS;
+  }
+
+  for (int i = 0; i < workers; i++) // Start worker threads
+  {
+    if (pthread_create(&pool->threads[i], NULL, pool_worker, pool) != 0) // Error handling: thread creation failed
+    {
+      break; // Keep the workers that did start
+    }
+    pool->workers++;
+  }
+
+  if (pool->workers == 0) // No worker could be started
+  {
+    fprintf(stderr, "\033[1;91mERROR: \033[1;97mUnable to start worker threads\n");
+    pool_finish(pool); // Release queue and synchronisation objects
+    return e_failure;
+  }
+  return e_success; // Pool running
+}
+
+/*
+ * Function: pool_submit
+ * Description: Adds an item to the ring buffer (blocks while full so memory stays bounded)
+ * Parameters: pool - pointer to WorkPool, item - item for the task
+ * Return: Status (e_success/e_failure)
+ */
+Status pool_submit(WorkPool *pool, void *item)
+{
+  pthread_mutex_lock(&pool->lock); // Lock queue
+
+  while (pool->count == pool->capacity && !pool->closed) // Wait for space
+  {
+    pthread_cond_wait(&pool->not_full, &pool->lock);
+  }
+
+  if (pool->closed) // Pool already finished: refuse new work
+  {
+    pthread_mutex_unlock(&pool->lock);
+    return e_failure;
+  }
+
+  pool->queue[(pool->head + pool->count) % pool->capacity] = item; // Append item at the tail
+  pool->count++;                                                   // One more item pending
+  pthread_cond_signal(&pool->not_empty);                           // Wake one worker
+  pthread_mutex_unlock(&pool->lock);                               // Unlock queue
+  return e_success;
+}
+
+/*
+ * Function: pool_finish
+ * Description: Closes the queue, joins all workers after the queue drains and frees the pool resources
+ * Parameters: pool - pointer to WorkPool
+ * Return: void
+ */
+void pool_finish(WorkPool *pool)
+{
+  pthread_mutex_lock(&pool->lock);          // Lock queue
+  pool->closed = 1;                         // No more items will arrive
+  pthread_cond_broadcast(&pool->not_empty); // Wake all idle workers so they can exit once drained
+  pthread_cond_broadcast(&pool->not_full);  // Wake any blocked producer
+  pthread_mutex_unlock(&pool->lock);        // Unlock queue
+
+  for (int i = 0; i < pool->workers; i++) // Wait for every worker to finish its remaining items
+  {
+    pthread_join(pool->threads[i], NULL);
+  }
+
+  pthread_mutex_destroy(&pool->lock);      // Release queue lock
+  pthread_cond_destroy(&pool->not_empty);  // Release consumer condition
+  pthread_cond_destroy(&pool->not_full);   // Release producer condition
+  free(pool->queue);                       // Free ring buffer
+  pool->queue = NULL;
+  pool->workers = 0;
+}
@@ -0,0 +1,64 @@
+#ifndef POOL_H // If not defined POOL_H ---> Checks if POOL_H was previously defined: If not present, code is processed; else code below till #endif is ignored
+#define POOL_H // Defines the macro POOL_H if macro was not previously defined
+
+#include <stddef.h>  // Header file for size_t
+#include <pthread.h> // Header file for POSIX threads (pthread_t, pthread_mutex_t, pthread_cond_t)
+#include "type.h"    // User-defined header file for custom type definitions (Status, e_success, e_failure)
+
+#define POOL_QUEUE_CAPACITY 1024 // Default number of queued jobs; producers block when it is full (bounded memory)
+#define POOL_MAX_WORKERS 256     // Upper limit on worker threads
+
+// Function type executed by a worker for every submitted item
+typedef void (*PoolTask)(void *item, void *ctx);
+
+// Structure to store a fixed-size worker pool fed through a bounded job queue
+typedef struct // typedef used to give alternate name for structure here
+{
+  pthread_t threads[POOL_MAX_WORKERS]; // Worker thread handles
+  int workers;                         // Number of running worker threads
+  void **queue;                        // Ring buffer of pending items
+  size_t capacity;                     // Maximum number of pending items
+  size_t head;                         // Index of the next item to take
+  size_t count;                        // Number of pending items
+  int closed;                          // Set when no more items will be submitted
+  PoolTask task;                       // Function run for every item
+  void *ctx;                           // Shared context passed to every task call
+  pthread_mutex_t lock;                // Protects the queue fields
+  pthread_cond_t not_empty;            // Signalled when an item is queued or the pool is closed
+  pthread_cond_t not_full;             // Signalled when an item is taken from the queue
+} WorkPool;                            // WorkPool is alternate name for this structure
+
+/*
+ * Function: pool_default_workers
+ * Description: Returns a worker count sized to the machine (online CPUs, at least 1)
+ * Parameters: None
+ * Return: int - number of workers
+ */
+int pool_default_workers(void);
+
+/*
+ * Function: pool_start
+ * Description: Creates the job queue and starts the worker threads
+ * Parameters: pool - pointer to WorkPool, workers - thread count (<= 0 for pool_default_workers()),
+ *             capacity - queue length (0 for POOL_QUEUE_CAPACITY), task - function run per item, ctx - shared context
+ * Return: Status (e_success/e_failure)
+ */
+Status pool_start(WorkPool *pool, int workers, size_t capacity, PoolTask task, void *ctx);
+
+/*
+ * Function: pool_submit
+ * Description: Queues one item for the workers, blocking while the queue is full
+ * Parameters: pool - pointer to WorkPool, item - item handed to the task (ownership passes to the task)
+ * Return: Status (e_success/e_failure)
+ */
+Status pool_submit(WorkPool *pool, void *item);
+
+/*
+ * Function: pool_finish
+ * Description: Closes the queue, waits for all queued items to be processed and releases the pool
+ * Parameters: pool - pointer to WorkPool
+ * Return: void
+ */
+void pool_finish(WorkPool *pool);
+
+#endif // End of header guard: Marks the end of conditional compilation block started by #ifndef POOL_H
@@ -0,0 +1,674 @@
+#define _GNU_SOURCE // Enables GNU extensions (qsort_r) declared in stdlib.h
+
+#include <stdio.h>    // Header file for standard input/output functions (printf, fprintf, fopen, fwrite, rename, etc.)
+#include <stdlib.h>   // Header file for memory allocation and sorting functions (malloc, realloc, free, qsort, qsort_r)
+#include <string.h>   // Header file for string manipulation functions (strcmp, strncmp, strlen, strstr, etc.)
+#include <ctype.h>    // Header file for character classification (tolower, isdigit)
+#include <fcntl.h>    // Header file for open() and its flags (O_RDONLY)
+#include <unistd.h>   // Header file for POSIX functions (close, fsync, unlink)
+#include <sys/mman.h> // Header file for memory mapping functions (mmap, munmap)
+#include <sys/stat.h> // Header file for file status information (fstat, fchmod)
+#include "type.h"     // User-defined header file for custom type definitions (Status, e_success, e_failure)
+#include "id3.h"      // User-defined header file for TagField names and lookup
+#include "index.h"    // User-defined header file for TagIndex
+#include "query.h"    // User-defined header file for QueryInfo structure and function declarations
+#include "output.h"   // User-defined header file for JSON Lines / TSV output
+
+// Structure to store a growing pool of null-terminated strings
+typedef struct
+{
+  char *data; // Pool contents
+  size_t len; // Bytes in use
+  size_t cap; // Bytes allocated
+} StringPool;
+
+/*
+ * Function: pool_add_string
+ * Description: Appends a string (optionally case-folded) to the pool
+ * Parameters: pool - pointer to StringPool, s - string, fold - 1 to store ASCII letters in lower case, offset - receives its offset
+ * Return: Status (e_success/e_failure)
+ */
+static Status pool_add_string(StringPool *pool, const char *s, int fold, uint32_t *offset)
+{
+  size_t len = strlen(s) + 1; // String + terminator
+
+  if (pool->len + len > pool->cap) // Grow geometrically
+  {
+    size_t cap = pool->cap ? pool->cap * 2 : 64 * 1024;
+    while (cap < pool->len + len)
+    {
+      cap *= 2;
+    }
+    if (cap > QUERY_ABSENT) // Offsets are 32-bit
+    {
+      return e_failure;
+    }
+    char *data = realloc(pool->data, cap);
+    if (data == NULL) // Error handling: allocation failed (old pool is freed by the caller)
+    {
+      return e_failure;
+    }
+    pool->data = data;
+    pool->cap = cap;
+  }
+
+  *offset = (uint32_t)pool->len;
+  for (size_t i = 0; i < len; i++) // Copy (and fold) every byte, terminator included
+  {
+    pool->data[pool->len + i] = fold ? (char)tolower((unsigned char)s[i]) : s[i];
+  }
+  pool->len += len;
+  return e_success;
+}
+
+/*
+ * Function: fold_string
+ * Description: Makes a case-folded copy of a string (ASCII letters; other bytes such as UTF-8 are kept as they are)
+ * Parameters: s - string
+ * Return: char * - malloc'd folded copy (NULL on allocation failure)
+ */
+static char *fold_string(const char *s)
+{
+  char *folded = strdup(s);
+
+  for (char *p = folded; p != NULL && *p != '\0'; p++)
+  {
+    *p = (char)tolower((unsigned char)*p);
+  }
+  return folded;
+}
+
+/*
+ * Function: parse_year
+ * Description: Reads the year at the start of a TYER value ("1998", "1998-05-01")
+ * Parameters: s - value, year - receives the year
+ * Return: int - 1 if the value starts with digits, 0 otherwise
+ */
+static int parse_year(const char *s, int *year)
+{
+  if (!isdigit((unsigned char)*s))
+  {
+    return 0;
+  }
+  *year = atoi(s);
+  return 1;
+}
+
+/*
+ * Function: compare_doc_paths / compare_postings / compare_years
+ * Description: Sort comparators (qsort_r context: string pool)
+ * Parameters: a, b - records, ctx - string pool data
+ * Return: int - ordering
+ */
+static int compare_doc_paths(const void *a, const void *b, void *ctx)
+{
+  return strcmp((const char *)ctx + ((const QueryDoc *)a)->path, (const char *)ctx + ((const QueryDoc *)b)->path);
+}
+
+static int compare_postings(const void *a, const void *b, void *ctx)
+{
+  const QueryPosting *x = a, *y = b;
+  int order = strcmp((const char *)ctx + x->key, (const char *)ctx + y->key);
+
+  return order != 0 ? order : (x->doc > y->doc) - (x->doc < y->doc);
+}
+
+static int compare_years(const void *a, const void *b)
+{
+  const QueryYear *x = a, *y = b;
+
+  return x->year != y->year ? (x->year > y->year) - (x->year < y->year) : (x->doc > y->doc) - (x->doc < y->doc);
+}
+
+/*
+ * Function: query_file_name
+ * Description: Builds the query file name for an index file
+ * Parameters: index_fname - index file name
+ * Return: char * - malloc'd name (NULL on allocation failure)
+ */
+static char *query_file_name(const char *index_fname)
+{
+  char *name = malloc(strlen(index_fname) + sizeof(QUERY_SUFFIX));
+
+  if (name != NULL)
+  {
+    sprintf(name, "%s%s", index_fname, QUERY_SUFFIX);
+  }
+  return name;
+}
+
+/*
+ * Function: write_query_file
+ * Description: Writes header, tables and string pool to a temporary file and renames it over the query file
+ * Parameters: fname - query file name, header - completed header, docs, postings, years, pool - sections to write
+ * Return: Status (e_success/e_failure)
+ */
+static Status write_query_file(const char *fname, const QueryFileHeader *header, const QueryDoc *docs, QueryPosting *const postings[TAG_FIELD_COUNT], const QueryYear *years, const StringPool *pool)
+{
+  char *temp = malloc(strlen(fname) + 8); // fname + ".XXXXXX" + '\0'
+
+  if (temp == NULL)
+  {
+    return e_failure;
+  }
+  sprintf(temp, "%s.XXXXXX", fname);
+
+  int fd = mkstemp(temp);                            // New query file is written beside the old one
+  FILE *fptr = (fd == -1) ? NULL : fdopen(fd, "wb"); // Buffered section writes
+
+  if (fptr == NULL)
+  {
+    if (fd != -1)
+    {
+      close(fd);
+      unlink(temp);
+    }
+    free(temp);
+    return e_failure;
+  }
+  fchmod(fd, 0644); // Same permissions as the index
+
+  fwrite(header, sizeof(*header), 1, fptr);                   // Header
+  fwrite(docs, sizeof(QueryDoc), header->doc_count, fptr);    // Document table
+  for (int f = 0; f < TAG_FIELD_COUNT; f++)                   // Inverted index of every field
+  {
+    fwrite(postings[f], sizeof(QueryPosting), header->post_count[f], fptr);
+  }
+  fwrite(years, sizeof(QueryYear), header->year_count, fptr); // Year range index
+  fwrite(pool->data, 1, pool->len, fptr);                     // Strings
+
+  int failed = (fflush(fptr) == EOF || ferror(fptr) || fsync(fd) == -1); // Data on disk before the rename
+  failed |= (fclose(fptr) == EOF);
+
+  if (failed || rename(temp, fname) == -1) // Replace the old query file atomically
+  {
+    unlink(temp);
+    free(temp);
+    return e_failure;
+  }
+  free(temp);
+  return e_success;
+}
+
+/*
+ * Function: query_build
+ * Description: Builds document table, per-field inverted index and year range index from the tag index
+ * Parameters: index - pointer to TagIndex, index_fname - index file name
+ * Return: Status (e_success/e_failure)
+ */
+Status query_build(const TagIndex *index, const char *index_fname)
+{
+  QueryFileHeader header;                          // File header
+  StringPool pool = {NULL, 0, 0};                  // Paths, display values and folded keys
+  QueryDoc *docs = malloc((index->count ? index->count : 1) * sizeof(QueryDoc)); // One document per indexed file
+  QueryPosting *postings[TAG_FIELD_COUNT] = {NULL}; // Inverted index per field
+  QueryYear *years = malloc((index->count ? index->count : 1) * sizeof(QueryYear)); // Year range index
+  char *fname = query_file_name(index_fname);       // Query file name
+  Status status = e_failure;                        // Result of the build
+  uint32_t n = 0;                                    // Documents collected
+
+  memset(&header, 0, sizeof(header));
+  if (docs == NULL || years == NULL || fname == NULL)
+  {
+    goto done;
+  }
+
+  for (size_t i = 0; i < index->capacity; i++) // Documents: path + display values
+  {
+    const IndexEntry *entry = index->slots[i];
+
+    if (entry == NULL)
+    {
+      continue;
+    }
+    if (pool_add_string(&pool, entry->path, 0, &docs[n].path) == e_failure)
+    {
+      goto done;
+    }
+    for (int f = 0; f < TAG_FIELD_COUNT; f++)
+    {
+      docs[n].value[f] = QUERY_ABSENT;
+      if (entry->fields.value[f] != NULL && pool_add_string(&pool, entry->fields.value[f], 0, &docs[n].value[f]) == e_failure)
+      {
+        goto done;
+      }
+    }
+    n++;
+  }
+  qsort_r(docs, n, sizeof(QueryDoc), compare_doc_paths, pool.data); // Document number order = path order (sorted output)
+
+  for (int f = 0; f < TAG_FIELD_COUNT; f++) // Inverted index: folded value -> documents
+  {
+    if ((postings[f] = malloc((n ? n : 1) * sizeof(QueryPosting))) == NULL)
+    {
+      goto done;
+    }
+    for (uint32_t d = 0; d < n; d++)
+    {
+      if (docs[d].value[f] == QUERY_ABSENT)
+      {
+        continue;
+      }
+      QueryPosting *post = &postings[f][header.post_count[f]];
+      char *value = strdup(pool.data + docs[d].value[f]); // Pool may move while appending
+      Status added = (value == NULL) ? e_failure : pool_add_string(&pool, value, 1, &post->key);
+
+      free(value);
+      if (added == e_failure)
+      {
+        goto done;
+      }
+      post->doc = d;
+      header.post_count[f]++;
+    }
+  }
+  for (int f = 0; f < TAG_FIELD_COUNT; f++) // Sort keys once so lookups are binary searches
+  {
+    qsort_r(postings[f], header.post_count[f], sizeof(QueryPosting), compare_postings, pool.data);
+  }
+
+  for (uint32_t d = 0; d < n; d++) // Range index over the numeric year
+  {
+    int year;
+
+    if (docs[d].value[e_year] != QUERY_ABSENT && parse_year(pool.data + docs[d].value[e_year], &year))
+    {
+      years[header.year_count].year = year;
+      years[header.year_count].doc = d;
+      header.year_count++;
+    }
+  }
+  qsort(years, header.year_count, sizeof(QueryYear), compare_years);
+
+  memcpy(header.magic, QUERY_MAGIC, 8); // Section offsets follow the fixed order of the layout
+  header.byte_order = 0x01020304;
+  header.doc_count = n;
+  header.docs_off = sizeof(header);
+  uint64_t off = header.docs_off + (uint64_t)n * sizeof(QueryDoc);
+  for (int f = 0; f < TAG_FIELD_COUNT; f++)
+  {
+    header.post_off[f] = off;
+    off += (uint64_t)header.post_count[f] * sizeof(QueryPosting);
+  }
+  header.years_off = off;
+  header.strings_off = off + (uint64_t)header.year_count * sizeof(QueryYear);
+  header.strings_len = pool.len;
+
+  status = write_query_file(fname, &header, docs, postings, years, &pool);
+
+done:
+  if (status == e_failure)
+  {
+    fprintf(stderr, "\033[1;91mERROR: \033[1;97m%s%s: unable to write query index\033[0m\n", index_fname, QUERY_SUFFIX);
+  }
+  for (int f = 0; f < TAG_FIELD_COUNT; f++)
+  {
+    free(postings[f]);
+  }
+  free(pool.data);
+  free(docs);
+  free(years);
+  free(fname);
+  return status;
+}
+
+/*
+ * Function: parse_term
+ * Description: Parses field=value, field^=prefix or year=from..to (either end of the range may be left out)
+ * Parameters: arg - term text (modified in place), term - pointer to QueryTerm to fill
+ * Return: Status (e_success/e_failure)
+ */
+static Status parse_term(char *arg, QueryTerm *term)
+{
+  char *eq = strchr(arg, '='); // Separator between field and value
+
+  if (eq == NULL || eq == arg)
+  {
+    return e_failure;
+  }
+
+  term->op = (eq[-1] == '^') ? e_query_prefix : e_query_exact; // "^=" selects prefix search
+  eq[term->op == e_query_prefix ? -1 : 0] = '\0';              // Terminate the field name
+
+  int field = id3_field_lookup(arg);
+  if (field == -1)
+  {
+    return e_failure;
+  }
+  term->field = (TagField)field;
+
+  char *value = eq + 1;  // Value text
+  char *dots = strstr(value, "..");
+
+  if (term->field == e_year && term->op == e_query_exact && (dots != NULL || isdigit((unsigned char)*value))) // Numeric year or year range
+  {
+    term->op = e_query_range;
+    term->from = (dots == value) ? -2147483647 : atoi(value);                     // "..2003": no lower bound
+    term->to = dots == NULL ? term->from : (dots[2] ? atoi(dots + 2) : 2147483647); // "1998..": no upper bound
+    term->value = NULL;
+    return term->from <= term->to ? e_success : e_failure;
+  }
+
+  term->value = fold_string(value); // Keys are stored case-folded
+  return term->value != NULL ? e_success : e_failure;
+}
+
+/*
+ * Function: read_and_validate_for_query
+ * Description: Stores the index file name and parses every term
+ * Parameters: argc - argument count, argv[] - command-line argument array, qInfo - pointer to QueryInfo structure
+ * Return: Status (e_success/e_failure)
+ */
+Status read_and_validate_for_query(int argc, char *argv[], QueryInfo *qInfo)
+{
+  memset(qInfo, 0, sizeof(*qInfo)); // No terms, nothing mapped
+
+  if (argc < 4 || argc - 3 > QUERY_MAX_TERMS) // -q INDEX term...
+  {
+    printf("\033[1;91mERROR: \033[1;97mQuery needs an index file and 1 to %d terms\n", QUERY_MAX_TERMS);
+    return e_failure;
+  }
+  qInfo->index_fname = argv[2];
+
+  for (int i = 3; i < argc; i++) // Every remaining argument is a term
+  {
+    if (parse_term(argv[i], &qInfo->terms[qInfo->term_count]) == e_failure)
+    {
+      printf("\033[1;91mERROR: \033[1;97mInvalid query term %s (use field=value, field^=prefix or year=from..to)\n", argv[i]);
+      for (int t = 0; t < qInfo->term_count; t++)
+      {
+        free(qInfo->terms[t].value);
+      }
+      return e_failure;
+    }
+    qInfo->term_count++;
+  }
+  return e_success;
+}
+
+/*
+ * Function: map_query_file
+ * Description: Maps the query file and checks that every section lies inside it
+ * Parameters: qInfo - pointer to QueryInfo structure
+ * Return: Status (e_success/e_failure)
+ */
+static Status map_query_file(QueryInfo *qInfo)
+{
+  char *fname = query_file_name(qInfo->index_fname);
+  int fd = (fname == NULL) ? -1 : open(fname, O_RDONLY);
+  struct stat st;
+
+  if (fd == -1 || fstat(fd, &st) == -1 || (size_t)st.st_size < sizeof(QueryFileHeader))
+  {
+    fprintf(stderr, "\033[1;91mERROR: \033[1;97m%s: no query index (run a scan with --index=%s first)\033[0m\n", fname ? fname : qInfo->index_fname, qInfo->index_fname);
+    if (fd != -1)
+    {
+      close(fd);
+    }
+    free(fname);
+    return e_failure;
+  }
+
+  void *p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0); // Only the pages touched by the searches are read
+  close(fd); // Mapping stays valid after close
+  free(fname);
+
+  if (p == MAP_FAILED)
+  {
+    perror("mmap");
+    return e_failure;
+  }
+  qInfo->map = p;
+  qInfo->map_len = (size_t)st.st_size;
+  qInfo->header = p;
+
+  const QueryFileHeader *h = qInfo->header;
+  int valid = memcmp(h->magic, QUERY_MAGIC, 8) == 0 && h->byte_order == 0x01020304 &&
+              h->docs_off + (uint64_t)h->doc_count * sizeof(QueryDoc) <= qInfo->map_len &&
+              h->years_off + (uint64_t)h->year_count * sizeof(QueryYear) <= qInfo->map_len &&
+              h->strings_off + h->strings_len <= qInfo->map_len &&
+              (h->strings_len == 0 || qInfo->map[h->strings_off + h->strings_len - 1] == '\0'); // Pool must end with a terminator
+  for (int f = 0; f < TAG_FIELD_COUNT && valid; f++)
+  {
+    valid = h->post_off[f] + (uint64_t)h->post_count[f] * sizeof(QueryPosting) <= qInfo->map_len;
+  }
+
+  if (!valid) // Corrupt or from another version
+  {
+    fprintf(stderr, "\033[1;91mERROR: \033[1;97m%s%s: invalid query index\033[0m\n", qInfo->index_fname, QUERY_SUFFIX);
+    munmap((void *)qInfo->map, qInfo->map_len);
+    qInfo->map = NULL;
+    return e_failure;
+  }
+  return e_success;
+}
+
+/*
+ * Function: query_string
+ * Description: Returns a string of the mapped pool (empty for out-of-range offsets)
+ * Parameters: qInfo - pointer to QueryInfo, offset - string offset
+ * Return: const char * - string
+ */
+static const char *query_string(const QueryInfo *qInfo, uint32_t offset)
+{
+  if (offset >= qInfo->header->strings_len)
+  {
+    return "";
+  }
+  return (const char *)qInfo->map + qInfo->header->strings_off + offset;
+}
+
+/*
+ * Function: compare_u32
+ * Description: qsort comparator for document numbers
+ * Parameters: a, b - pointers to uint32_t
+ * Return: int - ordering
+ */
+static int compare_u32(const void *a, const void *b)
+{
+  uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+
+  return (x > y) - (x < y);
+}
+
+/*
+ * Function: term_documents
+ * Description: Finds all documents matching one term with a binary search over the sorted index
+ * Parameters: qInfo - pointer to QueryInfo, term - term to resolve, count - receives the number of documents
+ * Return: uint32_t * - malloc'd sorted document numbers (NULL on allocation failure)
+ */
+static uint32_t *term_documents(const QueryInfo *qInfo, const QueryTerm *term, size_t *count)
+{
+  const QueryFileHeader *h = qInfo->header;
+  size_t lo = 0, hi, n = 0; // Binary search bounds, matches
+  uint32_t *docs;
+
+  *count = 0;
+  if (term->op == e_query_range) // Year range index
+  {
+    const QueryYear *years = (const QueryYear *)(qInfo->map + h->years_off);
+
+    hi = h->year_count;
+    while (lo < hi) // First year >= from
+    {
+      size_t mid = lo + (hi - lo) / 2;
+      if (years[mid].year < term->from)
+      {
+        lo = mid + 1;
+      }
+      else
+      {
+        hi = mid;
+      }
+    }
+    hi = lo;
+    while (hi < h->year_count && years[hi].year <= term->to) // Run of years <= to
+    {
+      hi++;
+    }
+    if ((docs = malloc((hi - lo ? hi - lo : 1) * sizeof(uint32_t))) == NULL)
+    {
+      return NULL;
+    }
+    for (size_t i = lo; i < hi; i++)
+    {
+      docs[n++] = years[i].doc;
+    }
+    qsort(docs, n, sizeof(uint32_t), compare_u32); // Year order -> document order
+  }
+  else // Inverted index of the field
+  {
+    const QueryPosting *posts = (const QueryPosting *)(qInfo->map + h->post_off[term->field]);
+    size_t len = strlen(term->value);
+
+    hi = h->post_count[term->field];
+    while (lo < hi) // First key >= value
+    {
+      size_t mid = lo + (hi - lo) / 2;
+      if (strcmp(query_string(qInfo, posts[mid].key), term->value) < 0)
+      {
+        lo = mid + 1;
+      }
+      else
+      {
+        hi = mid;
+      }
+    }
+    for (hi = lo; hi < h->post_count[term->field]; hi++) // Run of equal (or prefixed) keys
+    {
+      const char *key = query_string(qInfo, posts[hi].key);
+      if (term->op == e_query_exact ? strcmp(key, term->value) != 0 : strncmp(key, term->value, len) != 0)
+      {
+        break;
+      }
+    }
+    if ((docs = malloc((hi - lo ? hi - lo : 1) * sizeof(uint32_t))) == NULL)
+    {
+      return NULL;
+    }
+    for (size_t i = lo; i < hi; i++)
+    {
+      docs[n++] = posts[i].doc;
+    }
+    if (term->op == e_query_prefix) // Several keys: merge their document lists
+    {
+      qsort(docs, n, sizeof(uint32_t), compare_u32);
+    }
+  }
+  *count = n;
+  return docs;
+}
+
+/*
+ * Function: intersect
+ * Description: Keeps the documents present in both sorted lists (result written over the first list)
+ * Parameters: a - sorted list (modified), a_count - its length, b - sorted list, b_count - its length
+ * Return: size_t - length of the intersection
+ */
+static size_t intersect(uint32_t *a, size_t a_count, const uint32_t *b, size_t b_count)
+{
+  size_t i = 0, j = 0, n = 0;
+
+  while (i < a_count && j < b_count)
+  {
+    if (a[i] < b[j])
+    {
+      i++;
+    }
+    else if (a[i] > b[j])
+    {
+      j++;
+    }
+    else
+    {
+      a[n++] = a[i];
+      i++;
+      j++;
+    }
+  }
+  return n;
+}
+
+/*
+ * Function: run_query
+ * Description: Resolves every term, intersects the results and prints the matching files
+ * Parameters: qInfo - pointer to QueryInfo structure
+ * Return: Status (e_success/e_failure)
+ */
+Status run_query(QueryInfo *qInfo)
+{
+  Status status = e_failure;
+  uint32_t *result = NULL; // Documents matching every term so far
+  size_t result_count = 0;
+
+  if (map_query_file(qInfo) == e_failure)
+  {
+    goto done;
+  }
+
+  for (int t = 0; t < qInfo->term_count; t++) // Terms are combined with AND
+  {
+    size_t count;
+    uint32_t *docs = term_documents(qInfo, &qInfo->terms[t], &count);
+
+    if (docs == NULL)
+    {
+      goto done;
+    }
+    if (result == NULL) // First term
+    {
+      result = docs;
+      result_count = count;
+    }
+    else
+    {
+      result_count = intersect(result, result_count, docs, count);
+      free(docs);
+    }
+    if (result_count == 0) // Nothing can match any more
+    {
+      break;
+    }
+  }
+
+  const QueryDoc *docs = (const QueryDoc *)(qInfo->map + qInfo->header->docs_off);
+  for (size_t i = 0; i < result_count; i++) // One line per match, in path order
+  {
+    const QueryDoc *doc = &docs[result[i]];
+
+    if (output_porcelain()) // JSON Lines / TSV record
+    {
+      TagFields fields; // Values point into the mapping (nothing copied)
+
+      for (int f = 0; f < TAG_FIELD_COUNT; f++)
+      {
+        fields.value[f] = doc->value[f] == QUERY_ABSENT ? NULL : (char *)query_string(qInfo, doc->value[f]);
+      }
+      output_tags(query_string(qInfo, doc->path), &fields);
+      continue;
+    }
+
+    printf("\033[1;92m%s\033[0m", query_string(qInfo, doc->path));
+    for (int f = 0; f < TAG_FIELD_COUNT; f++)
+    {
+      printf(" \033[1;97m▐ %s: \033[1;3m%s\033[0m", id3_field_names[f], doc->value[f] == QUERY_ABSENT ? "" : query_string(qInfo, doc->value[f]));
+    }
+    printf("\n");
+  }
+  qInfo->matches = result_count;
+  fprintf(stderr, "\033[1;97mMatched %lu of %u file(s)\033[0m\n", qInfo->matches, qInfo->header->doc_count);
+  status = e_success;
+
+done:
+  free(result);
+  for (int t = 0; t < qInfo->term_count; t++)
+  {
+    free(qInfo->terms[t].value);
+  }
+  if (qInfo->map != NULL)
+  {
+    munmap((void *)qInfo->map, qInfo->map_len);
+    qInfo->map = NULL;
+  }
+  return status;
+}
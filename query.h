@@ -0,0 +1,110 @@
+#ifndef QUERY_H // If not defined QUERY_H ---> Checks if QUERY_H was previously defined: If not present, code is processed; else code below till #endif is ignored
+#define QUERY_H // Defines the macro QUERY_H if macro was not previously defined
+
+#include <stddef.h> // Header file for size_t
+#include <stdint.h> // Header file for fixed-width integers (uint32_t, uint64_t) used in the query file layout
+#include "type.h"   // User-defined header file for custom type definitions (Status, e_success, e_failure)
+#include "id3.h"    // User-defined header file for TagField and TAG_FIELD_COUNT
+#include "index.h"  // User-defined header file for TagIndex (source of the query file)
+
+#define QUERY_MAGIC "MP3TQRY1"  // First 8 bytes of a query file (format version included)
+#define QUERY_SUFFIX ".q"       // Query file name = index file name + suffix
+#define QUERY_MAX_TERMS 16      // Maximum number of terms in one query
+#define QUERY_ABSENT UINT32_MAX // String offset of a field the file does not have
+
+/*
+ * Query file layout (written after every indexed scan, read through mmap):
+ * - QueryFileHeader
+ * - doc_count QueryDoc records (path + display values as string offsets)
+ * - per field: post_count[field] QueryPosting records sorted by case-folded value, then document (inverted index)
+ * - year_count QueryYear records sorted by year (range index)
+ * - string pool (null-terminated strings)
+ */
+typedef struct // typedef used to give alternate name for structure here
+{
+  char magic[8];                            // QUERY_MAGIC
+  uint32_t byte_order;                      // 0x01020304 as written (file is only read on the same byte order)
+  uint32_t doc_count;                       // Number of indexed files
+  uint32_t post_count[TAG_FIELD_COUNT];     // Number of postings per field
+  uint32_t year_count;                      // Number of year records
+  uint64_t docs_off;                        // Offset of the document table
+  uint64_t post_off[TAG_FIELD_COUNT];       // Offset of each field's posting list
+  uint64_t years_off;                       // Offset of the year table
+  uint64_t strings_off;                     // Offset of the string pool
+  uint64_t strings_len;                     // Size of the string pool
+} QueryFileHeader;                          // QueryFileHeader is alternate name for this structure
+
+typedef struct // typedef used to give alternate name for structure here
+{
+  uint32_t path;                   // String offset of the file path
+  uint32_t value[TAG_FIELD_COUNT]; // String offsets of the field values (QUERY_ABSENT if missing)
+} QueryDoc;                        // QueryDoc is alternate name for this structure
+
+typedef struct // typedef used to give alternate name for structure here
+{
+  uint32_t key; // String offset of the case-folded value
+  uint32_t doc; // Document number
+} QueryPosting; // QueryPosting is alternate name for this structure
+
+typedef struct // typedef used to give alternate name for structure here
+{
+  int32_t year; // Year parsed from TYER
+  uint32_t doc; // Document number
+} QueryYear;    // QueryYear is alternate name for this structure
+
+// Enumeration of the supported comparisons
+typedef enum // typedef used to give alternate name for enum here
+{
+  e_query_exact,  // field=value   (case-folded equality)
+  e_query_prefix, // field^=prefix (case-folded prefix)
+  e_query_range   // year=from..to (inclusive year range)
+} QueryOp;        // QueryOp is alternate name for this enum
+
+// Structure to store one query term
+typedef struct // typedef used to give alternate name for structure here
+{
+  TagField field; // Field compared
+  QueryOp op;     // Comparison
+  char *value;    // Case-folded value or prefix (exact/prefix)
+  int from, to;   // Inclusive year range (range)
+} QueryTerm;      // QueryTerm is alternate name for this structure
+
+// Structure to store the state of a query command
+typedef struct // typedef used to give alternate name for structure here
+{
+  char *index_fname;                 // Index file given on the command line (query file is index_fname + ".q")
+  QueryTerm terms[QUERY_MAX_TERMS];  // Parsed terms (all must match)
+  int term_count;                    // Number of terms
+  const unsigned char *map;          // Mapped query file
+  size_t map_len;                    // Length of the mapping
+  const QueryFileHeader *header;     // Header inside the mapping
+  unsigned long matches;             // Number of files printed
+} QueryInfo;                         // QueryInfo is alternate name for this structure
+
+/*
+ * Function: query_build
+ * Description: Writes the query file for an index: inverted index (case-folded value -> files) for every field and a
+ *              year range index. Called after every indexed scan so queries never need to touch the music files.
+ * Parameters: index - pointer to TagIndex, index_fname - index file name (query file is index_fname + ".q")
+ * Return: Status (e_success/e_failure)
+ */
+Status query_build(const TagIndex *index, const char *index_fname);
+
+/*
+ * Function: read_and_validate_for_query
+ * Description: Parses "-q INDEX term..." where a term is field=value, field^=prefix or year=from..to
+ * Parameters: argc - argument count, argv[] - command-line argument array, qInfo - pointer to QueryInfo structure
+ * Return: Status (e_success/e_failure)
+ */
+Status read_and_validate_for_query(int argc, char *argv[], QueryInfo *qInfo);
+
+/*
+ * Function: run_query
+ * Description: Maps the query file, resolves every term with binary searches, intersects the results and prints
+ *              one line per matching file
+ * Parameters: qInfo - pointer to QueryInfo structure
+ * Return: Status (e_success/e_failure)
+ */
+Status run_query(QueryInfo *qInfo);
+
+#endif // End of header guard: Marks the end of conditional compilation block started by #ifndef QUERY_H
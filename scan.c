@@ -0,0 +1,429 @@
+#include <stdio.h>    // Header file for standard input/output functions (printf, fprintf, getdelim, flockfile, etc.)
+#include <stdlib.h>   // Header file for memory allocation functions (malloc, free)
+#include <string.h>   // Header file for string manipulation functions (strcmp, strlen, strcasecmp, etc.)
+#include <strings.h>  // Header file for strcasecmp
+#include <dirent.h>   // Header file for directory streams (opendir, readdir, closedir)
+#include <limits.h>   // Header file for NAME_MAX (longest directory entry name)
+#include <sys/stat.h> // Header file for file status information (stat, lstat, S_ISDIR)
+#include <unistd.h>   // Header file for POSIX functions (close)
+#include "type.h"     // User-defined header file for custom type definitions (Status, e_success, e_failure)
+#include "id3.h"      // User-defined header file for ID3v2 tag loading (id3_read_tag, id3_collect_fields)
+#include "bulkio.h"   // User-defined header file for the bulk reader (io_uring or worker pool)
+#include "index.h"    // User-defined header file for the persistent tag index
+#include "query.h"    // User-defined header file for the query index built from the tag index
+#include "output.h"   // User-defined header file for JSON Lines / TSV output
+#include "trailer.h"  // User-defined header file for the trailer probe (files with only end-of-file tags)
+#include "stats.h"    // User-defined header file for phase timers (--stats)
+#include "scan.h"     // User-defined header file for ScanInfo structure and function declarations
+
+/*
+ * Function: is_directory
+ * Description: Checks whether a path names a directory
+ * Parameters: path - path to check
+ * Return: int - 1 for a directory, 0 otherwise
+ */
+static int is_directory(const char *path)
+{
+  struct stat st; // File status
+
+  return stat(path, &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+/*
+ * Function: has_mp3_extension
+ * Description: Checks for a ".mp3" suffix (case-insensitive, so ".MP3" files are found as well)
+ * Parameters: name - file name or path
+ * Return: int - 1 if the name ends in .mp3, 0 otherwise
+ */
+static int has_mp3_extension(const char *name)
+{
+  size_t len = strlen(name); // Length of the name
+
+  return len > 4 && strcasecmp(name + len - 4, ".mp3") == 0;
+}
+
+/*
+ * Function: is_scan_request
+ * Description: Scan mode is used for "-", for a directory, or for more than one path
+ * Parameters: argc - argument count, argv[] - command-line argument array
+ * Return: int - 1 for scan mode, 0 otherwise
+ */
+int is_scan_request(int argc, char *argv[])
+{
+  return argc > 3 || strcmp(argv[2], "-") == 0 || strncmp(argv[2], "--", 2) == 0 || is_directory(argv[2]);
+}
+
+/*
+ * Function: read_and_validate_for_scan
+ * Description: Records the scan paths; "-" anywhere means read a NUL-separated path list from standard input
+ * Parameters: argc - argument count, argv[] - command-line argument array, scInfo - pointer to ScanInfo structure
+ * Return: Status (e_success/e_failure)
+ */
+Status read_and_validate_for_scan(int argc, char *argv[], ScanInfo *scInfo)
+{
+  scInfo->paths = argv + 2;         // Paths start after "-v"
+  scInfo->path_count = argc - 2;    // Number of paths given
+  scInfo->from_stdin = 0;           // Standard input not requested yet
+  scInfo->files_read = 0;           // No files read yet
+  scInfo->files_failed = 0;         // No failures yet
+  scInfo->use_io_uring = 0;         // Thread-pool backend unless "--io=uring" is given
+  scInfo->index_fname = NULL;       // No index unless requested
+  scInfo->files_cached = 0;         // Nothing answered from the index yet
+
+  for (int i = 0; i < scInfo->path_count; i++) // Look for the "-" marker
+  {
+    if (strcmp(scInfo->paths[i], "-") == 0)
+    {
+      scInfo->from_stdin = 1; // Paths will also come from standard input
+    }
+    else if (strcmp(scInfo->paths[i], "--io=threads") == 0) // Portable thread-pool backend (default)
+    {
+      scInfo->use_io_uring = 0;
+    }
+    else if (strcmp(scInfo->paths[i], "--io=uring") == 0) // io_uring when available
+    {
+      scInfo->use_io_uring = 1;
+    }
+    else if (strncmp(scInfo->paths[i], "--index=", 8) == 0 && scInfo->paths[i][8] != '\0') // Persistent tag index file
+    {
+      scInfo->index_fname = scInfo->paths[i] + 8;
+    }
+    else if (strncmp(scInfo->paths[i], "--", 2) == 0) // Unknown option
+    {
+      printf("\033[1;91mERROR: \033[1;97mUnknown scan option %s\n", scInfo->paths[i]);
+      return e_failure;
+    }
+  }
+  return e_success;
+}
+
+/*
+ * Function: print_scan_line
+ * Description: Prints one line with the path and all fields of a file
+ * Parameters: path - file path, fields - decoded field values
+ * Return: void
+ */
+static void print_scan_line(const char *path, const TagFields *fields)
+{
+  if (output_porcelain()) // JSON Lines / TSV record instead of the coloured line
+  {
+    output_tags(path, fields);
+    return;
+  }
+
+  flockfile(stdout); // Keep the whole line together when several workers print
+  printf("\033[1;92m%s\033[0m", path);
+  for (int i = 0; i < TAG_FIELD_COUNT; i++) // Print every field on the same line
+  {
+    printf(" \033[1;97m▐ %s: \033[1;3m%s\033[0m", id3_field_names[i], fields->value[i] ? fields->value[i] : "");
+  }
+  printf("\n");
+  funlockfile(stdout);
+}
+
+/*
+ * Function: scan_trailer
+ * Description: Reads the tags at the end of a file without an ID3v2 tag, from the tail the bulk reader already read
+ *              when it has one (otherwise one pread of the tail through the open descriptor)
+ * Parameters: file - file handed to the callback, fields - pointer to TagFields to fill
+ * Return: Status (e_success if a trailer tag was found)
+ */
+static Status scan_trailer(const BulkFile *file, TagFields *fields)
+{
+  TrailerInfo trailer; // Trailer probe result
+  Status status;
+
+  if (file->fd == -1)
+  {
+    return e_failure;
+  }
+  if (file->tail != NULL) // Tail read by the io_uring backend
+  {
+    trailer_probe_tail(file->fd, file->tail, file->tail_len, file->size, &trailer);
+    status = e_success;
+  }
+  else
+  {
+    status = trailer_probe(file->fd, &trailer);
+  }
+  if (status == e_failure || trailer.found == 0) // Read error or no trailer tags
+  {
+    trailer_free(&trailer);
+    return e_failure;
+  }
+
+  *fields = trailer.fields; // Hand the merged values over to the caller
+  return e_success;
+}
+
+/*
+ * Function: scan_file
+ * Description: Bulk reader callback: parses the header + tag bytes read from one file and prints one line with all fields
+ * Parameters: file - path, FileIdentity taken before reading (NULL without an index), descriptor and bytes read,
+ *             ctx - pointer to ScanInfo
+ * Return: void
+ */
+static void scan_file(const BulkFile *file, void *ctx)
+{
+  ScanInfo *scInfo = ctx;        // Shared scan state
+  FileIdentity *id = file->item; // Identity to record in the index
+  const unsigned char *data = file->data; // Bytes from the start of the file (NULL if unreadable)
+  size_t len = file->len;        // Number of bytes read
+  Id3Header header;              // Decoded ID3v2 header
+  TagFields fields;              // Decoded field values
+  StatsTimer timer;              // Phase timer (--stats)
+
+  stats_begin(&timer);
+  Status status = (data != NULL && len >= ID3_HEADER_SIZE) ? id3_parse_header(data, &header) : e_failure;
+  stats_end(e_phase_header, &timer);
+
+  stats_begin(&timer);
+  if (status == e_failure) // No ID3v2 tag: try the trailer tags
+  {
+    if (data == NULL || scan_trailer(file, &fields) == e_failure) // Error handling: unreadable file or no tag at all
+    {
+      fprintf(stderr, "\033[1;91mERROR: \033[1;97m%s: unable to read ID3 tag\033[0m\n", file->path);
+      __atomic_add_fetch(&scInfo->files_failed, 1, __ATOMIC_RELAXED); // Count failure
+      free(id);
+      return;
+    }
+  }
+  else
+  {
+    size_t tag_len = len - ID3_HEADER_SIZE; // Tag bytes actually read (short for truncated files and large tags)
+    if (tag_len >= header.tag_size)         // Whole tag in memory: never parse beyond it (audio follows)
+    {
+      id3_collect_fields(&header, data + ID3_HEADER_SIZE, header.tag_size, &fields); // Decode known frames from the buffer
+    }
+    else // Tag with large binary frames: continue from the bytes already read through the reader's descriptor
+    {
+      id3_stream_fields(file->fd, &header, data + ID3_HEADER_SIZE, tag_len, &fields);
+    }
+  }
+  stats_end(e_phase_walk, &timer);
+  print_scan_line(file->path, &fields);
+
+  if (id != NULL) // Remember the result for the next scan
+  {
+    index_store(&scInfo->index, id, file->path, &fields);
+    free(id);
+  }
+
+  id3_free_fields(&fields);                                     // Free decoded values
+  __atomic_add_fetch(&scInfo->files_read, 1, __ATOMIC_RELAXED); // Count success
+}
+
+/*
+ * Function: submit_file
+ * Description: Answers a file from the index when its identity is unchanged; otherwise hands the path to
+ *              the bulk reader (blocks while the maximum number of files is in flight)
+ * Parameters: scInfo - pointer to ScanInfo, path - file path
+ * Return: void
+ */
+static void submit_file(ScanInfo *scInfo, const char *path)
+{
+  FileIdentity *id = NULL; // Identity handed to scan_file (index only)
+
+  if (scInfo->index_fname != NULL)
+  {
+    struct stat st;   // Current identity of the file (stat only, the file is not opened)
+    TagFields fields; // Indexed values
+
+    if (stat(path, &st) == 0 && (id = malloc(sizeof(FileIdentity))) != NULL)
+    {
+      index_identity(&st, id);
+      if (index_lookup(&scInfo->index, id, path, &fields)) // Unchanged since the last scan
+      {
+        print_scan_line(path, &fields);
+        id3_free_fields(&fields);
+        free(id);
+        __atomic_add_fetch(&scInfo->files_read, 1, __ATOMIC_RELAXED); // Workers update the same counter
+        scInfo->files_cached++;
+        return;
+      }
+    }
+  }
+
+  if (bulk_submit(&scInfo->reader, path, id) == e_failure) // Error handling: allocation or queue failure (the reader copies the path)
+  {
+    free(id);
+    __atomic_add_fetch(&scInfo->files_failed, 1, __ATOMIC_RELAXED);
+  }
+}
+
+/*
+ * Function: walk_directory
+ * Description: Recursively streams a directory and visits every .mp3 file (symbolic links to directories are not
+ *              followed, so link loops cannot make the walk run forever)
+ * Parameters: dir_path - directory to walk, visit - called for every file, ctx - passed to visit
+ * Return: void
+ */
+static void walk_directory(const char *dir_path, ScanVisit visit, void *ctx)
+{
+  DIR *dir = opendir(dir_path); // Open directory stream
+
+  if (dir == NULL) // Error handling: unreadable directory
+  {
+    fprintf(stderr, "\033[1;91mERROR: \033[1;97m%s: unable to open directory\033[0m\n", dir_path);
+    return;
+  }
+
+  size_t dir_len = strlen(dir_path);              // Length of the directory prefix
+  char *child = malloc(dir_len + NAME_MAX + 2); // Directory + '/' + name + '\0', reused for every entry
+  struct dirent *entry;                           // Current directory entry
+
+  if (child == NULL)
+  {
+    closedir(dir);
+    return;
+  }
+
+  while ((entry = readdir(dir)) != NULL) // Read entries one at a time (no full listing kept in memory)
+  {
+    if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) // Skip self and parent links
+    {
+      continue;
+    }
+
+    sprintf(child, "%s%s%s", dir_path, (dir_len && dir_path[dir_len - 1] == '/') ? "" : "/", entry->d_name); // Build child path
+
+    unsigned char type = entry->d_type; // Entry type from readdir (avoids a stat per file on most filesystems)
+    if (type == DT_UNKNOWN) // Filesystem does not report types: ask lstat
+    {
+      struct stat st;
+      type = (lstat(child, &st) == 0) ? (S_ISDIR(st.st_mode) ? DT_DIR : S_ISREG(st.st_mode) ? DT_REG : DT_LNK) : DT_UNKNOWN;
+    }
+
+    if (type == DT_DIR) // Sub-directory: walk it too
+    {
+      walk_directory(child, visit, ctx);
+    }
+    else if ((type == DT_REG || type == DT_LNK) && has_mp3_extension(entry->d_name)) // MP3 file (or link to one)
+    {
+      visit(child, ctx);
+    }
+  }
+  free(child);   // Free child path buffer (visit copies the path when it needs it later)
+  closedir(dir); // Close directory stream
+}
+
+/*
+ * Function: walk_path
+ * Description: Dispatches one command-line or stdin path: directories are walked, .mp3 files are visited
+ * Parameters: path - path to walk, visit - called for every file, ctx - passed to visit
+ * Return: Status (e_failure if the path is neither a directory nor an .mp3 file)
+ */
+static Status walk_path(const char *path, ScanVisit visit, void *ctx)
+{
+  if (is_directory(path)) // Directory: walk recursively
+  {
+    walk_directory(path, visit, ctx);
+  }
+  else if (has_mp3_extension(path)) // Single MP3 file
+  {
+    visit(path, ctx);
+  }
+  else
+  {
+    fprintf(stderr, "\033[1;91mERROR: \033[1;97m%s: not a directory or .mp3 file\033[0m\n", path);
+    return e_failure;
+  }
+  return e_success;
+}
+
+/*
+ * Function: scan_walk
+ * Description: Visits the .mp3 files of the command-line paths, then of the NUL-separated list on standard input
+ *              when one of the paths is "-"
+ * Parameters: paths - command-line paths, count - number of paths, visit - called for every file, ctx - passed to visit
+ * Return: unsigned long - number of paths that were neither a directory nor an .mp3 file
+ */
+unsigned long scan_walk(char **paths, int count, ScanVisit visit, void *ctx)
+{
+  unsigned long bad = 0; // Rejected paths
+  int from_stdin = 0;    // Set when "-" is among the paths
+
+  for (int i = 0; i < count; i++) // Command-line paths first
+  {
+    if (strcmp(paths[i], "-") == 0)
+    {
+      from_stdin = 1;
+    }
+    else if (strncmp(paths[i], "--", 2) != 0 && walk_path(paths[i], visit, ctx) == e_failure) // Options are skipped
+    {
+      bad++;
+    }
+  }
+
+  if (from_stdin) // NUL-separated list on standard input (e.g. find -print0)
+  {
+    char *line = NULL; // Buffer reused by getdelim for every path
+    size_t cap = 0;    // Capacity of the buffer
+    ssize_t len;       // Length of the current path
+
+    while ((len = getdelim(&line, &cap, '\0', stdin)) != -1)
+    {
+      if (len > 1 || (len == 1 && line[0] != '\0')) // Skip empty entries
+      {
+        bad += (walk_path(line, visit, ctx) == e_failure);
+      }
+    }
+    free(line); // Free path buffer
+  }
+  return bad;
+}
+
+/*
+ * Function: scan_visit
+ * Description: Walk callback of the scan: submits one file
+ * Parameters: path - file path, ctx - pointer to ScanInfo
+ * Return: void
+ */
+static void scan_visit(const char *path, void *ctx)
+{
+  submit_file(ctx, path);
+}
+
+/*
+ * Function: scan_library
+ * Description: Starts the bulk reader, feeds it from the command-line paths and/or standard input, then waits
+ * Parameters: scInfo - pointer to ScanInfo structure
+ * Return: Status (e_success/e_failure)
+ */
+Status scan_library(ScanInfo *scInfo)
+{
+  if (scInfo->index_fname != NULL && index_load(&scInfo->index, scInfo->index_fname) == e_failure) // Results of earlier scans
+  {
+    return e_failure;
+  }
+
+  if (bulk_start(&scInfo->reader, scInfo->use_io_uring, scan_file, scInfo) == e_failure) // io_uring queue, or one worker per CPU
+  {
+    if (scInfo->index_fname != NULL)
+    {
+      index_free(&scInfo->index);
+    }
+    return e_failure;
+  }
+
+  unsigned long bad = scan_walk(scInfo->paths, scInfo->path_count, scan_visit, scInfo); // Command-line paths, then stdin
+  __atomic_add_fetch(&scInfo->files_failed, bad, __ATOMIC_RELAXED);
+
+  bulk_finish(&scInfo->reader); // Wait until every queued file has been read
+
+  if (scInfo->index_fname != NULL) // Persist the index for the next scan
+  {
+    if (index_save(&scInfo->index, scInfo->index_fname) == e_failure)
+    {
+      fprintf(stderr, "\033[1;91mERROR: \033[1;97m%s: unable to write index\033[0m\n", scInfo->index_fname);
+    }
+    else
+    {
+      query_build(&scInfo->index, scInfo->index_fname); // Inverted and year range indexes for -q
+    }
+    index_free(&scInfo->index);
+  }
+
+  fprintf(stderr, "\033[1;97mScanned %lu file(s) (%lu from index), %lu failed\033[0m\n", scInfo->files_read, scInfo->files_cached, scInfo->files_failed);
+  return scInfo->files_failed ? e_failure : e_success;
+}
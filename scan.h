@@ -0,0 +1,65 @@
+#ifndef SCAN_H // If not defined SCAN_H ---> Checks if SCAN_H was previously defined: If not present, code is processed; else code below till #endif is ignored
+#define SCAN_H // Defines the macro SCAN_H if macro was not previously defined
+
+#include "type.h" // User-defined header file for custom type definitions (Status, e_success, e_failure)
+#include "bulkio.h" // User-defined header file for the bulk reader (io_uring or worker pool backend)
+#include "index.h" // User-defined header file for the persistent tag index
+
+// Function type called for every .mp3 file found by scan_walk (path is only valid during the call)
+typedef void (*ScanVisit)(const char *path, void *ctx);
+
+// Structure to store the state of a library scan (many files / directories read in parallel)
+typedef struct // typedef used to give alternate name for structure here
+{
+  char **paths;                // Files and directories given on the command line
+  int path_count;              // Number of entries in paths
+  int from_stdin;              // Set when paths are read as a NUL-separated list from standard input ("-")
+  int use_io_uring;            // 1 to use the io_uring backend when available ("--io=uring" sets it)
+  BulkReader reader;           // Bulk reader feeding tag bytes to the parser
+  char *index_fname;           // Persistent index file ("--index=FILE"), NULL when not used
+  TagIndex index;              // Index loaded from index_fname
+  unsigned long files_cached;  // Files answered from the index without being opened
+  unsigned long files_read;    // Files whose tag was printed (updated atomically by workers)
+  unsigned long files_failed;  // Files that could not be opened or had no ID3v2 tag
+} ScanInfo;                    // ScanInfo is alternate name for this structure
+
+/*
+ * Function: is_scan_request
+ * Description: Decides whether a -v command must run as a library scan (directory, several paths, or "-")
+ * Parameters: argc - argument count, argv[] - command-line argument array
+ * Return: int - 1 for scan mode, 0 for the single-file table view
+ */
+int is_scan_request(int argc, char *argv[]);
+
+/*
+ * Function: read_and_validate_for_scan
+ * Description: Stores the paths to scan (argv[2] .. argv[argc-1]) and the --io=uring|threads and --index=FILE
+ *              options in ScanInfo
+ * Parameters: argc - argument count, argv[] - command-line argument array, scInfo - pointer to ScanInfo structure
+ * Return: Status (e_success/e_failure)
+ */
+Status read_and_validate_for_scan(int argc, char *argv[], ScanInfo *scInfo);
+
+/*
+ * Function: scan_walk
+ * Description: Visits every .mp3 file of the given paths: directories are walked recursively (streamed, symbolic
+ *              links to directories not followed), "-" adds a NUL-separated path list read from standard input,
+ *              and arguments starting with "--" are skipped as options. Shared by the scan and the audio hashing.
+ * Parameters: paths - paths from the command line, count - number of paths, visit - called for every file,
+ *             ctx - passed to visit
+ * Return: unsigned long - number of paths that were neither a directory nor an .mp3 file (reported on stderr)
+ */
+unsigned long scan_walk(char **paths, int count, ScanVisit visit, void *ctx);
+
+/*
+ * Function: scan_library
+ * Description: Walks all given paths recursively and reads the tag of every .mp3 file through the bulk reader
+ *              (io_uring with many files in flight, or a worker pool sized to the machine). Memory stays bounded:
+ *              directories are streamed and the number of queued files is fixed. With an index, files whose device,
+ *              inode, size and mtime are unchanged are answered from the index without being opened.
+ * Parameters: scInfo - pointer to ScanInfo structure
+ * Return: Status (e_success if every file was read, e_failure otherwise)
+ */
+Status scan_library(ScanInfo *scInfo);
+
+#endif // End of header guard: Marks the end of conditional compilation block started by #ifndef SCAN_H
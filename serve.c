@@ -0,0 +1,659 @@
+#define _GNU_SOURCE // Enables GNU extensions (fwrite_unlocked, open_memstream)
+
+#include <stdio.h>      // Header file for standard input/output functions (fprintf, fgets, open_memstream)
+#include <stdlib.h>     // Header file for memory allocation functions (malloc, free, realpath)
+#include <string.h>     // Header file for string functions (strcmp, strlen, strchr, memset)
+#include <signal.h>     // Header file for signal handling (SIGPIPE, SIGINT, SIGTERM)
+#include <errno.h>      // Header file for errno (cause of a failed edit)
+#include <fcntl.h>      // Header file for open() and its flags
+#include <unistd.h>     // Header file for POSIX functions (close, unlink, write)
+#include <limits.h>     // Header file for PATH_MAX
+#include <sys/socket.h> // Header file for socket, bind, listen, accept
+#include <sys/un.h>     // Header file for struct sockaddr_un
+#include <sys/stat.h>   // Header file for stat() (file identity, stale socket check)
+#include <time.h>       // Header file for nanosleep() (accept back-off when out of descriptors)
+#include "type.h"       // User-defined header file for custom type definitions (Status, e_success, e_failure)
+#include "id3.h"        // User-defined header file for field IDs and id3_free_fields
+#include "index.h"      // User-defined header file for FileIdentity (index_identity)
+#include "mp3tag.h"     // Library header file for reading and editing tags (open, parse, get/set frame, commit)
+#include "output.h"     // User-defined header file for JSON string output
+#include "serve.h"      // User-defined header file for ServeInfo structure and function declarations
+
+#define SERVE_MAX_FIELDS 16 // Most tab-separated fields in one request (command, path, 7 field/value pairs)
+#define SERVE_MAX_LINE 65536 // Longest request line kept (longer lines are drained and answered with an error)
+#define SERVE_ACCEPT_BACKOFF_NS 100000000L // Pause of the accept loop while the process is out of descriptors (100 ms)
+
+static const char *listening_path; // Socket removed by the signal handler
+
+// Structure to store what a connection thread needs
+typedef struct // typedef used to give alternate name for structure here
+{
+  ServeInfo *seInfo; // Shared service state
+  int fd;            // Connected client
+} ServeClient;       // ServeClient is alternate name for this structure
+
+/*
+ * Function: read_and_validate_for_serve
+ * Description: Stores the socket path and prepares the cache and the locks
+ * Parameters: argc - argument count, argv[] - command-line argument array, seInfo - pointer to ServeInfo structure
+ * Return: Status (e_success/e_failure)
+ */
+Status read_and_validate_for_serve(int argc, char *argv[], ServeInfo *seInfo)
+{
+  memset(seInfo, 0, sizeof(*seInfo)); // Empty cache
+
+  if (argc != 3) // Error handling: exactly one socket path
+  {
+    printf("\033[1;91mERROR: \033[1;97mUsage: --serve <socket>\n");
+    return e_failure;
+  }
+  if (strlen(argv[2]) >= sizeof(((struct sockaddr_un *)0)->sun_path)) // Error handling: path does not fit the address
+  {
+    printf("\033[1;91mERROR: \033[1;97mSocket path too long: %s\n", argv[2]);
+    return e_failure;
+  }
+  seInfo->socket_path = argv[2];
+  seInfo->listen_fd = -1;
+  pthread_mutex_init(&seInfo->cache_lock, NULL);
+  for (int i = 0; i < SERVE_LOCK_STRIPES; i++)
+  {
+    pthread_rwlock_init(&seInfo->file_locks[i], NULL);
+  }
+  return e_success;
+}
+
+/*
+ * Function: hash_path
+ * Description: FNV-1a hash of a path
+ * Parameters: path - null-terminated path
+ * Return: unsigned long - hash value
+ */
+static unsigned long hash_path(const char *path)
+{
+  unsigned long h = 2166136261UL;
+
+  for (const unsigned char *p = (const unsigned char *)path; *p != '\0'; p++)
+  {
+    h = (h ^ *p) * 16777619UL;
+  }
+  return h;
+}
+
+/*
+ * Function: file_lock
+ * Description: Picks the lock stripe of a file from its resolved path, so two spellings of one file share a lock
+ * Parameters: seInfo - pointer to ServeInfo, path - path sent by the client
+ * Return: pthread_rwlock_t * - lock of the file
+ */
+static pthread_rwlock_t *file_lock(ServeInfo *seInfo, const char *path)
+{
+  char real[PATH_MAX];
+  const char *key = realpath(path, real) != NULL ? real : path; // Missing file: the request fails anyway
+
+  return &seInfo->file_locks[hash_path(key) % SERVE_LOCK_STRIPES];
+}
+
+/*
+ * Function: same_identity
+ * Description: Compares two file identities
+ * Parameters: a, b - identities
+ * Return: int - 1 if device, inode, size and mtime all match
+ */
+static int same_identity(const FileIdentity *a, const FileIdentity *b)
+{
+  return a->dev == b->dev && a->ino == b->ino && a->size == b->size && a->mtime_sec == b->mtime_sec && a->mtime_nsec == b->mtime_nsec;
+}
+
+/*
+ * Function: cache_find
+ * Description: Finds the entry of a path (cache_lock held)
+ * Parameters: seInfo - pointer to ServeInfo, path - client path, slot - receives the bucket link pointing to the entry
+ * Return: CacheEntry * - entry, or NULL
+ */
+static CacheEntry *cache_find(ServeInfo *seInfo, const char *path, CacheEntry ***slot)
+{
+  CacheEntry **link = &seInfo->buckets[hash_path(path) & (SERVE_CACHE_BUCKETS - 1)];
+
+  while (*link != NULL && strcmp((*link)->path, path) != 0)
+  {
+    link = &(*link)->chain;
+  }
+  *slot = link;
+  return *link;
+}
+
+/*
+ * Function: lru_unlink
+ * Description: Takes an entry out of the LRU list (cache_lock held)
+ * Parameters: seInfo - pointer to ServeInfo, entry - entry in the list
+ * Return: void
+ */
+static void lru_unlink(ServeInfo *seInfo, CacheEntry *entry)
+{
+  if (entry->prev != NULL)
+  {
+    entry->prev->next = entry->next;
+  }
+  else
+  {
+    seInfo->newest = entry->next;
+  }
+  if (entry->next != NULL)
+  {
+    entry->next->prev = entry->prev;
+  }
+  else
+  {
+    seInfo->oldest = entry->prev;
+  }
+}
+
+/*
+ * Function: lru_push
+ * Description: Makes an entry the most recently used (cache_lock held)
+ * Parameters: seInfo - pointer to ServeInfo, entry - entry not in the list
+ * Return: void
+ */
+static void lru_push(ServeInfo *seInfo, CacheEntry *entry)
+{
+  entry->prev = NULL;
+  entry->next = seInfo->newest;
+  if (seInfo->newest != NULL)
+  {
+    seInfo->newest->prev = entry;
+  }
+  seInfo->newest = entry;
+  if (seInfo->oldest == NULL)
+  {
+    seInfo->oldest = entry;
+  }
+}
+
+/*
+ * Function: cache_free
+ * Description: Frees an entry that is no longer in the table or the list
+ * Parameters: entry - entry to free
+ * Return: void
+ */
+static void cache_free(CacheEntry *entry)
+{
+  id3_free_fields(&entry->fields);
+  free(entry->path);
+  free(entry);
+}
+
+/*
+ * Function: cache_drop
+ * Description: Removes the entry of a path, if any (cache_lock held)
+ * Parameters: seInfo - pointer to ServeInfo, path - client path
+ * Return: void
+ */
+static void cache_drop(ServeInfo *seInfo, const char *path)
+{
+  CacheEntry **slot;
+  CacheEntry *entry = cache_find(seInfo, path, &slot);
+
+  if (entry != NULL)
+  {
+    *slot = entry->chain;
+    lru_unlink(seInfo, entry);
+    seInfo->cached--;
+    cache_free(entry);
+  }
+}
+
+/*
+ * Function: cache_insert
+ * Description: Adds a freshly parsed entry, replacing any older entry of the same path and evicting the least
+ *              recently used entry when the cache is full (cache_lock held)
+ * Parameters: seInfo - pointer to ServeInfo, entry - new entry
+ * Return: void
+ */
+static void cache_insert(ServeInfo *seInfo, CacheEntry *entry)
+{
+  CacheEntry **slot;
+
+  cache_drop(seInfo, entry->path);
+  if (seInfo->cached == SERVE_CACHE_SIZE) // Full: drop the least recently used entry
+  {
+    cache_drop(seInfo, seInfo->oldest->path);
+  }
+  cache_find(seInfo, entry->path, &slot); // Empty link at the end of the bucket
+  entry->chain = NULL;
+  *slot = entry;
+  lru_push(seInfo, entry);
+  seInfo->cached++;
+}
+
+/*
+ * Function: load_entry
+ * Description: Reads the tags of a file through the tag library, like view_tags: ID3v2 frames streamed, missing
+ *              fields from the trailer tags
+ * Parameters: path - file path, id - identity taken before reading
+ * Return: CacheEntry * - new entry (not in the cache), or NULL if the file has no tag or cannot be read
+ */
+static CacheEntry *load_entry(const char *path, const FileIdentity *id)
+{
+  Mp3Tag *tag = NULL;
+  CacheEntry *entry = NULL;
+
+  if (mp3tag_open_file(path, 0, &tag) == e_mp3tag_ok && mp3tag_parse(tag) == e_mp3tag_ok &&
+      (entry = calloc(1, sizeof(CacheEntry))) != NULL)
+  {
+    Status status = ((entry->path = strdup(path)) != NULL) ? e_success : e_failure;
+
+    entry->id = *id;
+    mp3tag_version(tag, &entry->major, &entry->revision); // Both stay 0 without an ID3v2 tag
+    for (int i = 0; i < TAG_FIELD_COUNT && status == e_success; i++) // Copy the values out of the handle
+    {
+      const char *value;
+      if (mp3tag_get_frame(tag, id3_field_ids[i], &value) == e_mp3tag_ok && (entry->fields.value[i] = strdup(value)) == NULL)
+      {
+        status = e_failure;
+      }
+    }
+    if (status == e_failure) // Error handling: allocation failed
+    {
+      id3_free_fields(&entry->fields);
+      free(entry->path);
+      free(entry);
+      entry = NULL;
+    }
+  }
+  mp3tag_close(tag);
+  return entry;
+}
+
+/*
+ * Function: put_entry
+ * Description: Writes the reply of a VIEW or VERSION request from a cache entry (cache_lock held)
+ * Parameters: out - reply stream, entry - cached tags, version - 1 for VERSION, hit - 1 if answered from the cache
+ * Return: void
+ */
+static void put_entry(FILE *out, const CacheEntry *entry, int version, int hit)
+{
+  if (version && entry->major == 0) // Only trailer tags: no ID3v2 version to report
+  {
+    fputs("{\"error\":\"no ID3v2 tag\"}\n", out);
+    return;
+  }
+  fputs("{\"path\":", out);
+  output_json_string(out, entry->path);
+  if (version)
+  {
+    fprintf(out, ",\"version\":\"2.%d.%d\"}\n", entry->major, entry->revision);
+    return;
+  }
+  output_json_fields(out, &entry->fields);
+  fprintf(out, ",\"cached\":%s}\n", hit ? "true" : "false");
+}
+
+/*
+ * Function: serve_tags
+ * Description: Answers VIEW / VERSION: from the cache when the file identity is unchanged, else by parsing the
+ *              file under its read lock and caching the result
+ * Parameters: seInfo - pointer to ServeInfo, path - file path, version - 1 for VERSION, out - reply stream
+ * Return: void
+ */
+static void serve_tags(ServeInfo *seInfo, const char *path, int version, FILE *out)
+{
+  struct stat st;
+  FileIdentity id;
+  CacheEntry **slot;
+
+  if (stat(path, &st) != 0 || !S_ISREG(st.st_mode)) // Error handling: missing file or not a regular file
+  {
+    fputs("{\"error\":\"unable to open file\"}\n", out);
+    return;
+  }
+  index_identity(&st, &id);
+
+  pthread_mutex_lock(&seInfo->cache_lock);
+  CacheEntry *entry = cache_find(seInfo, path, &slot);
+  if (entry != NULL && same_identity(&entry->id, &id)) // Warm: no file access beyond stat()
+  {
+    lru_unlink(seInfo, entry);
+    lru_push(seInfo, entry);
+    seInfo->cache_hits++;
+    put_entry(out, entry, version, 1);
+    pthread_mutex_unlock(&seInfo->cache_lock);
+    return;
+  }
+  pthread_mutex_unlock(&seInfo->cache_lock);
+
+  pthread_rwlock_t *lock = file_lock(seInfo, path); // Never read a tag while an edit rewrites it
+  pthread_rwlock_rdlock(lock);
+  entry = load_entry(path, &id);
+  pthread_rwlock_unlock(lock);
+  if (entry == NULL)
+  {
+    fputs("{\"error\":\"no ID3 tag\"}\n", out);
+    return;
+  }
+
+  pthread_mutex_lock(&seInfo->cache_lock);
+  cache_insert(seInfo, entry);
+  put_entry(out, entry, version, 0);
+  pthread_mutex_unlock(&seInfo->cache_lock);
+}
+
+/*
+ * Function: serve_edit
+ * Description: Answers EDIT: applies every field/value pair in one rewrite while holding the file's write lock,
+ *              then drops the cached tags
+ * Parameters: seInfo - pointer to ServeInfo, args - path then field/value pairs, count - number of args, out - reply stream
+ * Return: void
+ */
+static void serve_edit(ServeInfo *seInfo, char **args, int count, FILE *out)
+{
+  if (count < 3 || count % 2 == 0) // Error handling: path + at least one field/value pair
+  {
+    fputs("{\"error\":\"usage: EDIT <path> <field> <value> [<field> <value> ...]\"}\n", out);
+    return;
+  }
+
+  pthread_rwlock_t *lock = file_lock(seInfo, args[0]); // One edit of a file at a time
+  Mp3Tag *tag = NULL;
+
+  pthread_rwlock_wrlock(lock);
+  Mp3TagError error = mp3tag_open_file(args[0], 1, &tag);
+  if (error == e_mp3tag_ok)
+  {
+    error = edit_set_padding(tag, &seInfo->padding); // Policy given with --padding when the service started
+  }
+  for (int i = 1; i + 1 < count && error == e_mp3tag_ok; i += 2) // Stage every pair, then one rewrite
+  {
+    error = mp3tag_set_frame(tag, args[i], args[i + 1]);
+  }
+  if (error == e_mp3tag_ok)
+  {
+    error = mp3tag_commit(tag);
+  }
+  int saved = errno; // Cause of an e_mp3tag_io failure: the failing call was the last one made
+  mp3tag_close(tag);
+  pthread_mutex_lock(&seInfo->cache_lock);
+  cache_drop(seInfo, args[0]); // Next VIEW re-reads the file
+  pthread_mutex_unlock(&seInfo->cache_lock);
+  pthread_rwlock_unlock(lock);
+
+  if (error != e_mp3tag_ok)
+  {
+    fputs("{\"error\":", out);
+    output_json_string(out, (error == e_mp3tag_io) ? strerror(saved) : mp3tag_strerror(error));
+    fputs("}\n", out);
+    return;
+  }
+  fputs("{\"path\":", out);
+  output_json_string(out, args[0]);
+  fputs(",\"edited\":true}\n", out);
+}
+
+/*
+ * Function: split_request
+ * Description: Splits a request line at tabs and resolves the \t, \n and \\ escapes in place
+ * Parameters: line - request without its newline, args - receives the fields
+ * Return: int - number of fields (at most SERVE_MAX_FIELDS)
+ */
+static int split_request(char *line, char **args)
+{
+  int count = 0;
+  char *out = line;
+
+  args[count++] = out;
+  for (char *p = line; *p != '\0'; p++)
+  {
+    if (*p == '\t') // Field separator
+    {
+      *out++ = '\0';
+      if (count == SERVE_MAX_FIELDS)
+      {
+        break;
+      }
+      args[count++] = out;
+    }
+    else if (*p == '\\' && p[1] != '\0') // Escape
+    {
+      p++;
+      *out++ = (*p == 't') ? '\t' : (*p == 'n') ? '\n' : (*p == 'r') ? '\r' : *p;
+    }
+    else
+    {
+      *out++ = *p;
+    }
+  }
+  *out = '\0';
+  return count;
+}
+
+/*
+ * Function: serve_line
+ * Description: Runs one request and writes its JSON reply
+ * Parameters: seInfo - pointer to ServeInfo, line - request line, out - reply stream
+ * Return: void
+ */
+static void serve_line(ServeInfo *seInfo, char *line, FILE *out)
+{
+  char *args[SERVE_MAX_FIELDS];
+  int count = split_request(line, args);
+
+  __atomic_add_fetch(&seInfo->requests, 1, __ATOMIC_RELAXED);
+  if ((strcmp(args[0], "VIEW") == 0 || strcmp(args[0], "VERSION") == 0) && count == 2)
+  {
+    serve_tags(seInfo, args[1], strcmp(args[0], "VERSION") == 0, out);
+  }
+  else if (strcmp(args[0], "EDIT") == 0)
+  {
+    serve_edit(seInfo, args + 1, count - 1, out);
+  }
+  else if (strcmp(args[0], "STATS") == 0)
+  {
+    pthread_mutex_lock(&seInfo->cache_lock);
+    fprintf(out, "{\"requests\":%lu,\"cache_hits\":%lu,\"cached\":%zu}\n", seInfo->requests, seInfo->cache_hits, seInfo->cached);
+    pthread_mutex_unlock(&seInfo->cache_lock);
+  }
+  else
+  {
+    fputs("{\"error\":\"unknown request (VIEW, VERSION, EDIT, STATS)\"}\n", out);
+  }
+}
+
+/*
+ * Function: read_request
+ * Description: Reads one request line into a fixed buffer; the rest of a line longer than the buffer is read and
+ *              dropped, so a client cannot make the service allocate without bound
+ * Parameters: in - client stream, line - buffer of SERVE_MAX_LINE + 1 bytes, too_long - set to 1 for a dropped line
+ * Return: ssize_t - length without the line end, or -1 at end of stream
+ */
+static ssize_t read_request(FILE *in, char *line, int *too_long)
+{
+  size_t len;
+  int c;
+
+  *too_long = 0;
+  if (fgets(line, SERVE_MAX_LINE + 1, in) == NULL)
+  {
+    return -1;
+  }
+  len = strlen(line);
+  if (len > 0 && line[len - 1] == '\n')
+  {
+    line[--len] = '\0';
+  }
+  else if (len == SERVE_MAX_LINE && (c = getc(in)) != EOF && c != '\n') // Buffer full before the line end
+  {
+    while ((c = getc(in)) != EOF && c != '\n') // Drain the rest of the line
+    {
+    }
+    *too_long = 1;
+  }
+  if (len > 0 && line[len - 1] == '\r') // Tolerate CRLF clients
+  {
+    line[--len] = '\0';
+  }
+  return (ssize_t)len;
+}
+
+/*
+ * Function: serve_client
+ * Description: Connection thread: answers request lines until the client closes the connection
+ * Parameters: arg - malloc'd ServeClient
+ * Return: void * - NULL
+ */
+static void *serve_client(void *arg)
+{
+  ServeClient *client = arg;
+  FILE *in = fdopen(client->fd, "r"); // Buffered reads of request lines
+  char *line = malloc(SERVE_MAX_LINE + 1); // Request line (fixed size for the whole connection)
+  int too_long;
+
+  while (in != NULL && line != NULL && read_request(in, line, &too_long) >= 0)
+  {
+    char *reply = NULL;
+    size_t reply_len = 0;
+    FILE *out = open_memstream(&reply, &reply_len); // Whole reply sent with one write
+
+    if (out == NULL)
+    {
+      break;
+    }
+    if (too_long)
+    {
+      fputs("{\"error\":\"request line too long\"}\n", out);
+    }
+    else
+    {
+      serve_line(client->seInfo, line, out);
+    }
+    fclose(out);
+
+    size_t sent = 0;
+    while (sent < reply_len) // Error handling: a client that went away ends the connection (SIGPIPE is ignored)
+    {
+      ssize_t n = write(client->fd, reply + sent, reply_len - sent);
+      if (n <= 0)
+      {
+        break;
+      }
+      sent += (size_t)n;
+    }
+    free(reply);
+    if (sent < reply_len)
+    {
+      break;
+    }
+  }
+
+  free(line);
+  if (in != NULL)
+  {
+    fclose(in); // Also closes the socket
+  }
+  else
+  {
+    close(client->fd);
+  }
+  free(client);
+  return NULL;
+}
+
+/*
+ * Function: stop_serving
+ * Description: SIGINT / SIGTERM handler: removes the socket file and exits (only async-signal-safe calls)
+ * Parameters: sig - signal number
+ * Return: void
+ */
+static void stop_serving(int sig)
+{
+  (void)sig;
+  unlink(listening_path);
+  _exit(0);
+}
+
+/*
+ * Function: open_socket
+ * Description: Creates, binds and listens on the Unix socket; a stale socket file left by a crash is replaced,
+ *              any other existing file is left alone
+ * Parameters: seInfo - pointer to ServeInfo structure
+ * Return: Status (e_success/e_failure)
+ */
+static Status open_socket(ServeInfo *seInfo)
+{
+  struct sockaddr_un addr;
+  struct stat st;
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strcpy(addr.sun_path, seInfo->socket_path); // Length checked by read_and_validate_for_serve
+
+  if (lstat(seInfo->socket_path, &st) == 0 && S_ISSOCK(st.st_mode)) // Stale socket from an earlier run
+  {
+    unlink(seInfo->socket_path);
+  }
+
+  seInfo->listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (seInfo->listen_fd == -1 || bind(seInfo->listen_fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(seInfo->listen_fd, SOMAXCONN) != 0)
+  {
+    perror("socket");
+    fprintf(stderr, "\033[1;91mERROR: \033[1;97m%s: unable to listen\033[0m\n", seInfo->socket_path);
+    if (seInfo->listen_fd != -1)
+    {
+      close(seInfo->listen_fd);
+    }
+    return e_failure;
+  }
+  return e_success;
+}
+
+/*
+ * Function: serve_requests
+ * Description: Accept loop: one detached thread per connection
+ * Parameters: seInfo - pointer to ServeInfo structure
+ * Return: Status (e_failure if the socket cannot be created)
+ */
+Status serve_requests(ServeInfo *seInfo)
+{
+  pthread_attr_t attr;
+
+  if (open_socket(seInfo) == e_failure)
+  {
+    return e_failure;
+  }
+  listening_path = seInfo->socket_path;
+  signal(SIGPIPE, SIG_IGN); // A vanished client is a failed write, not a dead service
+  signal(SIGINT, stop_serving);
+  signal(SIGTERM, stop_serving);
+
+  pthread_attr_init(&attr);
+  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+  fprintf(stderr, "\033[1;97mServing on %s\033[0m\n", seInfo->socket_path);
+
+  for (;;)
+  {
+    int fd = accept4(seInfo->listen_fd, NULL, NULL, SOCK_CLOEXEC);
+    if (fd == -1) // Keep serving; out of descriptors or memory, the pending connection stays queued, so wait first
+    {
+      if (errno == EMFILE || errno == ENFILE || errno == ENOBUFS || errno == ENOMEM)
+      {
+        struct timespec pause = {0, SERVE_ACCEPT_BACKOFF_NS}; // Connections closing meanwhile free descriptors
+        nanosleep(&pause, NULL);
+      }
+      continue;
+    }
+
+    pthread_t thread;
+    ServeClient *client = malloc(sizeof(ServeClient));
+    if (client == NULL)
+    {
+      close(fd);
+      continue;
+    }
+    client->seInfo = seInfo;
+    client->fd = fd;
+    if (pthread_create(&thread, &attr, serve_client, client) != 0) // Error handling: no thread, drop the connection
+    {
+      close(fd);
+      free(client);
+    }
+  }
+  return e_success; // Not reached: the signal handler exits
+}
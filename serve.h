@@ -0,0 +1,75 @@
+#ifndef SERVE_H // If not defined SERVE_H ---> Checks if SERVE_H was previously defined: If not present, code is processed; else code below till #endif is ignored
+#define SERVE_H // Defines the macro SERVE_H if macro was not previously defined
+
+#include <stddef.h>  // Header file for size_t
+#include <pthread.h> // Header file for pthread_mutex_t / pthread_rwlock_t
+#include "type.h"    // User-defined header file for custom type definitions (Status, e_success, e_failure)
+#include "id3.h"     // User-defined header file for TagFields
+#include "index.h"   // User-defined header file for FileIdentity (cache validation)
+#include "edit_cli.h" // User-defined header file for EditPadding (--padding policy)
+
+#define SERVE_CACHE_SIZE 4096                   // Parsed tags kept warm; the least recently used are dropped
+#define SERVE_CACHE_BUCKETS (2 * SERVE_CACHE_SIZE) // Hash buckets of the cache (power of two)
+#define SERVE_LOCK_STRIPES 64                   // Per-file locks: each path hashes onto one of these reader/writer locks
+
+/*
+ * Request protocol: one request per line, fields separated by tabs ("\t", "\n" and "\\" escaped as in --format=tsv).
+ * Every request gets exactly one JSON line back; failures are {"error":"..."}.
+ *
+ *   VIEW <path>                         -> {"path":...,"title":...,...,"comment":...,"cached":true|false}
+ *   VERSION <path>                      -> {"path":...,"version":"2.3.0"}
+ *   EDIT <path> <field> <value> [...]   -> {"path":...,"edited":true}     (field: title, artist, album, year, genre, comment)
+ *   STATS                               -> {"requests":...,"cache_hits":...,"cached":...}
+ *
+ * A connection may send any number of requests; replies come back in order.
+ */
+
+// Structure to store the parsed tags of one file in the cache
+typedef struct CacheEntry // typedef used to give alternate name for structure here
+{
+  char *path;               // Path as sent by the client (cache key)
+  FileIdentity id;          // Identity before the file was read: any change makes the entry stale
+  TagFields fields;         // Decoded field values (ID3v2 first, trailer tags for missing fields)
+  int major;                // ID3v2 major version (0 = no ID3v2 tag)
+  int revision;             // ID3v2 revision
+  struct CacheEntry *chain; // Next entry in the same hash bucket
+  struct CacheEntry *prev;  // More recently used entry
+  struct CacheEntry *next;  // Less recently used entry
+} CacheEntry;               // CacheEntry is alternate name for this structure
+
+// Structure to store the state of the tag service
+typedef struct // typedef used to give alternate name for structure here
+{
+  const char *socket_path;                          // Unix domain socket the service listens on
+  int listen_fd;                                    // Listening socket
+  CacheEntry *buckets[SERVE_CACHE_BUCKETS];         // Cache hash table (chained)
+  CacheEntry *newest;                               // Head of the LRU list
+  CacheEntry *oldest;                               // Tail of the LRU list (evicted first)
+  size_t cached;                                    // Entries in the cache
+  pthread_mutex_t cache_lock;                       // Protects the table, the list and the counters
+  pthread_rwlock_t file_locks[SERVE_LOCK_STRIPES];  // Edits take a stripe for writing, cache misses for reading
+  unsigned long requests;                           // Requests answered
+  unsigned long cache_hits;                         // VIEW / VERSION requests answered from the cache
+  EditPadding padding;                              // --padding policy of EDIT requests (set by main)
+} ServeInfo;                                        // ServeInfo is alternate name for this structure
+
+/*
+ * Function: read_and_validate_for_serve
+ * Description: Stores the socket path given after --serve
+ * Parameters: argc - argument count, argv[] - command-line argument array, seInfo - pointer to ServeInfo structure
+ * Return: Status (e_success/e_failure)
+ */
+Status read_and_validate_for_serve(int argc, char *argv[], ServeInfo *seInfo);
+
+/*
+ * Function: serve_requests
+ * Description: Listens on the Unix socket and answers requests until SIGINT / SIGTERM. Each connection has its own
+ *              thread. Parsed tags stay in an LRU cache validated by file identity (device, inode, size, mtime),
+ *              so a repeated VIEW costs one stat() and no read. Edits of the same file are serialised by a
+ *              per-file lock and drop the cached entry.
+ * Parameters: seInfo - pointer to ServeInfo structure
+ * Return: Status (e_failure if the socket cannot be created)
+ */
+Status serve_requests(ServeInfo *seInfo);
+
+#endif // End of header guard: Marks the end of conditional compilation block started by #ifndef SERVE_H
@@ -0,0 +1,386 @@
+#include <stdio.h>        // Header file for standard input/output functions (fprintf, fopen, fscanf)
+#include <stdlib.h>       // Header file for atexit()
+#include <string.h>       // Header file for string functions (strcmp, strncmp)
+#include <time.h>         // Header file for clock_gettime() and its clocks
+#include <sys/resource.h> // Header file for getrusage() (process CPU time, peak RSS)
+#include "type.h"         // User-defined header file for custom type definitions (Status, e_success, e_failure)
+#include "stats.h"        // User-defined header file for the phase timers and StatsPhase
+
+#if defined(__GLIBC_PREREQ) // Defined by <features.h> (through stdio.h) on glibc only
+#if __GLIBC_PREREQ(2, 33)
+#define HAVE_MALLINFO2 1 // Heap growth over the run from mallinfo2() at start and exit
+#include <malloc.h>      // Header file for mallinfo2() (heap in use, glibc)
+#endif
+#endif
+
+static int stats_mode;                                  // 0 = off, 1 = table, 2 = JSON (set once, before any thread starts)
+static uint64_t start_ns;                               // Monotonic clock when the option was taken
+static uint64_t phase_wall_ns[STATS_PHASE_COUNT];       // Wall time per phase, summed over all threads
+static uint64_t phase_cpu_ns[STATS_PHASE_COUNT];        // Thread CPU time per phase
+static unsigned long phase_calls[STATS_PHASE_COUNT];    // Intervals charged to each phase
+static unsigned long latency[STATS_LATENCY_BUCKETS];    // Per-file latency histogram (batch runs)
+static int64_t start_heap;                              // Heap in use when the option was taken
+
+static const char *const phase_names[STATS_PHASE_COUNT] = {"open", "header", "walk", "copy", "commit"};
+
+/*
+ * Function: malloc_count_read
+ * Description: Allocation counter of the benchmark build (bench/malloc_count.c). The tool itself never replaces the
+ *              allocator: without that object the weak reference stays NULL and only the heap growth is reported.
+ * Parameters: calls - receives malloc + calloc + realloc calls, bytes - receives the bytes they requested
+ * Return: void
+ */
+extern void malloc_count_read(unsigned long *calls, unsigned long long *bytes) __attribute__((weak));
+
+/*
+ * Function: heap_in_use
+ * Description: Bytes the allocator has handed out and not taken back (all malloc arenas and mmapped chunks); only
+ *              called when the option is taken and at exit, because mallinfo2 locks every arena
+ * Parameters: None
+ * Return: int64_t - bytes in use (0 without mallinfo2)
+ */
+static int64_t heap_in_use(void)
+{
+#ifdef HAVE_MALLINFO2
+  struct mallinfo2 info = mallinfo2();
+
+  return (int64_t)(info.uordblks + info.hblkhd);
+#else
+  return 0;
+#endif
+}
+
+/*
+ * Function: clock_ns
+ * Description: Reads a clock in nanoseconds
+ * Parameters: clock - CLOCK_MONOTONIC or CLOCK_THREAD_CPUTIME_ID
+ * Return: uint64_t - nanoseconds
+ */
+static uint64_t clock_ns(clockid_t clock)
+{
+  struct timespec ts;
+
+  clock_gettime(clock, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/*
+ * Function: stats_begin
+ * Description: Reads both clocks when --stats is active
+ * Parameters: timer - receives the start times
+ * Return: void
+ */
+void stats_begin(StatsTimer *timer)
+{
+  if (stats_mode)
+  {
+    timer->wall_ns = clock_ns(CLOCK_MONOTONIC);
+    timer->cpu_ns = clock_ns(CLOCK_THREAD_CPUTIME_ID);
+  }
+}
+
+/*
+ * Function: stats_end
+ * Description: Charges the interval to a phase with relaxed atomic adds (workers never wait on each other)
+ * Parameters: phase - phase to charge, timer - interval start
+ * Return: void
+ */
+void stats_end(StatsPhase phase, const StatsTimer *timer)
+{
+  if (stats_mode)
+  {
+    __atomic_add_fetch(&phase_wall_ns[phase], clock_ns(CLOCK_MONOTONIC) - timer->wall_ns, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&phase_cpu_ns[phase], clock_ns(CLOCK_THREAD_CPUTIME_ID) - timer->cpu_ns, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&phase_calls[phase], 1, __ATOMIC_RELAXED);
+  }
+}
+
+/*
+ * Function: stats_phase_hook
+ * Description: Starts the caller's timer at the start of a library step and charges it at the stop
+ * Parameters: context - StatsTimer, phase - library step (same values as StatsPhase), end - 0 start, 1 stop
+ * Return: void
+ */
+void stats_phase_hook(void *context, Mp3TagPhase phase, int end)
+{
+  if (end)
+  {
+    stats_end((StatsPhase)phase, context);
+  }
+  else
+  {
+    stats_begin(context);
+  }
+}
+
+/*
+ * Function: stats_file_done
+ * Description: Adds one file to the power-of-two latency histogram
+ * Parameters: timer - interval started when the file was picked up
+ * Return: void
+ */
+void stats_file_done(const StatsTimer *timer)
+{
+  if (stats_mode)
+  {
+    uint64_t us = (clock_ns(CLOCK_MONOTONIC) - timer->wall_ns) / 1000;
+    int bucket = 0;
+
+    while (us > 1 && bucket < STATS_LATENCY_BUCKETS - 1) // floor(log2(us)), clamped
+    {
+      us >>= 1;
+      bucket++;
+    }
+    __atomic_add_fetch(&latency[bucket], 1, __ATOMIC_RELAXED);
+  }
+}
+
+// Structure to store the process-wide counters read at exit
+typedef struct // typedef used to give alternate name for structure here
+{
+  double wall;                     // Seconds since the option was taken
+  double user;                     // User CPU seconds (all threads)
+  double sys;                      // System CPU seconds (all threads)
+  long peak_rss_kb;                // Peak resident set size
+  unsigned long long rchar, wchar; // Bytes passed to read-type / write-type system calls
+  unsigned long long syscr, syscw; // Read-type / write-type system calls
+  unsigned long long disk_read;    // Bytes fetched from storage
+  unsigned long long disk_write;   // Bytes sent to storage
+  int have_io;                     // 1 if /proc/self/io was readable
+  int64_t heap_growth;             // Heap in use at exit minus at start
+  unsigned long alloc_calls;       // malloc + calloc + realloc calls (benchmark build only)
+  unsigned long long alloc_bytes;  // Bytes requested by those calls
+} ProcessTotals;                   // ProcessTotals is alternate name for this structure
+
+/*
+ * Function: read_totals
+ * Description: Collects CPU time and peak RSS (getrusage) and the I/O counters of /proc/self/io
+ * Parameters: totals - receives the counters
+ * Return: void
+ */
+static void read_totals(ProcessTotals *totals)
+{
+  struct rusage usage;
+  char key[32];
+  unsigned long long value;
+
+  memset(totals, 0, sizeof(*totals));
+  totals->wall = (clock_ns(CLOCK_MONOTONIC) - start_ns) / 1e9;
+  if (getrusage(RUSAGE_SELF, &usage) == 0)
+  {
+    totals->user = usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6;
+    totals->sys = usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+    totals->peak_rss_kb = usage.ru_maxrss;
+  }
+  totals->heap_growth = heap_in_use() - start_heap;
+  if (malloc_count_read != NULL) // Counting object linked in (bench/run.sh)
+  {
+    malloc_count_read(&totals->alloc_calls, &totals->alloc_bytes);
+  }
+
+  static const char *const keys[6] = {"rchar", "wchar", "syscr", "syscw", "read_bytes", "write_bytes"}; // Lines of /proc/self/io
+  unsigned long long *slots[6] = {&totals->rchar, &totals->wchar, &totals->syscr, &totals->syscw, &totals->disk_read, &totals->disk_write};
+
+  FILE *fptr = fopen("/proc/self/io", "r"); // Linux: counters of every thread of the process
+  if (fptr == NULL)
+  {
+    return;
+  }
+  while (fscanf(fptr, "%31[^:]: %llu\n", key, &value) == 2)
+  {
+    for (int i = 0; i < 6; i++)
+    {
+      if (strcmp(key, keys[i]) == 0)
+      {
+        *slots[i] = value;
+        totals->have_io = 1;
+      }
+    }
+  }
+  fclose(fptr);
+}
+
+/*
+ * Function: latency_percentile
+ * Description: Upper bound of the bucket holding the given fraction of the files
+ * Parameters: files - files in the histogram, fraction - 0.5 for the median, 0.99 for p99
+ * Return: unsigned long long - microseconds (0 without files)
+ */
+static unsigned long long latency_percentile(unsigned long files, double fraction)
+{
+  unsigned long seen = 0;
+
+  for (int i = 0; i < STATS_LATENCY_BUCKETS && files > 0; i++)
+  {
+    seen += latency[i];
+    if (seen >= fraction * files)
+    {
+      return 2ULL << i;
+    }
+  }
+  return 0;
+}
+
+/*
+ * Function: report_json
+ * Description: Writes all counters as one JSON object on stderr
+ * Parameters: t - process totals, files - files in the latency histogram
+ * Return: void
+ */
+static void report_json(const ProcessTotals *t, unsigned long files)
+{
+  fprintf(stderr, "{\"wall_s\":%.6f,\"user_s\":%.6f,\"sys_s\":%.6f,\"peak_rss_kb\":%ld,\"phases\":{", t->wall, t->user, t->sys, t->peak_rss_kb);
+  for (int i = 0; i < STATS_PHASE_COUNT; i++)
+  {
+    fprintf(stderr, "%s\"%s\":{\"calls\":%lu,\"wall_s\":%.6f,\"cpu_s\":%.6f", i ? "," : "", phase_names[i], phase_calls[i], phase_wall_ns[i] / 1e9, phase_cpu_ns[i] / 1e9);
+    fprintf(stderr, "}");
+  }
+  fprintf(stderr, "}");
+  if (t->have_io)
+  {
+    fprintf(stderr, ",\"io\":{\"read_bytes\":%llu,\"write_bytes\":%llu,\"read_calls\":%llu,\"write_calls\":%llu,\"disk_read_bytes\":%llu,\"disk_write_bytes\":%llu}",
+            t->rchar, t->wchar, t->syscr, t->syscw, t->disk_read, t->disk_write);
+  }
+#ifdef HAVE_MALLINFO2
+  fprintf(stderr, ",\"heap_growth_bytes\":%lld", (long long)t->heap_growth);
+#endif
+  if (malloc_count_read != NULL)
+  {
+    fprintf(stderr, ",\"allocations\":%lu,\"allocated_bytes\":%llu", t->alloc_calls, t->alloc_bytes);
+  }
+  if (files > 0)
+  {
+    fprintf(stderr, ",\"latency_us\":{\"files\":%lu,\"p50\":%llu,\"p99\":%llu,\"buckets\":[", files, latency_percentile(files, 0.5), latency_percentile(files, 0.99));
+    for (int i = 0, first = 1; i < STATS_LATENCY_BUCKETS; i++) // Non-empty buckets: upper bound and count
+    {
+      if (latency[i])
+      {
+        fprintf(stderr, "%s{\"le\":%llu,\"count\":%lu}", first ? "" : ",", 2ULL << i, latency[i]);
+        first = 0;
+      }
+    }
+    fprintf(stderr, "]}");
+  }
+  fprintf(stderr, "}\n");
+}
+
+/*
+ * Function: report_table
+ * Description: Writes all counters as a readable table on stderr
+ * Parameters: t - process totals, files - files in the latency histogram
+ * Return: void
+ */
+static void report_table(const ProcessTotals *t, unsigned long files)
+{
+  fprintf(stderr, "\033[1;97m--- stats ---\033[0m\n");
+  fprintf(stderr, "wall %.3f s   user %.3f s   sys %.3f s   peak RSS %ld KB\n", t->wall, t->user, t->sys, t->peak_rss_kb);
+  fprintf(stderr, "%-8s %10s %12s %12s\n", "phase", "calls", "wall ms", "cpu ms");
+  for (int i = 0; i < STATS_PHASE_COUNT; i++)
+  {
+    fprintf(stderr, "%-8s %10lu %12.3f %12.3f\n", phase_names[i], phase_calls[i], phase_wall_ns[i] / 1e6, phase_cpu_ns[i] / 1e6);
+  }
+  if (t->have_io)
+  {
+    fprintf(stderr, "read  %llu bytes in %llu call(s) (%llu from storage)\n", t->rchar, t->syscr, t->disk_read);
+    fprintf(stderr, "write %llu bytes in %llu call(s) (%llu to storage)\n", t->wchar, t->syscw, t->disk_write);
+  }
+#ifdef HAVE_MALLINFO2
+  fprintf(stderr, "heap growth %lld bytes\n", (long long)t->heap_growth);
+#endif
+  if (malloc_count_read != NULL)
+  {
+    fprintf(stderr, "allocations %lu (%llu bytes requested)\n", t->alloc_calls, t->alloc_bytes);
+  }
+  if (files == 0)
+  {
+    return;
+  }
+
+  unsigned long most = 0; // Longest bar
+  for (int i = 0; i < STATS_LATENCY_BUCKETS; i++)
+  {
+    most = latency[i] > most ? latency[i] : most;
+  }
+  fprintf(stderr, "per-file latency: %lu file(s), p50 <= %llu us, p99 <= %llu us\n", files, latency_percentile(files, 0.5), latency_percentile(files, 0.99));
+  for (int i = 0; i < STATS_LATENCY_BUCKETS; i++)
+  {
+    if (latency[i])
+    {
+      fprintf(stderr, "  < %10llu us %8lu %.*s\n", 2ULL << i, latency[i], (int)(40 * latency[i] / most + 1),
+              "########################################");
+    }
+  }
+}
+
+/*
+ * Function: stats_report
+ * Description: atexit handler: prints the report after the command's own output
+ * Parameters: None
+ * Return: void
+ */
+static void stats_report(void)
+{
+  ProcessTotals totals;
+  unsigned long files = 0;
+
+  fflush(stdout); // Command output first
+  read_totals(&totals);
+  for (int i = 0; i < STATS_LATENCY_BUCKETS; i++)
+  {
+    files += latency[i];
+  }
+
+  if (stats_mode == 2)
+  {
+    report_json(&totals, files);
+  }
+  else
+  {
+    report_table(&totals, files);
+  }
+}
+
+/*
+ * Function: stats_take_option
+ * Description: Removes --stats[=table|json] from argv, starts the process clock and registers the exit report
+ * Parameters: argc - pointer to argument count, argv[] - argument array
+ * Return: Status (e_success/e_failure)
+ */
+Status stats_take_option(int *argc, char *argv[])
+{
+  for (int i = 1; i < *argc; i++) // Option may appear anywhere
+  {
+    if (strcmp(argv[i], "--stats") == 0 || strcmp(argv[i], "--stats=table") == 0)
+    {
+      stats_mode = 1;
+    }
+    else if (strcmp(argv[i], "--stats=json") == 0)
+    {
+      stats_mode = 2;
+    }
+    else if (strncmp(argv[i], "--stats=", 8) == 0)
+    {
+      printf("\033[1;91mERROR: \033[1;97mUnknown stats format %s (use table or json)\n", argv[i] + 8);
+      return e_failure;
+    }
+    else
+    {
+      continue;
+    }
+
+    for (int j = i; j < *argc; j++) // Remove the option so commands see their usual arguments (argv[argc] stays NULL)
+    {
+      argv[j] = argv[j + 1];
+    }
+    (*argc)--;
+    i--;
+  }
+
+  if (stats_mode)
+  {
+    start_ns = clock_ns(CLOCK_MONOTONIC);
+    start_heap = heap_in_use();
+    atexit(stats_report);
+  }
+  return e_success;
+}
@@ -0,0 +1,70 @@
+#ifndef STATS_H // If not defined STATS_H ---> Checks if STATS_H was previously defined: If not present, code is processed; else code below till #endif is ignored
+#define STATS_H // Defines the macro STATS_H if macro was not previously defined
+
+#include <stdint.h> // Header file for fixed-width integers (uint64_t)
+#include "type.h"   // User-defined header file for custom type definitions (Status, e_success, e_failure)
+#include "mp3tag.h" // Library header file for Mp3TagPhase (library steps are reported through a phase hook)
+
+#define STATS_LATENCY_BUCKETS 32 // Per-file latency histogram: bucket k counts files taking [2^k, 2^(k+1)) microseconds
+
+// Enumeration of the timed phases of one file
+typedef enum // typedef used to give alternate name for enum here
+{
+  e_phase_open = e_mp3tag_phase_open,     // Opening the file (with its 10-byte header) and the temporary file of a full rewrite
+  e_phase_header = e_mp3tag_phase_header, // Whole-tag load and trailer probe
+  e_phase_walk = e_mp3tag_phase_walk,     // Frame walk: decoding fields, or rebuilding frames for an edit
+  e_phase_copy = e_mp3tag_phase_copy,     // Full rewrite: new header + frames and the audio copy into the temporary file
+  e_phase_commit = e_mp3tag_phase_commit, // Making the edit visible: in-place tag write, rename, or copy-back
+  STATS_PHASE_COUNT = MP3TAG_PHASE_COUNT
+} StatsPhase;     // StatsPhase is alternate name for this enum
+
+// Structure to store the start of a timed interval
+typedef struct // typedef used to give alternate name for structure here
+{
+  uint64_t wall_ns; // Monotonic clock at the start
+  uint64_t cpu_ns;  // CPU time of the calling thread at the start
+} StatsTimer;       // StatsTimer is alternate name for this structure
+
+/*
+ * Function: stats_take_option
+ * Description: Finds "--stats" (table) or "--stats=json" anywhere on the command line, enables the counters,
+ *              removes the option from argv and registers the report to run at exit (on stderr)
+ * Parameters: argc - pointer to argument count (decremented when the option is removed), argv[] - argument array
+ * Return: Status (e_failure for an unknown --stats= value)
+ */
+Status stats_take_option(int *argc, char *argv[]);
+
+/*
+ * Function: stats_begin
+ * Description: Starts a timed interval (does nothing unless --stats was given)
+ * Parameters: timer - receives the start times
+ * Return: void
+ */
+void stats_begin(StatsTimer *timer);
+
+/*
+ * Function: stats_end
+ * Description: Adds the wall and thread CPU time since stats_begin to a phase (safe from worker threads)
+ * Parameters: phase - phase to charge, timer - interval started by stats_begin
+ * Return: void
+ */
+void stats_end(StatsPhase phase, const StatsTimer *timer);
+
+/*
+ * Function: stats_phase_hook
+ * Description: Mp3TagPhaseHook that charges the library's steps to the phases (installed by the commands with
+ *              mp3tag_set_phase_hook; the library itself never links against the counters)
+ * Parameters: context - StatsTimer of the calling thread, phase - library step, end - 0 at the start, 1 at the stop
+ * Return: void
+ */
+void stats_phase_hook(void *context, Mp3TagPhase phase, int end);
+
+/*
+ * Function: stats_file_done
+ * Description: Records the latency of one file of a batch run in the histogram
+ * Parameters: timer - interval started by stats_begin when the file was picked up
+ * Return: void
+ */
+void stats_file_done(const StatsTimer *timer);
+
+#endif // End of header guard: Marks the end of conditional compilation block started by #ifndef STATS_H
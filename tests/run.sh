@@ -0,0 +1,185 @@
+#!/bin/sh
+# ----------------------------------------------------------------------------------------------------------------
+# TITLE: Regression checks of the edit path
+# DESCRIPTION: Builds the tool, writes small MP3 files by hand and checks that every ID3v2 layout is walked, that
+#              edits read back exactly as written and that a rewrite keeps the file's owner and group.
+#              Prints one PASS / FAIL line per check and exits non-zero if any check fails.
+#
+# Usage: tests/run.sh [work-dir]
+# Environment: CFLAGS (default -O2)
+# ----------------------------------------------------------------------------------------------------------------
+
+set -e
+
+WORK=${1:-/tmp/mp3tag-tests}
+CFLAGS=${CFLAGS:--O2}
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+FAILED=0
+
+mkdir -p "$WORK"
+cc $CFLAGS "$ROOT"/*.c -o "$WORK/mp3_tag" -pthread
+TAG="$WORK/mp3_tag"
+
+# Result line of one check: check <name> <expected> <actual>
+check()
+{
+  if [ "$2" = "$3" ]; then
+    echo "PASS $1"
+  else
+    echo "FAIL $1: expected '$2', got '$3'"
+    FAILED=1
+  fi
+}
+
+# ID3v2 tag with one 4-byte TIT2 frame and 17 bytes of padding, then 2 KB of filler audio: make_mp3 <file> <major>
+make_mp3()
+{
+  printf "ID3\\00$2\\000\\000\\000\\000\\000\\040TIT2\\000\\000\\000\\005\\000\\000\\000abcd" > "$1"
+  head -c 17 /dev/zero >> "$1"
+  head -c 2048 /dev/zero | tr '\000' '\125' >> "$1"
+}
+
+# Bytes given as decimal numbers: octets <byte>...
+octets()
+{
+  for b in "$@"; do
+    printf "\\$(printf %03o "$b")"
+  done
+}
+
+# 24-bit / 32-bit big-endian and 28-bit synchsafe sizes: be24 <n>, be32 <n>, ss32 <n>
+be24() { octets $(( ($1 >> 16) & 255 )) $(( ($1 >> 8) & 255 )) $(( $1 & 255 )); }
+be32() { octets $(( ($1 >> 24) & 255 )) $(( ($1 >> 16) & 255 )) $(( ($1 >> 8) & 255 )) $(( $1 & 255 )); }
+ss32() { octets $(( ($1 >> 21) & 127 )) $(( ($1 >> 14) & 127 )) $(( ($1 >> 7) & 127 )) $(( $1 & 127 )); }
+
+# ISO-8859-1 text frame in the layout of one ID3v2 version: text_frame <major> <id> <text>
+text_frame()
+{
+  size=$(( $(printf %s "$3" | wc -c) + 1 ))
+  case $1 in
+    2) printf %s "$2"; be24 $size ;;
+    3) printf %s "$2"; be32 $size; octets 0 0 ;;
+    4) printf %s "$2"; ss32 $size; octets 0 0 ;;
+  esac
+  octets 0
+  printf %s "$3"
+}
+
+# ID3v2 header + the tag body read from a file + 2 KB of filler audio: tag_file <file> <major> <flags> <body-file>
+tag_file()
+{
+  printf "ID3" > "$1"
+  octets "$2" 0 "$3" >> "$1"
+  ss32 "$(wc -c < "$4")" >> "$1"
+  cat "$4" >> "$1"
+  head -c 2048 /dev/zero | tr '\000' '\125' >> "$1"
+}
+
+# Field of a file as read back by the tool: field_of <file> <column> (2 = title, 3 = artist)
+field_of()
+{
+  "$TAG" -v --format=tsv "$1" | cut -f"$2"
+}
+
+# Title of a file as read back by the tool
+title_of()
+{
+  field_of "$1" 2
+}
+
+# 1 when the last 2 KB of a file are still the filler audio written by make_mp3 / tag_file
+audio_intact()
+{
+  if [ "$(tail -c 2048 "$1" | tr -d '\125' | wc -c)" -eq 0 ]; then echo 1; else echo 0; fi
+}
+
+# Edits whose ISO-8859-1 bytes are also valid UTF-8 must read back unchanged (ID3v2.3 has no UTF-8 encoding)
+for title in 'Ã©tude' 'étude' 'Ã¼ber Â£5' 'plain'; do
+  make_mp3 "$WORK/roundtrip.mp3" 3
+  "$TAG" -e -t "$title" "$WORK/roundtrip.mp3" > /dev/null
+  check "v2.3 title round-trip: $title" "$title" "$(title_of "$WORK/roundtrip.mp3")"
+done
+
+# Frame walker: one file per tag layout, each with a frame after the one that exercises the layout
+BODY="$WORK/body"
+{ text_frame 2 TT2 "Two Two"; text_frame 2 TP1 "Artist 22"; head -c 10 /dev/zero; } > "$BODY"
+tag_file "$WORK/walk.mp3" 2 0 "$BODY"
+check "v2.2 three-character frame IDs" "Two Two/Artist 22" "$(title_of "$WORK/walk.mp3")/$(field_of "$WORK/walk.mp3" 3)"
+
+walk_title=$(head -c 200 /dev/zero | tr '\000' 'L') # Frame size 201: synchsafe 00 00 01 49, not 00 00 00 c9
+{ text_frame 4 TIT2 "$walk_title"; text_frame 4 TPE1 "After"; head -c 10 /dev/zero; } > "$BODY"
+tag_file "$WORK/walk.mp3" 4 0 "$BODY"
+check "v2.4 synchsafe frame sizes" "$walk_title/After" "$(title_of "$WORK/walk.mp3")/$(field_of "$WORK/walk.mp3" 3)"
+
+# "x" ff e1 "y" needs a 00 after the ff once unsynchronised; the v2.3 frame size counts the decoded bytes
+{ printf TIT2; be32 5; octets 0 0 0; printf x; octets 255 0 225; printf y; text_frame 3 TPE1 "Sync"; head -c 10 /dev/zero; } > "$BODY"
+tag_file "$WORK/walk.mp3" 3 128 "$BODY"
+check "v2.3 whole-tag unsynchronisation" "xÿáy/Sync" "$(title_of "$WORK/walk.mp3")/$(field_of "$WORK/walk.mp3" 3)"
+
+# Same text with the v2.4 per-frame flag (format flags 00 02); the v2.4 frame size counts the stored bytes
+{ printf TIT2; ss32 6; octets 0 2 0; printf x; octets 255 0 225; printf y; text_frame 4 TPE1 "Sync"; head -c 10 /dev/zero; } > "$BODY"
+tag_file "$WORK/frame-unsync.mp3" 4 0 "$BODY"
+check "v2.4 per-frame unsynchronisation" "xÿáy/Sync" "$(title_of "$WORK/frame-unsync.mp3")/$(field_of "$WORK/frame-unsync.mp3" 3)"
+
+{ ss32 6; octets 1 0; text_frame 4 TIT2 "Extended 4"; head -c 10 /dev/zero; } > "$BODY" # Size (itself included), 1 flag byte
+tag_file "$WORK/walk.mp3" 4 64 "$BODY"
+check "v2.4 extended header skipped" "Extended 4" "$(title_of "$WORK/walk.mp3")"
+
+{ be32 6; octets 0 0 0 0 0 0; text_frame 3 TIT2 "Extended 3"; head -c 10 /dev/zero; } > "$BODY" # Size 6: flags + padding size
+tag_file "$WORK/walk.mp3" 3 64 "$BODY"
+check "v2.3 extended header skipped" "Extended 3" "$(title_of "$WORK/walk.mp3")"
+
+# Edits of unsynchronised v2.4 tags: a changed frame beside a per-frame unsynchronised one fits in place and leaves
+# it readable; with the header flag set the tag is rewritten without it
+size_before=$(wc -c < "$WORK/frame-unsync.mp3")
+"$TAG" -e -a "Artist" "$WORK/frame-unsync.mp3" > /dev/null
+check "v2.4 per-frame unsync edited in place" "$size_before xÿáy/Artist 1" \
+  "$(wc -c < "$WORK/frame-unsync.mp3") $(title_of "$WORK/frame-unsync.mp3")/$(field_of "$WORK/frame-unsync.mp3" 3) $(audio_intact "$WORK/frame-unsync.mp3")"
+{ printf TIT2; ss32 6; octets 0 2 0; printf x; octets 255 0 225; printf y; text_frame 4 TPE1 "Sync"; head -c 10 /dev/zero; } > "$BODY"
+tag_file "$WORK/walk.mp3" 4 128 "$BODY"
+"$TAG" -e -a "Artist" "$WORK/walk.mp3" > /dev/null
+check "v2.4 tag unsync edited" "xÿáy/Artist 1" "$(title_of "$WORK/walk.mp3")/$(field_of "$WORK/walk.mp3" 3) $(audio_intact "$WORK/walk.mp3")"
+
+# Batch manifests: quoted CSV fields, JSON escapes, several lines for one file and a file that does not exist
+MANIFEST="$WORK/edits.csv"
+make_mp3 "$WORK/csv.mp3" 3
+make_mp3 "$WORK/later.mp3" 3
+cat > "$MANIFEST" << EOF
+"$WORK/csv.mp3",title,"Hello, ""World""",artist,"A, B"
+$WORK/later.mp3,title,First
+$WORK/later.mp3,title,Second
+$WORK/missing.mp3,title,Nothing
+EOF
+batch_out=$("$TAG" -b "$MANIFEST" 2> /dev/null | sed "s/$(printf '\033')\[[0-9;]*m//g") && batch_status=0 || batch_status=$?
+check "batch CSV quoted commas and quotes" 'Hello, "World"/A, B' "$(title_of "$WORK/csv.mp3")/$(field_of "$WORK/csv.mp3" 3)"
+check "batch later line wins for the same file" "Second" "$(title_of "$WORK/later.mp3")"
+check "batch FAILED line for a missing file" "FAILED $WORK/missing.mp3" "$(echo "$batch_out" | grep '^FAILED' | sed 's/ (.*//')"
+
+MANIFEST="$WORK/edits.jsonl"
+make_mp3 "$WORK/json.mp3" 3
+printf '{"path": "%s", "title": "G\\ud834\\udd1e clef \\u00e9", "artist": "q\\"uote"}\n' "$WORK/json.mp3" > "$MANIFEST"
+"$TAG" -b "$MANIFEST" > /dev/null 2>&1
+check "batch JSON surrogate pair and escapes" 'G𝄞 clef é/q"uote' "$(title_of "$WORK/json.mp3")/$(field_of "$WORK/json.mp3" 3)"
+rm -f "$WORK/csv.mp3" "$WORK/later.mp3" "$WORK/json.mp3" "$WORK/edits.csv" "$MANIFEST"
+
+# A full rewrite of a file owned by someone else must keep its owner and group. Run as root: the edit itself runs as
+# nobody with the file's group (not nobody's primary group) as a supplementary group, so the fchown of the new file
+# fails and the edit has to be copied back into the original.
+if [ "$(id -u)" -eq 0 ] && command -v setpriv > /dev/null; then
+  mkdir -p "$WORK/shared"
+  chmod 0777 "$WORK/shared"
+  make_mp3 "$WORK/shared/owned.mp3" 3
+  chown 1:12345 "$WORK/shared/owned.mp3"
+  chmod 0664 "$WORK/shared/owned.mp3"
+  long_title="A title much longer than the tag and its padding"
+  setpriv --reuid=65534 --regid=65534 --groups=12345 "$TAG" -e -t "$long_title" "$WORK/shared/owned.mp3" > /dev/null || true
+  check "rewrite keeps owner and group" "1:12345" "$(stat -c %u:%g "$WORK/shared/owned.mp3")"
+  check "rewrite of a file owned by another user" "$long_title" "$(title_of "$WORK/shared/owned.mp3")"
+  check "no temporary file left" "owned.mp3" "$(ls -A "$WORK/shared")"
+  rm -rf "$WORK/shared"
+else
+  echo "SKIP owner/group check (needs root and setpriv)"
+fi
+
+rm -f "$WORK/roundtrip.mp3" "$WORK/walk.mp3" "$WORK/frame-unsync.mp3" "$BODY"
+exit $FAILED
@@ -0,0 +1,515 @@
+#include <stdlib.h> // Header file for malloc/free (ISO-8859-1 check of new text)
+#include <string.h> // Header file for memory functions (memchr, memcpy, strlen)
+#include <stdint.h> // Header file for fixed-width integers (uint64_t)
+#include "text.h"   // User-defined header file for text encoding declarations
+#include "arena.h"  // User-defined header file for arena_malloc (decoded values of bulk scans)
+
+#if defined(__SSE2__) // x86-64 always has SSE2: ASCII runs are checked 16 bytes at a time
+#define HAVE_SSE2 1   // Enables the SSE2 fast paths below
+#include <emmintrin.h> // Header file for SSE2 intrinsics
+#elif defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define HAVE_SWAR 1   // Other little-endian CPUs: 8 bytes at a time in a 64-bit register
+#endif
+
+#define TEXT_REPLACEMENT 0xFFFDUL // U+FFFD, written for bytes that are not valid in their encoding
+
+/*
+ * Function: text_put_utf8
+ * Description: Writes a Unicode code point as UTF-8
+ * Parameters: out - output position, cp - code point
+ * Return: char * - position after the written bytes
+ */
+char *text_put_utf8(char *out, unsigned long cp)
+{
+  if (cp < 0x80) // 1 byte
+  {
+    *out++ = (char)cp;
+  }
+  else if (cp < 0x800) // 2 bytes
+  {
+    *out++ = (char)(0xC0 | (cp >> 6));
+    *out++ = (char)(0x80 | (cp & 0x3F));
+  }
+  else if (cp < 0x10000) // 3 bytes
+  {
+    *out++ = (char)(0xE0 | (cp >> 12));
+    *out++ = (char)(0x80 | ((cp >> 6) & 0x3F));
+    *out++ = (char)(0x80 | (cp & 0x3F));
+  }
+  else // 4 bytes
+  {
+    *out++ = (char)(0xF0 | (cp >> 18));
+    *out++ = (char)(0x80 | ((cp >> 12) & 0x3F));
+    *out++ = (char)(0x80 | ((cp >> 6) & 0x3F));
+    *out++ = (char)(0x80 | (cp & 0x3F));
+  }
+  return out;
+}
+
+/*
+ * Function: next_utf8
+ * Description: Decodes one UTF-8 sequence (overlong forms, surrogates and truncated sequences are rejected)
+ * Parameters: p - read position (advanced past the sequence, or one byte when it is invalid), end - end of the text
+ * Return: unsigned long - code point, or TEXT_REPLACEMENT
+ */
+static unsigned long next_utf8(const unsigned char **p, const unsigned char *end)
+{
+  const unsigned char *s = *p;
+  unsigned long cp = s[0];
+  unsigned long min;    // Smallest code point allowed for the sequence length
+  size_t more;          // Continuation bytes
+
+  *p = s + 1; // Invalid sequences consume one byte
+  if (cp < 0x80)
+  {
+    return cp;
+  }
+  else if ((cp & 0xE0) == 0xC0)
+  {
+    more = 1;
+    cp &= 0x1F;
+    min = 0x80;
+  }
+  else if ((cp & 0xF0) == 0xE0)
+  {
+    more = 2;
+    cp &= 0x0F;
+    min = 0x800;
+  }
+  else if ((cp & 0xF8) == 0xF0)
+  {
+    more = 3;
+    cp &= 0x07;
+    min = 0x10000;
+  }
+  else // Stray continuation byte or invalid lead byte
+  {
+    return TEXT_REPLACEMENT;
+  }
+
+  if ((size_t)(end - s) <= more) // Truncated sequence
+  {
+    return TEXT_REPLACEMENT;
+  }
+  for (size_t i = 1; i <= more; i++)
+  {
+    if ((s[i] & 0xC0) != 0x80)
+    {
+      return TEXT_REPLACEMENT;
+    }
+    cp = (cp << 6) | (s[i] & 0x3F);
+  }
+  if (cp < min || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) // Overlong, out of range or surrogate
+  {
+    return TEXT_REPLACEMENT;
+  }
+  *p = s + more + 1;
+  return cp;
+}
+
+/*
+ * Function: text_ascii_prefix
+ * Description: Counts the leading bytes below 0x80 (16 or 8 bytes per step on the fast paths)
+ * Parameters: src - bytes, len - byte count
+ * Return: size_t - length of the ASCII prefix
+ */
+size_t text_ascii_prefix(const unsigned char *src, size_t len)
+{
+  size_t i = 0;
+
+#ifdef HAVE_SSE2
+  for (; i + 16 <= len; i += 16)
+  {
+    int mask = _mm_movemask_epi8(_mm_loadu_si128((const __m128i *)(src + i))); // Top bit of every byte
+    if (mask != 0)
+    {
+      return i + (size_t)__builtin_ctz((unsigned int)mask); // First byte with the top bit set
+    }
+  }
+#elif defined(HAVE_SWAR)
+  for (; i + 8 <= len; i += 8)
+  {
+    uint64_t w;
+    memcpy(&w, src + i, 8);
+    if (w & 0x8080808080808080ULL) // Some byte has the top bit set: the scalar loop finds which
+    {
+      break;
+    }
+  }
+#endif
+
+  while (i < len && src[i] < 0x80)
+  {
+    i++;
+  }
+  return i;
+}
+
+/*
+ * Function: is_utf8
+ * Description: Checks whether text is valid UTF-8 (ASCII runs are skipped on the fast path)
+ * Parameters: src - text, len - length
+ * Return: int - 1 if every sequence is valid
+ */
+static int is_utf8(const unsigned char *src, size_t len)
+{
+  const unsigned char *end = src + len;
+
+  while (src < end)
+  {
+    src += text_ascii_prefix(src, (size_t)(end - src));
+    if (src < end && next_utf8(&src, end) == TEXT_REPLACEMENT)
+    {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+/*
+ * Function: latin1_to_utf8
+ * Description: ISO-8859-1 to UTF-8: ASCII runs are copied, other bytes become two UTF-8 bytes
+ * Parameters: src - text without terminator, len - length
+ * Return: char * - UTF-8 text from arena_malloc
+ */
+static char *latin1_to_utf8(const unsigned char *src, size_t len)
+{
+  char *value = arena_malloc(2 * len + 1); // Every byte needs at most two UTF-8 bytes
+  char *out = value;
+
+  if (value == NULL)
+  {
+    return NULL;
+  }
+  for (size_t i = 0; i < len;)
+  {
+    size_t run = text_ascii_prefix(src + i, len - i); // Copied as-is
+    memcpy(out, src + i, run);
+    out += run;
+    i += run;
+    if (i < len)
+    {
+      *out++ = (char)(0xC0 | (src[i] >> 6));
+      *out++ = (char)(0x80 | (src[i] & 0x3F));
+      i++;
+    }
+  }
+  *out = '\0';
+  return value;
+}
+
+/*
+ * Function: utf8_to_utf8
+ * Description: Validates UTF-8: ASCII runs are copied, invalid sequences become U+FFFD
+ * Parameters: src - text without terminator, len - length
+ * Return: char * - UTF-8 text from arena_malloc
+ */
+static char *utf8_to_utf8(const unsigned char *src, size_t len)
+{
+  const unsigned char *end = src + len;
+  char *value = arena_malloc(3 * len + 1); // Every invalid byte may become a 3-byte U+FFFD
+  char *out = value;
+
+  if (value == NULL)
+  {
+    return NULL;
+  }
+  if (len >= 3 && src[0] == 0xEF && src[1] == 0xBB && src[2] == 0xBF) // Byte order mark written by some taggers
+  {
+    src += 3;
+  }
+  while (src < end)
+  {
+    size_t run = text_ascii_prefix(src, (size_t)(end - src));
+    memcpy(out, src, run);
+    out += run;
+    src += run;
+    if (src < end)
+    {
+      out = text_put_utf8(out, next_utf8(&src, end));
+    }
+  }
+  *out = '\0';
+  return value;
+}
+
+/*
+ * Function: unit16
+ * Description: Reads one UTF-16 code unit
+ * Parameters: p - two bytes, big_endian - 1 for UTF-16BE
+ * Return: unsigned int - code unit
+ */
+static unsigned int unit16(const unsigned char *p, int big_endian)
+{
+  return big_endian ? ((unsigned int)p[0] << 8 | p[1]) : ((unsigned int)p[1] << 8 | p[0]);
+}
+
+/*
+ * Function: utf16_ascii_run
+ * Description: Converts leading UTF-16 code units that are ASCII and not the terminator, 8 (SSE2) or 4 (SWAR)
+ *              units per step; the remainder is left to the scalar loop
+ * Parameters: src - code units, units - number of units, big_endian - 1 for UTF-16BE, out - output
+ * Return: size_t - units converted (one output byte each)
+ */
+static size_t utf16_ascii_run(const unsigned char *src, size_t units, int big_endian, char *out)
+{
+  size_t done = 0;
+
+#ifdef HAVE_SSE2
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i high = _mm_set1_epi16((short)0xFF80); // Bits that must be clear in an ASCII unit
+
+  for (; done + 8 <= units; done += 8)
+  {
+    __m128i v = _mm_loadu_si128((const __m128i *)(src + 2 * done));
+    if (big_endian) // Swap the bytes of every unit
+    {
+      v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+    }
+    __m128i ascii = _mm_andnot_si128(_mm_cmpeq_epi16(v, zero), _mm_cmpeq_epi16(_mm_and_si128(v, high), zero)); // 1..0x7F
+    if (_mm_movemask_epi8(ascii) != 0xFFFF)
+    {
+      break;
+    }
+    _mm_storel_epi64((__m128i *)(out + done), _mm_packus_epi16(v, v)); // 8 units -> 8 bytes
+  }
+#elif defined(HAVE_SWAR)
+  for (; done + 4 <= units; done += 4)
+  {
+    uint64_t w;
+    memcpy(&w, src + 2 * done, 8);
+    if (big_endian)
+    {
+      w = ((w >> 8) & 0x00FF00FF00FF00FFULL) | ((w & 0x00FF00FF00FF00FFULL) << 8);
+    }
+    if ((w & 0xFF80FF80FF80FF80ULL) != 0 || ((w - 0x0001000100010001ULL) & ~w & 0x8000800080008000ULL) != 0) // Non-ASCII or zero unit
+    {
+      break;
+    }
+    out[done] = (char)w;
+    out[done + 1] = (char)(w >> 16);
+    out[done + 2] = (char)(w >> 32);
+    out[done + 3] = (char)(w >> 48);
+  }
+#else
+  (void)src, (void)units, (void)big_endian, (void)out;
+#endif
+  return done;
+}
+
+/*
+ * Function: utf16_to_utf8
+ * Description: UTF-16 to UTF-8 up to the first zero unit: surrogate pairs are combined, unpaired surrogates become U+FFFD
+ * Parameters: src - code units, len - bytes available, big_endian - 1 for UTF-16BE
+ * Return: char * - UTF-8 text from arena_malloc
+ */
+static char *utf16_to_utf8(const unsigned char *src, size_t len, int big_endian)
+{
+  size_t units = len / 2;            // A trailing odd byte is ignored
+  char *value = arena_malloc(3 * units + 1); // At most 3 UTF-8 bytes per unit (4 per surrogate pair)
+  char *out = value;
+
+  if (value == NULL)
+  {
+    return NULL;
+  }
+  for (size_t i = 0; i < units;)
+  {
+    size_t run = utf16_ascii_run(src + 2 * i, units - i, big_endian, out);
+    out += run;
+    i += run;
+    if (i >= units)
+    {
+      break;
+    }
+
+    unsigned long cp = unit16(src + 2 * i, big_endian);
+    i++;
+    if (cp == 0) // Terminator
+    {
+      break;
+    }
+    if (cp >= 0xD800 && cp <= 0xDFFF) // Surrogate: valid only as high + low pair
+    {
+      unsigned long low = (i < units) ? unit16(src + 2 * i, big_endian) : 0;
+      if (cp <= 0xDBFF && low >= 0xDC00 && low <= 0xDFFF)
+      {
+        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+        i++;
+      }
+      else
+      {
+        cp = TEXT_REPLACEMENT;
+      }
+    }
+    out = text_put_utf8(out, cp);
+  }
+  *out = '\0';
+  return value;
+}
+
+/*
+ * Function: text_to_utf8
+ * Description: Converts one ID3 string to UTF-8 (see text.h)
+ * Parameters: encoding - ID3 encoding byte, src - encoded bytes, len - bytes available
+ * Return: char * - null-terminated UTF-8 text from arena_malloc
+ */
+char *text_to_utf8(unsigned char encoding, const unsigned char *src, size_t len)
+{
+  if (encoding == TEXT_UTF16 || encoding == TEXT_UTF16BE)
+  {
+    int big_endian = (encoding == TEXT_UTF16BE); // UTF-16 without byte order mark: little-endian (what most taggers write)
+
+    if (len >= 2 && src[0] == 0xFF && src[1] == 0xFE) // Byte order mark wins over the encoding byte
+    {
+      big_endian = 0;
+      src += 2;
+      len -= 2;
+    }
+    else if (len >= 2 && src[0] == 0xFE && src[1] == 0xFF)
+    {
+      big_endian = 1;
+      src += 2;
+      len -= 2;
+    }
+    return utf16_to_utf8(src, len, big_endian);
+  }
+
+  const unsigned char *nul = memchr(src, '\0', len); // Single-byte encodings end at the first zero byte
+  if (nul != NULL)
+  {
+    len = (size_t)(nul - src);
+  }
+  if (encoding == TEXT_UTF8 || is_utf8(src, len)) // ISO-8859-1 text is almost never valid UTF-8: raw UTF-8 written as encoding 0 is read as UTF-8
+  {
+    return utf8_to_utf8(src, len);
+  }
+  return latin1_to_utf8(src, len); // Unknown encodings read as ISO-8859-1
+}
+
+/*
+ * Function: text_skip
+ * Description: Finds the end of one ID3 string
+ * Parameters: encoding - ID3 encoding byte, src - encoded bytes, len - bytes available
+ * Return: size_t - offset after the terminator (len when there is none)
+ */
+size_t text_skip(unsigned char encoding, const unsigned char *src, size_t len)
+{
+  if (encoding == TEXT_UTF16 || encoding == TEXT_UTF16BE) // Zero 16-bit unit, aligned to the string start
+  {
+    for (size_t i = 0; i + 1 < len; i += 2)
+    {
+      if (src[i] == 0 && src[i + 1] == 0)
+      {
+        return i + 2;
+      }
+    }
+    return len;
+  }
+
+  const unsigned char *nul = memchr(src, '\0', len);
+  return nul ? (size_t)(nul + 1 - src) : len;
+}
+
+/*
+ * Function: text_choose_encoding
+ * Description: Picks the encoding byte for new text (never ISO-8859-1 bytes the reader would take for UTF-8)
+ * Parameters: utf8 - new text, major - major version of the tag
+ * Return: unsigned char - TEXT_* encoding byte
+ */
+unsigned char text_choose_encoding(const char *utf8, unsigned char major)
+{
+  const unsigned char *p = (const unsigned char *)utf8;
+  const unsigned char *end = p + strlen(utf8);
+
+  if (text_ascii_prefix(p, (size_t)(end - p)) == (size_t)(end - p)) // Plain ASCII: ISO-8859-1, readable everywhere
+  {
+    return TEXT_LATIN1;
+  }
+  if (major >= 4)
+  {
+    return TEXT_UTF8;
+  }
+  while (p < end) // ID3v2.2/2.3: ISO-8859-1 if every character fits, else UTF-16
+  {
+    if (next_utf8(&p, end) > 0xFF)
+    {
+      return TEXT_UTF16;
+    }
+  }
+
+  size_t len = strlen(utf8); // ISO-8859-1 bytes that pass as UTF-8 would be read back as UTF-8 (text_to_utf8): UTF-16 instead
+  unsigned char *latin1 = malloc(len ? len : 1);
+  if (latin1 == NULL)
+  {
+    return TEXT_UTF16; // Always round-trips
+  }
+  int ambiguous = is_utf8(latin1, text_encode(utf8, TEXT_LATIN1, latin1));
+  free(latin1);
+  return ambiguous ? TEXT_UTF16 : TEXT_LATIN1;
+}
+
+/*
+ * Function: text_encode
+ * Description: Converts UTF-8 text to an ID3 encoding, without terminator
+ * Parameters: utf8 - text, encoding - TEXT_* encoding byte, out - output buffer
+ * Return: size_t - bytes written
+ */
+size_t text_encode(const char *utf8, unsigned char encoding, unsigned char *out)
+{
+  const unsigned char *p = (const unsigned char *)utf8;
+  const unsigned char *end = p + strlen(utf8);
+  unsigned char *start = out;
+
+  if (encoding == TEXT_UTF8)
+  {
+    memcpy(out, p, (size_t)(end - p));
+    return (size_t)(end - p);
+  }
+  if (encoding == TEXT_UTF16) // Byte order mark, then little-endian units
+  {
+    *out++ = 0xFF;
+    *out++ = 0xFE;
+  }
+
+  while (p < end)
+  {
+    if (encoding == TEXT_LATIN1) // ASCII runs are copied
+    {
+      size_t run = text_ascii_prefix(p, (size_t)(end - p));
+      memcpy(out, p, run);
+      out += run;
+      p += run;
+      if (p < end)
+      {
+        unsigned long cp = next_utf8(&p, end);
+        *out++ = (cp <= 0xFF) ? (unsigned char)cp : '?'; // Not representable in ISO-8859-1
+      }
+      continue;
+    }
+
+    unsigned long cp = next_utf8(&p, end);
+    unsigned int units[2] = {(unsigned int)cp, 0}; // One unit, or a surrogate pair
+    int n = 1;
+    if (cp >= 0x10000)
+    {
+      units[0] = 0xD800 + (unsigned int)((cp - 0x10000) >> 10);
+      units[1] = 0xDC00 + (unsigned int)((cp - 0x10000) & 0x3FF);
+      n = 2;
+    }
+    for (int i = 0; i < n; i++)
+    {
+      if (encoding == TEXT_UTF16BE)
+      {
+        *out++ = (unsigned char)(units[i] >> 8);
+        *out++ = (unsigned char)units[i];
+      }
+      else
+      {
+        *out++ = (unsigned char)units[i];
+        *out++ = (unsigned char)(units[i] >> 8);
+      }
+    }
+  }
+  return (size_t)(out - start);
+}
@@ -0,0 +1,65 @@
+#ifndef TEXT_H // If not defined TEXT_H ---> Checks if TEXT_H was previously defined: If not present, code is processed; else code below till #endif is ignored
+#define TEXT_H // Defines the macro TEXT_H if macro was not previously defined
+
+#include <stddef.h> // Header file for size_t
+
+#define TEXT_LATIN1 0  // Encoding byte 0: ISO-8859-1
+#define TEXT_UTF16 1   // Encoding byte 1: UTF-16 with byte order mark (little-endian when the mark is missing)
+#define TEXT_UTF16BE 2 // Encoding byte 2: UTF-16BE without byte order mark (ID3v2.4)
+#define TEXT_UTF8 3    // Encoding byte 3: UTF-8 (ID3v2.4)
+
+#define TEXT_ENCODED_MAX(n) (2 * (n) + 2) // Most bytes text_encode writes for n UTF-8 bytes (UTF-16 + byte order mark)
+
+/*
+ * Function: text_to_utf8
+ * Description: Converts one ID3 string to UTF-8, up to its terminator (one zero byte, or a zero 16-bit unit in
+ *              UTF-16) or the end of the bytes. Runs of ASCII are copied 16 bytes (SSE2) or 8 bytes (SWAR) at a
+ *              time; invalid UTF-8 and unpaired surrogates become U+FFFD. ISO-8859-1 text that is valid UTF-8
+ *              (written by taggers that ignore the encoding byte) is kept as UTF-8.
+ * Parameters: encoding - ID3 encoding byte (TEXT_*), src - encoded bytes, len - bytes available
+ * Return: char * - null-terminated UTF-8 text from arena_malloc, released with arena_release (NULL on allocation failure)
+ */
+char *text_to_utf8(unsigned char encoding, const unsigned char *src, size_t len);
+
+/*
+ * Function: text_skip
+ * Description: Finds the end of one ID3 string (COMM description, APIC description, ...)
+ * Parameters: encoding - ID3 encoding byte, src - encoded bytes, len - bytes available
+ * Return: size_t - offset just after the terminator (len when there is none)
+ */
+size_t text_skip(unsigned char encoding, const unsigned char *src, size_t len);
+
+/*
+ * Function: text_ascii_prefix
+ * Description: Counts the leading bytes below 0x80
+ * Parameters: src - bytes, len - byte count
+ * Return: size_t - length of the ASCII prefix
+ */
+size_t text_ascii_prefix(const unsigned char *src, size_t len);
+
+/*
+ * Function: text_choose_encoding
+ * Description: Picks the encoding byte for a new text frame: ISO-8859-1 when the text fits, else UTF-8 in ID3v2.4
+ *              and UTF-16 with byte order mark in ID3v2.2/2.3 (they have no UTF-8)
+ * Parameters: utf8 - new text, major - major version of the tag
+ * Return: unsigned char - TEXT_* encoding byte
+ */
+unsigned char text_choose_encoding(const char *utf8, unsigned char major);
+
+/*
+ * Function: text_encode
+ * Description: Converts UTF-8 text to an ID3 encoding, without terminator
+ * Parameters: utf8 - text, encoding - TEXT_* encoding byte, out - output (at least TEXT_ENCODED_MAX(strlen(utf8)) bytes)
+ * Return: size_t - bytes written
+ */
+size_t text_encode(const char *utf8, unsigned char encoding, unsigned char *out);
+
+/*
+ * Function: text_put_utf8
+ * Description: Writes a Unicode code point as UTF-8
+ * Parameters: out - output position, cp - code point
+ * Return: char * - position after the written bytes
+ */
+char *text_put_utf8(char *out, unsigned long cp);
+
+#endif // End of header guard: Marks the end of conditional compilation block started by #ifndef TEXT_H
@@ -0,0 +1,487 @@
+#include <stdlib.h>   // Header file for memory allocation functions (malloc, free)
+#include <string.h>   // Header file for string/memory functions (memcmp, memcpy, memset, strlen, strdup)
+#include <strings.h>  // Header file for strcasecmp
+#include <unistd.h>   // Header file for POSIX I/O functions (pread)
+#include <sys/stat.h> // Header file for file status information (fstat)
+#include "type.h"     // User-defined header file for custom type definitions (Status, e_success, e_failure)
+#include "id3.h"      // User-defined header file for ID3v2 parsing (appended tags) and TagFields
+#include "trailer.h"  // User-defined header file for trailer probe declarations
+#include "text.h"     // User-defined header file for ISO-8859-1 <-> UTF-8 conversion
+#include "arena.h"    // User-defined header file for arena_malloc (blocks read during bulk scans)
+
+// ID3v1 genre list (index = genre byte)
+static const char *const id3v1_genres[] = {
+    "Blues", "Classic Rock", "Country", "Dance", "Disco", "Funk", "Grunge", "Hip-Hop", "Jazz", "Metal",
+    "New Age", "Oldies", "Other", "Pop", "R&B", "Rap", "Reggae", "Rock", "Techno", "Industrial",
+    "Alternative", "Ska", "Death Metal", "Pranks", "Soundtrack", "Euro-Techno", "Ambient", "Trip-Hop", "Vocal", "Jazz+Funk",
+    "Fusion", "Trance", "Classical", "Instrumental", "Acid", "House", "Game", "Sound Clip", "Gospel", "Noise",
+    "AlternRock", "Bass", "Soul", "Punk", "Space", "Meditative", "Instrumental Pop", "Instrumental Rock", "Ethnic", "Gothic",
+    "Darkwave", "Techno-Industrial", "Electronic", "Pop-Folk", "Eurodance", "Dream", "Southern Rock", "Comedy", "Cult", "Gangsta",
+    "Top 40", "Christian Rap", "Pop/Funk", "Jungle", "Native American", "Cabaret", "New Wave", "Psychadelic", "Rave", "Showtunes",
+    "Trailer", "Lo-Fi", "Tribal", "Acid Punk", "Acid Jazz", "Polka", "Retro", "Musical", "Rock & Roll", "Hard Rock",
+};
+
+#define ID3V1_GENRE_COUNT (sizeof(id3v1_genres) / sizeof(id3v1_genres[0])) // Number of named genres
+
+/*
+ * Function: set_text
+ * Description: Stores a UTF-8 copy of a fixed-width or length-prefixed text in a field that is still absent,
+ *              without trailing spaces and null bytes
+ * Parameters: fields - TagFields to fill, field - target field, text - text bytes, len - available bytes,
+ *             encoding - TEXT_LATIN1 (ID3v1, Lyrics3v2) or TEXT_UTF8 (APEv2)
+ * Return: void
+ */
+static void set_text(TagFields *fields, TagField field, const unsigned char *text, size_t len, unsigned char encoding)
+{
+  const unsigned char *nul = memchr(text, '\0', len); // Fixed-width fields end at the first null byte
+
+  if (nul != NULL)
+  {
+    len = (size_t)(nul - text);
+  }
+  while (len > 0 && text[len - 1] == ' ') // ID3v1 pads with spaces as well
+  {
+    len--;
+  }
+  if (len == 0 || fields->value[field] != NULL) // Empty value, or already known from a preferred block
+  {
+    return;
+  }
+
+  fields->value[field] = text_to_utf8(encoding, text, len);
+}
+
+/*
+ * Function: le32
+ * Description: Decodes a 4-byte little-endian integer (APEv2 sizes and counts)
+ * Parameters: p - pointer to 4 bytes
+ * Return: unsigned int - decoded value
+ */
+static unsigned int le32(const unsigned char *p)
+{
+  return (unsigned int)p[0] | ((unsigned int)p[1] << 8) | ((unsigned int)p[2] << 16) | ((unsigned int)p[3] << 24);
+}
+
+/*
+ * Function: ascii_number
+ * Description: Decodes a fixed-width decimal number (Lyrics3v2 sizes)
+ * Parameters: p - digits, n - number of digits
+ * Return: long - value, or -1 when a byte is not a digit
+ */
+static long ascii_number(const unsigned char *p, size_t n)
+{
+  long value = 0;
+
+  for (size_t i = 0; i < n; i++)
+  {
+    if (p[i] < '0' || p[i] > '9')
+    {
+      return -1;
+    }
+    value = value * 10 + (p[i] - '0');
+  }
+  return value;
+}
+
+/*
+ * Function: block_bytes
+ * Description: Returns the bytes of [offset, offset + len): from the probe buffer when they are inside it, otherwise
+ *              from one extra pread into an allocated buffer
+ * Parameters: fd - file descriptor, probe - probe buffer, base - file offset of probe[0], offset - block offset,
+ *             len - block length, owned - receives the buffer from arena_malloc (NULL when the probe buffer is used)
+ * Return: const unsigned char * - block bytes, or NULL on read/allocation failure
+ */
+static const unsigned char *block_bytes(int fd, const unsigned char *probe, off_t base, off_t offset, size_t len, unsigned char **owned)
+{
+  *owned = NULL;
+  if (offset >= base) // Common case: the whole block was in the probe read
+  {
+    return probe + (offset - base);
+  }
+
+  *owned = arena_malloc(len ? len : 1);
+  if (*owned == NULL || pread(fd, *owned, len, offset) != (ssize_t)len)
+  {
+    arena_release(*owned);
+    *owned = NULL;
+    return NULL;
+  }
+  return *owned;
+}
+
+/*
+ * Function: parse_id3v1
+ * Description: Decodes an ID3v1 / ID3v1.1 block (v1.1 stores a track number in the last two comment bytes)
+ * Parameters: b - 128-byte block starting with "TAG", fields - TagFields to fill
+ * Return: void
+ */
+static void parse_id3v1(const unsigned char *b, TagFields *fields)
+{
+  set_text(fields, e_title, b + 3, 30, TEXT_LATIN1);
+  set_text(fields, e_artist, b + 33, 30, TEXT_LATIN1);
+  set_text(fields, e_album, b + 63, 30, TEXT_LATIN1);
+  set_text(fields, e_year, b + 93, 4, TEXT_LATIN1);
+  set_text(fields, e_comment, b + 97, (b[125] == 0 && b[126] != 0) ? 28 : 30, TEXT_LATIN1); // v1.1: comment is 28 bytes + 0 + track
+  if (b[127] < ID3V1_GENRE_COUNT)                                                // 255 = no genre
+  {
+    set_text(fields, e_genre, (const unsigned char *)id3v1_genres[b[127]], strlen(id3v1_genres[b[127]]), TEXT_LATIN1);
+  }
+}
+
+/*
+ * Function: parse_ape
+ * Description: Decodes the text items of an APEv2 tag (keys are case-insensitive, values are UTF-8)
+ * Parameters: items - first item, len - bytes of all items, count - number of items, fields - TagFields to fill
+ * Return: void
+ *
+ * Item structure:
+ * - 4 bytes: value size (little-endian)
+ * - 4 bytes: item flags (bits 1-2 = 0 for UTF-8 text)
+ * - key: ASCII, null-terminated
+ * - value: size bytes
+ */
+static void parse_ape(const unsigned char *items, size_t len, unsigned int count, TagFields *fields)
+{
+  static const char *const keys[TAG_FIELD_COUNT] = {"Title", "Artist", "Album", "Year", "Genre", "Comment"}; // APEv2 key of every TagField
+  size_t pos = 0;
+
+  for (unsigned int i = 0; i < count && pos + 8 < len; i++)
+  {
+    size_t value_len = le32(items + pos);                                 // Value size
+    unsigned int flags = le32(items + pos + 4);                           // Item flags
+    const unsigned char *key = items + pos + 8;                           // Key text
+    const unsigned char *key_end = memchr(key, '\0', len - pos - 8);     // Key terminator
+
+    if (key_end == NULL || value_len > len - (size_t)(key_end + 1 - items)) // Error handling: item runs past the tag
+    {
+      return;
+    }
+
+    const unsigned char *value = key_end + 1; // Value follows the key terminator
+    for (int f = 0; f < TAG_FIELD_COUNT && (flags & 0x06) == 0; f++) // Text items only
+    {
+      if (strcasecmp((const char *)key, keys[f]) == 0)
+      {
+        set_text(fields, (TagField)f, value, value_len, TEXT_UTF8);
+        break;
+      }
+    }
+    pos = (size_t)(value + value_len - items); // Next item
+  }
+}
+
+/*
+ * Function: parse_lyrics3
+ * Description: Decodes the fields of a Lyrics3v2 block ("LYRICSBEGIN" followed by ID + 5-digit size + data fields)
+ * Parameters: b - block starting with "LYRICSBEGIN", len - block length without the 15-byte footer, fields - TagFields to fill
+ * Return: void
+ */
+static void parse_lyrics3(const unsigned char *b, size_t len, TagFields *fields)
+{
+  size_t pos = 11; // After "LYRICSBEGIN"
+
+  while (pos + 8 <= len)
+  {
+    long size = ascii_number(b + pos + 3, 5); // Field data size
+    if (size < 0 || (size_t)size > len - pos - 8) // Error handling: corrupt field
+    {
+      return;
+    }
+
+    const unsigned char *data = b + pos + 8;
+    if (memcmp(b + pos, "ETT", 3) == 0) // Extended title
+    {
+      set_text(fields, e_title, data, (size_t)size, TEXT_LATIN1);
+    }
+    else if (memcmp(b + pos, "EAR", 3) == 0) // Extended artist
+    {
+      set_text(fields, e_artist, data, (size_t)size, TEXT_LATIN1);
+    }
+    else if (memcmp(b + pos, "EAL", 3) == 0) // Extended album
+    {
+      set_text(fields, e_album, data, (size_t)size, TEXT_LATIN1);
+    }
+    else if (memcmp(b + pos, "INF", 3) == 0) // Additional information
+    {
+      set_text(fields, e_comment, data, (size_t)size, TEXT_LATIN1);
+    }
+    pos += 8 + (size_t)size;
+  }
+}
+
+/*
+ * Function: probe_block
+ * Description: Recognises one trailer block ending at *tail (appended ID3v2, APEv2 or Lyrics3v2), decodes it and moves *tail to its start
+ * Parameters: fd - file descriptor, probe - probe buffer, base - file offset of probe[0], tail - end of the unprocessed
+ *             region (updated), parts - TagFields per block kind (indexed by the bit position of TRAILER_*), found - bits (updated)
+ * Return: int - 1 if a block was recognised
+ */
+static int probe_block(int fd, const unsigned char *probe, off_t base, off_t *tail, TagFields parts[4], unsigned int *found)
+{
+  const unsigned char *end = probe + (*tail - base); // Probe bytes just before the tail
+  size_t avail = (size_t)(*tail - base);             // Probe bytes available before the tail
+  unsigned char *owned;                              // Extra read, if any
+
+  if (!(*found & TRAILER_ID3V2) && avail >= ID3_FOOTER_SIZE && memcmp(end - ID3_FOOTER_SIZE, "3DI", 3) == 0) // Appended ID3v2.4 tag
+  {
+    unsigned char header_buf[ID3_HEADER_SIZE]; // Footer rewritten as a header so the usual parser can decode it
+    Id3Header header;
+
+    memcpy(header_buf, end - ID3_FOOTER_SIZE, ID3_HEADER_SIZE);
+    memcpy(header_buf, "ID3", 3);
+    if (id3_parse_header(header_buf, &header) == e_failure || header.tag_size > TRAILER_BLOCK_MAX)
+    {
+      return 0;
+    }
+
+    off_t total = 2 * ID3_HEADER_SIZE + (off_t)header.tag_size; // Header + frames + footer
+    if (total > *tail)
+    {
+      return 0;
+    }
+
+    const unsigned char *tag = block_bytes(fd, probe, base, *tail - ID3_FOOTER_SIZE - header.tag_size, header.tag_size, &owned);
+    if (tag != NULL)
+    {
+      id3_collect_fields(&header, tag, header.tag_size, &parts[1]);
+      arena_release(owned);
+    }
+    *found |= TRAILER_ID3V2;
+    *tail -= total;
+    return 1;
+  }
+
+  if (!(*found & TRAILER_APE) && avail >= APE_FOOTER_SIZE && memcmp(end - APE_FOOTER_SIZE, "APETAGEX", 8) == 0) // APEv2 footer
+  {
+    const unsigned char *footer = end - APE_FOOTER_SIZE;
+    size_t size = le32(footer + 12);                                          // Items + footer
+    size_t total = size + ((le32(footer + 20) & 0x80000000u) ? APE_FOOTER_SIZE : 0); // Plus the optional header
+    if (size < APE_FOOTER_SIZE || total > TRAILER_BLOCK_MAX || (off_t)total > *tail)
+    {
+      return 0;
+    }
+
+    size_t items_len = size - APE_FOOTER_SIZE;
+    const unsigned char *items = block_bytes(fd, probe, base, *tail - (off_t)size, items_len, &owned);
+    if (items != NULL)
+    {
+      parse_ape(items, items_len, le32(footer + 16), &parts[2]);
+      arena_release(owned);
+    }
+    *found |= TRAILER_APE;
+    *tail -= (off_t)total;
+    return 1;
+  }
+
+  if (!(*found & TRAILER_LYRICS3) && avail >= LYRICS3_FOOTER_SIZE && memcmp(end - 9, "LYRICS200", 9) == 0) // Lyrics3v2 footer
+  {
+    long size = ascii_number(end - LYRICS3_FOOTER_SIZE, 6); // Block size without the footer
+    if (size < 11 || size > TRAILER_BLOCK_MAX || size + LYRICS3_FOOTER_SIZE > *tail)
+    {
+      return 0;
+    }
+
+    const unsigned char *block = block_bytes(fd, probe, base, *tail - LYRICS3_FOOTER_SIZE - size, (size_t)size, &owned);
+    if (block != NULL && memcmp(block, "LYRICSBEGIN", 11) == 0)
+    {
+      parse_lyrics3(block, (size_t)size, &parts[3]);
+    }
+    arena_release(owned);
+    *found |= TRAILER_LYRICS3;
+    *tail -= size + LYRICS3_FOOTER_SIZE;
+    return 1;
+  }
+  return 0; // No more trailer blocks
+}
+
+/*
+ * Function: probe_tail
+ * Description: Detects ID3v1 and the other trailer blocks from the end backwards in the probed tail of a file
+ * Parameters: fd - file descriptor for blocks that start before the probe (-1 when probe holds the whole file),
+ *             probe - last bytes of the file, base - file offset of probe[0], size - file size, trailer - TrailerInfo to fill
+ * Return: void
+ */
+static void probe_tail(int fd, const unsigned char *probe, off_t base, off_t size, TrailerInfo *trailer)
+{
+  TagFields parts[4];          // Fields per block kind: ID3v1, appended ID3v2, APEv2, Lyrics3v2
+  size_t n = (size_t)(size - base); // Probe length
+  off_t tail = size;           // End of the unprocessed region
+
+  memset(parts, 0, sizeof(parts));
+
+  if (n >= ID3V1_SIZE && memcmp(probe + n - ID3V1_SIZE, "TAG", 3) == 0) // ID3v1 is always the very last block
+  {
+    trailer->found |= TRAILER_ID3V1;
+    trailer->id3v1_offset = tail - ID3V1_SIZE;
+    memcpy(trailer->id3v1, probe + n - ID3V1_SIZE, ID3V1_SIZE);
+    parse_id3v1(trailer->id3v1, &parts[0]);
+    tail -= ID3V1_SIZE;
+  }
+
+  while (tail > base && probe_block(fd, probe, base, &tail, parts, &trailer->found)) // Other blocks, in any order
+  {
+  }
+  trailer->start = tail;
+
+  static const int priority[4] = {1, 2, 3, 0}; // Appended ID3v2, APEv2, Lyrics3v2, then ID3v1
+  for (int p = 0; p < 4; p++)
+  {
+    for (int i = 0; i < TAG_FIELD_COUNT; i++)
+    {
+      if (trailer->fields.value[i] == NULL) // Take the value from the preferred block that has it
+      {
+        trailer->fields.value[i] = parts[priority[p]].value[i];
+        parts[priority[p]].value[i] = NULL;
+      }
+    }
+    id3_free_fields(&parts[priority[p]]); // Values hidden by a preferred block
+  }
+}
+
+/*
+ * Function: trailer_probe
+ * Description: One pread of the file tail, then ID3v1 and the other trailer blocks from the end backwards
+ * Parameters: fd - file descriptor, trailer - TrailerInfo to fill
+ * Return: Status (e_success/e_failure)
+ */
+Status trailer_probe(int fd, TrailerInfo *trailer)
+{
+  unsigned char probe[TRAILER_PROBE_SIZE]; // Last bytes of the file
+  struct stat st;
+
+  memset(trailer, 0, sizeof(*trailer));
+  trailer->id3v1_offset = -1;
+
+  if (fstat(fd, &st) == -1)
+  {
+    return e_failure;
+  }
+
+  size_t n = (st.st_size < TRAILER_PROBE_SIZE) ? (size_t)st.st_size : TRAILER_PROBE_SIZE; // Probe length
+  off_t base = st.st_size - (off_t)n;                                                    // File offset of probe[0]
+
+  if (pread(fd, probe, n, base) != (ssize_t)n) // The single probe read
+  {
+    return e_failure;
+  }
+  probe_tail(fd, probe, base, st.st_size, trailer);
+  return e_success;
+}
+
+/*
+ * Function: trailer_probe_tail
+ * Description: Same detection as trailer_probe over a tail read by the caller
+ * Parameters: fd - file descriptor, tail - last len bytes, len - length of tail, size - file size, trailer - TrailerInfo to fill
+ * Return: void
+ */
+void trailer_probe_tail(int fd, const unsigned char *tail, size_t len, off_t size, TrailerInfo *trailer)
+{
+  memset(trailer, 0, sizeof(*trailer));
+  trailer->id3v1_offset = -1;
+  probe_tail(fd, tail, size - (off_t)len, size, trailer);
+}
+
+/*
+ * Function: trailer_probe_buffer
+ * Description: Same detection as trailer_probe over a file image held in memory (every block is inside the buffer)
+ * Parameters: data - whole file, len - length of data, trailer - TrailerInfo to fill
+ * Return: void
+ */
+void trailer_probe_buffer(const unsigned char *data, size_t len, TrailerInfo *trailer)
+{
+  memset(trailer, 0, sizeof(*trailer));
+  trailer->id3v1_offset = -1;
+  probe_tail(-1, data, 0, (off_t)len, trailer);
+}
+
+/*
+ * Function: trailer_fill
+ * Description: Duplicates trailer values into the absent fields
+ * Parameters: trailer - probed TrailerInfo, fields - TagFields to complete
+ * Return: void
+ */
+void trailer_fill(const TrailerInfo *trailer, TagFields *fields)
+{
+  for (int i = 0; i < TAG_FIELD_COUNT; i++)
+  {
+    if (fields->value[i] == NULL && trailer->fields.value[i] != NULL)
+    {
+      fields->value[i] = strdup(trailer->fields.value[i]);
+    }
+  }
+}
+
+/*
+ * Function: put_fixed
+ * Description: Writes text into a fixed-width ID3v1 field as ISO-8859-1, null-padded and truncated to the width
+ * Parameters: dst - field start, width - field width, text - new value (UTF-8)
+ * Return: void
+ */
+static void put_fixed(unsigned char *dst, size_t width, const char *text)
+{
+  unsigned char *latin1 = malloc(TEXT_ENCODED_MAX(strlen(text))); // Characters outside ISO-8859-1 become '?'
+  size_t len = 0;
+
+  memset(dst, 0, width);
+  if (latin1 != NULL)
+  {
+    len = text_encode(text, TEXT_LATIN1, latin1);
+    memcpy(dst, latin1, len < width ? len : width);
+    free(latin1);
+  }
+}
+
+/*
+ * Function: trailer_patch_id3v1
+ * Description: Applies the new values to the stored ID3v1 block
+ * Parameters: trailer - TrailerInfo, values - new value per TagField
+ * Return: void
+ */
+void trailer_patch_id3v1(TrailerInfo *trailer, char *const values[TAG_FIELD_COUNT])
+{
+  unsigned char *b = trailer->id3v1;               // Raw block
+  int v11 = (b[125] == 0 && b[126] != 0);          // Keep the v1.1 track number
+
+  if (values[e_title] != NULL)
+  {
+    put_fixed(b + 3, 30, values[e_title]);
+  }
+  if (values[e_artist] != NULL)
+  {
+    put_fixed(b + 33, 30, values[e_artist]);
+  }
+  if (values[e_album] != NULL)
+  {
+    put_fixed(b + 63, 30, values[e_album]);
+  }
+  if (values[e_year] != NULL)
+  {
+    put_fixed(b + 93, 4, values[e_year]);
+  }
+  if (values[e_comment] != NULL)
+  {
+    put_fixed(b + 97, v11 ? 28 : 30, values[e_comment]);
+  }
+  if (values[e_genre] != NULL)
+  {
+    for (size_t g = 0; g < ID3V1_GENRE_COUNT; g++) // Genre byte only when the name is in the list
+    {
+      if (strcasecmp(values[e_genre], id3v1_genres[g]) == 0)
+      {
+        b[127] = (unsigned char)g;
+        break;
+      }
+    }
+  }
+}
+
+/*
+ * Function: trailer_free
+ * Description: Frees the merged values
+ * Parameters: trailer - pointer to TrailerInfo
+ * Return: void
+ */
+void trailer_free(TrailerInfo *trailer)
+{
+  id3_free_fields(&trailer->fields);
+}
@@ -0,0 +1,83 @@
+#ifndef TRAILER_H // If not defined TRAILER_H ---> Checks if TRAILER_H was previously defined: If not present, code is processed; else code below till #endif is ignored
+#define TRAILER_H // Defines the macro TRAILER_H if macro was not previously defined
+
+#include <sys/types.h> // Header file for off_t
+#include "type.h"      // User-defined header file for custom type definitions (Status, e_success, e_failure)
+#include "id3.h"       // User-defined header file for TagFields
+
+#define TRAILER_PROBE_SIZE 4096            // Bytes read from the end of the file in the single probe read
+#define TRAILER_BLOCK_MAX (16 * 1024 * 1024) // Largest trailer block accepted (larger sizes are treated as corrupt)
+#define ID3V1_SIZE 128                     // "TAG" + title[30] + artist[30] + album[30] + year[4] + comment[30] + genre
+#define APE_FOOTER_SIZE 32                 // "APETAGEX" footer (and optional header) of an APEv2 tag
+#define LYRICS3_FOOTER_SIZE 15             // 6-digit block size + "LYRICS200"
+
+#define TRAILER_ID3V1 0x01   // ID3v1 / ID3v1.1 block found
+#define TRAILER_ID3V2 0x02   // Appended ID3v2.4 tag found through its "3DI" footer
+#define TRAILER_APE 0x04     // APEv2 tag found
+#define TRAILER_LYRICS3 0x08 // Lyrics3v2 block found
+
+// Structure to store the tags found at the end of a file
+typedef struct // typedef used to give alternate name for structure here
+{
+  unsigned int found;                // TRAILER_* bits of the blocks found
+  off_t start;                       // Offset of the first trailer block (end of the audio data)
+  off_t id3v1_offset;                // Offset of the ID3v1 block (-1 when absent)
+  unsigned char id3v1[ID3V1_SIZE];   // Raw ID3v1 block (kept so an edit can patch it without reading it again)
+  TagFields fields;                  // Merged fields: appended ID3v2 first, then APEv2, Lyrics3v2, ID3v1
+} TrailerInfo;                       // TrailerInfo is alternate name for this structure
+
+/*
+ * Function: trailer_probe
+ * Description: Reads the last TRAILER_PROBE_SIZE bytes of a file with one pread and detects, from the end backwards,
+ *              ID3v1/v1.1, then any order of an appended ID3v2.4 tag (footer), APEv2 and Lyrics3v2 blocks.
+ *              Blocks that start before the probed range (large APE tags, appended tags with pictures) are
+ *              fetched with one extra pread each.
+ * Parameters: fd - file descriptor, trailer - pointer to TrailerInfo to fill (free with trailer_free)
+ * Return: Status (e_failure only for read errors; a file without trailer tags succeeds with found == 0)
+ */
+Status trailer_probe(int fd, TrailerInfo *trailer);
+
+/*
+ * Function: trailer_probe_tail
+ * Description: Runs the detection of trailer_probe over the last bytes of a file the caller already read (the bulk
+ *              reader queues that read itself); blocks that start before them are still fetched through fd
+ * Parameters: fd - file descriptor (-1: blocks outside tail are ignored), tail - last len bytes of the file,
+ *             len - bytes in tail, size - file size, trailer - pointer to TrailerInfo to fill (free with trailer_free)
+ * Return: void
+ */
+void trailer_probe_tail(int fd, const unsigned char *tail, size_t len, off_t size, TrailerInfo *trailer);
+
+/*
+ * Function: trailer_probe_buffer
+ * Description: Runs the trailer detection of trailer_probe over a whole file image in memory (no reads)
+ * Parameters: data - file bytes, len - length of data, trailer - pointer to TrailerInfo to fill (free with trailer_free)
+ * Return: void
+ */
+void trailer_probe_buffer(const unsigned char *data, size_t len, TrailerInfo *trailer);
+
+/*
+ * Function: trailer_fill
+ * Description: Copies trailer values into the fields that are still absent (the ID3v2 tag at the start wins)
+ * Parameters: trailer - probed TrailerInfo, fields - pointer to TagFields to complete
+ * Return: void
+ */
+void trailer_fill(const TrailerInfo *trailer, TagFields *fields);
+
+/*
+ * Function: trailer_patch_id3v1
+ * Description: Writes new values into the stored ID3v1 block (truncated to the fixed field widths; the genre is
+ *              matched by name against the ID3v1 genre list and left unchanged when unknown)
+ * Parameters: trailer - TrailerInfo with an ID3v1 block, values - new value per TagField (NULL = unchanged)
+ * Return: void
+ */
+void trailer_patch_id3v1(TrailerInfo *trailer, char *const values[TAG_FIELD_COUNT]);
+
+/*
+ * Function: trailer_free
+ * Description: Frees the merged field values
+ * Parameters: trailer - pointer to TrailerInfo
+ * Return: void
+ */
+void trailer_free(TrailerInfo *trailer);
+
+#endif // End of header guard: Marks the end of conditional compilation block started by #ifndef TRAILER_H